@@ -0,0 +1,175 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo item type for sorting the memory items
+typedef struct __tb_demo_item_t
+{
+    // the key
+    tb_long_t           key;
+
+    // the index
+    tb_size_t           index;
+
+    // the padding
+    tb_byte_t           padding[16];
+
+}tb_demo_item_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_bool_t tb_demo_parallel_fill(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // fill the random values
+    tb_long_t*  data = (tb_long_t*)priv;
+    tb_uint32_t seed = (tb_uint32_t)head * 2654435761u + 1;
+    for (; head < tail; head++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        data[head] = (tb_long_t)(seed & 0xffffff) - 0x800000;
+    }
+    return tb_true;
+}
+static tb_bool_t tb_demo_parallel_walk(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+{
+    // stop it at the given value
+    return (tb_long_t)item != (tb_long_t)priv;
+}
+static tb_hong_t tb_demo_parallel_sum(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // sum this range
+    tb_hong_t sum = 0;
+    for (; head < tail; head++) sum += (tb_long_t)tb_iterator_item(iterator, head);
+    return sum;
+}
+static tb_hong_t tb_demo_parallel_add(tb_hong_t left, tb_hong_t right, tb_cpointer_t priv)
+{
+    return left + right;
+}
+static tb_long_t tb_demo_parallel_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // compare the keys
+    tb_long_t lkey = ((tb_demo_item_t const*)litem)->key;
+    tb_long_t rkey = ((tb_demo_item_t const*)ritem)->key;
+    return lkey < rkey? -1 : (lkey > rkey);
+}
+static tb_void_t tb_demo_parallel_test_long(tb_size_t n)
+{
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_long_t* copy = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    if (data && copy)
+    {
+        // init iterator
+        tb_array_iterator_t array_iterator;
+        tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, data, n);
+
+        // fill data
+        tb_hong_t time = tb_mclock();
+        tb_parallel_for_all(iterator, 0, tb_demo_parallel_fill, data);
+        time = tb_mclock() - time;
+        tb_trace_i("for: %lu items, %lld ms", n, time);
+
+        // count it
+        time = tb_mclock();
+        tb_size_t count = tb_count_all_if(iterator, tb_predicate_le, (tb_cpointer_t)0);
+        tb_hong_t count_time = tb_mclock() - time;
+        time = tb_mclock();
+        tb_size_t parallel_count = tb_parallel_count_all_if(iterator, 0, tb_predicate_le, (tb_cpointer_t)0);
+        time = tb_mclock() - time;
+        tb_trace_i("count_if: %lu ?= %lu, %lld ms, parallel: %lld ms", parallel_count, count, count_time, time);
+
+        // reduce it
+        tb_hong_t sum = tb_demo_parallel_sum(iterator, 0, n, tb_null);
+        time = tb_mclock();
+        tb_hong_t parallel_sum = tb_parallel_reduce_all(iterator, 0, 0, tb_demo_parallel_sum, tb_demo_parallel_add, tb_null);
+        time = tb_mclock() - time;
+        tb_trace_i("reduce: %lld ?= %lld, %lld ms", parallel_sum, sum, time);
+
+        // walk it until the last item
+        tb_size_t walked = tb_parallel_walk_all(iterator, 0, tb_demo_parallel_walk, (tb_cpointer_t)TB_MAXS32);
+        tb_trace_i("walk: %lu ?= %lu", walked, n);
+
+        // sort it
+        tb_memcpy(copy, data, n * sizeof(tb_long_t));
+        time = tb_mclock();
+        tb_sort_all(iterator, tb_null);
+        tb_hong_t sort_time = tb_mclock() - time;
+        tb_swap(tb_long_t*, data, copy);
+        iterator = tb_iterator_make_for_long(&array_iterator, data, n);
+        time = tb_mclock();
+        tb_parallel_sort_all(iterator, 0, tb_null);
+        time = tb_mclock() - time;
+        tb_trace_i("sort: %s, %lld ms, parallel: %lld ms", tb_memcmp(data, copy, n * sizeof(tb_long_t))? "failed" : "ok", sort_time, time);
+
+        // sort it with the small odd ranges for merging many runs
+        tb_parallel_for_all(iterator, 0, tb_demo_parallel_fill, data);
+        time = tb_mclock();
+        tb_parallel_sort_all(iterator, n / 7 + 1, tb_null);
+        time = tb_mclock() - time;
+        tb_trace_i("sort: ranges: 7, %s, %lld ms", tb_memcmp(data, copy, n * sizeof(tb_long_t))? "failed" : "ok", time);
+    }
+
+    // exit data
+    if (data) tb_free(data);
+    if (copy) tb_free(copy);
+}
+static tb_void_t tb_demo_parallel_test_mem(tb_size_t n)
+{
+    // init items
+    tb_demo_item_t* items = tb_nalloc0_type(n, tb_demo_item_t);
+    tb_assert_and_check_return(items);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_mem(&array_iterator, items, n, sizeof(tb_demo_item_t));
+
+    // make the keys with many equal items
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++) 
+    {
+        items[i].key = tb_random_range(0, 1000);
+        items[i].index = i;
+    }
+
+    // sort it
+    tb_hong_t time = tb_mclock();
+    tb_parallel_sort_all(iterator, n / 5 + 1, tb_demo_parallel_comp);
+    time = tb_mclock() - time;
+
+    // check it
+    tb_size_t failed = 0;
+    tb_size_t checksum = 0;
+    for (i = 0; i < n; i++) 
+    {
+        if (i && items[i - 1].key > items[i].key) failed++;
+        checksum += items[i].index;
+    }
+    tb_trace_i("sort: mem: %s, %lld ms", (failed || checksum != n * (n - 1) / 2)? "failed" : "ok", time);
+
+    // exit items
+    tb_free(items);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_algorithm_parallel_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the items count
+    tb_size_t n = argv[1]? tb_atoi(argv[1]) : 4000000;
+    tb_check_return_val(n, 0);
+
+    // test it
+    tb_demo_parallel_test_long(n);
+    tb_demo_parallel_test_mem(n / 4 + 1);
+    return 0;
+}
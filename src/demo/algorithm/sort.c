@@ -475,6 +475,303 @@ static tb_void_t tb_sort_str_test_perf_heap(tb_size_t n)
     for (i = 0; i < n; i++) tb_free(data[i]);
     tb_free(data);
 }
+static tb_long_t tb_sort_int_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return ((tb_long_t)litem < (tb_long_t)ritem)? -1 : ((tb_long_t)litem > (tb_long_t)ritem);
+}
+static tb_bool_t tb_sort_int_check(tb_long_t const* data, tb_size_t n)
+{
+    tb_size_t i = 0;
+    for (i = 1; i < n; i++) tb_check_return_val(data[i - 1] <= data[i], tb_false);
+    return tb_true;
+}
+static tb_void_t tb_sort_int_make(tb_long_t* data, tb_size_t n, tb_size_t mode)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        switch (mode)
+        {
+        case 0:  data[i] = tb_random_range(TB_MINS32, TB_MAXS32);  break; // random
+        case 1:  data[i] = (tb_long_t)i - (tb_long_t)(n >> 1);     break; // sorted
+        case 2:  data[i] = (tb_long_t)(n - i);                     break; // reversed
+        default: data[i] = tb_random_range(0, 16);                 break; // many duplicates
+        }
+    }
+}
+static tb_void_t tb_sort_int_test_bench(tb_size_t n)
+{
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_long_t* temp = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data && temp);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, temp, n);
+
+    // bench all data patterns
+    tb_size_t           mode = 0;
+    tb_char_t const*    names[] = {"random", "sorted", "reversed", "duplicates"};
+    for (mode = 0; mode < tb_arrayn(names); mode++)
+    {
+        // make data
+        tb_sort_int_make(data, n, mode);
+
+        // sort it, the radix sort will be used for the integer items
+        tb_memcpy(temp, data, n * sizeof(tb_long_t));
+        tb_hong_t sort_time = tb_mclock();
+        tb_sort_all(iterator, tb_null);
+        sort_time = tb_mclock() - sort_time;
+        tb_bool_t ok = tb_sort_int_check(temp, n);
+
+        // sort it using the pdq sort with the comparer
+        tb_memcpy(temp, data, n * sizeof(tb_long_t));
+        tb_hong_t pdq_time = tb_mclock();
+        tb_pdq_sort_all(iterator, tb_sort_int_comp);
+        pdq_time = tb_mclock() - pdq_time;
+        if (!tb_sort_int_check(temp, n)) ok = tb_false;
+
+        // sort it using the heap sort
+        tb_memcpy(temp, data, n * sizeof(tb_long_t));
+        tb_hong_t heap_time = tb_mclock();
+        tb_heap_sort_all(iterator, tb_sort_int_comp);
+        heap_time = tb_mclock() - heap_time;
+        if (!tb_sort_int_check(temp, n)) ok = tb_false;
+
+        // trace
+        tb_trace_i("bench: %s: %lu: sort: %lld ms, pdq_sort: %lld ms, heap_sort: %lld ms, %s", names[mode], n, sort_time, pdq_time, heap_time, ok? "ok" : "failed");
+    }
+
+    // free data
+    tb_free(temp);
+    tb_free(data);
+}
+static tb_long_t tb_sort_uint32_comp_greater(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    return ((tb_uint32_t)(tb_size_t)ldata > (tb_uint32_t)(tb_size_t)rdata)? -1 : ((tb_uint32_t)(tb_size_t)ldata < (tb_uint32_t)(tb_size_t)rdata);
+}
+static tb_void_t tb_sort_vector_test_func(tb_size_t n)
+{
+    // init vectors, the second vector uses the reversed comparer and will not be sorted by the radix sort
+    tb_element_t    element = tb_element_uint32();
+    tb_vector_ref_t vector = tb_vector_init(0, element);
+    element.comp = tb_sort_uint32_comp_greater;
+    tb_vector_ref_t greater = tb_vector_init(0, element);
+    tb_assert_and_check_return(vector && greater);
+
+    // make data
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++) 
+    {
+        tb_uint32_t value = (tb_uint32_t)tb_random_range(0, TB_MAXS32) << 1;
+        tb_vector_insert_tail(vector, tb_u2p(value));
+        tb_vector_insert_tail(greater, tb_u2p(value));
+    }
+
+    // sort them
+    tb_sort_all(vector, tb_null);
+    tb_sort_all(greater, tb_null);
+
+    // check
+    tb_bool_t ok = tb_true;
+    for (i = 1; i < n && ok; i++)
+    {
+        if (tb_p2u32(tb_iterator_item(vector, i - 1)) > tb_p2u32(tb_iterator_item(vector, i))) ok = tb_false;
+        if (tb_p2u32(tb_iterator_item(greater, i - 1)) < tb_p2u32(tb_iterator_item(greater, i))) ok = tb_false;
+    }
+    for (i = 0; i < n && ok; i++)
+    {
+        if (tb_iterator_item(vector, i) != tb_iterator_item(greater, n - i - 1)) ok = tb_false;
+    }
+
+    // trace
+    tb_trace_i("vector: %lu: %s", n, ok? "ok" : "failed");
+
+    // exit vectors
+    tb_vector_exit(greater);
+    tb_vector_exit(vector);
+}
+static tb_long_t tb_sort_mem_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    tb_uint32_t lkey = *((tb_uint32_t const*)litem);
+    tb_uint32_t rkey = *((tb_uint32_t const*)ritem);
+    return (lkey < rkey)? -1 : (lkey > rkey);
+}
+static tb_void_t tb_sort_mem_test_func(tb_size_t n)
+{
+    // the item: key + the payload which is made from the key
+    tb_size_t const step = 24;
+
+    // init data
+    tb_byte_t* data = (tb_byte_t*)tb_nalloc0(n, step);
+    tb_assert_and_check_return(data);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_mem(&array_iterator, data, n, step);
+
+    // make data with many duplicate keys
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_uint32_t key = (tb_uint32_t)tb_random_range(0, (tb_long_t)(n >> 2));
+        tb_memcpy(data + i * step, &key, sizeof(key));
+        tb_memset(data + i * step + sizeof(key), (tb_int_t)(key & 0xff), step - sizeof(key));
+    }
+
+    // sort it
+    tb_pdq_sort_all(iterator, tb_sort_mem_comp);
+
+    // check
+    tb_bool_t ok = tb_true;
+    for (i = 0; i < n && ok; i++)
+    {
+        tb_byte_t const* item = data + i * step;
+        if (i && tb_sort_mem_comp(iterator, item - step, item) > 0) ok = tb_false;
+        if (item[step - 1] != (*((tb_uint32_t const*)item) & 0xff)) ok = tb_false;
+    }
+
+    // trace
+    tb_trace_i("mem: %lu: %s", n, ok? "ok" : "failed");
+
+    // free data
+    tb_free(data);
+}
+static tb_long_t tb_sort_int_comp_greater(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return ((tb_long_t)litem > (tb_long_t)ritem)? -1 : ((tb_long_t)litem < (tb_long_t)ritem);
+}
+static tb_void_t tb_sort_stable_test_func(tb_size_t n)
+{
+    // the item: key + the original index
+    tb_size_t const step = 2 * sizeof(tb_uint32_t);
+
+    // init data
+    tb_uint32_t* data = (tb_uint32_t*)tb_nalloc0(n, step);
+    tb_assert_and_check_return(data);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_mem(&array_iterator, data, n, step);
+
+    // make data with many duplicate keys
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        data[i << 1] = (tb_uint32_t)tb_random_range(0, 100);
+        data[(i << 1) + 1] = (tb_uint32_t)i;
+    }
+
+    // sort it
+    tb_hong_t time = tb_mclock();
+    tb_stable_sort_all(iterator, tb_sort_mem_comp);
+    time = tb_mclock() - time;
+
+    // check, the equal items keep their original order
+    tb_bool_t ok = tb_true;
+    for (i = 1; i < n && ok; i++)
+    {
+        tb_uint32_t const* prev = data + ((i - 1) << 1);
+        tb_uint32_t const* item = data + (i << 1);
+        if (prev[0] > item[0] || (prev[0] == item[0] && prev[1] > item[1])) ok = tb_false;
+    }
+
+    // trace
+    tb_trace_i("stable_sort: %lu: %lld ms, %s", n, time, ok? "ok" : "failed");
+
+    // free data
+    tb_free(data);
+}
+static tb_void_t tb_sort_nth_test_func(tb_size_t n)
+{
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_long_t* temp = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data && temp);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, temp, n);
+
+    // make the sorted data
+    tb_sort_int_make(data, n, 0);
+    tb_memcpy(temp, data, n * sizeof(tb_long_t));
+    tb_sort_all(iterator, tb_null);
+    tb_long_t median = temp[n >> 1];
+
+    // select the median directly
+    tb_memcpy(temp, data, n * sizeof(tb_long_t));
+    tb_nth_element_all(iterator, n >> 1, tb_null);
+    tb_bool_t ok = temp[n >> 1] == median;
+
+    // select the median with the comparer
+    tb_memcpy(temp, data, n * sizeof(tb_long_t));
+    tb_nth_element_all(iterator, n >> 1, tb_sort_int_comp);
+    if (temp[n >> 1] != median) ok = tb_false;
+
+    // check the partitions
+    tb_size_t i = 0;
+    for (i = 0; i < n && ok; i++)
+    {
+        if (i < (n >> 1) && temp[i] > median) ok = tb_false;
+        if (i > (n >> 1) && temp[i] < median) ok = tb_false;
+    }
+
+    // trace
+    tb_trace_i("nth_element: %lu: median: %ld, %s", n, median, ok? "ok" : "failed");
+
+    // free data
+    tb_free(temp);
+    tb_free(data);
+}
+static tb_void_t tb_sort_partial_test_bench(tb_size_t n, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(size && size <= n);
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_long_t* temp = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_long_t* top = (tb_long_t*)tb_nalloc0(size, sizeof(tb_long_t));
+    tb_assert_and_check_return(data && temp && top);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, temp, n);
+
+    // make the random counts
+    tb_sort_int_make(data, n, 0);
+
+    // get the top items by sorting all items
+    tb_memcpy(temp, data, n * sizeof(tb_long_t));
+    tb_hong_t sort_time = tb_mclock();
+    tb_sort_all(iterator, tb_sort_int_comp_greater);
+    sort_time = tb_mclock() - sort_time;
+    tb_memcpy(top, temp, size * sizeof(tb_long_t));
+
+    // get the top items by the partial sort with the comparer
+    tb_memcpy(temp, data, n * sizeof(tb_long_t));
+    tb_hong_t partial_time = tb_mclock();
+    tb_partial_sort_all(iterator, size, tb_sort_int_comp_greater);
+    partial_time = tb_mclock() - partial_time;
+    tb_bool_t ok = !tb_memcmp(top, temp, size * sizeof(tb_long_t));
+
+    // get the smallest items by the partial sort directly
+    tb_memcpy(temp, data, n * sizeof(tb_long_t));
+    tb_hong_t direct_time = tb_mclock();
+    tb_partial_sort_all(iterator, size, tb_null);
+    direct_time = tb_mclock() - direct_time;
+    if (!tb_sort_int_check(temp, size)) ok = tb_false;
+
+    // trace
+    tb_trace_i("partial_sort: top %lu of %lu: sort: %lld ms, partial_sort: %lld ms, direct: %lld ms, %s", size, n, sort_time, partial_time, direct_time, ok? "ok" : "failed");
+
+    // free data
+    tb_free(top);
+    tb_free(temp);
+    tb_free(data);
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -498,5 +795,13 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_str_test_perf_bubble(1000);
     tb_sort_str_test_perf_insert(1000);
 
+    // bench
+    tb_sort_vector_test_func(100000);
+    tb_sort_mem_test_func(100000);
+    tb_sort_int_test_bench(argv[1]? tb_atoi(argv[1]) : 1000000);
+    tb_sort_stable_test_func(100000);
+    tb_sort_nth_test_func(100000);
+    tb_sort_partial_test_bench(argv[1]? tb_atoi(argv[1]) : 1000000, 100);
+
     return 0;
 }
@@ -306,6 +306,89 @@ static tb_void_t tb_demo_test_long_p()
         tb_bloom_filter_exit(filter);
     }
 }
+static tb_void_t tb_demo_test_long_b(tb_bool_t block)
+{
+    // the count
+    tb_size_t count = 1000000;
+
+    // init filter
+    tb_bloom_filter_ref_t filter = block?    tb_bloom_filter_init_block(TB_BLOOM_FILTER_PROBABILITY_0_01, 6, count, tb_element_long())
+                                        :   tb_bloom_filter_init(TB_BLOOM_FILTER_PROBABILITY_0_01, 6, count, tb_element_long());
+    if (filter)
+    {
+        // set the even values
+        tb_size_t i = 0;
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < count; i++) tb_bloom_filter_set(filter, (tb_cpointer_t)(i << 1));
+        t = tb_mclock() - t;
+
+        // get the even and odd values
+        tb_size_t f = 0;
+        tb_size_t l = 0;
+        tb_hong_t g = tb_mclock();
+        for (i = 0; i < count; i++) 
+        {
+            // lost?
+            if (!tb_bloom_filter_get(filter, (tb_cpointer_t)(i << 1))) l++;
+
+            // false positive?
+            if (tb_bloom_filter_get(filter, (tb_cpointer_t)((i << 1) + 1))) f++;
+        }
+        g = tb_mclock() - g;
+
+        // trace
+        tb_trace_i("long: %s: count: %lu, lost: %lu, false: %lu, set: %lld ms, get: %lld ms", block? "block" : "plain", count, l, f, t, g);
+
+        // exit filter
+        tb_bloom_filter_exit(filter);
+    }
+}
+static tb_void_t tb_demo_test_long_s(tb_bool_t block)
+{
+    // the count
+    tb_size_t count = 100000;
+
+    // the file path
+    tb_char_t path[TB_PATH_MAXN];
+    tb_size_t size = tb_directory_temporary(path, sizeof(path));
+    if (!size) return ;
+    tb_snprintf(path + size, sizeof(path) - size, "/tbox_bloom_filter.dat");
+
+    // init filter
+    tb_bloom_filter_ref_t filter = block?    tb_bloom_filter_init_block(TB_BLOOM_FILTER_PROBABILITY_0_001, 8, count, tb_element_long())
+                                        :   tb_bloom_filter_init(TB_BLOOM_FILTER_PROBABILITY_0_001, 3, count, tb_element_long());
+    if (filter)
+    {
+        // set values
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) tb_bloom_filter_set(filter, (tb_cpointer_t)(i * 3));
+
+        // save and load it
+        tb_bloom_filter_ref_t loaded = tb_bloom_filter_save(filter, path)? tb_bloom_filter_load(path, tb_element_long()) : tb_null;
+        if (loaded)
+        {
+            // the loaded filter must be the same as the original filter
+            tb_size_t d = 0;
+            for (i = 0; i < (count << 1); i++)
+            {
+                if (tb_bloom_filter_get(filter, (tb_cpointer_t)i) != tb_bloom_filter_get(loaded, (tb_cpointer_t)i)) d++;
+            }
+
+            // trace
+            tb_trace_i("long: %s: save and load: %s, diff: %lu", block? "block" : "plain", path, d);
+
+            // exit the loaded filter
+            tb_bloom_filter_exit(loaded);
+        }
+        else tb_trace_e("long: %s: save and load: %s failed", block? "block" : "plain", path);
+
+        // remove the file
+        tb_file_remove(path);
+
+        // exit filter
+        tb_bloom_filter_exit(filter);
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -406,5 +489,11 @@ tb_int_t tb_demo_container_bloom_filter_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_test_long_p();
     tb_demo_test_cstr_p();
 
+    tb_trace_i("===========================================================");
+    tb_demo_test_long_b(tb_false);
+    tb_demo_test_long_b(tb_true);
+    tb_demo_test_long_s(tb_false);
+    tb_demo_test_long_s(tb_true);
+
     return 0;
 }
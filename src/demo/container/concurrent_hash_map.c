@@ -0,0 +1,283 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maxn
+#define TB_DEMO_THREAD_MAXN         (16)
+
+// the name count of benchmark
+#define TB_DEMO_BENCH_NAME_COUNT    (1 << 16)
+
+// the data of the given name for benchmark, so the readers can check it
+#define TB_DEMO_BENCH_NAME_DATA(n)  ((n) * 7 + 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo worker type
+typedef struct __tb_demo_worker_t
+{
+    // the worker index
+    tb_size_t                       index;
+
+    // the operation count
+    tb_size_t                       count;
+
+    // the found count
+    tb_size_t                       found;
+
+    // the count of the wrong values
+    tb_size_t                       errors;
+
+}tb_demo_worker_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the concurrent hash map
+static tb_concurrent_hash_map_ref_t g_concurrent_hash_map = tb_null;
+
+// the hash map with the global lock for comparing
+static tb_hash_map_ref_t            g_hash_map = tb_null;
+
+// the global lock
+static tb_spinlock_t                g_lock = TB_SPINLOCK_INIT;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_int_t tb_demo_test_insert_func(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_worker_t* worker = (tb_demo_worker_t*)priv;
+    tb_assert_and_check_return_val(worker, -1);
+
+    // insert the names of this worker: index, index + 16, index + 32, ...
+    tb_size_t i = 0;
+    tb_char_t name[64];
+    for (i = 0; i < worker->count; i++)
+    {
+        tb_size_t n = i * TB_DEMO_THREAD_MAXN + worker->index;
+        tb_snprintf(name, sizeof(name), "name%lu", n);
+        tb_concurrent_hash_map_insert(g_concurrent_hash_map, name, (tb_pointer_t)n);
+    }
+    return 0;
+}
+static tb_bool_t tb_demo_test_walk_func(tb_hash_map_item_ref_t item, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(item && priv);
+
+    // check this item
+    tb_char_t name[64];
+    tb_snprintf(name, sizeof(name), "name%lu", (tb_size_t)item->data);
+    tb_assert(!tb_strcmp((tb_char_t const*)item->name, name));
+
+    // count it
+    (*((tb_size_t*)priv))++;
+    return tb_true;
+}
+static tb_bool_t tb_demo_test_pred_func(tb_hash_map_item_ref_t item, tb_cpointer_t priv)
+{
+    // remove the odd items of each worker
+    return (((tb_size_t)item->data) / TB_DEMO_THREAD_MAXN) & 1;
+}
+static tb_void_t tb_demo_test_func(tb_size_t thread_count, tb_size_t count)
+{
+    // init hash map
+    g_concurrent_hash_map = tb_concurrent_hash_map_init(0, tb_element_str(tb_true), tb_element_size());
+    tb_assert_and_check_return(g_concurrent_hash_map);
+
+    // insert items from all threads
+    tb_size_t           i = 0;
+    tb_thread_ref_t     threads[TB_DEMO_THREAD_MAXN] = {0};
+    tb_demo_worker_t    workers[TB_DEMO_THREAD_MAXN] = {{0}};
+    for (i = 0; i < thread_count; i++)
+    {
+        workers[i].index = i;
+        workers[i].count = count;
+        threads[i] = tb_thread_init(tb_null, tb_demo_test_insert_func, &workers[i], 0);
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    tb_assert(tb_concurrent_hash_map_size(g_concurrent_hash_map) == thread_count * count);
+
+    // check all items
+    tb_char_t name[64];
+    for (i = 0; i < count * TB_DEMO_THREAD_MAXN; i++)
+    {
+        tb_pointer_t data = tb_null;
+        tb_snprintf(name, sizeof(name), "name%lu", i);
+        tb_bool_t found = tb_concurrent_hash_map_get(g_concurrent_hash_map, name, &data);
+        tb_assert(found == (i % TB_DEMO_THREAD_MAXN < thread_count));
+        tb_assert(!found || (tb_size_t)data == i);
+        tb_used(found);
+    }
+
+    // walk all items
+    tb_size_t walked = 0;
+    tb_concurrent_hash_map_walk(g_concurrent_hash_map, tb_demo_test_walk_func, &walked);
+    tb_assert(walked == thread_count * count);
+
+    // remove the odd items
+    tb_concurrent_hash_map_remove_if(g_concurrent_hash_map, tb_demo_test_pred_func, tb_null);
+    tb_assert(tb_concurrent_hash_map_size(g_concurrent_hash_map) == thread_count * count / 2);
+
+    // remove the even items of each worker
+    for (i = 0; i < count * TB_DEMO_THREAD_MAXN; i++)
+    {
+        tb_snprintf(name, sizeof(name), "name%lu", i);
+        tb_bool_t removed = tb_concurrent_hash_map_remove(g_concurrent_hash_map, name);
+        tb_assert(removed == (i % TB_DEMO_THREAD_MAXN < thread_count && !((i / TB_DEMO_THREAD_MAXN) & 1)));
+        tb_used(removed);
+    }
+
+    // trace
+    tb_trace_i("func: threads: %lu, walked: %lu, left: %lu", thread_count, walked, tb_concurrent_hash_map_size(g_concurrent_hash_map));
+    tb_assert(!tb_concurrent_hash_map_size(g_concurrent_hash_map));
+
+    // exit hash map
+    tb_concurrent_hash_map_exit(g_concurrent_hash_map);
+    g_concurrent_hash_map = tb_null;
+}
+static tb_int_t tb_demo_bench_func(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_worker_t* worker = (tb_demo_worker_t*)priv;
+    tb_assert_and_check_return_val(worker, -1);
+
+    // get 15/16 and insert 1/16 for the random names
+    tb_size_t i = 0;
+    tb_size_t found = 0;
+    tb_size_t errors = 0;
+    tb_pointer_t data = tb_null;
+    tb_uint32_t seed = (tb_uint32_t)worker->index * 2654435761u + 1;
+    for (i = 0; i < worker->count; i++)
+    {
+        // the next random value, xorshift32
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        // the name
+        tb_size_t name = seed & (TB_DEMO_BENCH_NAME_COUNT - 1);
+        tb_bool_t insert = !((seed >> 16) & 15);
+
+        // done
+        if (g_concurrent_hash_map)
+        {
+            if (insert) tb_concurrent_hash_map_insert(g_concurrent_hash_map, (tb_pointer_t)name, (tb_pointer_t)TB_DEMO_BENCH_NAME_DATA(name));
+            else if (tb_concurrent_hash_map_get(g_concurrent_hash_map, (tb_pointer_t)name, &data))
+            {
+                // check the value
+                if ((tb_size_t)data != TB_DEMO_BENCH_NAME_DATA(name)) errors++;
+                found++;
+            }
+        }
+        else
+        {
+            tb_spinlock_enter(&g_lock);
+            if (insert) tb_hash_map_insert(g_hash_map, (tb_pointer_t)name, (tb_pointer_t)TB_DEMO_BENCH_NAME_DATA(name));
+            else if (tb_hash_map_find(g_hash_map, (tb_pointer_t)name))
+            {
+                // check the value
+                if ((tb_size_t)tb_hash_map_get(g_hash_map, (tb_pointer_t)name) != TB_DEMO_BENCH_NAME_DATA(name)) errors++;
+                found++;
+            }
+            tb_spinlock_leave(&g_lock);
+        }
+    }
+    worker->found  = found;
+    worker->errors = errors;
+    return 0;
+}
+static tb_hong_t tb_demo_bench_run(tb_size_t thread_count, tb_size_t count, tb_size_t* perrors)
+{
+    // run all threads
+    tb_size_t           i = 0;
+    tb_thread_ref_t     threads[TB_DEMO_THREAD_MAXN] = {0};
+    tb_demo_worker_t    workers[TB_DEMO_THREAD_MAXN] = {{0}};
+    tb_hong_t           time = tb_mclock();
+    for (i = 0; i < thread_count; i++)
+    {
+        workers[i].index = i;
+        workers[i].count = count / thread_count;
+        threads[i] = tb_thread_init(tb_null, tb_demo_bench_func, &workers[i], 0);
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // the count of the wrong values
+    for (i = 0; i < thread_count; i++) *perrors += workers[i].errors;
+    return time;
+}
+static tb_void_t tb_demo_bench(tb_size_t count)
+{
+    // init hash maps
+    g_hash_map = tb_hash_map_init(0, tb_element_size(), tb_element_size());
+    tb_assert_and_check_return(g_hash_map);
+
+    // the thread count
+    tb_size_t thread_maxn = tb_min(tb_processor_count() * 2, TB_DEMO_THREAD_MAXN);
+    tb_size_t thread_count = 1;
+    for (thread_count = 1; thread_count <= thread_maxn; thread_count <<= 1)
+    {
+        // bench the hash map with the global lock
+        tb_size_t errors = 0;
+        tb_hash_map_clear(g_hash_map);
+        tb_hong_t locked_time = tb_demo_bench_run(thread_count, count, &errors);
+
+        // bench the concurrent hash map
+        g_concurrent_hash_map = tb_concurrent_hash_map_init(0, tb_element_size(), tb_element_size());
+        tb_assert_and_check_break(g_concurrent_hash_map);
+        tb_hong_t concurrent_time = tb_demo_bench_run(thread_count, count, &errors);
+        tb_concurrent_hash_map_exit(g_concurrent_hash_map);
+        g_concurrent_hash_map = tb_null;
+
+        // trace
+        tb_trace_i("bench: threads: %lu, ops: %lu, locked: %lld ms, concurrent: %lld ms, errors: %lu", thread_count, count, locked_time, concurrent_time, errors);
+        tb_assert(!errors);
+    }
+
+    // exit hash map
+    tb_hash_map_exit(g_hash_map);
+    g_hash_map = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_concurrent_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+#if 1
+    tb_demo_test_func(1, 10000);
+    tb_demo_test_func(4, 10000);
+    tb_demo_test_func(TB_DEMO_THREAD_MAXN, 10000);
+#endif
+
+#if 1
+    tb_demo_bench(argv[1]? tb_atoi(argv[1]) : 4000000);
+#endif
+
+    return 0;
+}
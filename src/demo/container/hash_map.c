@@ -580,7 +580,154 @@ static tb_void_t tb_hash_map_test_walk_perf()
     // exit 
     tb_hash_map_exit(hash);
 }
+static tb_void_t tb_hash_map_test_bench_shuffle(tb_size_t* order, tb_size_t count)
+{
+    // shuffle the access order for avoiding the sequential memory access
+    tb_size_t i = 0;
+    for (i = count - 1; i > 0; i--)
+    {
+        tb_size_t j = (tb_size_t)tb_random_range(0, i + 1);
+        tb_size_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+}
+static tb_void_t tb_hash_map_test_i2i_bench(tb_size_t* order, tb_size_t count)
+{
+    // init hash
+    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert
+    tb_size_t i = 0;
+    tb_hash_map_test_bench_shuffle(order, count);
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < count; i++) tb_hash_map_insert(hash, (tb_pointer_t)(order[i] * 2654435761ul), (tb_pointer_t)order[i]);
+    tb_hong_t insert_time = tb_mclock() - t;
+    tb_assert(tb_hash_map_size(hash) == count);
+
+    // get
+    __tb_volatile__ tb_size_t sum = 0;
+    tb_hash_map_test_bench_shuffle(order, count);
+    t = tb_mclock();
+    for (i = 0; i < count; i++) sum += (tb_size_t)tb_hash_map_get(hash, (tb_pointer_t)(order[i] * 2654435761ul));
+    tb_hong_t get_time = tb_mclock() - t;
+
+    // remove
+    tb_hash_map_test_bench_shuffle(order, count);
+    t = tb_mclock();
+    for (i = 0; i < count; i++) tb_hash_map_remove(hash, (tb_pointer_t)(order[i] * 2654435761ul));
+    tb_hong_t remove_time = tb_mclock() - t;
+    tb_assert(!tb_hash_map_size(hash));
+
+    // trace
+    tb_trace_i("i2i: %lu items, insert: %lld ms, get: %lld ms, remove: %lld ms, sum: %lu", count, insert_time, get_time, remove_time, sum);
+
+    // exit hash
+    tb_hash_map_exit(hash);
+}
+static tb_void_t tb_hash_map_test_s2i_bench(tb_size_t* order, tb_size_t count)
+{
+    // init hash
+    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // make names
+    tb_char_t* names = (tb_char_t*)tb_malloc(count * 16);
+    if (names)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) tb_snprintf(names + i * 16, 16, "%lx", i * 2654435761ul);
+
+        // insert
+        tb_hash_map_test_bench_shuffle(order, count);
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < count; i++) tb_hash_map_insert(hash, names + order[i] * 16, (tb_pointer_t)order[i]);
+        tb_hong_t insert_time = tb_mclock() - t;
+        tb_assert(tb_hash_map_size(hash) == count);
+
+        // get
+        __tb_volatile__ tb_size_t sum = 0;
+        tb_hash_map_test_bench_shuffle(order, count);
+        t = tb_mclock();
+        for (i = 0; i < count; i++) sum += (tb_size_t)tb_hash_map_get(hash, names + order[i] * 16);
+        tb_hong_t get_time = tb_mclock() - t;
+
+        // remove
+        tb_hash_map_test_bench_shuffle(order, count);
+        t = tb_mclock();
+        for (i = 0; i < count; i++) tb_hash_map_remove(hash, names + order[i] * 16);
+        tb_hong_t remove_time = tb_mclock() - t;
+        tb_assert(!tb_hash_map_size(hash));
+
+        // trace
+        tb_trace_i("s2i: %lu items, insert: %lld ms, get: %lld ms, remove: %lld ms, sum: %lu", count, insert_time, get_time, remove_time, sum);
+
+        // exit names
+        tb_free(names);
+    }
+
+    // exit hash
+    tb_hash_map_exit(hash);
+}
+static tb_void_t tb_hash_map_test_latency_bench(tb_size_t count)
+{
+    // init hash
+    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert and count the latency of each insert by the microseconds, the last one is for all larger latencies
+    tb_size_t   i = 0;
+    tb_size_t   counts[1025] = {0};
+    tb_hong_t   latency_max = 0;
+    tb_hong_t   t = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        tb_hong_t u = tb_uclock();
+        tb_hash_map_insert(hash, (tb_pointer_t)(i * 2654435761ul), (tb_pointer_t)i);
+        u = tb_uclock() - u;
+        if (u > latency_max) latency_max = u;
+        counts[tb_min(u, 1024)]++;
+    }
+    t = tb_mclock() - t;
+
+    // the p99 latency
+    tb_size_t p99 = 0;
+    tb_size_t total = 0;
+    for (p99 = 0; p99 < 1024; p99++)
+    {
+        total += counts[p99];
+        if (total >= count - count / 100) break;
+    }
+
+    // trace
+    tb_trace_i("latency: %lu items, insert: %lld ms, p99: %lu us, max: %lld us, maxn: %lu", count, t, p99, latency_max, tb_hash_map_maxn(hash));
 
+    // exit hash
+    tb_hash_map_exit(hash);
+}
+static tb_void_t tb_hash_map_test_bench(tb_size_t count)
+{
+    // check
+    tb_check_return(count);
+
+    // make the access order
+    tb_size_t* order = tb_nalloc_type(count, tb_size_t);
+    if (order)
+    {
+        // init order
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) order[i] = i;
+
+        // done
+        tb_hash_map_test_i2i_bench(order, count);
+        tb_hash_map_test_s2i_bench(order, count);
+        tb_hash_map_test_latency_bench(count);
+
+        // exit order
+        tb_free(order);
+    }
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -606,5 +753,9 @@ tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
     tb_hash_map_test_walk_perf();
 #endif
 
+#if 1
+    tb_hash_map_test_bench(argv[1]? tb_atoi(argv[1]) : 1000000);
+#endif
+
     return 0;
 }
@@ -0,0 +1,138 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the heap entry demo type
+typedef struct __tb_demo_heap_entry_t
+{
+    // the heap entry
+    tb_heap_entry_t         entry;
+
+    // the key
+    tb_size_t               key;
+
+}tb_demo_heap_entry_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_long_t tb_demo_heap_entry_comp(tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_assert(litem && ritem);
+
+    // comp by key
+    tb_size_t lkey = ((tb_demo_heap_entry_t const*)litem)->key;
+    tb_size_t rkey = ((tb_demo_heap_entry_t const*)ritem)->key;
+    return lkey > rkey? 1 : (lkey < rkey? -1 : 0);
+}
+static tb_void_t tb_demo_heap_entry_test_func(tb_size_t count)
+{
+    // init entries
+    tb_demo_heap_entry_t* entries = tb_nalloc0_type(count, tb_demo_heap_entry_t);
+    tb_assert_and_check_return(entries);
+
+    // init heap
+    tb_heap_entry_head_t heap;
+    tb_heap_entry_init(&heap, tb_demo_heap_entry_t, entry, 0, tb_demo_heap_entry_comp);
+
+    // put the random keys
+    tb_size_t i = 0;
+    tb_random_reset(tb_false);
+    for (i = 0; i < count; i++)
+    {
+        entries[i].key = tb_random_range(0, count);
+        tb_heap_entry_put(&heap, &entries[i].entry);
+    }
+
+    // remove the half entries and update the others
+    tb_size_t removed = 0;
+    for (i = 0; i < count; i += 2)
+    {
+        tb_heap_entry_remove(&heap, &entries[i].entry);
+        if (!tb_heap_entry_is_in(&entries[i].entry)) removed++;
+    }
+    for (i = 1; i < count; i += 2)
+    {
+        entries[i].key = tb_random_range(0, count);
+        tb_heap_entry_update(&heap, &entries[i].entry);
+    }
+    tb_assert(removed == (count + 1) >> 1 && tb_heap_entry_size(&heap) == count - removed);
+
+    // pop all entries in order
+    tb_size_t           prev = 0;
+    tb_size_t           popped = 0;
+    tb_heap_entry_ref_t top = tb_null;
+    while ((top = tb_heap_entry_top(&heap)))
+    {
+        tb_demo_heap_entry_t* item = (tb_demo_heap_entry_t*)tb_heap_entry(&heap, top);
+        if (item->key >= prev) popped++;
+        prev = item->key;
+        tb_heap_entry_pop(&heap);
+    }
+    tb_assert(popped == count - removed);
+
+    // trace
+    tb_trace_i("func: count: %lu, removed: %lu, popped: %lu", count, removed, popped);
+
+    // exit heap
+    tb_heap_entry_exit(&heap);
+
+    // exit entries
+    tb_free(entries);
+}
+static tb_void_t tb_demo_heap_entry_test_perf(tb_size_t count)
+{
+    // init entries
+    tb_demo_heap_entry_t* entries = tb_nalloc0_type(count, tb_demo_heap_entry_t);
+    tb_assert_and_check_return(entries);
+
+    // init heap
+    tb_heap_entry_head_t heap;
+    tb_heap_entry_init(&heap, tb_demo_heap_entry_t, entry, 0, tb_demo_heap_entry_comp);
+
+    // put the random keys
+    tb_size_t i = 0;
+    tb_hong_t time = tb_mclock();
+    tb_random_reset(tb_false);
+    for (i = 0; i < count; i++)
+    {
+        entries[i].key = tb_random_range(0, count);
+        tb_heap_entry_put(&heap, &entries[i].entry);
+    }
+
+    // reschedule all entries like the timeouts
+    for (i = 0; i < count; i++)
+    {
+        entries[i].key += tb_random_range(0, count);
+        tb_heap_entry_update(&heap, &entries[i].entry);
+    }
+
+    // cancel all entries
+    for (i = 0; i < count; i++) tb_heap_entry_remove(&heap, &entries[i].entry);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("perf: put + update + remove: %lu items, %lld ms, left: %lu", count, time, tb_heap_entry_size(&heap));
+
+    // exit heap
+    tb_heap_entry_exit(&heap);
+
+    // exit entries
+    tb_free(entries);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_heap_entry_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_demo_heap_entry_test_func(10000);
+    tb_demo_heap_entry_test_perf(argv[1]? tb_atoi(argv[1]) : 1000000);
+    return 0;
+}
@@ -0,0 +1,304 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maxn for each side
+#define TB_DEMO_THREAD_MAXN         (8)
+
+// the batch size
+#define TB_DEMO_BATCH_SIZE          (32)
+
+// the queue maxn
+#define TB_DEMO_QUEUE_MAXN          (1024)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo mode type
+typedef enum __tb_demo_mode_e
+{
+    TB_DEMO_MODE_TRY        = 0     //!< try_put and try_get with yielding
+,   TB_DEMO_MODE_BATCH      = 1     //!< put_list and get_list with yielding
+,   TB_DEMO_MODE_BLOCKING   = 2     //!< put and get with waiting
+,   TB_DEMO_MODE_LOCKED     = 3     //!< circle queue with the mutex and semaphores for comparing
+
+}tb_demo_mode_e;
+
+// the demo worker type
+typedef struct __tb_demo_worker_t
+{
+    // the worker index
+    tb_size_t               index;
+
+    // the item count
+    tb_size_t               count;
+
+    // the item sum
+    tb_hize_t               sum;
+
+}tb_demo_worker_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the mode
+static tb_size_t                g_mode = TB_DEMO_MODE_TRY;
+
+// the mpmc queue
+static tb_mpmc_queue_ref_t      g_queue = tb_null;
+
+// the circle queue, the mutex and semaphores for comparing
+static tb_circle_queue_ref_t    g_circle_queue = tb_null;
+static tb_mutex_ref_t           g_mutex = tb_null;
+static tb_semaphore_ref_t       g_semaphore_put = tb_null;
+static tb_semaphore_ref_t       g_semaphore_get = tb_null;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_locked_put(tb_cpointer_t data)
+{
+    tb_semaphore_wait(g_semaphore_put, -1);
+    tb_mutex_enter(g_mutex);
+    tb_circle_queue_put(g_circle_queue, data);
+    tb_mutex_leave(g_mutex);
+    tb_semaphore_post(g_semaphore_get, 1);
+}
+static tb_pointer_t tb_demo_locked_get()
+{
+    tb_semaphore_wait(g_semaphore_get, -1);
+    tb_mutex_enter(g_mutex);
+    tb_pointer_t data = tb_circle_queue_get(g_circle_queue);
+    tb_circle_queue_pop(g_circle_queue);
+    tb_mutex_leave(g_mutex);
+    tb_semaphore_post(g_semaphore_put, 1);
+    return data;
+}
+static tb_int_t tb_demo_producer_func(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_worker_t* worker = (tb_demo_worker_t*)priv;
+    tb_assert_and_check_return_val(worker, -1);
+
+    // put the items: 1, 2, 3, ...
+    tb_size_t i = 1;
+    tb_size_t n = worker->count;
+    switch (g_mode)
+    {
+    case TB_DEMO_MODE_TRY:
+        for (; i <= n; i++) 
+        {
+            while (!tb_mpmc_queue_try_put(g_queue, (tb_cpointer_t)i)) tb_sched_yield();
+        }
+        break;
+    case TB_DEMO_MODE_BATCH:
+        {
+            tb_cpointer_t list[TB_DEMO_BATCH_SIZE];
+            while (i <= n)
+            {
+                tb_size_t k = 0;
+                tb_size_t m = tb_min(n - i + 1, TB_DEMO_BATCH_SIZE);
+                for (k = 0; k < m; k++) list[k] = (tb_cpointer_t)(i + k);
+                for (k = 0; k < m; ) 
+                {
+                    tb_size_t real = tb_mpmc_queue_put_list(g_queue, list + k, m - k);
+                    if (!real) tb_sched_yield();
+                    k += real;
+                }
+                i += m;
+            }
+        }
+        break;
+    case TB_DEMO_MODE_BLOCKING:
+        for (; i <= n; i++) tb_mpmc_queue_put(g_queue, (tb_cpointer_t)i, -1);
+        break;
+    case TB_DEMO_MODE_LOCKED:
+        for (; i <= n; i++) tb_demo_locked_put((tb_cpointer_t)i);
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+static tb_int_t tb_demo_consumer_func(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_worker_t* worker = (tb_demo_worker_t*)priv;
+    tb_assert_and_check_return_val(worker, -1);
+
+    // get the items
+    tb_size_t    i = 0;
+    tb_size_t    n = worker->count;
+    tb_hize_t    sum = 0;
+    tb_pointer_t data = tb_null;
+    switch (g_mode)
+    {
+    case TB_DEMO_MODE_TRY:
+        for (i = 0; i < n; i++) 
+        {
+            while (!tb_mpmc_queue_try_get(g_queue, &data)) tb_sched_yield();
+            sum += (tb_size_t)data;
+        }
+        break;
+    case TB_DEMO_MODE_BATCH:
+        {
+            tb_pointer_t list[TB_DEMO_BATCH_SIZE];
+            while (i < n)
+            {
+                tb_size_t k = 0;
+                tb_size_t real = tb_mpmc_queue_get_list(g_queue, list, tb_min(n - i, TB_DEMO_BATCH_SIZE));
+                if (!real) tb_sched_yield();
+                for (k = 0; k < real; k++) sum += (tb_size_t)list[k];
+                i += real;
+            }
+        }
+        break;
+    case TB_DEMO_MODE_BLOCKING:
+        for (i = 0; i < n; i++) 
+        {
+            if (tb_mpmc_queue_get(g_queue, &data, -1) > 0) sum += (tb_size_t)data;
+        }
+        break;
+    case TB_DEMO_MODE_LOCKED:
+        for (i = 0; i < n; i++) sum += (tb_size_t)tb_demo_locked_get();
+        break;
+    default:
+        break;
+    }
+    worker->sum = sum;
+    return 0;
+}
+static tb_void_t tb_demo_bench(tb_size_t mode, tb_size_t thread_count, tb_size_t count)
+{
+    // init queue
+    g_mode = mode;
+    if (mode == TB_DEMO_MODE_LOCKED)
+    {
+        g_circle_queue  = tb_circle_queue_init(TB_DEMO_QUEUE_MAXN, tb_element_size());
+        g_mutex         = tb_mutex_init();
+        g_semaphore_put = tb_semaphore_init(TB_DEMO_QUEUE_MAXN);
+        g_semaphore_get = tb_semaphore_init(0);
+        tb_assert_and_check_return(g_circle_queue && g_mutex && g_semaphore_put && g_semaphore_get);
+    }
+    else
+    {
+        g_queue = tb_mpmc_queue_init(TB_DEMO_QUEUE_MAXN, mode == TB_DEMO_MODE_BLOCKING);
+        tb_assert_and_check_return(g_queue);
+    }
+
+    // run the producers and consumers
+    tb_size_t           i = 0;
+    tb_thread_ref_t     producers[TB_DEMO_THREAD_MAXN] = {0};
+    tb_thread_ref_t     consumers[TB_DEMO_THREAD_MAXN] = {0};
+    tb_demo_worker_t    workers_put[TB_DEMO_THREAD_MAXN] = {{0}};
+    tb_demo_worker_t    workers_get[TB_DEMO_THREAD_MAXN] = {{0}};
+    tb_hong_t           time = tb_mclock();
+    for (i = 0; i < thread_count; i++)
+    {
+        workers_put[i].index = i;
+        workers_put[i].count = count / thread_count;
+        workers_get[i].index = i;
+        workers_get[i].count = count / thread_count;
+        consumers[i] = tb_thread_init(tb_null, tb_demo_consumer_func, &workers_get[i], 0);
+        producers[i] = tb_thread_init(tb_null, tb_demo_producer_func, &workers_put[i], 0);
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        if (producers[i])
+        {
+            tb_thread_wait(producers[i], -1, tb_null);
+            tb_thread_exit(producers[i]);
+        }
+        if (consumers[i])
+        {
+            tb_thread_wait(consumers[i], -1, tb_null);
+            tb_thread_exit(consumers[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // check the sum, every producer puts 1 + 2 + ... + n
+    tb_size_t n = count / thread_count;
+    tb_hize_t sum = 0;
+    for (i = 0; i < thread_count; i++) sum += workers_get[i].sum;
+    tb_bool_t ok = (sum == (tb_hize_t)n * (n + 1) / 2 * thread_count);
+
+    // trace
+    static tb_char_t const* s_modes[] = {"try", "batch", "blocking", "locked"};
+    tb_trace_i("%-8s: producers: %lu, consumers: %lu, count: %lu, sum: %s, time: %lld ms, %lld items/ms", s_modes[mode], thread_count, thread_count, n * thread_count, ok? "ok" : "failed", time, (tb_hong_t)(n * thread_count) / tb_max(time, 1));
+
+    // exit queue
+    if (g_queue) tb_mpmc_queue_exit(g_queue);
+    if (g_circle_queue) tb_circle_queue_exit(g_circle_queue);
+    if (g_mutex) tb_mutex_exit(g_mutex);
+    if (g_semaphore_put) tb_semaphore_exit(g_semaphore_put);
+    if (g_semaphore_get) tb_semaphore_exit(g_semaphore_get);
+    g_queue         = tb_null;
+    g_circle_queue  = tb_null;
+    g_mutex         = tb_null;
+    g_semaphore_put = tb_null;
+    g_semaphore_get = tb_null;
+}
+static tb_void_t tb_demo_test_list()
+{
+    // init queue
+    tb_mpmc_queue_ref_t queue = tb_mpmc_queue_init(8, tb_false);
+    tb_assert_and_check_return(queue);
+
+    // put 10 items to the queue with 8 cells
+    tb_size_t       i = 0;
+    tb_cpointer_t   list_put[10];
+    for (i = 0; i < 10; i++) list_put[i] = (tb_cpointer_t)(i + 1);
+    tb_size_t put = tb_mpmc_queue_put_list(queue, list_put, 10);
+    tb_bool_t full = !tb_mpmc_queue_try_put(queue, (tb_cpointer_t)11);
+
+    // get 5 items and put 5 items again for wrapping it
+    tb_pointer_t    list_get[16];
+    tb_size_t get = tb_mpmc_queue_get_list(queue, list_get, 5);
+    put += tb_mpmc_queue_put_list(queue, list_put, 5);
+    get += tb_mpmc_queue_get_list(queue, list_get + get, 16 - get);
+    tb_bool_t empty = !tb_mpmc_queue_try_get(queue, &list_get[0]);
+
+    // check the order: 1 .. 8, 1 .. 5
+    tb_size_t error = 0;
+    for (i = 0; i < get; i++)
+    {
+        if ((tb_size_t)list_get[i] != (i < 8? i + 1 : i - 7)) error++;
+    }
+
+    // trace
+    tb_trace_i("list: put: %lu, get: %lu, full: %s, empty: %s, error: %lu, maxn: %lu", put, get, full? "ok" : "no", empty? "ok" : "no", error, tb_mpmc_queue_maxn(queue));
+
+    // exit queue
+    tb_mpmc_queue_exit(queue);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_mpmc_queue_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the item count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 2000000;
+
+    // test list
+    tb_demo_test_list();
+
+    // bench it for 1, 2, 4 and 8 producers and consumers
+    tb_size_t mode = 0;
+    tb_size_t thread_count = 1;
+    for (thread_count = 1; thread_count <= TB_DEMO_THREAD_MAXN; thread_count <<= 1)
+    {
+        tb_trace_i("===========================================================");
+        for (mode = TB_DEMO_MODE_TRY; mode <= TB_DEMO_MODE_LOCKED; mode++)
+            tb_demo_bench(mode, thread_count, count);
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the batch size
+#define TB_DEMO_BATCH_SIZE          (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo context type
+typedef struct __tb_demo_context_t
+{
+    // the queue
+    tb_spsc_queue_ref_t         queue;
+
+    // the item count
+    tb_size_t                   count;
+
+    // use the batch put and get?
+    tb_bool_t                   batch;
+
+    // use the blocking put and get?
+    tb_bool_t                   blocking;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_int_t tb_demo_producer_func(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+    tb_assert_and_check_return_val(context, -1);
+
+    // put the items: 1, 2, 3, ...
+    tb_size_t i = 1;
+    tb_size_t n = context->count;
+    if (context->batch)
+    {
+        tb_cpointer_t list[TB_DEMO_BATCH_SIZE];
+        while (i <= n)
+        {
+            tb_size_t k = 0;
+            tb_size_t m = tb_min(n - i + 1, TB_DEMO_BATCH_SIZE);
+            for (k = 0; k < m; k++) list[k] = (tb_cpointer_t)(i + k);
+            for (k = 0; k < m; ) 
+            {
+                tb_size_t real = tb_spsc_queue_put_list(context->queue, list + k, m - k);
+                if (!real) tb_sched_yield();
+                k += real;
+            }
+            i += m;
+        }
+    }
+    else if (context->blocking)
+    {
+        for (; i <= n; i++) 
+        {
+            if (tb_spsc_queue_put(context->queue, (tb_cpointer_t)i, -1) <= 0) break;
+        }
+    }
+    else
+    {
+        for (; i <= n; i++) 
+        {
+            while (!tb_spsc_queue_try_put(context->queue, (tb_cpointer_t)i)) tb_sched_yield();
+        }
+    }
+    return 0;
+}
+static tb_void_t tb_demo_test(tb_size_t count, tb_bool_t batch, tb_bool_t blocking)
+{
+    // init context
+    tb_demo_context_t context;
+    context.queue       = tb_spsc_queue_init(1024, blocking);
+    context.count       = count;
+    context.batch       = batch;
+    context.blocking    = blocking;
+    tb_assert_and_check_return(context.queue);
+
+    // init producer
+    tb_hong_t       time = tb_mclock();
+    tb_thread_ref_t producer = tb_thread_init(tb_null, tb_demo_producer_func, &context, 0);
+    if (producer)
+    {
+        // get the items and check the order
+        tb_size_t   i = 0;
+        tb_size_t   next = 1;
+        tb_size_t   error = 0;
+        tb_pointer_t list[TB_DEMO_BATCH_SIZE];
+        while (next <= count)
+        {
+            tb_size_t real = 0;
+            if (batch) real = tb_spsc_queue_get_list(context.queue, list, TB_DEMO_BATCH_SIZE);
+            else if (blocking) real = tb_spsc_queue_get(context.queue, &list[0], -1) > 0? 1 : 0;
+            else real = tb_spsc_queue_try_get(context.queue, &list[0])? 1 : 0;
+            if (!real) 
+            {
+                if (blocking) break;
+                tb_sched_yield();
+                continue;
+            }
+            for (i = 0; i < real; i++, next++)
+            {
+                if ((tb_size_t)list[i] != next) error++;
+            }
+        }
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("%s%s: count: %lu, error: %lu, left: %lu, time: %lld ms", batch? "batch" : "single", blocking? ", blocking" : "", next - 1, error, tb_spsc_queue_size(context.queue), time);
+
+        // exit producer
+        tb_thread_wait(producer, -1, tb_null);
+        tb_thread_exit(producer);
+    }
+
+    // exit queue
+    tb_spsc_queue_exit(context.queue);
+}
+static tb_void_t tb_demo_test_timeout()
+{
+    // init queue
+    tb_spsc_queue_ref_t queue = tb_spsc_queue_init(2, tb_true);
+    tb_assert_and_check_return(queue);
+
+    // get it from the empty queue
+    tb_pointer_t data = tb_null;
+    tb_hong_t    time = tb_mclock();
+    tb_long_t    ok_get = tb_spsc_queue_get(queue, &data, 100);
+    tb_hong_t    time_get = tb_mclock() - time;
+
+    // put it to the full queue
+    tb_spsc_queue_try_put(queue, (tb_cpointer_t)1);
+    tb_spsc_queue_try_put(queue, (tb_cpointer_t)2);
+    time = tb_mclock();
+    tb_long_t    ok_put = tb_spsc_queue_put(queue, (tb_cpointer_t)3, 100);
+    tb_hong_t    time_put = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("timeout: get: %ld, %lld ms, put: %ld, %lld ms, size: %lu, maxn: %lu", ok_get, time_get, ok_put, time_put, tb_spsc_queue_size(queue), tb_spsc_queue_maxn(queue));
+
+    // exit queue
+    tb_spsc_queue_exit(queue);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_spsc_queue_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the item count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 10000000;
+
+    // test it
+    tb_demo_test(count, tb_false, tb_false);
+    tb_demo_test(count, tb_true, tb_false);
+    tb_demo_test(count, tb_false, tb_true);
+    tb_demo_test_timeout();
+    return 0;
+}
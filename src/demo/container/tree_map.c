@@ -0,0 +1,203 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_bool_t tb_tree_map_test_pred_func(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    // check
+    tb_assert(item);
+
+    // remove the odd names
+    return ((tb_size_t)((tb_tree_map_item_ref_t)item)->name) & 1;
+}
+static tb_void_t tb_tree_map_test_func()
+{
+    // init tree map
+    tb_tree_map_ref_t tree_map = tb_tree_map_init(tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(tree_map);
+
+    // insert the names: 0, 2, 4, ..., 19998 and 1, 3, 5, ..., 19999 in the random order
+    tb_size_t i = 0;
+    tb_size_t n = 10000;
+    for (i = 0; i < n; i++)
+    {
+        tb_size_t name = (i * 7919) % n;
+        tb_tree_map_insert(tree_map, (tb_pointer_t)(name << 1), (tb_pointer_t)name);
+        tb_tree_map_insert(tree_map, (tb_pointer_t)((name << 1) + 1), (tb_pointer_t)name);
+    }
+    tb_assert(tb_tree_map_size(tree_map) == (n << 1));
+
+    // check the order
+    tb_size_t count = 0;
+    tb_for_all_if (tb_tree_map_item_ref_t, item, tree_map, item)
+    {
+        if ((tb_size_t)item->name == count && (tb_size_t)item->data == (count >> 1)) count++;
+    }
+    tb_assert(count == (n << 1));
+
+    // remove the odd names
+    tb_remove_if(tree_map, tb_tree_map_test_pred_func, tb_null);
+    tb_assert(tb_tree_map_size(tree_map) == n);
+    tb_assert(!tb_tree_map_find(tree_map, (tb_pointer_t)1001));
+
+    // walk the range: [1001, 2001)
+    count = 0;
+    tb_size_t head = tb_tree_map_lower_bound(tree_map, (tb_pointer_t)1001);
+    tb_size_t tail = tb_tree_map_lower_bound(tree_map, (tb_pointer_t)2001);
+    tb_for (tb_tree_map_item_ref_t, fitem, head, tail, tree_map)
+    {
+        if ((tb_size_t)fitem->name == 1002 + (count << 1)) count++;
+    }
+    tb_assert(count == 500);
+
+    // walk the range: (2000, 1000] in the reverse order
+    count = 0;
+    head = tb_tree_map_upper_bound(tree_map, (tb_pointer_t)1000);
+    tail = tb_tree_map_upper_bound(tree_map, (tb_pointer_t)2000);
+    tb_rfor (tb_tree_map_item_ref_t, ritem, head, tail, tree_map)
+    {
+        if ((tb_size_t)ritem->name == 2000 - (count << 1)) count++;
+    }
+    tb_assert(count == 500);
+
+    // remove all
+    for (i = 0; i < n; i++) tb_tree_map_remove(tree_map, (tb_pointer_t)(i << 1));
+    tb_assert(!tb_tree_map_size(tree_map) && tb_iterator_head(tree_map) == tb_iterator_tail(tree_map));
+
+    // trace
+    tb_trace_i("func: long: ok");
+
+    // exit tree map
+    tb_tree_map_exit(tree_map);
+}
+static tb_void_t tb_tree_map_test_str()
+{
+    // init tree map
+    tb_tree_map_ref_t tree_map = tb_tree_map_init(tb_element_str(tb_true), tb_element_str(tb_true));
+    tb_assert_and_check_return(tree_map);
+
+    // insert
+    tb_tree_map_insert(tree_map, "orange", "4");
+    tb_tree_map_insert(tree_map, "apple", "1");
+    tb_tree_map_insert(tree_map, "pear", "5");
+    tb_tree_map_insert(tree_map, "banana", "2");
+    tb_tree_map_insert(tree_map, "cherry", "3");
+    tb_tree_map_insert(tree_map, "apple", "0");
+
+    // get
+    tb_assert(!tb_strcmp((tb_char_t const*)tb_tree_map_get(tree_map, "apple"), "0"));
+    tb_assert(!tb_tree_map_get(tree_map, "grape"));
+
+    // walk the names in [b, p)
+    tb_size_t head = tb_tree_map_lower_bound(tree_map, "b");
+    tb_size_t tail = tb_tree_map_lower_bound(tree_map, "p");
+    tb_for (tb_tree_map_item_ref_t, item, head, tail, tree_map)
+    {
+        tb_trace_i("func: str: %s => %s", item->name, item->data);
+    }
+
+#ifdef __tb_debug__
+    // dump
+    tb_tree_map_dump(tree_map);
+#endif
+
+    // exit tree map
+    tb_tree_map_exit(tree_map);
+}
+static tb_void_t tb_tree_set_test()
+{
+    // init tree set
+    tb_tree_set_ref_t tree_set = tb_tree_set_init(tb_element_long());
+    tb_assert_and_check_return(tree_set);
+
+    // insert: -500, -499, ..., 499
+    tb_long_t i = 0;
+    for (i = 0; i < 1000; i++) tb_tree_set_insert(tree_set, (tb_pointer_t)(500 - i - 1));
+    tb_assert(tb_tree_set_size(tree_set) == 1000);
+    tb_assert(tb_tree_set_get(tree_set, (tb_pointer_t)-500) && !tb_tree_set_get(tree_set, (tb_pointer_t)500));
+
+    // check the order
+    tb_long_t prev = -501;
+    tb_for_all (tb_long_t, data, tree_set)
+    {
+        if (data == prev + 1) prev = data;
+    }
+    tb_assert(prev == 499);
+
+    // trace
+    tb_trace_i("func: set: ok");
+
+    // exit tree set
+    tb_tree_set_exit(tree_set);
+}
+static tb_void_t tb_tree_map_test_perf(tb_size_t count)
+{
+    // init tree map and hash map
+    tb_tree_map_ref_t tree_map = tb_tree_map_init(tb_element_size(), tb_element_size());
+    tb_hash_map_ref_t hash_map = tb_hash_map_init(0, tb_element_size(), tb_element_size());
+    tb_size_t*        names = tb_nalloc_type(count, tb_size_t);
+    if (tree_map && hash_map && names)
+    {
+        // make the random names
+        tb_size_t i = 0;
+        tb_random_reset(tb_false);
+        for (i = 0; i < count; i++) names[i] = tb_random_value();
+
+        // insert
+        tb_hong_t tree_insert = tb_mclock();
+        for (i = 0; i < count; i++) tb_tree_map_insert(tree_map, (tb_pointer_t)names[i], (tb_pointer_t)i);
+        tree_insert = tb_mclock() - tree_insert;
+
+        tb_hong_t hash_insert = tb_mclock();
+        for (i = 0; i < count; i++) tb_hash_map_insert(hash_map, (tb_pointer_t)names[i], (tb_pointer_t)i);
+        hash_insert = tb_mclock() - hash_insert;
+
+        // get
+        tb_size_t found = 0;
+        tb_hong_t tree_get = tb_mclock();
+        for (i = 0; i < count; i++) if (tb_tree_map_find(tree_map, (tb_pointer_t)names[i])) found++;
+        tree_get = tb_mclock() - tree_get;
+
+        tb_hong_t hash_get = tb_mclock();
+        for (i = 0; i < count; i++) if (tb_hash_map_find(hash_map, (tb_pointer_t)names[i])) found++;
+        hash_get = tb_mclock() - hash_get;
+
+        // scan the ordered items
+        tb_size_t sum = 0;
+        tb_hong_t tree_scan = tb_mclock();
+        tb_for_all_if (tb_tree_map_item_ref_t, item, tree_map, item) sum += (tb_size_t)item->data;
+        tree_scan = tb_mclock() - tree_scan;
+
+        // trace
+        tb_trace_i("perf: count: %lu, found: %lu, sum: %lu", count, found, sum);
+        tb_trace_i("perf: tree_map: insert: %lld ms, get: %lld ms, scan: %lld ms", tree_insert, tree_get, tree_scan);
+        tb_trace_i("perf: hash_map: insert: %lld ms, get: %lld ms", hash_insert, hash_get);
+    }
+
+    // exit
+    if (tree_map) tb_tree_map_exit(tree_map);
+    if (hash_map) tb_hash_map_exit(hash_map);
+    if (names) tb_free(names);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_tree_map_main(tb_int_t argc, tb_char_t** argv)
+{
+#if 1
+    tb_tree_map_test_func();
+    tb_tree_map_test_str();
+    tb_tree_set_test();
+#endif
+
+#if 1
+    tb_tree_map_test_perf(argv[1]? tb_atoi(argv[1]) : 1000000);
+#endif
+
+    return 0;
+}
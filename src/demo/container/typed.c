@@ -0,0 +1,171 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// define tb_vector_u32_t
+TB_VECTOR_DEFINE_INTEGER(u32, tb_uint32_t)
+
+// define tb_heap_u32_t
+TB_HEAP_DEFINE(u32, tb_uint32_t, tb_typed_comp)
+
+// define tb_hash_map_u32_t
+TB_HASH_MAP_DEFINE(u32, tb_uint32_t, tb_size_t, tb_typed_hash_uint32, tb_typed_equal)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_typed_test_vector(tb_uint32_t const* values, tb_size_t count)
+{
+    // init vector
+    tb_vector_u32_t vector;
+    tb_vector_u32_init(&vector, 0);
+    tb_vector_ref_t generic = tb_vector_init(0, tb_element_uint32());
+    tb_assert_and_check_return(generic);
+
+    // insert and sort the typed vector
+    tb_size_t i = 0;
+    tb_hong_t typed_time = tb_mclock();
+    for (i = 0; i < count; i++) tb_vector_u32_insert_tail(&vector, values[i]);
+    tb_vector_u32_sort(&vector);
+    typed_time = tb_mclock() - typed_time;
+
+    // insert and sort the generic vector
+    tb_hong_t generic_time = tb_mclock();
+    for (i = 0; i < count; i++) tb_vector_insert_tail(generic, tb_u2p(values[i]));
+    tb_sort_all(generic, tb_null);
+    generic_time = tb_mclock() - generic_time;
+
+    // check them
+    tb_size_t failed = 0;
+    tb_uint32_t const* data = (tb_uint32_t const*)tb_vector_data(generic);
+    for (i = 0; i < count; i++)
+    {
+        if (tb_vector_u32_at(&vector, i) != data[i]) failed++;
+        if (i && tb_vector_u32_at(&vector, i - 1) > tb_vector_u32_at(&vector, i)) failed++;
+    }
+    for (i = 0; i < count; i += 97)
+    {
+        if (tb_vector_u32_bfind(&vector, values[i]) == tb_vector_u32_size(&vector)) failed++;
+    }
+    tb_assert(!failed);
+
+    // trace
+    tb_trace_i("vector: insert + sort: %lu items, typed: %lld ms, generic: %lld ms, failed: %lu", count, typed_time, generic_time, failed);
+
+    // exit vector
+    tb_vector_u32_exit(&vector);
+    tb_vector_exit(generic);
+}
+static tb_void_t tb_typed_test_heap(tb_uint32_t const* values, tb_size_t count)
+{
+    // init heap
+    tb_heap_u32_t heap;
+    tb_heap_u32_init(&heap, 0);
+    tb_heap_ref_t generic = tb_heap_init(0, tb_element_uint32());
+    tb_assert_and_check_return(generic);
+
+    // put and pop the typed heap
+    tb_size_t   i = 0;
+    tb_size_t   failed = 0;
+    tb_uint32_t prev = 0;
+    tb_hong_t   typed_time = tb_mclock();
+    for (i = 0; i < count; i++) tb_heap_u32_put(&heap, values[i]);
+    while (tb_heap_u32_size(&heap))
+    {
+        tb_uint32_t top = tb_heap_u32_top(&heap);
+        if (top < prev) failed++;
+        prev = top;
+        tb_heap_u32_pop(&heap);
+    }
+    typed_time = tb_mclock() - typed_time;
+
+    // put and pop the generic heap
+    prev = 0;
+    tb_hong_t generic_time = tb_mclock();
+    for (i = 0; i < count; i++) tb_heap_put(generic, tb_u2p(values[i]));
+    while (tb_heap_size(generic))
+    {
+        tb_uint32_t top = tb_p2u32(tb_heap_top(generic));
+        if (top < prev) failed++;
+        prev = top;
+        tb_heap_pop(generic);
+    }
+    generic_time = tb_mclock() - generic_time;
+    tb_assert(!failed);
+
+    // trace
+    tb_trace_i("heap: put + pop: %lu items, typed: %lld ms, generic: %lld ms, failed: %lu", count, typed_time, generic_time, failed);
+
+    // exit heap
+    tb_heap_u32_exit(&heap);
+    tb_heap_exit(generic);
+}
+static tb_void_t tb_typed_test_hash_map(tb_uint32_t const* values, tb_size_t count)
+{
+    // init hash map
+    tb_hash_map_u32_t hash_map;
+    tb_hash_map_u32_init(&hash_map, 0);
+    tb_hash_map_ref_t generic = tb_hash_map_init(0, tb_element_uint32(), tb_element_size());
+    tb_assert_and_check_return(generic);
+
+    // insert and get the typed hash map
+    tb_size_t   i = 0;
+    tb_size_t   found = 0;
+    tb_hong_t   typed_time = tb_mclock();
+    for (i = 0; i < count; i++) tb_hash_map_u32_insert(&hash_map, values[i], i);
+    for (i = 0; i < count; i++) if (tb_hash_map_u32_get(&hash_map, values[i])) found++;
+    for (i = 0; i < count; i += 2) tb_hash_map_u32_remove(&hash_map, values[i]);
+    typed_time = tb_mclock() - typed_time;
+
+    // insert and get the generic hash map
+    tb_hong_t generic_time = tb_mclock();
+    for (i = 0; i < count; i++) tb_hash_map_insert(generic, tb_u2p(values[i]), tb_u2p(i));
+    for (i = 0; i < count; i++) if (tb_hash_map_find(generic, tb_u2p(values[i]))) found++;
+    for (i = 0; i < count; i += 2) tb_hash_map_remove(generic, tb_u2p(values[i]));
+    generic_time = tb_mclock() - generic_time;
+
+    // check them
+    tb_size_t failed = 0;
+    tb_size_t slot = 0;
+    if (tb_hash_map_u32_size(&hash_map) != tb_hash_map_size(generic)) failed++;
+    for (slot = tb_hash_map_u32_head(&hash_map); slot != tb_hash_map_u32_tail(&hash_map); slot = tb_hash_map_u32_next(&hash_map, slot))
+    {
+        if (tb_p2u32(tb_hash_map_get(generic, tb_u2p(hash_map.names[slot]))) != hash_map.datas[slot]) failed++;
+    }
+    tb_assert(!failed);
+
+    // trace
+    tb_trace_i("hash_map: insert + get + remove: %lu items, typed: %lld ms, generic: %lld ms, found: %lu, failed: %lu", count, typed_time, generic_time, found, failed);
+
+    // exit hash map
+    tb_hash_map_u32_exit(&hash_map);
+    tb_hash_map_exit(generic);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_typed_main(tb_int_t argc, tb_char_t** argv)
+{
+    // make the random values
+    tb_size_t       i = 0;
+    tb_size_t       count = argv[1]? tb_atoi(argv[1]) : 1000000;
+    tb_uint32_t*    values = tb_nalloc_type(count, tb_uint32_t);
+    tb_assert_and_check_return_val(values, 0);
+    tb_random_reset(tb_false);
+    for (i = 0; i < count; i++) values[i] = (tb_uint32_t)tb_random_value();
+
+    // test them
+    tb_typed_test_vector(values, count);
+    tb_typed_test_heap(values, count);
+    tb_typed_test_hash_map(values, count);
+
+    // exit values
+    tb_free(values);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the tasks count
+#define TB_DEMO_TASK_COUNT      (64)
+
+// the slices count of each task
+#define TB_DEMO_TASK_SLICES     (100)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the migrated count
+static tb_atomic_t  g_migrated = 0;
+
+// the checksum
+static tb_atomic_t  g_checksum = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_void_t tb_demo_coroutine_task(tb_cpointer_t priv)
+{
+    // the work size
+    tb_size_t work = (tb_size_t)priv;
+
+    // compute it with many slices and yield the cpu after each slice
+    tb_size_t               i = 0;
+    tb_size_t               j = 0;
+    tb_uint32_t             hash = 0;
+    tb_co_scheduler_ref_t   scheduler = tb_co_scheduler_self();
+    for (i = 0; i < TB_DEMO_TASK_SLICES; i++)
+    {
+        // do some cpu-heavy work
+        for (j = 0; j < work; j++) hash = hash * 31 + (tb_uint32_t)j;
+
+        // yield it, this coroutine may be migrated to the other scheduler
+        tb_coroutine_yield();
+
+        // migrated?
+        if (scheduler != tb_co_scheduler_self())
+        {
+            scheduler = tb_co_scheduler_self();
+            tb_atomic_fetch_and_inc(&g_migrated);
+        }
+    }
+
+    // update the checksum
+    tb_atomic_fetch_and_add(&g_checksum, (tb_long_t)(hash & 0xffff));
+}
+static tb_void_t tb_demo_coroutine_spawner(tb_cpointer_t priv)
+{
+    // the work size
+    tb_size_t work = (tb_size_t)priv;
+
+    // spawn the tasks with the different work sizes on the least-loaded schedulers
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_TASK_COUNT; i++)
+        tb_coroutine_spawn(tb_null, tb_demo_coroutine_task, (tb_cpointer_t)(work * ((i & 3) + 1)), 0);
+
+    // sleep some time, this coroutine will be pinned to the current scheduler
+    tb_msleep(10);
+}
+static tb_hong_t tb_demo_coroutine_group_perf(tb_size_t count, tb_size_t work)
+{
+    // init the scheduler group
+    tb_hong_t                   time = -1;
+    tb_co_scheduler_group_ref_t group = tb_co_scheduler_group_init(count);
+    if (group)
+    {
+        // init the migrated count
+        tb_atomic_set0(&g_migrated);
+        tb_atomic_set0(&g_checksum);
+
+        // start the spawner
+        tb_coroutine_spawn(group, tb_demo_coroutine_spawner, (tb_cpointer_t)work, 0);
+
+        // run the scheduler group
+        time = tb_mclock();
+        tb_co_scheduler_group_loop(group);
+        time = tb_mclock() - time;
+
+        // exit the scheduler group
+        tb_co_scheduler_group_exit(group);
+
+        // trace
+        tb_trace_i("schedulers: %lu, time: %lld ms, migrated: %ld, checksum: %ld", count, time, tb_atomic_get(&g_migrated), tb_atomic_get(&g_checksum));
+    }
+    return time;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_coroutine_group_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the work size of each slice
+    tb_size_t work = argv[1]? tb_atoi(argv[1]) : 100000;
+
+    // run tasks on one scheduler
+    tb_demo_coroutine_group_perf(1, work);
+
+    // the schedulers count, uses the processors count by default
+    tb_size_t count = (argv[1] && argv[2])? tb_atoi(argv[2]) : tb_processor_count();
+
+    // run tasks on all schedulers
+    tb_demo_coroutine_group_perf(count, work);
+    return 0;
+}
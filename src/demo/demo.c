@@ -150,6 +150,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(memory_string_pool)
 ,   TB_DEMO_MAIN_ITEM(memory_large_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_small_allocator)
+,   TB_DEMO_MAIN_ITEM(memory_cache_allocator)
+,   TB_DEMO_MAIN_ITEM(memory_arena_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_default_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_memops)
 ,   TB_DEMO_MAIN_ITEM(memory_buffer)
@@ -202,25 +204,33 @@ static tb_demo_t g_demo[] =
 
     // container
 ,   TB_DEMO_MAIN_ITEM(container_heap)
+,   TB_DEMO_MAIN_ITEM(container_heap_entry)
 ,   TB_DEMO_MAIN_ITEM(container_stack)
 ,   TB_DEMO_MAIN_ITEM(container_vector)
 ,   TB_DEMO_MAIN_ITEM(container_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_concurrent_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_tree_map)
 ,   TB_DEMO_MAIN_ITEM(container_hash_set)
 ,   TB_DEMO_MAIN_ITEM(container_queue)
 ,   TB_DEMO_MAIN_ITEM(container_circle_queue)
+,   TB_DEMO_MAIN_ITEM(container_spsc_queue)
+,   TB_DEMO_MAIN_ITEM(container_mpmc_queue)
 ,   TB_DEMO_MAIN_ITEM(container_list)
 ,   TB_DEMO_MAIN_ITEM(container_list_entry)
 ,   TB_DEMO_MAIN_ITEM(container_single_list)
 ,   TB_DEMO_MAIN_ITEM(container_single_list_entry)
 ,   TB_DEMO_MAIN_ITEM(container_bloom_filter)
+,   TB_DEMO_MAIN_ITEM(container_typed)
 
     // algorithm
 ,   TB_DEMO_MAIN_ITEM(algorithm_find)
 ,   TB_DEMO_MAIN_ITEM(algorithm_sort)
+,   TB_DEMO_MAIN_ITEM(algorithm_parallel)
 
     // coroutine
 #ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
 ,   TB_DEMO_MAIN_ITEM(coroutine_nest)
+,   TB_DEMO_MAIN_ITEM(coroutine_group)
 ,   TB_DEMO_MAIN_ITEM(coroutine_lock)
 ,   TB_DEMO_MAIN_ITEM(coroutine_sleep)
 ,   TB_DEMO_MAIN_ITEM(coroutine_switch)
@@ -139,6 +139,8 @@ TB_DEMO_MAIN_DECL(memory_fixed_pool);
 TB_DEMO_MAIN_DECL(memory_string_pool);
 TB_DEMO_MAIN_DECL(memory_large_allocator);
 TB_DEMO_MAIN_DECL(memory_small_allocator);
+TB_DEMO_MAIN_DECL(memory_cache_allocator);
+TB_DEMO_MAIN_DECL(memory_arena_allocator);
 TB_DEMO_MAIN_DECL(memory_default_allocator);
 TB_DEMO_MAIN_DECL(memory_memops);
 TB_DEMO_MAIN_DECL(memory_buffer);
@@ -187,24 +189,32 @@ TB_DEMO_MAIN_DECL(platform_context);
 
 // container
 TB_DEMO_MAIN_DECL(container_heap);
+TB_DEMO_MAIN_DECL(container_heap_entry);
 TB_DEMO_MAIN_DECL(container_stack);
 TB_DEMO_MAIN_DECL(container_vector);
 TB_DEMO_MAIN_DECL(container_hash_map);
+TB_DEMO_MAIN_DECL(container_concurrent_hash_map);
+TB_DEMO_MAIN_DECL(container_tree_map);
 TB_DEMO_MAIN_DECL(container_hash_set);
 TB_DEMO_MAIN_DECL(container_queue);
 TB_DEMO_MAIN_DECL(container_circle_queue);
+TB_DEMO_MAIN_DECL(container_spsc_queue);
+TB_DEMO_MAIN_DECL(container_mpmc_queue);
 TB_DEMO_MAIN_DECL(container_list);
 TB_DEMO_MAIN_DECL(container_list_entry);
 TB_DEMO_MAIN_DECL(container_single_list);
 TB_DEMO_MAIN_DECL(container_single_list_entry);
 TB_DEMO_MAIN_DECL(container_bloom_filter);
+TB_DEMO_MAIN_DECL(container_typed);
 
 // algorithm
 TB_DEMO_MAIN_DECL(algorithm_find);
 TB_DEMO_MAIN_DECL(algorithm_sort);
+TB_DEMO_MAIN_DECL(algorithm_parallel);
 
 // coroutine
 TB_DEMO_MAIN_DECL(coroutine_nest);
+TB_DEMO_MAIN_DECL(coroutine_group);
 TB_DEMO_MAIN_DECL(coroutine_lock);
 TB_DEMO_MAIN_DECL(coroutine_sleep);
 TB_DEMO_MAIN_DECL(coroutine_spider);
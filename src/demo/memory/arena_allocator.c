@@ -0,0 +1,89 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * demo
+ */
+static tb_hong_t tb_demo_arena_allocator_perf(tb_allocator_ref_t allocator, tb_bool_t clear)
+{
+    // check
+    tb_assert_and_check_return_val(allocator, -1);
+
+    // make data list
+    tb_size_t       maxn = 10000;
+    tb_pointer_t*   list = tb_nalloc0_type(maxn, tb_pointer_t);
+    tb_assert_and_check_return_val(list, -1);
+
+    // done
+    __tb_volatile__ tb_size_t indx = 0;
+    __tb_volatile__ tb_size_t loop = 0;
+    __tb_volatile__ tb_size_t rand = 0xbeaf;
+    __tb_volatile__ tb_hong_t time = tb_mclock();
+    for (loop = 0; loop < 100; loop++)
+    {
+        // make data for one request
+        for (indx = 0; indx < maxn; indx++)
+        {
+            // make rand
+            rand = (rand * 10807 + 1) & 0xffffffff;
+
+            // make data
+            list[indx] = tb_allocator_malloc(allocator, (rand & 127) + 1);
+            tb_assert_and_check_break(list[indx]);
+
+            // re-make data
+            if (!(indx & 15))
+            {
+                list[indx] = tb_allocator_ralloc(allocator, list[indx], (rand & 511) + 1);
+                tb_assert_and_check_break(list[indx]);
+            }
+        }
+
+        // release all data of this request
+        if (clear) tb_allocator_clear(allocator);
+        else
+        {
+            for (indx = 0; indx < maxn; indx++)
+            {
+                if (list[indx]) tb_allocator_free(allocator, list[indx]);
+            }
+        }
+    }
+    time = tb_mclock() - time;
+
+#ifdef __tb_debug__
+    // dump allocator
+    tb_allocator_dump(allocator);
+#endif
+
+    // exit list
+    tb_free(list);
+
+    // ok
+    return time;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_arena_allocator_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test the small allocator
+    tb_allocator_ref_t small_allocator = tb_small_allocator_init(tb_null);
+    if (small_allocator)
+    {
+        tb_trace_i("small: %lld ms", tb_demo_arena_allocator_perf(small_allocator, tb_false));
+        tb_allocator_exit(small_allocator);
+    }
+
+    // test the arena allocator
+    tb_allocator_ref_t arena_allocator = tb_arena_allocator_init(tb_null, 0);
+    if (arena_allocator)
+    {
+        tb_trace_i("arena: %lld ms", tb_demo_arena_allocator_perf(arena_allocator, tb_true));
+        tb_allocator_exit(arena_allocator);
+    }
+    return 0;
+}
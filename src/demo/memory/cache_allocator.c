@@ -0,0 +1,165 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (16)
+
+// the live data count for each thread
+#define TB_DEMO_LIVE_MAXN           (1024)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo worker type
+typedef struct __tb_demo_worker_t
+{
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
+    // the loop count
+    tb_size_t               count;
+
+    // the random seed
+    tb_size_t               seed;
+
+    // the live data, will be freed by the main thread
+    tb_pointer_t            list[TB_DEMO_LIVE_MAXN];
+
+}tb_demo_worker_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_int_t tb_demo_cache_allocator_worker(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_worker_t* worker = (tb_demo_worker_t*)priv;
+    tb_assert_and_check_return_val(worker && worker->allocator, -1);
+
+    // done
+    tb_size_t           indx = 0;
+    tb_size_t           rand = worker->seed;
+    tb_allocator_ref_t  allocator = worker->allocator;
+    for (indx = 0; indx < worker->count; indx++)
+    {
+        // make rand
+        rand = (rand * 10807 + 1) & 0xffffffff;
+
+        // the live data
+        tb_pointer_t* data = &worker->list[rand & (TB_DEMO_LIVE_MAXN - 1)];
+
+        // free or re-make the old data
+        if (*data)
+        {
+            if (!(indx & 7)) *data = tb_allocator_ralloc(allocator, *data, ((rand >> 8) & 3071) + 1);
+            else
+            {
+                tb_allocator_free(allocator, *data);
+                *data = tb_null;
+            }
+        }
+        // make data
+        else *data = tb_allocator_malloc(allocator, ((rand >> 8) & 1023) + 1);
+    }
+
+    // ok
+    return 0;
+}
+static tb_hong_t tb_demo_cache_allocator_perf(tb_allocator_ref_t allocator, tb_size_t thread_count, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(allocator && thread_count <= TB_DEMO_THREAD_MAXN, -1);
+
+    // make workers
+    tb_demo_worker_t* workers = tb_nalloc0_type(thread_count, tb_demo_worker_t);
+    tb_assert_and_check_return_val(workers, -1);
+
+    // start threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < thread_count; i++)
+    {
+        workers[i].allocator    = allocator;
+        workers[i].count        = count / thread_count;
+        workers[i].seed         = 0xbeaf + i;
+        threads[i] = tb_thread_init(tb_null, tb_demo_cache_allocator_worker, &workers[i], 0);
+        tb_assert(threads[i]);
+    }
+
+    // wait threads
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // free the left data from the main thread
+    tb_size_t j = 0;
+    for (i = 0; i < thread_count; i++)
+    {
+        for (j = 0; j < TB_DEMO_LIVE_MAXN; j++)
+        {
+            if (workers[i].list[j]) tb_allocator_free(allocator, workers[i].list[j]);
+        }
+    }
+
+    // exit workers
+    tb_free(workers);
+
+    // ok
+    return time;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_cache_allocator_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the total loop count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 4000000;
+
+    // done
+    tb_size_t thread_count = 1;
+    for (thread_count = 1; thread_count <= TB_DEMO_THREAD_MAXN; thread_count <<= 1)
+    {
+        // test the small allocator with the global lock
+        tb_hong_t small_time = -1;
+        tb_allocator_ref_t small_allocator = tb_small_allocator_init(tb_null);
+        if (small_allocator)
+        {
+            small_time = tb_demo_cache_allocator_perf(small_allocator, thread_count, count);
+#ifdef __tb_debug__
+            tb_allocator_dump(small_allocator);
+#endif
+            tb_allocator_exit(small_allocator);
+        }
+
+        // test the cache allocator with the thread-local magazines
+        tb_hong_t cache_time = -1;
+        tb_allocator_ref_t cache_allocator = tb_cache_allocator_init(tb_null);
+        if (cache_allocator)
+        {
+            cache_time = tb_demo_cache_allocator_perf(cache_allocator, thread_count, count);
+#ifdef __tb_debug__
+            tb_allocator_dump(cache_allocator);
+#endif
+            tb_allocator_exit(cache_allocator);
+        }
+
+        // trace
+        tb_trace_i("threads: %lu, small: %lld ms, cache: %lld ms", thread_count, small_time, cache_time);
+    }
+    return 0;
+}
@@ -213,6 +213,120 @@ tb_void_t tb_demo_default_allocator_perf()
     if (large_allocator) tb_allocator_exit(large_allocator);
     large_allocator = tb_null;
 }
+tb_void_t tb_demo_default_allocator_trim(tb_noarg_t);
+tb_void_t tb_demo_default_allocator_trim()
+{
+    // done
+    tb_byte_t*          data = tb_null;
+    tb_allocator_ref_t  allocator = tb_null;
+    tb_allocator_ref_t  large_allocator = tb_null;
+    do
+    {
+        // make the static data, 64MB
+        tb_size_t size = 64 * 1024 * 1024;
+        data = (tb_byte_t*)tb_native_memory_malloc(size);
+        tb_assert_and_check_break(data);
+
+        // init the static large allocator
+        large_allocator = tb_large_allocator_init(data, size);
+        tb_assert_and_check_break(large_allocator);
+
+        // init allocator
+        allocator = tb_default_allocator_init(large_allocator);
+        tb_assert_and_check_break(allocator);
+
+        // make data list
+        tb_size_t       maxn = 10000;
+        tb_pointer_t*   list = (tb_pointer_t*)tb_allocator_nalloc0(allocator, maxn, sizeof(tb_pointer_t));
+        tb_assert_and_check_break(list);
+
+        // make data and touch all pages
+        tb_size_t indx = 0;
+        tb_size_t rand = 0xbeaf;
+        for (indx = 0; indx < maxn; indx++)
+        {
+            // make rand
+            rand = (rand * 10807 + 1) & 0xffffffff;
+
+            // make data
+            tb_size_t space = (indx & 1)? (rand & 8191) + 1 : (rand & 255) + 1;
+            list[indx] = tb_allocator_malloc(allocator, space);
+            tb_assert_and_check_break(list[indx]);
+            tb_memset(list[indx], 0xcc, space);
+        }
+
+        // free the most of data 
+        for (indx = 0; indx < maxn; indx++)
+        {
+            if (indx & 15)
+            {
+                tb_allocator_free(allocator, list[indx]);
+                list[indx] = tb_null;
+            }
+        }
+
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+        // dump the stats before trimming it
+        tb_object_ref_t stat = tb_oc_allocator_stat(allocator);
+        if (stat)
+        {
+            tb_object_dump(stat, TB_OBJECT_FORMAT_JSON);
+            tb_object_exit(stat);
+        }
+#endif
+
+        // trim it
+        tb_hong_t time = tb_mclock();
+        tb_size_t trim = tb_allocator_trim(allocator);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("trim: %lu bytes, %lld ms", trim, time);
+
+        // trim it again, the purged pages will not be returned again
+        trim = tb_allocator_trim(allocator);
+
+        // trace
+        tb_trace_i("trim: %lu bytes again", trim);
+
+        // the data can be allocated from the purged pages
+        for (indx = 0; indx < maxn; indx++)
+        {
+            if (!list[indx]) 
+            {
+                list[indx] = tb_allocator_malloc0(allocator, 1024);
+                tb_assert_and_check_break(list[indx]);
+            }
+        }
+
+        // exit data
+        for (indx = 0; indx < maxn; indx++)
+        {
+            if (list[indx]) tb_allocator_free(allocator, list[indx]);
+        }
+
+        // exit list
+        tb_allocator_free(allocator, list);
+
+#ifdef __tb_debug__
+        // dump allocator
+        tb_allocator_dump(allocator);
+#endif
+
+    } while (0);
+
+    // exit allocator
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+
+    // exit large allocator
+    if (large_allocator) tb_allocator_exit(large_allocator);
+    large_allocator = tb_null;
+
+    // exit data
+    if (data) tb_native_memory_free(data);
+    data = tb_null;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -223,6 +337,10 @@ tb_int_t tb_demo_memory_default_allocator_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_default_allocator_perf();
 #endif
 
+#if 1
+    tb_demo_default_allocator_trim();
+#endif
+
 #if 0
     tb_demo_default_allocator_leak();
 #endif
@@ -188,6 +188,64 @@ tb_void_t tb_demo_fixed_pool_perf(tb_size_t item_size)
     if (pool) tb_fixed_pool_exit(pool);
 }
 
+tb_void_t tb_demo_fixed_pool_perf_slots(tb_size_t slot_count);
+tb_void_t tb_demo_fixed_pool_perf_slots(tb_size_t slot_count)
+{
+    // done
+    tb_fixed_pool_ref_t pool = tb_null;
+    tb_pointer_t*       list = tb_null;
+    do
+    {
+        // init pool with the small slots
+        tb_size_t slot_size = 16;
+        pool = tb_fixed_pool_init(tb_null, slot_size, 32, tb_null, tb_null, tb_null);
+        tb_assert_and_check_break(pool);
+
+        // make data list
+        tb_size_t maxn = slot_count * slot_size;
+        list = tb_nalloc0_type(maxn, tb_pointer_t);
+        tb_assert_and_check_break(list);
+
+        // make the live data for all slots
+        __tb_volatile__ tb_size_t indx = 0;
+        for (indx = 0; indx < maxn; indx++)
+        {
+            list[indx] = tb_fixed_pool_malloc(pool);
+            tb_assert_and_check_break(list[indx]);
+        }
+
+        // done free and malloc
+        __tb_volatile__ tb_size_t count = 1000000;
+        __tb_volatile__ tb_size_t rand = 0xbeaf;
+        __tb_volatile__ tb_hong_t time = tb_mclock();
+        for (indx = 0; indx < count; indx++)
+        {
+            // make rand
+            rand = (rand * 10807 + 1) & 0xffffffff;
+
+            // free it
+            tb_size_t free_indx = rand % maxn;
+            tb_fixed_pool_free(pool, list[free_indx]);
+
+            // re-make it
+            list[free_indx] = tb_fixed_pool_malloc(pool);
+            tb_assert_and_check_break(list[free_indx]);
+        }
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("slots: %lu, items: %lu, free and malloc: %lu, time: %lld ms", slot_count, maxn, count, time);
+
+    } while (0);
+
+    // exit list
+    if (list) tb_free(list);
+    list = tb_null;
+
+    // exit pool
+    if (pool) tb_fixed_pool_exit(pool);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
@@ -208,6 +266,13 @@ tb_int_t tb_demo_memory_fixed_pool_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_fixed_pool_perf(3072);
 #endif
 
+#if 1
+    tb_demo_fixed_pool_perf_slots(100);
+    tb_demo_fixed_pool_perf_slots(1000);
+    tb_demo_fixed_pool_perf_slots(10000);
+    tb_demo_fixed_pool_perf_slots(20000);
+#endif
+
 #if 0
     tb_demo_fixed_pool_leak();
 #endif
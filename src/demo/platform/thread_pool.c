@@ -3,6 +3,29 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the batch count of the task graph
+#define TB_DEMO_GRAPH_COUNT         (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the thread pool for benchmark
+static tb_thread_pool_ref_t g_pool = tb_null;
+
+// the done count
+static tb_atomic_t          g_count = 0;
+
+// the error count
+static tb_atomic_t          g_errors = 0;
+
+// the done stages of the task graph
+static tb_size_t            g_stages[TB_DEMO_GRAPH_COUNT];
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * test
  */ 
@@ -19,12 +42,177 @@ static tb_void_t tb_demo_task_time_exit(tb_thread_pool_worker_ref_t worker, tb_c
     // trace
     tb_trace_i("exit: %u ms", tb_p2u32(priv));
 }
+static tb_void_t tb_demo_task_count_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // count it
+    tb_atomic_fetch_and_inc(&g_count);
+}
+static tb_void_t tb_demo_task_tree_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // count it
+    tb_atomic_fetch_and_inc(&g_count);
+
+    // post two child tasks from this worker until the depth is zero
+    tb_size_t depth = (tb_size_t)priv;
+    if (depth)
+    {
+        tb_thread_pool_task_post(g_pool, tb_null, tb_demo_task_tree_done, tb_null, (tb_cpointer_t)(depth - 1), tb_false);
+        tb_thread_pool_task_post(g_pool, tb_null, tb_demo_task_tree_done, tb_null, (tb_cpointer_t)(depth - 1), tb_false);
+    }
+}
+static tb_void_t tb_demo_task_stage_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the batch index and stage
+    tb_size_t index = (tb_size_t)priv >> 2;
+    tb_size_t stage = (tb_size_t)priv & 3;
+
+    // the previous stage must have been done
+    if (index >= TB_DEMO_GRAPH_COUNT || g_stages[index] + 1 != stage) tb_atomic_fetch_and_inc(&g_errors);
+    else g_stages[index] = stage;
+
+    // count it
+    tb_atomic_fetch_and_inc(&g_count);
+}
+static tb_void_t tb_demo_task_join_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // all batches must have been done
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_GRAPH_COUNT; i++)
+    {
+        if (g_stages[i] != 3) tb_atomic_fetch_and_inc(&g_errors);
+    }
+
+    // count it
+    tb_atomic_fetch_and_inc(&g_count);
+}
+static tb_void_t tb_demo_graph()
+{
+    // init pool
+    g_pool = tb_thread_pool_init(0, 0);
+    tb_assert_and_check_return(g_pool);
+
+    // the task handles
+    tb_thread_pool_task_ref_t* tasks = tb_nalloc0_type(TB_DEMO_GRAPH_COUNT * 3, tb_thread_pool_task_ref_t);
+    if (tasks)
+    {
+        // post the pipelines: decompress => parse => index
+        tb_size_t i = 0;
+        tb_hong_t time = tb_mclock();
+        tb_atomic_set0(&g_count);
+        tb_memset(g_stages, 0, sizeof(g_stages));
+        for (i = 0; i < TB_DEMO_GRAPH_COUNT; i++)
+        {
+            tb_thread_pool_task_ref_t* stages = tasks + i * 3;
+            stages[0] = tb_thread_pool_task_init(g_pool, "decompress", tb_demo_task_stage_done, tb_null, (tb_cpointer_t)((i << 2) + 1), tb_false);
+            stages[1] = stages[0]? tb_thread_pool_task_then(g_pool, stages[0], "parse", tb_demo_task_stage_done, tb_null, (tb_cpointer_t)((i << 2) + 2)) : tb_null;
+            stages[2] = stages[1]? tb_thread_pool_task_then(g_pool, stages[1], "index", tb_demo_task_stage_done, tb_null, (tb_cpointer_t)((i << 2) + 3)) : tb_null;
+        }
+
+        // join all indexed batches, we need not block any threads until the last task
+        tb_thread_pool_task_ref_t indices[TB_DEMO_GRAPH_COUNT];
+        for (i = 0; i < TB_DEMO_GRAPH_COUNT; i++) indices[i] = tasks[i * 3 + 2];
+        tb_thread_pool_task_ref_t join = tb_thread_pool_task_init_after(g_pool, indices, TB_DEMO_GRAPH_COUNT, "join", tb_demo_task_join_done, tb_null, tb_null);
+        if (join)
+        {
+            tb_thread_pool_task_wait(g_pool, join, -1);
+            tb_thread_pool_task_exit(g_pool, join);
+        }
+        time = tb_mclock() - time;
+
+        // exit all task handles
+        for (i = 0; i < TB_DEMO_GRAPH_COUNT * 3; i++) 
+        {
+            if (tasks[i]) tb_thread_pool_task_exit(g_pool, tasks[i]);
+        }
+        tb_free(tasks);
+
+        // trace
+        tb_trace_i("graph: count: %ld / %lu, errors: %ld, time: %lld ms", (tb_long_t)tb_atomic_get(&g_count), (tb_size_t)TB_DEMO_GRAPH_COUNT * 3 + 1, (tb_long_t)tb_atomic_get(&g_errors), time);
+    }
+
+    // the killed task will kill all its continuations
+    tb_atomic_set0(&g_count);
+    tb_thread_pool_task_ref_t first = tb_thread_pool_task_init(g_pool, "sleep", tb_demo_task_time_done, tb_null, tb_u2p(100), tb_false);
+    tb_thread_pool_task_ref_t second = first? tb_thread_pool_task_then(g_pool, first, "count", tb_demo_task_count_done, tb_null, tb_null) : tb_null;
+    tb_thread_pool_task_ref_t third = second? tb_thread_pool_task_then(g_pool, second, "count", tb_demo_task_count_done, tb_null, tb_null) : tb_null;
+    if (third)
+    {
+        // kill the second task
+        tb_thread_pool_task_kill(g_pool, second);
+
+        // wait the third task
+        tb_long_t wait = tb_thread_pool_task_wait(g_pool, third, -1);
+
+        // trace
+        tb_trace_i("graph: kill: wait: %ld, count: %ld", wait, (tb_long_t)tb_atomic_get(&g_count));
+    }
+    if (third) tb_thread_pool_task_exit(g_pool, third);
+    if (second) tb_thread_pool_task_exit(g_pool, second);
+    if (first) tb_thread_pool_task_exit(g_pool, first);
+
+    // exit pool
+    tb_thread_pool_exit(g_pool);
+    g_pool = tb_null;
+}
+static tb_void_t tb_demo_bench()
+{
+    // init pool
+    g_pool = tb_thread_pool_init(0, 0);
+    tb_assert_and_check_return(g_pool);
+
+    // post the tiny tasks from this thread
+    tb_size_t i = 0;
+    tb_size_t count = 1000000;
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++) 
+        tb_thread_pool_task_post(g_pool, tb_null, tb_demo_task_count_done, tb_null, tb_null, tb_false);
+    tb_thread_pool_task_wait_all(g_pool, -1);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("bench: post: count: %ld / %lu, workers: %lu, time: %lld ms", (tb_long_t)tb_atomic_get(&g_count), count, tb_thread_pool_worker_size(g_pool), time);
+
+    // post the task tree from the workers, 2^20 - 1 tasks
+    tb_atomic_set0(&g_count);
+    time = tb_mclock();
+    tb_thread_pool_task_post(g_pool, tb_null, tb_demo_task_tree_done, tb_null, (tb_cpointer_t)19, tb_false);
+    tb_thread_pool_task_wait_all(g_pool, -1);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("bench: tree: count: %ld / %lu, workers: %lu, time: %lld ms", (tb_long_t)tb_atomic_get(&g_count), (tb_size_t)(1 << 20) - 1, tb_thread_pool_worker_size(g_pool), time);
+
+    // wait the task handle
+    tb_atomic_set0(&g_count);
+    tb_thread_pool_task_ref_t task = tb_thread_pool_task_init(g_pool, "count", tb_demo_task_count_done, tb_null, tb_null, tb_true);
+    if (task)
+    {
+        // wait it
+        tb_long_t wait = tb_thread_pool_task_wait(g_pool, task, -1);
+
+        // trace
+        tb_trace_i("bench: wait: %ld, count: %ld", wait, (tb_long_t)tb_atomic_get(&g_count));
+
+        // exit it
+        tb_thread_pool_task_exit(g_pool, task);
+    }
+
+    // exit pool
+    tb_thread_pool_exit(g_pool);
+    g_pool = tb_null;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_platform_thread_pool_main(tb_int_t argc, tb_char_t** argv)
 {
+    // bench it
+    tb_demo_bench();
+
+    // test the task graph
+    tb_demo_graph();
+
 #if 0
     // post task: 60s
     tb_thread_pool_task_post(tb_thread_pool(), "60000ms", tb_demo_task_time_done, tb_null, (tb_cpointer_t)60000, tb_false);
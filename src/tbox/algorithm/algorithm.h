@@ -37,6 +37,11 @@
 #include "rfor.h"
 #include "rfor_if.h"
 #include "sort.h"
+#include "pdq_sort.h"
+#include "radix_sort.h"
+#include "stable_sort.h"
+#include "partial_sort.h"
+#include "nth_element.h"
 #include "heap_sort.h"
 #include "quick_sort.h"
 #include "insert_sort.h"
@@ -55,5 +60,6 @@
 #include "remove_if.h"
 #include "remove_first.h"
 #include "remove_first_if.h"
+#include "parallel.h"
 
 #endif
@@ -0,0 +1,335 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        nth_element.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "nth_element.h"
+#include "heap_sort.h"
+#include "../libc/libc.h"
+#include "../container/element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the ranges below this size are sorted using the insertion sort
+#define TB_NTH_ELEMENT_INSERTION_SORT_THRESHOLD     (16)
+
+// the ranges above this size use the ninther to select the pivot
+#define TB_NTH_ELEMENT_NINTHER_THRESHOLD            (128)
+
+/*! make the nth element selector for the contiguous integer items
+ *
+ * it is the same introselect as the generic version, but compares the items directly
+ *
+ * @return tb_false if there are too many bad partitions, [*phead, *ptail) is the left range
+ */
+#define tb_nth_element_make(name, type) \
+static tb_void_t tb_nth_element_##name##_sort3(type* items, tb_size_t a, tb_size_t b, tb_size_t c) \
+{ \
+    type t; \
+    if (items[b] < items[a]) { t = items[a]; items[a] = items[b]; items[b] = t; } \
+    if (items[c] < items[b]) { t = items[b]; items[b] = items[c]; items[c] = t; } \
+    if (items[b] < items[a]) { t = items[a]; items[a] = items[b]; items[b] = t; } \
+} \
+static tb_bool_t tb_nth_element_##name(type* items, tb_size_t* phead, tb_size_t* ptail, tb_size_t nth, tb_size_t* pdepth) \
+{ \
+    tb_size_t head = *phead; \
+    tb_size_t tail = *ptail; \
+    while (tail - head > TB_NTH_ELEMENT_INSERTION_SORT_THRESHOLD) \
+    { \
+        /* too many bad partitions? */ \
+        if (!*pdepth) \
+        { \
+            *phead = head; \
+            *ptail = tail; \
+            return tb_false; \
+        } \
+        (*pdepth)--; \
+        \
+        /* select the pivot */ \
+        tb_size_t mid = head + ((tail - head) >> 1); \
+        tb_nth_element_##name##_sort3(items, head, mid, tail - 1); \
+        if (tail - head > TB_NTH_ELEMENT_NINTHER_THRESHOLD) \
+        { \
+            tb_nth_element_##name##_sort3(items, head + 1, mid - 1, tail - 2); \
+            tb_nth_element_##name##_sort3(items, head + 2, mid + 1, tail - 3); \
+            tb_nth_element_##name##_sort3(items, mid - 1, mid, mid + 1); \
+        } \
+        type pivot = items[mid]; \
+        \
+        /* partition it */ \
+        tb_size_t i = head; \
+        tb_size_t j = tail - 1; \
+        while (1) \
+        { \
+            while (items[i] < pivot) i++; \
+            while (pivot < items[j]) j--; \
+            if (i >= j) break; \
+            type t = items[i]; \
+            items[i++] = items[j]; \
+            items[j--] = t; \
+        } \
+        if (i == j) \
+        { \
+            i++; \
+            j--; \
+        } \
+        \
+        /* narrow the range to the nth item, the items between j and i are equal to the pivot */ \
+        if (nth <= j) tail = j + 1; \
+        else if (nth >= i) head = i; \
+        else return tb_true; \
+    } \
+    \
+    /* sort the left items */ \
+    tb_size_t i; \
+    for (i = head + 1; i < tail; i++) \
+    { \
+        type      item = items[i]; \
+        tb_size_t hole = i; \
+        for (; hole > head && item < items[hole - 1]; hole--) items[hole] = items[hole - 1]; \
+        items[hole] = item; \
+    } \
+    return tb_true; \
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the nth element selector type
+typedef struct __tb_nth_element_t
+{
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the item step
+    tb_size_t               step;
+
+    // the pivot buffer for the large items
+    tb_byte_t*              pivot;
+
+    // the temporary buffer for the large items
+    tb_byte_t*              temp;
+
+}tb_nth_element_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+tb_nth_element_make(long, tb_long_t)
+tb_nth_element_make(size, tb_size_t)
+tb_nth_element_make(uint8, tb_uint8_t)
+tb_nth_element_make(uint16, tb_uint16_t)
+tb_nth_element_make(uint32, tb_uint32_t)
+
+static __tb_inline__ tb_bool_t tb_nth_element_less(tb_nth_element_t* select, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return select->comp(select->iterator, litem, ritem) < 0;
+}
+static __tb_inline__ tb_pointer_t tb_nth_element_item(tb_nth_element_t* select, tb_size_t itor)
+{
+    return tb_iterator_item(select->iterator, itor);
+}
+static __tb_inline__ tb_cpointer_t tb_nth_element_save(tb_nth_element_t* select, tb_size_t itor, tb_byte_t* buffer)
+{
+    // the item value or the item address
+    tb_pointer_t item = tb_iterator_item(select->iterator, itor);
+    tb_check_return_val(select->step > sizeof(tb_pointer_t), item);
+
+    // save the large item
+    tb_memcpy(buffer, item, select->step);
+    return buffer;
+}
+static __tb_inline__ tb_void_t tb_nth_element_swap(tb_nth_element_t* select, tb_size_t litor, tb_size_t ritor)
+{
+    tb_cpointer_t item = tb_nth_element_save(select, litor, select->temp);
+    tb_iterator_copy(select->iterator, litor, tb_nth_element_item(select, ritor));
+    tb_iterator_copy(select->iterator, ritor, item);
+}
+static __tb_inline__ tb_void_t tb_nth_element_sort3(tb_nth_element_t* select, tb_size_t a, tb_size_t b, tb_size_t c)
+{
+    if (tb_nth_element_less(select, tb_nth_element_item(select, b), tb_nth_element_item(select, a))) tb_nth_element_swap(select, a, b);
+    if (tb_nth_element_less(select, tb_nth_element_item(select, c), tb_nth_element_item(select, b))) tb_nth_element_swap(select, b, c);
+    if (tb_nth_element_less(select, tb_nth_element_item(select, b), tb_nth_element_item(select, a))) tb_nth_element_swap(select, a, b);
+}
+static tb_bool_t tb_nth_element_data(tb_iterator_ref_t iterator, tb_size_t* phead, tb_size_t* ptail, tb_size_t nth, tb_size_t* pdepth)
+{
+    // get the contiguous integer items
+    tb_size_t       type = TB_ELEMENT_TYPE_NULL;
+    tb_pointer_t    data = tb_iterator_data(iterator, &type);
+    tb_check_return_val(data, tb_false);
+
+    // select it
+    tb_size_t step = tb_iterator_step(iterator);
+    switch (type)
+    {
+    case TB_ELEMENT_TYPE_LONG:      
+        tb_check_break(step == sizeof(tb_long_t));
+        return tb_nth_element_long((tb_long_t*)data, phead, ptail, nth, pdepth);
+    case TB_ELEMENT_TYPE_SIZE:      
+        tb_check_break(step == sizeof(tb_size_t));
+        return tb_nth_element_size((tb_size_t*)data, phead, ptail, nth, pdepth);
+    case TB_ELEMENT_TYPE_UINT8:     
+        tb_check_break(step == sizeof(tb_uint8_t));
+        return tb_nth_element_uint8((tb_uint8_t*)data, phead, ptail, nth, pdepth);
+    case TB_ELEMENT_TYPE_UINT16:    
+        tb_check_break(step == sizeof(tb_uint16_t));
+        return tb_nth_element_uint16((tb_uint16_t*)data, phead, ptail, nth, pdepth);
+    case TB_ELEMENT_TYPE_UINT32:    
+        tb_check_break(step == sizeof(tb_uint32_t));
+        return tb_nth_element_uint32((tb_uint32_t*)data, phead, ptail, nth, pdepth);
+    default:
+        break;
+    }
+
+    // not supported
+    return tb_false;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_nth_element(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t nth, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+    tb_check_return(head != tail);
+    tb_assert_and_check_return(nth < tail - head);
+
+    // the nth item
+    nth += head;
+
+    // the allowed bad partitions: 2 * log2(n)
+    tb_size_t size = tail - head;
+    tb_size_t depth = 0;
+    while (size) 
+    {
+        depth += 2;
+        size >>= 1;
+    }
+
+    // the contiguous integer items with the natural order? select them directly
+    if ((!comp || comp == tb_iterator_comp) && tb_nth_element_data(iterator, &head, &tail, nth, &depth)) return ;
+
+    // init selector
+    tb_nth_element_t select;
+    select.iterator = iterator;
+    select.comp     = comp? comp : tb_iterator_comp;
+    select.step     = tb_iterator_step(iterator);
+    select.pivot    = select.step > sizeof(tb_pointer_t)? (tb_byte_t*)tb_malloc(select.step << 1) : tb_null;
+    select.temp     = select.pivot? select.pivot + select.step : tb_null;
+    tb_assert_and_check_return(select.step <= sizeof(tb_pointer_t) || select.pivot);
+
+    // done
+    tb_bool_t done = tb_false;
+    while (tail - head > TB_NTH_ELEMENT_INSERTION_SORT_THRESHOLD)
+    {
+        // too many bad partitions? fall back to the heap sort
+        if (!depth--)
+        {
+            tb_heap_sort(iterator, head, tail, select.comp);
+            done = tb_true;
+            break;
+        }
+
+        // select the pivot using the median of 3 or the ninther
+        tb_size_t mid = head + ((tail - head) >> 1);
+        tb_nth_element_sort3(&select, head, mid, tail - 1);
+        if (tail - head > TB_NTH_ELEMENT_NINTHER_THRESHOLD)
+        {
+            tb_nth_element_sort3(&select, head + 1, mid - 1, tail - 2);
+            tb_nth_element_sort3(&select, head + 2, mid + 1, tail - 3);
+            tb_nth_element_sort3(&select, mid - 1, mid, mid + 1);
+        }
+        tb_cpointer_t pivot = tb_nth_element_save(&select, mid, select.pivot);
+
+        /* partition it, the scanning stops at the equal items, so the many duplicate items are still balanced
+         *
+         * <pre>
+         * [ <= pivot ] j [ == pivot ] i [ >= pivot ]
+         * </pre>
+         */
+        tb_size_t i = head;
+        tb_size_t j = tail - 1;
+        while (1)
+        {
+            while (tb_nth_element_less(&select, tb_nth_element_item(&select, i), pivot)) i++;
+            while (tb_nth_element_less(&select, pivot, tb_nth_element_item(&select, j))) j--;
+            if (i >= j) break;
+            tb_nth_element_swap(&select, i++, j--);
+        }
+        if (i == j)
+        {
+            i++;
+            j--;
+        }
+
+        // narrow the range to the nth item, the items between j and i are equal to the pivot
+        if (nth <= j) tail = j + 1;
+        else if (nth >= i) head = i;
+        else 
+        {
+            done = tb_true;
+            break;
+        }
+    }
+
+    // sort the left items using the insertion sort
+    if (!done)
+    {
+        tb_size_t i;
+        for (i = head + 1; i < tail; i++)
+        {
+            // this item is not less than the previous item? continue it
+            if (!tb_nth_element_less(&select, tb_nth_element_item(&select, i), tb_nth_element_item(&select, i - 1))) continue;
+
+            // insert this item
+            tb_size_t       hole = i;
+            tb_cpointer_t   item = tb_nth_element_save(&select, i, select.temp);
+            do
+            {
+                tb_iterator_copy(iterator, hole, tb_nth_element_item(&select, hole - 1));
+                hole--;
+
+            } while (hole > head && tb_nth_element_less(&select, item, tb_nth_element_item(&select, hole - 1)));
+            tb_iterator_copy(iterator, hole, item);
+        }
+    }
+
+    // free
+    if (select.pivot) tb_free(select.pivot);
+}
+tb_void_t tb_nth_element_all(tb_iterator_ref_t iterator, tb_size_t nth, tb_iterator_comp_t comp)
+{
+    tb_nth_element(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), nth, comp);
+}
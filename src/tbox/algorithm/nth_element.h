@@ -0,0 +1,70 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        nth_element.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_NTH_ELEMENT_H
+#define TB_ALGORITHM_NTH_ELEMENT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the nth element selector, O(n)
+ *
+ * the item at head + nth will be the item which would be there if all items were sorted,
+ * the items before it are not larger than it and the items after it are not less than it.
+ *
+ * it uses the introselect and falls back to the heap sort for the bad partitions
+ *
+ * @param iterator  the iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param nth       the item index from head
+ * @param comp      the comparer
+ */
+tb_void_t           tb_nth_element(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t nth, tb_iterator_comp_t comp);
+
+/*! the nth element selector for all
+ *
+ * @param iterator  the iterator
+ * @param nth       the item index from head
+ * @param comp      the comparer
+ */
+tb_void_t           tb_nth_element_all(tb_iterator_ref_t iterator, tb_size_t nth, tb_iterator_comp_t comp);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
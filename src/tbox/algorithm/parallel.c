@@ -0,0 +1,583 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "parallel.h"
+#include "sort.h"
+#include "count_if.h"
+#include "../libc/libc.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimal default grain 
+#define TB_PARALLEL_GRAIN_MIN           (1024)
+
+// the ranges count of each processor for the default grain
+#define TB_PARALLEL_GRAIN_RANGES        (8)
+
+// the minimal default grain of each sorted range
+#define TB_PARALLEL_SORT_GRAIN_MIN      (1 << 14)
+
+// the helpers maxn
+#define TB_PARALLEL_HELPER_MAXN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the parallel range func type
+typedef tb_bool_t (*tb_parallel_range_func_t)(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv);
+
+/* the parallel type
+ *
+ * the ranges are claimed by the current thread and the helper tasks of the thread pool,
+ * and the helper tasks may be started after all ranges have been done, 
+ * so it will be freed by the last reference.
+ */
+typedef struct __tb_parallel_t
+{
+    // the references of the current thread and the helper tasks
+    tb_atomic_t                 refn;
+
+    // the next range index
+    tb_atomic_t                 next;
+
+    // the done ranges count
+    tb_atomic_t                 done;
+
+    // is stoped?
+    tb_atomic_t                 stop;
+
+    // the head
+    tb_size_t                   head;
+
+    // the tail
+    tb_size_t                   tail;
+
+    // the grain
+    tb_size_t                   grain;
+
+    // the ranges count
+    tb_size_t                   count;
+
+    // the range func
+    tb_parallel_range_func_t    func;
+
+    // the range func private data
+    tb_cpointer_t               priv;
+
+}tb_parallel_t;
+
+// the parallel for type
+typedef struct __tb_parallel_for_t
+{
+    // the iterator
+    tb_iterator_ref_t           iterator;
+
+    // the func
+    tb_parallel_func_t          func;
+
+    // the func private data
+    tb_cpointer_t               priv;
+
+}tb_parallel_for_t;
+
+// the parallel walk type
+typedef struct __tb_parallel_walk_t
+{
+    // the iterator
+    tb_iterator_ref_t           iterator;
+
+    // the walker func
+    tb_walk_func_t              func;
+
+    // the func private data
+    tb_cpointer_t               priv;
+
+    // the item count
+    tb_atomic_t                 count;
+
+}tb_parallel_walk_t;
+
+// the parallel count type
+typedef struct __tb_parallel_count_t
+{
+    // the iterator
+    tb_iterator_ref_t           iterator;
+
+    // the predicate
+    tb_predicate_ref_t          pred;
+
+    // the value of the predicate
+    tb_cpointer_t               value;
+
+    // the item count
+    tb_atomic_t                 count;
+
+}tb_parallel_count_t;
+
+// the parallel reduce type
+typedef struct __tb_parallel_reduce_t
+{
+    // the iterator
+    tb_iterator_ref_t           iterator;
+
+    // the reduce func
+    tb_parallel_reduce_func_t   reduce;
+
+    // the func private data
+    tb_cpointer_t               priv;
+
+    // the reduced values of all ranges
+    tb_hong_t*                  values;
+
+}tb_parallel_reduce_t;
+
+// the parallel sort type
+typedef struct __tb_parallel_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t           iterator;
+
+    // the iterator head
+    tb_size_t                   head;
+
+    // the items count
+    tb_size_t                   size;
+
+    // the comparer
+    tb_iterator_comp_t          comp;
+
+    // the temporary items
+    tb_byte_t*                  temp;
+
+    // the item step
+    tb_size_t                   step;
+
+    // the sorted runs width of the current merging pass
+    tb_size_t                   width;
+
+    // merge the temporary items to the iterator?
+    tb_bool_t                   from_temp;
+
+}tb_parallel_sort_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t tb_parallel_grain(tb_size_t size, tb_size_t grain_min)
+{
+    // the grain for some ranges of each processor
+    tb_size_t ranges = tb_processor_count() * TB_PARALLEL_GRAIN_RANGES;
+    tb_size_t grain = (size + ranges - 1) / ranges;
+    return tb_max(grain, grain_min);
+}
+static tb_void_t tb_parallel_work(tb_parallel_t* parallel)
+{
+    // claim and done the ranges
+    tb_size_t index = 0;
+    while ((index = (tb_size_t)tb_atomic_fetch_and_inc(&parallel->next)) < parallel->count)
+    {
+        // done this range if not be stoped
+        if (!*((__tb_volatile__ tb_atomic_t*)&parallel->stop))
+        {
+            tb_size_t head = parallel->head + index * parallel->grain;
+            tb_size_t tail = tb_min(head + parallel->grain, parallel->tail);
+            if (!parallel->func(index, head, tail, parallel->priv)) tb_atomic_set(&parallel->stop, 1);
+        }
+
+        // done++
+        tb_atomic_fetch_and_inc(&parallel->done);
+    }
+}
+static tb_void_t tb_parallel_exit(tb_parallel_t* parallel)
+{
+    // refn--, free it if no references
+    if (tb_atomic_fetch_and_dec(&parallel->refn) <= 1) tb_free(parallel);
+}
+static tb_void_t tb_parallel_helper_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // help the current thread
+    tb_parallel_work((tb_parallel_t*)priv);
+}
+static tb_void_t tb_parallel_helper_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // release it
+    tb_parallel_exit((tb_parallel_t*)priv);
+}
+static tb_void_t tb_parallel_done(tb_size_t head, tb_size_t tail, tb_size_t grain, tb_parallel_range_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return(func && grain && head <= tail);
+
+    // the ranges count
+    tb_size_t count = (tail - head + grain - 1) / grain;
+    tb_check_return(count);
+
+    // the helpers count
+    tb_size_t helpers = tb_min(count, tb_processor_count()) - 1;
+    helpers = tb_min(helpers, TB_PARALLEL_HELPER_MAXN);
+
+    // the thread pool
+    tb_thread_pool_ref_t pool = helpers? tb_thread_pool() : tb_null;
+
+    // make parallel
+    tb_parallel_t* parallel = pool? tb_malloc0_type(tb_parallel_t) : tb_null;
+
+    // only one range or no helpers? done it directly
+    if (!parallel)
+    {
+        tb_size_t index = 0;
+        for (index = 0; index < count; index++)
+        {
+            tb_size_t range_head = head + index * grain;
+            if (!func(index, range_head, tb_min(range_head + grain, tail), priv)) break;
+        }
+        return ;
+    }
+
+    // init parallel
+    parallel->refn  = helpers + 1;
+    parallel->head  = head;
+    parallel->tail  = tail;
+    parallel->grain = grain;
+    parallel->count = count;
+    parallel->func  = func;
+    parallel->priv  = priv;
+
+    // post the helper tasks
+    tb_size_t               i = 0;
+    tb_thread_pool_task_t   tasks[TB_PARALLEL_HELPER_MAXN];
+    for (i = 0; i < helpers; i++)
+    {
+        tasks[i].name   = tb_null;
+        tasks[i].done   = tb_parallel_helper_done;
+        tasks[i].exit   = tb_parallel_helper_exit;
+        tasks[i].priv   = parallel;
+        tasks[i].urgent = tb_false;
+    }
+    tb_size_t posted = tb_thread_pool_task_post_list(pool, tasks, helpers);
+    if (posted < helpers) tb_atomic_fetch_and_sub(&parallel->refn, helpers - posted);
+
+    // work it
+    tb_parallel_work(parallel);
+
+    // wait the ranges which have been claimed by the helpers
+    tb_size_t spin = 0;
+    while ((tb_size_t)*((__tb_volatile__ tb_atomic_t*)&parallel->done) < count)
+    {
+        if (spin < 64) 
+        {
+            tb_sched_yield();
+            spin++;
+        }
+        else tb_msleep(1);
+    }
+
+    // the results of the helpers must be visible now
+    tb_barrier();
+
+    // exit parallel
+    tb_parallel_exit(parallel);
+}
+static tb_bool_t tb_parallel_for_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // done it
+    tb_parallel_for_t* parallel = (tb_parallel_for_t*)priv;
+    return parallel->func(parallel->iterator, head, tail, parallel->priv);
+}
+static tb_bool_t tb_parallel_walk_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // walk it
+    tb_parallel_walk_t* parallel = (tb_parallel_walk_t*)priv;
+    tb_size_t count = tb_walk(parallel->iterator, head, tail, parallel->func, parallel->priv);
+    tb_atomic_fetch_and_add(&parallel->count, count);
+
+    // continue it if all items have been walked
+    return count == tail - head;
+}
+static tb_bool_t tb_parallel_count_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // count it
+    tb_parallel_count_t* parallel = (tb_parallel_count_t*)priv;
+    tb_atomic_fetch_and_add(&parallel->count, tb_count_if(parallel->iterator, head, tail, parallel->pred, parallel->value));
+    return tb_true;
+}
+static tb_bool_t tb_parallel_reduce_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // reduce it
+    tb_parallel_reduce_t* parallel = (tb_parallel_reduce_t*)priv;
+    parallel->values[index] = parallel->reduce(parallel->iterator, head, tail, parallel->priv);
+    return tb_true;
+}
+static __tb_inline__ tb_cpointer_t tb_parallel_sort_item(tb_parallel_sort_t* sort, tb_bool_t temp, tb_size_t index)
+{
+    // the item of the iterator
+    if (!temp) return tb_iterator_item(sort->iterator, sort->head + index);
+
+    // the temporary item
+    return sort->step <= sizeof(tb_pointer_t)? ((tb_cpointer_t*)sort->temp)[index] : (tb_cpointer_t)(sort->temp + index * sort->step);
+}
+static __tb_inline__ tb_void_t tb_parallel_sort_copy(tb_parallel_sort_t* sort, tb_bool_t temp, tb_size_t index, tb_cpointer_t item)
+{
+    // copy it to the iterator
+    if (!temp) tb_iterator_copy(sort->iterator, sort->head + index, item);
+    // copy it to the temporary items
+    else if (sort->step <= sizeof(tb_pointer_t)) ((tb_cpointer_t*)sort->temp)[index] = item;
+    else tb_memcpy(sort->temp + index * sort->step, item, sort->step);
+}
+static tb_bool_t tb_parallel_sort_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // sort this range
+    tb_parallel_sort_t* sort = (tb_parallel_sort_t*)priv;
+    tb_sort(sort->iterator, sort->head + head, sort->head + tail, sort->comp);
+    return tb_true;
+}
+static tb_bool_t tb_parallel_sort_merge_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // the sort
+    tb_parallel_sort_t* sort = (tb_parallel_sort_t*)priv;
+
+    // the source and destination
+    tb_bool_t           src = sort->from_temp;
+    tb_bool_t           dst = !sort->from_temp;
+    tb_size_t           width = sort->width;
+    tb_size_t           size = sort->size;
+    tb_iterator_ref_t   iterator = sort->iterator;
+    tb_iterator_comp_t  comp = sort->comp;
+
+    /* merge the output items [head, tail) of the run pairs
+     *
+     * left: [left, middle), right: [middle, right)
+     */
+    tb_size_t pos = head;
+    while (pos < tail)
+    {
+        // the run pair of this position
+        tb_size_t left   = pos - pos % (width << 1);
+        tb_size_t middle = tb_min(left + width, size);
+        tb_size_t right  = tb_min(middle + width, size);
+        tb_size_t last   = tb_min(tail, right);
+
+        /* find the left items count of the first (pos - left) output items by the binary search
+         *
+         * the left item is placed before the equal right item
+         */
+        tb_size_t k = pos - left;
+        tb_size_t l = k > right - middle? k - (right - middle) : 0;
+        tb_size_t r = tb_min(k, middle - left);
+        while (l < r)
+        {
+            tb_size_t m = (l + r) >> 1;
+            if (comp(iterator, tb_parallel_sort_item(sort, src, left + m), tb_parallel_sort_item(sort, src, middle + k - m - 1)) <= 0) l = m + 1;
+            else r = m;
+        }
+
+        // merge it
+        tb_size_t i = left + l;
+        tb_size_t j = middle + k - l;
+        for (; pos < last; pos++)
+        {
+            if (j >= right || (i < middle && comp(iterator, tb_parallel_sort_item(sort, src, i), tb_parallel_sort_item(sort, src, j)) <= 0))
+                tb_parallel_sort_copy(sort, dst, pos, tb_parallel_sort_item(sort, src, i++));
+            else tb_parallel_sort_copy(sort, dst, pos, tb_parallel_sort_item(sort, src, j++));
+        }
+    }
+    return tb_true;
+}
+static tb_bool_t tb_parallel_sort_copy_func(tb_size_t index, tb_size_t head, tb_size_t tail, tb_cpointer_t priv)
+{
+    // copy the temporary items to the iterator
+    tb_parallel_sort_t* sort = (tb_parallel_sort_t*)priv;
+    for (; head < tail; head++) tb_parallel_sort_copy(sort, tb_false, head, tb_parallel_sort_item(sort, tb_true, head));
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_parallel_for(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_parallel_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) && func);
+
+    // null?
+    tb_check_return(head < tail);
+
+    // done it
+    tb_parallel_for_t parallel = {iterator, func, priv};
+    tb_parallel_done(head, tail, grain? grain : tb_parallel_grain(tail - head, TB_PARALLEL_GRAIN_MIN), tb_parallel_for_func, &parallel);
+}
+tb_void_t tb_parallel_for_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_parallel_func_t func, tb_cpointer_t priv)
+{
+    tb_parallel_for(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), grain, func, priv);
+}
+tb_size_t tb_parallel_walk(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_walk_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) && func, 0);
+
+    // null?
+    tb_check_return_val(head < tail, 0);
+
+    // walk it
+    tb_parallel_walk_t parallel = {iterator, func, priv, 0};
+    tb_parallel_done(head, tail, grain? grain : tb_parallel_grain(tail - head, TB_PARALLEL_GRAIN_MIN), tb_parallel_walk_func, &parallel);
+
+    // ok?
+    return (tb_size_t)parallel.count;
+}
+tb_size_t tb_parallel_walk_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_walk_func_t func, tb_cpointer_t priv)
+{
+    return tb_parallel_walk(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), grain, func, priv);
+}
+tb_size_t tb_parallel_count_if(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_predicate_ref_t pred, tb_cpointer_t value)
+{
+    // check
+    tb_assert_and_check_return_val(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) && pred, 0);
+
+    // null?
+    tb_check_return_val(head < tail, 0);
+
+    // count it
+    tb_parallel_count_t parallel = {iterator, pred, value, 0};
+    tb_parallel_done(head, tail, grain? grain : tb_parallel_grain(tail - head, TB_PARALLEL_GRAIN_MIN), tb_parallel_count_func, &parallel);
+
+    // ok?
+    return (tb_size_t)parallel.count;
+}
+tb_size_t tb_parallel_count_all_if(tb_iterator_ref_t iterator, tb_size_t grain, tb_predicate_ref_t pred, tb_cpointer_t value)
+{
+    return tb_parallel_count_if(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), grain, pred, value);
+}
+tb_hong_t tb_parallel_reduce(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_hong_t init, tb_parallel_reduce_func_t reduce, tb_parallel_join_func_t join, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) && reduce && join, init);
+
+    // null?
+    tb_check_return_val(head < tail, init);
+
+    // the grain and ranges count
+    if (!grain) grain = tb_parallel_grain(tail - head, TB_PARALLEL_GRAIN_MIN);
+    tb_size_t count = (tail - head + grain - 1) / grain;
+
+    // make the reduced values
+    tb_parallel_reduce_t parallel = {iterator, reduce, priv, tb_null};
+    parallel.values = count > 1? tb_nalloc_type(count, tb_hong_t) : tb_null;
+
+    // only one range or no memory? reduce it directly
+    tb_hong_t value = init;
+    if (!parallel.values)
+    {
+        tb_size_t range_head = head;
+        for (range_head = head; range_head < tail; range_head += tb_min(grain, tail - range_head))
+            value = join(value, reduce(iterator, range_head, range_head + tb_min(grain, tail - range_head), priv), priv);
+        return value;
+    }
+
+    // reduce all ranges
+    tb_parallel_done(head, tail, grain, tb_parallel_reduce_func, &parallel);
+
+    // join them in order
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) value = join(value, parallel.values[i], priv);
+
+    // exit the reduced values
+    tb_free(parallel.values);
+
+    // ok
+    return value;
+}
+tb_hong_t tb_parallel_reduce_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_hong_t init, tb_parallel_reduce_func_t reduce, tb_parallel_join_func_t join, tb_cpointer_t priv)
+{
+    return tb_parallel_reduce(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), grain, init, reduce, join, priv);
+}
+tb_void_t tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+
+    // no elements?
+    tb_check_return(head < tail);
+
+    // readonly?
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+
+    // the comparer
+    if (!comp) comp = tb_iterator_comp;
+
+    // the sorted range size, using one range for each processor by default
+    tb_size_t size = tail - head;
+    tb_size_t width = grain;
+    if (!width)
+    {
+        tb_size_t ranges = tb_processor_count();
+        width = (size + ranges - 1) / ranges;
+        width = tb_max(width, TB_PARALLEL_SORT_GRAIN_MIN);
+    }
+
+    // init sort
+    tb_parallel_sort_t sort = {0};
+    sort.iterator   = iterator;
+    sort.head       = head;
+    sort.size       = size;
+    sort.comp       = comp;
+    sort.step       = tb_iterator_step(iterator);
+
+    // make the temporary items if there are some ranges
+    if (width < size) sort.temp = (tb_byte_t*)tb_nalloc(size, tb_max(sort.step, sizeof(tb_pointer_t)));
+
+    // only one range or no memory? sort it directly
+    if (!sort.temp)
+    {
+        tb_sort(iterator, head, tail, comp);
+        return ;
+    }
+
+    // sort all ranges
+    tb_parallel_done(0, size, width, tb_parallel_sort_func, &sort);
+
+    // merge the sorted runs until only one run is left
+    tb_size_t merge_grain = tb_parallel_grain(size, TB_PARALLEL_GRAIN_MIN);
+    for (sort.width = width; sort.width < size; sort.width <<= 1, sort.from_temp = !sort.from_temp)
+        tb_parallel_done(0, size, merge_grain, tb_parallel_sort_merge_func, &sort);
+
+    // copy the temporary items to the iterator
+    if (sort.from_temp) tb_parallel_done(0, size, merge_grain, tb_parallel_sort_copy_func, &sort);
+
+    // exit the temporary items
+    tb_free(sort.temp);
+}
+tb_void_t tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_iterator_comp_t comp)
+{
+    tb_parallel_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), grain, comp);
+}
@@ -0,0 +1,213 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_PARALLEL_H
+#define TB_ALGORITHM_PARALLEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "walk.h"
+#include "predicate.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the parallel func type 
+ *
+ * @param iterator  the iterator
+ * @param head      the range head
+ * @param tail      the range tail
+ * @param priv      the func private data
+ *
+ * @return          tb_false if the remaining ranges need not be done
+ */
+typedef tb_bool_t   (*tb_parallel_func_t)(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_cpointer_t priv);
+
+/*! the parallel reduce func type 
+ *
+ * @param iterator  the iterator
+ * @param head      the range head
+ * @param tail      the range tail
+ * @param priv      the func private data
+ *
+ * @return          the reduced value of this range
+ */
+typedef tb_hong_t   (*tb_parallel_reduce_func_t)(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_cpointer_t priv);
+
+/*! the parallel join func type, it must be associative
+ *
+ * @param left      the reduced value of the left ranges
+ * @param right     the reduced value of the right range
+ * @param priv      the func private data
+ *
+ * @return          the joined value
+ */
+typedef tb_hong_t   (*tb_parallel_join_func_t)(tb_hong_t left, tb_hong_t right, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! done the ranges in parallel
+ *
+ * the items of the random access iterator are partitioned to the ranges of grain items, 
+ * and these ranges are done by the current thread and the workers of tb_thread_pool().
+ *
+ * @note the ranges may be done in any order, and this function will not return until all ranges have been done
+ *
+ * @param iterator  the random access iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param func      the range func
+ * @param priv      the func private data
+ */
+tb_void_t           tb_parallel_for(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_parallel_func_t func, tb_cpointer_t priv);
+
+/*! done the ranges in parallel for all
+ *
+ * @param iterator  the random access iterator
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param func      the range func
+ * @param priv      the func private data
+ */
+tb_void_t           tb_parallel_for_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_parallel_func_t func, tb_cpointer_t priv);
+
+/*! the parallel walker
+ *
+ * @note the items may be walked in any order, 
+ * and the remaining ranges will not be walked if the walker func returns tb_false
+ *
+ * @param iterator  the random access iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param func      the walker func
+ * @param priv      the func private data
+ *
+ * @return          the item count
+ */
+tb_size_t           tb_parallel_walk(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_walk_func_t func, tb_cpointer_t priv);
+
+/*! the parallel walker for all
+ *
+ * @param iterator  the random access iterator
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param func      the walker func
+ * @param priv      the func private data
+ *
+ * @return          the item count
+ */
+tb_size_t           tb_parallel_walk_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_walk_func_t func, tb_cpointer_t priv);
+
+/*! count items in parallel
+ *
+ * @param iterator  the random access iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param pred      the predicate
+ * @param value     the value of the predicate
+ *
+ * @return          the real count
+ */
+tb_size_t           tb_parallel_count_if(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_predicate_ref_t pred, tb_cpointer_t value);
+
+/*! count items in parallel for all
+ *
+ * @param iterator  the random access iterator
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param pred      the predicate
+ * @param value     the value of the predicate
+ *
+ * @return          the real count
+ */
+tb_size_t           tb_parallel_count_all_if(tb_iterator_ref_t iterator, tb_size_t grain, tb_predicate_ref_t pred, tb_cpointer_t value);
+
+/*! reduce items in parallel
+ *
+ * the reduced values of all ranges are joined in the order of ranges, 
+ * so the join func need be associative but need not be commutative.
+ *
+ * @param iterator  the random access iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param init      the initial value 
+ * @param reduce    the reduce func
+ * @param join      the join func
+ * @param priv      the func private data
+ *
+ * @return          the reduced value
+ */
+tb_hong_t           tb_parallel_reduce(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_hong_t init, tb_parallel_reduce_func_t reduce, tb_parallel_join_func_t join, tb_cpointer_t priv);
+
+/*! reduce items in parallel for all
+ *
+ * @param iterator  the random access iterator
+ * @param grain     the items count of each range, using the default grain if be zero
+ * @param init      the initial value 
+ * @param reduce    the reduce func
+ * @param join      the join func
+ * @param priv      the func private data
+ *
+ * @return          the reduced value
+ */
+tb_hong_t           tb_parallel_reduce_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_hong_t init, tb_parallel_reduce_func_t reduce, tb_parallel_join_func_t join, tb_cpointer_t priv);
+
+/*! the parallel sorter
+ *
+ * sort the ranges in parallel first, and merge them in parallel, 
+ * it need the temporary buffer of all items, and it is not stable.
+ *
+ * @param iterator  the random access iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param grain     the items count of each sorted range, using the default grain if be zero
+ * @param comp      the comparer
+ */
+tb_void_t           tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t grain, tb_iterator_comp_t comp);
+
+/*! the parallel sorter for all
+ *
+ * @param iterator  the random access iterator
+ * @param grain     the items count of each sorted range, using the default grain if be zero
+ * @param comp      the comparer
+ */
+tb_void_t           tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_size_t grain, tb_iterator_comp_t comp);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -0,0 +1,157 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        partial_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "partial_sort.h"
+#include "sort.h"
+#include "nth_element.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum sorted item count (1 / 16 of all items) for selecting them by the heap
+#define TB_PARTIAL_SORT_HEAP_SIZE(n)    ((n) >> 4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_partial_sort_heap_adjust(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t hole, tb_size_t size, tb_cpointer_t item, tb_iterator_comp_t comp)
+{
+    // walk, 2 * hole + 1: the left child node of hole
+    tb_size_t       child = (hole << 1) + 1;
+    tb_cpointer_t   child_item = tb_null;
+    tb_cpointer_t   child_item_r = tb_null;
+    for (; child < size; child = (child << 1) + 1)
+    {
+        // the larger child node
+        child_item = tb_iterator_item(iterator, head + child);
+        if (child + 1 < size && comp(iterator, child_item, (child_item_r = tb_iterator_item(iterator, head + child + 1))) < 0)
+        {
+            child++;
+            child_item = child_item_r;
+        }
+
+        // end?
+        if (comp(iterator, child_item, item) <= 0) break;
+
+        // the larger child node => hole
+        tb_iterator_copy(iterator, head + hole, child_item);
+
+        // move the hole down to it's larger child node 
+        hole = child;
+    }
+
+    // copy item
+    tb_iterator_copy(iterator, head + hole, item);
+}
+/* select the smallest size items into the max heap at [head, head + size)
+ *
+ * it only compares the most items with the heap top once, so it's faster than 
+ * the nth element selector if only a few items are needed, e.g. the top 100 items of 10M items
+ */
+static tb_bool_t tb_partial_sort_heap_select(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t size, tb_iterator_comp_t comp)
+{
+    // init
+    tb_size_t       step = tb_iterator_step(iterator);
+    tb_pointer_t    temp = step > sizeof(tb_pointer_t)? tb_malloc(step) : tb_null;
+    tb_check_return_val(step <= sizeof(tb_pointer_t) || temp, tb_false);
+
+    // make heap
+    tb_size_t hole;
+    tb_pointer_t item = temp;
+    for (hole = size >> 1; hole > 0; )
+    {
+        --hole;
+
+        // save hole
+        if (step <= sizeof(tb_pointer_t)) item = tb_iterator_item(iterator, head + hole);
+        else tb_memcpy(temp, tb_iterator_item(iterator, head + hole), step);
+
+        // reheap top half, bottom to top
+        tb_partial_sort_heap_adjust(iterator, head, hole, size, item, comp);
+    }
+
+    // replace the heap top if the item is less than it
+    tb_size_t itor;
+    for (itor = head + size; itor < tail; itor++)
+    {
+        // less than the heap top?
+        tb_pointer_t top = tb_iterator_item(iterator, head);
+        if (comp(iterator, tb_iterator_item(iterator, itor), top) >= 0) continue;
+
+        // save this item
+        if (step <= sizeof(tb_pointer_t)) item = tb_iterator_item(iterator, itor);
+        else tb_memcpy(temp, tb_iterator_item(iterator, itor), step);
+
+        // the heap top => this item and reheap it
+        tb_iterator_copy(iterator, itor, top);
+        tb_partial_sort_heap_adjust(iterator, head, 0, size, item, comp);
+    }
+
+    // free
+    if (temp) tb_free(temp);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_partial_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t size, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+    tb_check_return(head != tail && size);
+
+    // sort all items?
+    tb_size_t count = tail - head;
+    if (size >= count) 
+    {
+        tb_sort(iterator, head, tail, comp);
+        return ;
+    }
+
+    /* select the smallest items
+     *
+     * only a few items? select them by the heap, otherwise use the nth element selector 
+     * which also selects the contiguous integer items directly
+     */
+    if (size > TB_PARTIAL_SORT_HEAP_SIZE(count) || !tb_partial_sort_heap_select(iterator, head, tail, size, comp? comp : tb_iterator_comp))
+        tb_nth_element(iterator, head, tail, size, comp);
+
+    // sort the selected items
+    tb_sort(iterator, head, head + size, comp);
+}
+tb_void_t tb_partial_sort_all(tb_iterator_ref_t iterator, tb_size_t size, tb_iterator_comp_t comp)
+{
+    tb_partial_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), size, comp);
+}
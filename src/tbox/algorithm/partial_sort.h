@@ -0,0 +1,74 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        partial_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_PARTIAL_SORT_H
+#define TB_ALGORITHM_PARTIAL_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the partial sorter, O(nlog(size)) 
+ *
+ * the smallest size items will be sorted and placed at [head, head + size), 
+ * the order of the other items is unspecified.
+ *
+ * e.g. get the top 100 items of the large vector
+ *
+ * @code
+ * tb_partial_sort_all(vector, 100, tb_null);
+ * @endcode
+ *
+ * @param iterator  the iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param size      the sorted item count
+ * @param comp      the comparer
+ */
+tb_void_t           tb_partial_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_size_t size, tb_iterator_comp_t comp);
+
+/*! the partial sorter for all
+ *
+ * @param iterator  the iterator
+ * @param size      the sorted item count
+ * @param comp      the comparer
+ */
+tb_void_t           tb_partial_sort_all(tb_iterator_ref_t iterator, tb_size_t size, tb_iterator_comp_t comp);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
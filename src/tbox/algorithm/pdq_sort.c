@@ -0,0 +1,368 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pdq_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pdq_sort.h"
+#include "heap_sort.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the partitions below this size are sorted using the insertion sort
+#define TB_PDQ_SORT_INSERTION_SORT_THRESHOLD        (24)
+
+// the partitions above this size use the ninther to select the pivot
+#define TB_PDQ_SORT_NINTHER_THRESHOLD               (128)
+
+// the maximum moved items for the partial insertion sort before it gives up
+#define TB_PDQ_SORT_PARTIAL_INSERTION_SORT_LIMIT    (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the pdq sorter type
+typedef struct __tb_pdq_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the item step
+    tb_size_t               step;
+
+    // the pivot buffer for the large items
+    tb_byte_t*              pivot;
+
+    // the temporary buffer for the large items
+    tb_byte_t*              temp;
+
+}tb_pdq_sort_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t tb_pdq_sort_less(tb_pdq_sort_t* sort, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return sort->comp(sort->iterator, litem, ritem) < 0;
+}
+static __tb_inline__ tb_pointer_t tb_pdq_sort_item(tb_pdq_sort_t* sort, tb_size_t itor)
+{
+    return tb_iterator_item(sort->iterator, itor);
+}
+static __tb_inline__ tb_cpointer_t tb_pdq_sort_save(tb_pdq_sort_t* sort, tb_size_t itor, tb_byte_t* buffer)
+{
+    // the item value or the item address
+    tb_pointer_t item = tb_iterator_item(sort->iterator, itor);
+    tb_check_return_val(sort->step > sizeof(tb_pointer_t), item);
+
+    // save the large item
+    tb_memcpy(buffer, item, sort->step);
+    return buffer;
+}
+static __tb_inline__ tb_void_t tb_pdq_sort_swap(tb_pdq_sort_t* sort, tb_size_t litor, tb_size_t ritor)
+{
+    tb_cpointer_t item = tb_pdq_sort_save(sort, litor, sort->temp);
+    tb_iterator_copy(sort->iterator, litor, tb_pdq_sort_item(sort, ritor));
+    tb_iterator_copy(sort->iterator, ritor, item);
+}
+static __tb_inline__ tb_void_t tb_pdq_sort_sort2(tb_pdq_sort_t* sort, tb_size_t a, tb_size_t b)
+{
+    if (tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, b), tb_pdq_sort_item(sort, a))) tb_pdq_sort_swap(sort, a, b);
+}
+static __tb_inline__ tb_void_t tb_pdq_sort_sort3(tb_pdq_sort_t* sort, tb_size_t a, tb_size_t b, tb_size_t c)
+{
+    tb_pdq_sort_sort2(sort, a, b);
+    tb_pdq_sort_sort2(sort, b, c);
+    tb_pdq_sort_sort2(sort, a, b);
+}
+static tb_void_t tb_pdq_sort_insertion_sort(tb_pdq_sort_t* sort, tb_size_t head, tb_size_t tail, tb_bool_t leftmost)
+{
+    // done
+    tb_size_t i;
+    for (i = head + 1; i < tail; i++)
+    {
+        // this item is not less than the previous item? continue it
+        if (!tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, i), tb_pdq_sort_item(sort, i - 1))) continue;
+
+        // save this item
+        tb_cpointer_t item = tb_pdq_sort_save(sort, i, sort->temp);
+
+        /* move the larger items to the right
+         *
+         * the previous item of this partition is not larger than all items if it's not the leftmost partition,
+         * so we need not check the bounds
+         */
+        tb_size_t j = i;
+        do
+        {
+            tb_iterator_copy(sort->iterator, j, tb_pdq_sort_item(sort, j - 1));
+            j--;
+
+        } while ((!leftmost || j > head) && tb_pdq_sort_less(sort, item, tb_pdq_sort_item(sort, j - 1)));
+
+        // insert this item
+        tb_iterator_copy(sort->iterator, j, item);
+    }
+}
+static tb_bool_t tb_pdq_sort_partial_insertion_sort(tb_pdq_sort_t* sort, tb_size_t head, tb_size_t tail)
+{
+    // done
+    tb_size_t i;
+    tb_size_t moved = 0;
+    for (i = head + 1; i < tail; i++)
+    {
+        // this item is not less than the previous item? continue it
+        if (!tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, i), tb_pdq_sort_item(sort, i - 1))) continue;
+
+        // insert this item
+        tb_size_t       j = i;
+        tb_cpointer_t   item = tb_pdq_sort_save(sort, i, sort->temp);
+        do
+        {
+            tb_iterator_copy(sort->iterator, j, tb_pdq_sort_item(sort, j - 1));
+            j--;
+
+        } while (j > head && tb_pdq_sort_less(sort, item, tb_pdq_sort_item(sort, j - 1)));
+        tb_iterator_copy(sort->iterator, j, item);
+
+        // too many moved items? give up
+        moved += i - j;
+        if (moved > TB_PDQ_SORT_PARTIAL_INSERTION_SORT_LIMIT) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+/* partition [head, tail) using the pivot at head, the equal items are placed on the right
+ *
+ * <pre>
+ * [ < pivot ] [pivot] [ >= pivot ]
+ * </pre>
+ */
+static tb_size_t tb_pdq_sort_partition_right(tb_pdq_sort_t* sort, tb_size_t head, tb_size_t tail, tb_bool_t* partitioned)
+{
+    // save the pivot
+    tb_cpointer_t pivot = tb_pdq_sort_save(sort, head, sort->pivot);
+
+    // find the first item which is not less than the pivot, the median of 3 guarantees that it exists
+    tb_size_t first = head;
+    tb_size_t last = tail;
+    while (tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, ++first), pivot)) ;
+
+    // find the last item which is less than the pivot, guard it if there is no item less than the pivot
+    if (first - 1 == head) while (first < last && !tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, --last), pivot)) ;
+    else while (!tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, --last), pivot)) ;
+
+    // no items need be swapped? it's already partitioned
+    *partitioned = first >= last;
+
+    // swap the misplaced items
+    while (first < last)
+    {
+        tb_pdq_sort_swap(sort, first, last);
+        while (tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, ++first), pivot)) ;
+        while (!tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, --last), pivot)) ;
+    }
+
+    // move the pivot to its final position
+    tb_size_t pivot_pos = first - 1;
+    if (pivot_pos != head)
+    {
+        tb_iterator_copy(sort->iterator, head, tb_pdq_sort_item(sort, pivot_pos));
+        tb_iterator_copy(sort->iterator, pivot_pos, pivot);
+    }
+    return pivot_pos;
+}
+/* partition [head, tail) using the pivot at head, the equal items are placed on the left
+ *
+ * it is used if the pivot is equal to the previous item of this partition, 
+ * so all equal items will be skipped at once and the many duplicate items only cost O(n)
+ *
+ * <pre>
+ * [ <= pivot ] [pivot] [ > pivot ]
+ * </pre>
+ */
+static tb_size_t tb_pdq_sort_partition_left(tb_pdq_sort_t* sort, tb_size_t head, tb_size_t tail)
+{
+    // save the pivot
+    tb_cpointer_t pivot = tb_pdq_sort_save(sort, head, sort->pivot);
+
+    // find the last item which is not larger than the pivot
+    tb_size_t first = head;
+    tb_size_t last = tail;
+    while (tb_pdq_sort_less(sort, pivot, tb_pdq_sort_item(sort, --last))) ;
+
+    // find the first item which is larger than the pivot
+    if (last + 1 == tail) while (first < last && !tb_pdq_sort_less(sort, pivot, tb_pdq_sort_item(sort, ++first))) ;
+    else while (!tb_pdq_sort_less(sort, pivot, tb_pdq_sort_item(sort, ++first))) ;
+
+    // swap the misplaced items
+    while (first < last)
+    {
+        tb_pdq_sort_swap(sort, first, last);
+        while (tb_pdq_sort_less(sort, pivot, tb_pdq_sort_item(sort, --last))) ;
+        while (!tb_pdq_sort_less(sort, pivot, tb_pdq_sort_item(sort, ++first))) ;
+    }
+
+    // move the pivot to its final position
+    tb_size_t pivot_pos = last;
+    if (pivot_pos != head)
+    {
+        tb_iterator_copy(sort->iterator, head, tb_pdq_sort_item(sort, pivot_pos));
+        tb_iterator_copy(sort->iterator, pivot_pos, pivot);
+    }
+    return pivot_pos;
+}
+static tb_void_t tb_pdq_sort_shuffle(tb_pdq_sort_t* sort, tb_size_t head, tb_size_t tail)
+{
+    // break the patterns by swapping the items at the quarters of this partition
+    tb_size_t size = tail - head;
+    tb_size_t quarter = size >> 2;
+    tb_pdq_sort_swap(sort, head, head + quarter);
+    tb_pdq_sort_swap(sort, tail - 1, tail - quarter);
+    if (size > TB_PDQ_SORT_NINTHER_THRESHOLD)
+    {
+        tb_pdq_sort_swap(sort, head + 1, head + quarter + 1);
+        tb_pdq_sort_swap(sort, head + 2, head + quarter + 2);
+        tb_pdq_sort_swap(sort, tail - 2, tail - quarter - 1);
+        tb_pdq_sort_swap(sort, tail - 3, tail - quarter - 2);
+    }
+}
+static tb_void_t tb_pdq_sort_loop(tb_pdq_sort_t* sort, tb_size_t head, tb_size_t tail, tb_size_t bad_allowed, tb_bool_t leftmost)
+{
+    while (1)
+    {
+        // the small partition? sort it using the insertion sort
+        tb_size_t size = tail - head;
+        if (size < TB_PDQ_SORT_INSERTION_SORT_THRESHOLD)
+        {
+            tb_pdq_sort_insertion_sort(sort, head, tail, leftmost);
+            return ;
+        }
+
+        // select the pivot using the median of 3 or the ninther and move it to head
+        tb_size_t half = size >> 1;
+        if (size > TB_PDQ_SORT_NINTHER_THRESHOLD)
+        {
+            tb_pdq_sort_sort3(sort, head, head + half, tail - 1);
+            tb_pdq_sort_sort3(sort, head + 1, head + half - 1, tail - 2);
+            tb_pdq_sort_sort3(sort, head + 2, head + half + 1, tail - 3);
+            tb_pdq_sort_sort3(sort, head + half - 1, head + half, head + half + 1);
+            tb_pdq_sort_swap(sort, head, head + half);
+        }
+        else tb_pdq_sort_sort3(sort, head + half, head, tail - 1);
+
+        // the pivot is equal to the previous item? all equal items can be placed on the left at once
+        if (!leftmost && !tb_pdq_sort_less(sort, tb_pdq_sort_item(sort, head - 1), tb_pdq_sort_item(sort, head)))
+        {
+            head = tb_pdq_sort_partition_left(sort, head, tail) + 1;
+            continue;
+        }
+
+        // partition it
+        tb_bool_t partitioned = tb_false;
+        tb_size_t pivot_pos = tb_pdq_sort_partition_right(sort, head, tail, &partitioned);
+
+        // the partition is highly unbalanced?
+        tb_size_t lsize = pivot_pos - head;
+        tb_size_t rsize = tail - pivot_pos - 1;
+        if (lsize < (size >> 3) || rsize < (size >> 3))
+        {
+            // too many bad partitions? fall back to the heap sort
+            if (!--bad_allowed)
+            {
+                tb_heap_sort(sort->iterator, head, tail, sort->comp);
+                return ;
+            }
+
+            // break the patterns
+            if (lsize >= TB_PDQ_SORT_INSERTION_SORT_THRESHOLD) tb_pdq_sort_shuffle(sort, head, pivot_pos);
+            if (rsize >= TB_PDQ_SORT_INSERTION_SORT_THRESHOLD) tb_pdq_sort_shuffle(sort, pivot_pos + 1, tail);
+        }
+        // it was already partitioned? try to sort it using the partial insertion sort, e.g. the sorted items
+        else if (partitioned && tb_pdq_sort_partial_insertion_sort(sort, head, pivot_pos) 
+                && tb_pdq_sort_partial_insertion_sort(sort, pivot_pos + 1, tail))
+            return ;
+
+        // sort the smaller partition recursively and loop for the larger partition, the stack depth is O(log(n))
+        if (lsize < rsize)
+        {
+            tb_pdq_sort_loop(sort, head, pivot_pos, bad_allowed, leftmost);
+            head = pivot_pos + 1;
+            leftmost = tb_false;
+        }
+        else
+        {
+            tb_pdq_sort_loop(sort, pivot_pos + 1, tail, bad_allowed, tb_false);
+            tail = pivot_pos;
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_pdq_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_check_return(head != tail);
+
+    // init sorter
+    tb_pdq_sort_t sort;
+    sort.iterator   = iterator;
+    sort.comp       = comp? comp : tb_iterator_comp;
+    sort.step       = tb_iterator_step(iterator);
+    sort.pivot      = sort.step > sizeof(tb_pointer_t)? (tb_byte_t*)tb_malloc(sort.step << 1) : tb_null;
+    sort.temp       = sort.pivot? sort.pivot + sort.step : tb_null;
+    tb_assert_and_check_return(sort.step <= sizeof(tb_pointer_t) || sort.pivot);
+
+    // the allowed bad partitions: log2(n)
+    tb_size_t size = tail - head;
+    tb_size_t bad_allowed = 0;
+    while (size) 
+    {
+        bad_allowed++;
+        size >>= 1;
+    }
+
+    // sort it
+    tb_pdq_sort_loop(&sort, head, tail, bad_allowed, tb_true);
+
+    // free
+    if (sort.pivot) tb_free(sort.pivot);
+}
+tb_void_t tb_pdq_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_pdq_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
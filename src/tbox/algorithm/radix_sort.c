@@ -0,0 +1,189 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        radix_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "radix_sort.h"
+#include "../libc/libc.h"
+#include "../container/element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! make the lsd radix sorter with 8-bits digits for the given integer width
+ *
+ * the digit histograms are counted in one pass and the digit pass will be skipped 
+ * if all items have the same digit, e.g. the high bytes of the small values
+ *
+ * the sign bit is flipped for the signed items, so the negative values will be placed first
+ */
+#define tb_radix_sort_make(bits) \
+static tb_bool_t tb_radix_sort_u##bits(tb_uint##bits##_t* items, tb_size_t count, tb_bool_t sign) \
+{ \
+    /* make the counts and the temporary items */ \
+    tb_size_t const     digits = bits >> 3; \
+    tb_size_t*          counts = (tb_size_t*)tb_malloc(digits * 256 * sizeof(tb_size_t) + count * sizeof(tb_uint##bits##_t)); \
+    tb_check_return_val(counts, tb_false); \
+    tb_memset(counts, 0, digits * 256 * sizeof(tb_size_t)); \
+    \
+    /* the key flag */ \
+    tb_uint##bits##_t   flag = sign? ((tb_uint##bits##_t)1 << (bits - 1)) : 0; \
+    \
+    /* count the histograms of all digits */ \
+    tb_size_t i = 0; \
+    tb_size_t d = 0; \
+    for (i = 0; i < count; i++) \
+    { \
+        tb_uint##bits##_t key = items[i] ^ flag; \
+        for (d = 0; d < digits; d++, key >>= 8) counts[(d << 8) + (key & 0xff)]++; \
+    } \
+    \
+    /* sort all digits from the low byte to the high byte */ \
+    tb_uint##bits##_t*  src = items; \
+    tb_uint##bits##_t*  dst = (tb_uint##bits##_t*)(counts + digits * 256); \
+    for (d = 0; d < digits; d++) \
+    { \
+        /* all items have the same digit? skip it */ \
+        tb_size_t           shift = d << 3; \
+        tb_size_t*          offsets = counts + (d << 8); \
+        if (offsets[((items[0] ^ flag) >> shift) & 0xff] == count) continue; \
+        \
+        /* the counts => the offsets */ \
+        tb_size_t offset = 0; \
+        for (i = 0; i < 256; i++) \
+        { \
+            tb_size_t n = offsets[i]; \
+            offsets[i] = offset; \
+            offset += n; \
+        } \
+        \
+        /* scatter the items */ \
+        for (i = 0; i < count; i++) \
+        { \
+            tb_uint##bits##_t item = src[i]; \
+            dst[offsets[((item ^ flag) >> shift) & 0xff]++] = item; \
+        } \
+        \
+        /* swap the buffers */ \
+        tb_uint##bits##_t* temp = src; \
+        src = dst; \
+        dst = temp; \
+    } \
+    \
+    /* the sorted items are in the temporary items? copy them back */ \
+    if (src != items) tb_memcpy(items, src, count * sizeof(tb_uint##bits##_t)); \
+    \
+    /* exit the counts and the temporary items */ \
+    tb_free(counts); \
+    \
+    /* ok */ \
+    return tb_true; \
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_radix_sort_u8(tb_uint8_t* items, tb_size_t count, tb_bool_t sign)
+{
+    // count all items
+    tb_size_t i = 0;
+    tb_size_t counts[256] = {0};
+    for (i = 0; i < count; i++) counts[items[i]]++;
+
+    // fill all items, the negative values are placed first for the signed items
+    tb_size_t flag = sign? 0x80 : 0;
+    for (i = 0; i < 256; i++)
+    {
+        tb_size_t value = i ^ flag;
+        tb_memset(items, (tb_int_t)value, counts[value]);
+        items += counts[value];
+    }
+
+    // ok
+    return tb_true;
+}
+tb_radix_sort_make(16)
+tb_radix_sort_make(32)
+tb_radix_sort_make(64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail)
+{
+    // check
+    tb_assert_and_check_return_val(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS), tb_false);
+    tb_assert_and_check_return_val(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY), tb_false);
+
+    // get the contiguous integer items
+    tb_size_t       type = TB_ELEMENT_TYPE_NULL;
+    tb_byte_t*      data = (tb_byte_t*)tb_iterator_data(iterator, &type);
+    tb_check_return_val(data, tb_false);
+
+    // the item size must be the width of this integer type
+    tb_size_t       step = tb_iterator_step(iterator);
+    switch (type)
+    {
+    case TB_ELEMENT_TYPE_LONG:      tb_check_return_val(step == sizeof(tb_long_t), tb_false);   break;
+    case TB_ELEMENT_TYPE_SIZE:      tb_check_return_val(step == sizeof(tb_size_t), tb_false);   break;
+    case TB_ELEMENT_TYPE_UINT8:     tb_check_return_val(step == sizeof(tb_uint8_t), tb_false);  break;
+    case TB_ELEMENT_TYPE_UINT16:    tb_check_return_val(step == sizeof(tb_uint16_t), tb_false); break;
+    case TB_ELEMENT_TYPE_UINT32:    tb_check_return_val(step == sizeof(tb_uint32_t), tb_false); break;
+    default:                        return tb_false;
+    }
+
+    // sort them
+    tb_check_return_val(tail > head + 1, tb_true);
+    return tb_radix_sort_items(data + head * step, tail - head, step, type == TB_ELEMENT_TYPE_LONG);
+}
+tb_bool_t tb_radix_sort_all(tb_iterator_ref_t iterator)
+{
+    return tb_radix_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator));
+}
+tb_bool_t tb_radix_sort_items(tb_pointer_t items, tb_size_t count, tb_size_t size, tb_bool_t sign)
+{
+    // check
+    tb_assert_and_check_return_val(items || !count, tb_false);
+
+    // no items?
+    tb_check_return_val(count > 1, tb_true);
+
+    // sort them
+    tb_bool_t ok = tb_false;
+    switch (size)
+    {
+    case 1: ok = tb_radix_sort_u8((tb_uint8_t*)items, count, sign);      break;
+    case 2: ok = tb_radix_sort_u16((tb_uint16_t*)items, count, sign);    break;
+    case 4: ok = tb_radix_sort_u32((tb_uint32_t*)items, count, sign);    break;
+    case 8: ok = tb_radix_sort_u64((tb_uint64_t*)items, count, sign);    break;
+    default: break;
+    }
+
+    // ok?
+    return ok;
+}
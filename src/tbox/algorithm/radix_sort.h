@@ -0,0 +1,79 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        radix_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_RADIX_SORT_H
+#define TB_ALGORITHM_RADIX_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the radix sorter for the integer items, O(n)
+ *
+ * only the iterator which provides the contiguous integer items by tb_iterator_data()
+ * can be sorted, the items will be sorted by the natural order of their values
+ *
+ * @param iterator  the iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ *
+ * @return          tb_true or tb_false if the items are not supported or no memory
+ */
+tb_bool_t           tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail);
+
+/*! the radix sorter for all integer items
+ *
+ * @param iterator  the iterator
+ *
+ * @return          tb_true or tb_false if the items are not supported or no memory
+ */
+tb_bool_t           tb_radix_sort_all(tb_iterator_ref_t iterator);
+
+/*! the radix sorter for the integer items of the plain array, O(n)
+ *
+ * @param items     the items
+ * @param count     the item count
+ * @param size      the item size, it must be 1, 2, 4 or 8 bytes
+ * @param sign      is the signed integer?
+ *
+ * @return          tb_true or tb_false if the item size is not supported or no memory
+ */
+tb_bool_t           tb_radix_sort_items(tb_pointer_t items, tb_size_t count, tb_size_t size, tb_bool_t sign);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -29,12 +29,67 @@
  */
 #include "sort.h"
 #include "distance.h"
+#include "pdq_sort.h"
 #include "heap_sort.h"
+#include "radix_sort.h"
 #include "quick_sort.h"
 #include "insert_sort.h"
 #include "bubble_sort.h"
 #include "../libc/libc.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum item count for the radix sort, the pdq sort is faster for the less items
+#define TB_SORT_RADIX_MINN      (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifndef TB_CONFIG_MICRO_ENABLE
+/* the integer items have been sorted or reversed? 
+ *
+ * the radix sort is much slower than the pdq sort for the presorted items,
+ * so we check them first, it will be broken quickly for the random items.
+ *
+ * @return      1: sorted, -1: reversed and they have been reversed to the sorted order, 0: unsorted
+ */
+static tb_long_t tb_sort_presorted(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail)
+{
+    // find the order of the first unequal items
+    tb_size_t       prev = head;
+    tb_size_t       itor = tb_iterator_next(iterator, head);
+    tb_long_t       order = 0;
+    for (; itor != tail && !order; prev = itor, itor = tb_iterator_next(iterator, itor))
+        order = tb_iterator_comp(iterator, tb_iterator_item(iterator, prev), tb_iterator_item(iterator, itor));
+
+    // check the order of the left items
+    for (; itor != tail; prev = itor, itor = tb_iterator_next(iterator, itor))
+    {
+        tb_long_t r = tb_iterator_comp(iterator, tb_iterator_item(iterator, prev), tb_iterator_item(iterator, itor));
+        if ((order < 0 && r > 0) || (order > 0 && r < 0)) return 0;
+    }
+
+    // sorted?
+    tb_check_return_val(order > 0, 1);
+
+    // reverse them, the integer items are copied by value
+    tb_size_t l = head;
+    tb_size_t r = tb_iterator_prev(iterator, tail);
+    while (l != r)
+    {
+        tb_pointer_t temp = tb_iterator_item(iterator, l);
+        tb_iterator_copy(iterator, l, tb_iterator_item(iterator, r));
+        tb_iterator_copy(iterator, r, temp);
+        l = tb_iterator_next(iterator, l);
+        if (l == r) break;
+        r = tb_iterator_prev(iterator, r);
+    }
+    return -1;
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -59,8 +114,18 @@ tb_void_t tb_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb
     // random access iterator? 
     if (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) 
     {
-        if (tb_distance(iterator, head, tail) > 100000) tb_heap_sort(iterator, head, tail, comp);
-        else tb_quick_sort(iterator, head, tail, comp); //!< @note the recursive stack size is limit
+        // the element type of the contiguous integer items
+        tb_size_t type = TB_ELEMENT_TYPE_NULL;
+
+        // the many contiguous integer items with the natural order? sort them using the radix sort if they are not presorted
+        if (    (!comp || comp == tb_iterator_comp) 
+            &&  tb_distance(iterator, head, tail) >= TB_SORT_RADIX_MINN 
+            &&  tb_iterator_data(iterator, &type)
+            &&  (tb_sort_presorted(iterator, head, tail) || tb_radix_sort(iterator, head, tail))) 
+            return ;
+
+        // sort it using the pdq sort, the recursive stack depth is only O(log(n))
+        tb_pdq_sort(iterator, head, tail, comp);
     }
     else tb_bubble_sort(iterator, head, tail, comp);
 #endif
@@ -0,0 +1,263 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stable_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "stable_sort.h"
+#include "sort.h"
+#include "insert_sort.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the ranges below this size are sorted using the insertion sort
+#define TB_STABLE_SORT_INSERTION_SORT_THRESHOLD     (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the stable sorter type
+typedef struct __tb_stable_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the item step
+    tb_size_t               step;
+
+    // the merge buffer, the items are saved by value if step <= sizeof(tb_pointer_t)
+    tb_byte_t*              buffer;
+
+    // the temporary buffer for the insertion sort
+    tb_byte_t*              temp;
+
+}tb_stable_sort_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t tb_stable_sort_less(tb_stable_sort_t* sort, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return sort->comp(sort->iterator, litem, ritem) < 0;
+}
+static __tb_inline__ tb_pointer_t tb_stable_sort_item(tb_stable_sort_t* sort, tb_size_t itor)
+{
+    return tb_iterator_item(sort->iterator, itor);
+}
+static __tb_inline__ tb_cpointer_t tb_stable_sort_save(tb_stable_sort_t* sort, tb_size_t itor, tb_byte_t* buffer)
+{
+    // the item value or the item address
+    tb_pointer_t item = tb_iterator_item(sort->iterator, itor);
+    if (sort->step <= sizeof(tb_pointer_t))
+    {
+        *((tb_pointer_t*)buffer) = item;
+        return item;
+    }
+
+    // save the large item
+    tb_memcpy(buffer, item, sort->step);
+    return buffer;
+}
+static __tb_inline__ tb_cpointer_t tb_stable_sort_saved(tb_stable_sort_t* sort, tb_byte_t* buffer)
+{
+    return sort->step <= sizeof(tb_pointer_t)? *((tb_pointer_t*)buffer) : (tb_cpointer_t)buffer;
+}
+static tb_void_t tb_stable_sort_insertion_sort(tb_stable_sort_t* sort, tb_size_t head, tb_size_t tail)
+{
+    // done
+    tb_size_t i;
+    for (i = head + 1; i < tail; i++)
+    {
+        // this item is not less than the previous item? continue it, the equal items will not be moved
+        if (!tb_stable_sort_less(sort, tb_stable_sort_item(sort, i), tb_stable_sort_item(sort, i - 1))) continue;
+
+        // insert this item
+        tb_size_t       hole = i;
+        tb_cpointer_t   item = tb_stable_sort_save(sort, i, sort->temp);
+        do
+        {
+            tb_iterator_copy(sort->iterator, hole, tb_stable_sort_item(sort, hole - 1));
+            hole--;
+
+        } while (hole > head && tb_stable_sort_less(sort, item, tb_stable_sort_item(sort, hole - 1)));
+        tb_iterator_copy(sort->iterator, hole, item);
+    }
+}
+static tb_void_t tb_stable_sort_reverse(tb_stable_sort_t* sort, tb_size_t head, tb_size_t tail)
+{
+    // reverse the strictly descending items
+    while (head + 1 < tail)
+    {
+        tb_cpointer_t item = tb_stable_sort_save(sort, head, sort->temp);
+        tb_iterator_copy(sort->iterator, head, tb_stable_sort_item(sort, tail - 1));
+        tb_iterator_copy(sort->iterator, tail - 1, item);
+        head++;
+        tail--;
+    }
+}
+/* merge [head, mid) and [mid, tail)
+ *
+ * the left items are moved to the merge buffer, and the left item is taken first if they are equal
+ *
+ * <pre>
+ * [ <= mid ] [ left items ] mid [ right items ] [ >= mid - 1 ]
+ *    skip          |                 |               skip
+ *                buffer ----------> merge
+ * </pre>
+ */
+static tb_void_t tb_stable_sort_merge(tb_stable_sort_t* sort, tb_size_t head, tb_size_t mid, tb_size_t tail)
+{
+    // skip the left items which are not larger than the first right item, they are already placed
+    tb_size_t       l = head;
+    tb_size_t       r = mid;
+    tb_cpointer_t   item = tb_stable_sort_item(sort, mid);
+    while (l < r)
+    {
+        tb_size_t m = l + ((r - l) >> 1);
+        if (tb_stable_sort_less(sort, item, tb_stable_sort_item(sort, m))) r = m;
+        else l = m + 1;
+    }
+    head = l;
+
+    // skip the right items which are not less than the last left item, they are already placed
+    l = mid;
+    r = tail;
+    item = tb_stable_sort_item(sort, mid - 1);
+    while (l < r)
+    {
+        tb_size_t m = l + ((r - l) >> 1);
+        if (tb_stable_sort_less(sort, tb_stable_sort_item(sort, m), item)) l = m + 1;
+        else r = m;
+    }
+    tail = l;
+
+    // move the left items to the merge buffer
+    tb_size_t   i = 0;
+    tb_size_t   size = mid - head;
+    tb_size_t   slot = sort->step <= sizeof(tb_pointer_t)? sizeof(tb_pointer_t) : sort->step;
+    for (i = 0; i < size; i++) tb_stable_sort_save(sort, head + i, sort->buffer + i * slot);
+
+    // merge them
+    tb_size_t   j = mid;
+    tb_size_t   k = head;
+    tb_byte_t*  left = sort->buffer;
+    tb_byte_t*  last = sort->buffer + size * slot;
+    while (left < last && j < tail)
+    {
+        tb_cpointer_t litem = tb_stable_sort_saved(sort, left);
+        tb_cpointer_t ritem = tb_stable_sort_item(sort, j);
+        if (tb_stable_sort_less(sort, ritem, litem)) 
+        {
+            tb_iterator_copy(sort->iterator, k++, ritem);
+            j++;
+        }
+        else
+        {
+            tb_iterator_copy(sort->iterator, k++, litem);
+            left += slot;
+        }
+    }
+
+    // move the left items, the left right items are already placed
+    for (; left < last; left += slot) tb_iterator_copy(sort->iterator, k++, tb_stable_sort_saved(sort, left));
+}
+static tb_void_t tb_stable_sort_done(tb_stable_sort_t* sort, tb_size_t head, tb_size_t tail)
+{
+    // the small range? sort it using the insertion sort
+    if (tail - head <= TB_STABLE_SORT_INSERTION_SORT_THRESHOLD)
+    {
+        tb_stable_sort_insertion_sort(sort, head, tail);
+        return ;
+    }
+
+    // sort the left and right halves
+    tb_size_t mid = head + ((tail - head) >> 1);
+    tb_stable_sort_done(sort, head, mid);
+    tb_stable_sort_done(sort, mid, tail);
+
+    // merge them if they are not in order
+    if (tb_stable_sort_less(sort, tb_stable_sort_item(sort, mid), tb_stable_sort_item(sort, mid - 1)))
+        tb_stable_sort_merge(sort, head, mid, tail);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_stable_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+    tb_check_return(head != tail);
+
+    // the contiguous integer items with the natural order? the equal items cannot be distinguished
+    tb_size_t type = 0;
+    if ((!comp || comp == tb_iterator_comp) && tb_iterator_data(iterator, &type))
+    {
+        tb_sort(iterator, head, tail, comp);
+        return ;
+    }
+
+    // init sorter with the merge buffer of (n / 2) items and the temporary item
+    tb_stable_sort_t sort;
+    sort.iterator   = iterator;
+    sort.comp       = comp? comp : tb_iterator_comp;
+    sort.step       = tb_iterator_step(iterator);
+
+    // make the merge buffer
+    tb_size_t slot  = sort.step <= sizeof(tb_pointer_t)? sizeof(tb_pointer_t) : sort.step;
+    tb_size_t count = ((tail - head) >> 1) + 1;
+    sort.buffer     = (tb_byte_t*)tb_nalloc(count + 1, slot);
+
+    // no memory? sort it using the insertion sort which is also stable
+    if (!sort.buffer)
+    {
+        tb_insert_sort(iterator, head, tail, comp);
+        return ;
+    }
+    sort.temp = sort.buffer + count * slot;
+
+    // the strictly descending items? reverse them
+    tb_size_t itor = head + 1;
+    while (itor < tail && tb_stable_sort_less(&sort, tb_stable_sort_item(&sort, itor), tb_stable_sort_item(&sort, itor - 1))) itor++;
+    if (itor == tail) tb_stable_sort_reverse(&sort, head, tail);
+    // sort it
+    else tb_stable_sort_done(&sort, head, tail);
+
+    // free
+    tb_free(sort.buffer);
+}
+tb_void_t tb_stable_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_stable_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
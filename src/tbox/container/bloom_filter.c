@@ -42,6 +42,11 @@
 #include "../stream/stream.h"
 #include "../platform/platform.h"
 #include "../algorithm/algorithm.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#elif defined(TB_ARCH_ARM_NEON)
+#   include <arm_neon.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -61,6 +66,29 @@
 #   define TB_BLOOM_FILTER_ITEM_MAXN_DEFAULT    TB_BLOOM_FILTER_ITEM_MAXN_SMALL
 #endif
 
+// the block size, one cache line
+#define TB_BLOOM_FILTER_BLOCK_SIZE              (64)
+
+// the block bits
+#define TB_BLOOM_FILTER_BLOCK_BITS              (TB_BLOOM_FILTER_BLOCK_SIZE << 3)
+
+// the block words
+#define TB_BLOOM_FILTER_BLOCK_WORDS             (TB_BLOOM_FILTER_BLOCK_SIZE >> 2)
+
+// the file header size
+#define TB_BLOOM_FILTER_FILE_HEAD_SIZE          (64)
+
+// the file magic: "TBBF"
+#define TB_BLOOM_FILTER_FILE_MAGIC              (0x46424254)
+
+// the file version
+#define TB_BLOOM_FILTER_FILE_VERSION            (1)
+
+// the file flags
+#define TB_BLOOM_FILTER_FILE_FLAG_BLOCK         (1)
+#define TB_BLOOM_FILTER_FILE_FLAG_BIT64         (2)
+#define TB_BLOOM_FILTER_FILE_FLAG_BIGENDIAN     (4)
+
 // the bit sets
 #define tb_bloom_filter_set1(data, i)           do {(data)[(i) >> 3] |= (0x1 << ((i) & 7));} while (0)
 #define tb_bloom_filter_set0(data, i)           do {(data)[(i) >> 3] &= ~(0x1 << ((i) & 7));} while (0)
@@ -94,12 +122,109 @@ typedef struct __tb_bloom_filter_t
     // the hash mask
     tb_size_t           mask;
 
+    // the block count, all bits of one item are in the same block if it is not zero
+    tb_size_t           blockn;
+
+    // the mapped file data, the bloom filter is read-only if it is not null
+    tb_byte_t const*    map;
+
+    // the mapped size
+    tb_size_t           mapsize;
+
 }tb_bloom_filter_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * globals
  */
-tb_bloom_filter_ref_t tb_bloom_filter_init(tb_size_t probability, tb_size_t hash_count, tb_size_t item_maxn, tb_element_t element)
+
+// the salts of the block bits, they are all odd
+static tb_uint32_t const g_bloom_filter_salts[16] = 
+{
+    0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31
+,   0x9e3779b1, 0x85ebca6b, 0xc2b2ae35, 0x27d4eb2f, 0x165667b1, 0xd3a2646d, 0xfd7046c5, 0xb55a4f09
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint32_t* tb_bloom_filter_block_mask(tb_bloom_filter_t* filter, tb_cpointer_t data, tb_uint32_t mask[TB_BLOOM_FILTER_BLOCK_WORDS])
+{
+    // compute the full hash value and mix all bits of it
+    tb_size_t   hash = filter->element.hash(&filter->element, data, (tb_size_t)-1, 0);
+#if TB_CPU_BIT64
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    tb_uint32_t hblock = (tb_uint32_t)(hash >> 32);
+    tb_uint32_t hbits = (tb_uint32_t)hash;
+#else
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    tb_uint32_t hblock = (tb_uint32_t)hash;
+    tb_uint32_t hbits = (tb_uint32_t)filter->element.hash(&filter->element, data, (tb_size_t)-1, 1) * 0xc2b2ae35;
+#endif
+
+    /* make the bit mask of this item in the block
+     *
+     * the high 4-bits of (hbits * salt) is the word index in the block
+     * and the next 5-bits is the bit index in the word
+     */
+    tb_size_t i = 0;
+    tb_size_t n = filter->hash_count;
+    tb_memset(mask, 0, TB_BLOOM_FILTER_BLOCK_SIZE);
+    for (i = 0; i < n; i++)
+    {
+        tb_uint32_t h = hbits * g_bloom_filter_salts[i];
+        mask[h >> 28] |= (tb_uint32_t)1 << ((h >> 23) & 31);
+    }
+
+    // the block, map the hash value to [0, blockn) without division
+    return (tb_uint32_t*)(filter->data + (tb_size_t)(((tb_uint64_t)hblock * filter->blockn) >> 32) * TB_BLOOM_FILTER_BLOCK_SIZE);
+}
+#if defined(TB_ARCH_SSE2)
+static __tb_inline_force__ tb_bool_t tb_bloom_filter_block_test(tb_uint32_t const* block, tb_uint32_t const* mask)
+{
+    // (block & mask) == mask for all words?
+    __m128i m0 = _mm_loadu_si128((__m128i const*)mask);
+    __m128i m1 = _mm_loadu_si128((__m128i const*)(mask + 4));
+    __m128i m2 = _mm_loadu_si128((__m128i const*)(mask + 8));
+    __m128i m3 = _mm_loadu_si128((__m128i const*)(mask + 12));
+    __m128i r0 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((__m128i const*)block), m0), m0);
+    __m128i r1 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((__m128i const*)(block + 4)), m1), m1);
+    __m128i r2 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((__m128i const*)(block + 8)), m2), m2);
+    __m128i r3 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((__m128i const*)(block + 12)), m3), m3);
+    return _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(r0, r1), _mm_and_si128(r2, r3))) == 0xffff;
+}
+#elif defined(TB_ARCH_ARM_NEON)
+static __tb_inline_force__ tb_bool_t tb_bloom_filter_block_test(tb_uint32_t const* block, tb_uint32_t const* mask)
+{
+    // (block & mask) == mask for all words?
+    uint32x4_t m0 = vld1q_u32(mask);
+    uint32x4_t m1 = vld1q_u32(mask + 4);
+    uint32x4_t m2 = vld1q_u32(mask + 8);
+    uint32x4_t m3 = vld1q_u32(mask + 12);
+    uint32x4_t r0 = vceqq_u32(vandq_u32(vld1q_u32(block), m0), m0);
+    uint32x4_t r1 = vceqq_u32(vandq_u32(vld1q_u32(block + 4), m1), m1);
+    uint32x4_t r2 = vceqq_u32(vandq_u32(vld1q_u32(block + 8), m2), m2);
+    uint32x4_t r3 = vceqq_u32(vandq_u32(vld1q_u32(block + 12), m3), m3);
+    uint32x4_t r = vandq_u32(vandq_u32(r0, r1), vandq_u32(r2, r3));
+    uint32x2_t h = vand_u32(vget_low_u32(r), vget_high_u32(r));
+    return (vget_lane_u32(h, 0) & vget_lane_u32(h, 1)) == 0xffffffff;
+}
+#else
+static __tb_inline__ tb_bool_t tb_bloom_filter_block_test(tb_uint32_t const* block, tb_uint32_t const* mask)
+{
+    // (block & mask) == mask for all words?
+    tb_size_t i = 0;
+    for (i = 0; i < TB_BLOOM_FILTER_BLOCK_WORDS; i++)
+    {
+        if ((block[i] & mask[i]) != mask[i]) return tb_false;
+    }
+    return tb_true;
+}
+#endif
+static tb_bloom_filter_ref_t tb_bloom_filter_init_(tb_size_t probability, tb_size_t hash_count, tb_size_t item_maxn, tb_element_t element, tb_bool_t block)
 {
     // check
     tb_assert_and_check_return_val(element.hash, tb_null);
@@ -188,8 +313,13 @@ tb_bloom_filter_ref_t tb_bloom_filter_init(tb_size_t probability, tb_size_t hash
         tb_size_t m = tb_fixed_mul(s_scale[hash_count - 1][probability], item_maxn);
 #endif
         
-        // init size
-        filter->size = tb_align8(m) >> 3;
+        // init size, 512 bits per block for the blocked bloom filter
+        if (block)
+        {
+            filter->blockn = (m + TB_BLOOM_FILTER_BLOCK_BITS - 1) / TB_BLOOM_FILTER_BLOCK_BITS;
+            filter->size = filter->blockn <= TB_BLOOM_FILTER_DATA_MAXN / TB_BLOOM_FILTER_BLOCK_SIZE? filter->blockn * TB_BLOOM_FILTER_BLOCK_SIZE : TB_BLOOM_FILTER_DATA_MAXN + 1;
+        }
+        else filter->size = tb_align8(m) >> 3;
         tb_assert_and_check_break(filter->size);
         if (filter->size > TB_BLOOM_FILTER_DATA_MAXN)
         {
@@ -222,6 +352,158 @@ tb_bloom_filter_ref_t tb_bloom_filter_init(tb_size_t probability, tb_size_t hash
     // ok?
     return (tb_bloom_filter_ref_t)filter;
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bloom_filter_ref_t tb_bloom_filter_init(tb_size_t probability, tb_size_t hash_count, tb_size_t item_maxn, tb_element_t element)
+{
+    return tb_bloom_filter_init_(probability, hash_count, item_maxn, element, tb_false);
+}
+tb_bloom_filter_ref_t tb_bloom_filter_init_block(tb_size_t probability, tb_size_t hash_count, tb_size_t item_maxn, tb_element_t element)
+{
+    return tb_bloom_filter_init_(probability, hash_count, item_maxn, element, tb_true);
+}
+tb_bloom_filter_ref_t tb_bloom_filter_load(tb_char_t const* path, tb_element_t element)
+{
+    // check
+    tb_assert_and_check_return_val(path && element.hash, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_file_ref_t       file = tb_null;
+    tb_bloom_filter_t*  filter = tb_null;
+    do
+    {
+        // open file
+        file = tb_file_init(path, TB_FILE_MODE_RO);
+        tb_check_break(file);
+
+        // read the file header
+        tb_byte_t head[TB_BLOOM_FILTER_FILE_HEAD_SIZE];
+        if (tb_file_pread(file, head, sizeof(head), 0) != sizeof(head)) break;
+
+        // check the file header
+        tb_uint32_t flags = tb_bits_get_u32_le(head + 8);
+        tb_uint32_t flags_host = 0;
+#if TB_CPU_BIT64
+        flags_host |= TB_BLOOM_FILTER_FILE_FLAG_BIT64;
+#endif
+#ifdef TB_WORDS_BIGENDIAN
+        flags_host |= TB_BLOOM_FILTER_FILE_FLAG_BIGENDIAN;
+#endif
+        if (    tb_bits_get_u32_le(head) != TB_BLOOM_FILTER_FILE_MAGIC 
+            ||  tb_bits_get_u32_le(head + 4) != TB_BLOOM_FILTER_FILE_VERSION
+            ||  (flags & ~TB_BLOOM_FILTER_FILE_FLAG_BLOCK) != flags_host)
+        {
+            tb_trace_e("load: invalid file header: %s", path);
+            break;
+        }
+
+        // make filter
+        filter = tb_malloc0_type(tb_bloom_filter_t);
+        tb_assert_and_check_break(filter);
+
+        // init filter
+        filter->element     = element;
+        filter->hash_count  = tb_bits_get_u32_le(head + 12);
+        filter->probability = tb_bits_get_u32_le(head + 16);
+        filter->maxn        = (tb_size_t)tb_bits_get_u64_le(head + 24);
+        filter->size        = (tb_size_t)tb_bits_get_u64_le(head + 32);
+        filter->blockn      = (flags & TB_BLOOM_FILTER_FILE_FLAG_BLOCK)? filter->size / TB_BLOOM_FILTER_BLOCK_SIZE : 0;
+
+        // check the filter
+        if (    !filter->hash_count || filter->hash_count >= 16 
+            ||  !filter->size || filter->size > TB_BLOOM_FILTER_DATA_MAXN
+            ||  (filter->blockn && filter->blockn * TB_BLOOM_FILTER_BLOCK_SIZE != filter->size)
+            ||  tb_file_size(file) < TB_BLOOM_FILTER_FILE_HEAD_SIZE + filter->size)
+        {
+            tb_trace_e("load: invalid file data: %s", path);
+            break;
+        }
+
+        // init hash mask
+        filter->mask = tb_align_pow2((filter->size << 3)) - 1;
+        tb_assert_and_check_break(filter->mask);
+
+        // map the file data
+        filter->mapsize = TB_BLOOM_FILTER_FILE_HEAD_SIZE + filter->size;
+        filter->map     = tb_file_map(file, filter->mapsize);
+        if (filter->map) filter->data = (tb_byte_t*)filter->map + TB_BLOOM_FILTER_FILE_HEAD_SIZE;
+        else
+        {
+            // not supported? read the file data
+            filter->data = tb_malloc_bytes(filter->size);
+            tb_assert_and_check_break(filter->data);
+            if (tb_file_pread(file, filter->data, filter->size, TB_BLOOM_FILTER_FILE_HEAD_SIZE) != filter->size) break;
+        }
+
+        // trace
+        tb_trace_d("load: %s, size: %lu, blockn: %lu, mapped: %s", path, filter->size, filter->blockn, filter->map? "ok" : "no");
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit file, the mapped data is still valid after closing it
+    if (file) tb_file_exit(file);
+    file = tb_null;
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (filter) tb_bloom_filter_exit((tb_bloom_filter_ref_t)filter);
+        filter = tb_null;
+    }
+
+    // ok?
+    return (tb_bloom_filter_ref_t)filter;
+}
+tb_bool_t tb_bloom_filter_save(tb_bloom_filter_ref_t self, tb_char_t const* path)
+{
+    // check
+    tb_bloom_filter_t* filter = (tb_bloom_filter_t*)self;
+    tb_assert_and_check_return_val(filter && filter->data && path, tb_false);
+
+    // make the file header
+    tb_uint32_t flags = filter->blockn? TB_BLOOM_FILTER_FILE_FLAG_BLOCK : 0;
+#if TB_CPU_BIT64
+    flags |= TB_BLOOM_FILTER_FILE_FLAG_BIT64;
+#endif
+#ifdef TB_WORDS_BIGENDIAN
+    flags |= TB_BLOOM_FILTER_FILE_FLAG_BIGENDIAN;
+#endif
+    tb_byte_t head[TB_BLOOM_FILTER_FILE_HEAD_SIZE] = {0};
+    tb_bits_set_u32_le(head, TB_BLOOM_FILTER_FILE_MAGIC);
+    tb_bits_set_u32_le(head + 4, TB_BLOOM_FILTER_FILE_VERSION);
+    tb_bits_set_u32_le(head + 8, flags);
+    tb_bits_set_u32_le(head + 12, (tb_uint32_t)filter->hash_count);
+    tb_bits_set_u32_le(head + 16, (tb_uint32_t)filter->probability);
+    tb_bits_set_u64_le(head + 24, (tb_uint64_t)filter->maxn);
+    tb_bits_set_u64_le(head + 32, (tb_uint64_t)filter->size);
+
+    // open file
+    tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+    tb_check_return_val(file, tb_false);
+
+    // write the file header and data
+    tb_bool_t ok = tb_false;
+    tb_size_t writ = 0;
+    tb_long_t real = 0;
+    if (tb_file_writ(file, head, sizeof(head)) == sizeof(head))
+    {
+        while (writ < filter->size && (real = tb_file_writ(file, filter->data + writ, filter->size - writ)) > 0) writ += real;
+        ok = (writ == filter->size);
+    }
+
+    // exit file
+    tb_file_exit(file);
+
+    // ok?
+    return ok;
+}
 tb_void_t tb_bloom_filter_exit(tb_bloom_filter_ref_t self)
 {
     // check
@@ -229,8 +511,10 @@ tb_void_t tb_bloom_filter_exit(tb_bloom_filter_ref_t self)
     tb_assert_and_check_return(filter);
 
     // exit data
-    if (filter->data) tb_free(filter->data);
+    if (filter->map) tb_file_unmap(filter->map, filter->mapsize);
+    else if (filter->data) tb_free(filter->data);
     filter->data = tb_null;
+    filter->map = tb_null;
 
     // exit it
     tb_free(filter);
@@ -241,6 +525,9 @@ tb_void_t tb_bloom_filter_clear(tb_bloom_filter_ref_t self)
     tb_bloom_filter_t* filter = (tb_bloom_filter_t*)self;
     tb_assert_and_check_return(filter);
 
+    // check
+    tb_assert_and_check_return(!filter->map);
+
     // clear it
     if (filter->data && filter->size) tb_memset(filter->data, 0, filter->size);
 }
@@ -248,7 +535,20 @@ tb_bool_t tb_bloom_filter_set(tb_bloom_filter_ref_t self, tb_cpointer_t data)
 {
     // check
     tb_bloom_filter_t* filter = (tb_bloom_filter_t*)self;
-    tb_assert_and_check_return_val(filter, tb_false);
+    tb_assert_and_check_return_val(filter && !filter->map, tb_false);
+
+    // blocked? set all bits of the block at once
+    if (filter->blockn)
+    {
+        // not exists? set it
+        tb_uint32_t mask[TB_BLOOM_FILTER_BLOCK_WORDS];
+        tb_uint32_t* block = tb_bloom_filter_block_mask(filter, data, mask);
+        tb_check_return_val(!tb_bloom_filter_block_test(block, mask), tb_false);
+
+        tb_size_t i = 0;
+        for (i = 0; i < TB_BLOOM_FILTER_BLOCK_WORDS; i++) block[i] |= mask[i];
+        return tb_true;
+    }
 
     // walk
     tb_size_t i = 0;
@@ -280,6 +580,13 @@ tb_bool_t tb_bloom_filter_get(tb_bloom_filter_ref_t self, tb_cpointer_t data)
     tb_bloom_filter_t* filter = (tb_bloom_filter_t*)self;
     tb_assert_and_check_return_val(filter, tb_false);
 
+    // blocked? test all bits of the block at once
+    if (filter->blockn)
+    {
+        tb_uint32_t mask[TB_BLOOM_FILTER_BLOCK_WORDS];
+        return tb_bloom_filter_block_test(tb_bloom_filter_block_mask(filter, data, mask), mask);
+    }
+
     // walk
     tb_size_t i = 0;
     tb_size_t n = filter->hash_count;
@@ -144,6 +144,48 @@ typedef enum __tb_bloom_filter_probability_e
  */
 tb_bloom_filter_ref_t   tb_bloom_filter_init(tb_size_t probability, tb_size_t hash_count, tb_size_t item_maxn, tb_element_t element);
 
+/*! init the blocked bloom filter
+ *
+ * all bits of one item are in the same 64-bytes block (one cache line), 
+ * so only one cache miss for each set and get, and all bits are tested by the simd compare.
+ *
+ * the false positives will be slightly higher than the normal bloom filter with the same space
+ *
+ * @note not supports iterator 
+ *
+ * @param probability   the probability of false positives
+ * @param hash_count    the hash count: < 16
+ * @param item_maxn     the item maxn
+ * @param element       the element only for hash
+ *
+ * @return              the bloom filter
+ */
+tb_bloom_filter_ref_t   tb_bloom_filter_init_block(tb_size_t probability, tb_size_t hash_count, tb_size_t item_maxn, tb_element_t element);
+
+/*! load the bloom filter from the given file
+ *
+ * the file data will be mapped to the read-only memory if the platform supports it, 
+ * so it will be loaded instantly and the pages are shared by all processes which load the same file. 
+ * the mapped bloom filter cannot be modified.
+ *
+ * @note the file must be saved by the same word size and endianness
+ *
+ * @param path          the file path
+ * @param element       the element only for hash, it must be same as the saved bloom filter
+ *
+ * @return              the bloom filter
+ */
+tb_bloom_filter_ref_t   tb_bloom_filter_load(tb_char_t const* path, tb_element_t element);
+
+/*! save the bloom filter to the given file
+ *
+ * @param bloom_filter  the bloom filter
+ * @param path          the file path
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_bloom_filter_save(tb_bloom_filter_ref_t bloom_filter, tb_char_t const* path);
+
 /*! exit bloom filter
  *
  * @param bloom_filter  the bloom filter
@@ -237,8 +237,11 @@ tb_void_t tb_circle_queue_clear(tb_circle_queue_ref_t self)
     tb_circle_queue_t* queue = (tb_circle_queue_t*)self;
     tb_assert_and_check_return(queue);
     
-    // clear it
-    while (!tb_circle_queue_null(self)) tb_circle_queue_pop(self);
+    // clear it, the pod items need not be freed
+    if (!tb_element_is_pod(&queue->element))
+    {
+        while (!tb_circle_queue_null(self)) tb_circle_queue_pop(self);
+    }
     queue->head = 0;
     queue->tail = 0;
     queue->size = 0;
@@ -261,7 +264,7 @@ tb_void_t tb_circle_queue_pop(tb_circle_queue_ref_t self)
     tb_assert_and_check_return(queue && queue->size);
 
     // pop it
-    if (queue->element.free) queue->element.free(&queue->element, queue->data + queue->head * queue->element.size);
+    if (queue->element.free && !tb_element_is_pod(&queue->element)) queue->element.free(&queue->element, queue->data + queue->head * queue->element.size);
     queue->head = (queue->head + 1) % queue->maxn;
     queue->size--;
 }
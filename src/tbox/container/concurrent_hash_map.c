@@ -0,0 +1,435 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "concurrent_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "concurrent_hash_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default shard count for each processor
+#define TB_CONCURRENT_HASH_MAP_SHARD_PER_PROCESSOR      (4)
+
+// the maximum shard count
+#define TB_CONCURRENT_HASH_MAP_SHARD_MAXN               (1024)
+
+// the writer of the lock
+#define TB_CONCURRENT_HASH_MAP_LOCK_WRITER              (1)
+
+// the waiting writers of the lock, the new readers will wait for them
+#define TB_CONCURRENT_HASH_MAP_LOCK_WAITING             (2)
+
+// the reader of the lock, the reader count is stored in the high bits
+#define TB_CONCURRENT_HASH_MAP_LOCK_READER              (4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the concurrent hash map shard type, each shard is placed at its own cache line
+typedef __tb_cacheline_aligned__ struct __tb_concurrent_hash_map_shard_t
+{
+    // the reader-writer lock
+    tb_atomic_t                 lock;
+
+    // the item size, it is only written with the write lock
+    tb_atomic_t                 size;
+
+    // the hash map
+    tb_hash_map_ref_t           hash_map;
+
+}__tb_cacheline_aligned__ tb_concurrent_hash_map_shard_t;
+
+// the concurrent hash map type
+typedef struct __tb_concurrent_hash_map_t
+{
+    // the shards
+    tb_concurrent_hash_map_shard_t* shards;
+
+    // the shard count, the power of 2
+    tb_size_t                       shard_count;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+}tb_concurrent_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_concurrent_hash_map_load_value(tb_atomic_t* value)
+{
+    /* load the value directly without the locked instruction, 
+     * the stale value will be validated by the next compare-and-swap
+     */
+    return *((__tb_volatile__ tb_atomic_t*)value);
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_lock_wait(tb_size_t* ptryn)
+{
+    // yield the processor after spinning a while
+    if (!(*ptryn)--)
+    {
+        tb_sched_yield();
+        *ptryn = 5;
+    }
+}
+static tb_void_t tb_concurrent_hash_map_enter_read(tb_concurrent_hash_map_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // add a reader if there are no writers and waiting writers
+    tb_size_t tryn = 5;
+    while (1)
+    {
+        tb_long_t lock = tb_concurrent_hash_map_load_value(&shard->lock);
+        if (!(lock & (TB_CONCURRENT_HASH_MAP_LOCK_WRITER | TB_CONCURRENT_HASH_MAP_LOCK_WAITING))
+            && tb_atomic_fetch_and_pset(&shard->lock, lock, lock + TB_CONCURRENT_HASH_MAP_LOCK_READER) == lock) 
+            break;
+
+        // wait it
+        tb_concurrent_hash_map_lock_wait(&tryn);
+    }
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_leave_read(tb_concurrent_hash_map_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // remove this reader
+    tb_atomic_fetch_and_sub(&shard->lock, TB_CONCURRENT_HASH_MAP_LOCK_READER);
+}
+static tb_void_t tb_concurrent_hash_map_enter_write(tb_concurrent_hash_map_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // lock it if there are no readers and writers, the waiting flag will be cleared 
+    tb_size_t tryn = 5;
+    while (1)
+    {
+        tb_long_t lock = tb_concurrent_hash_map_load_value(&shard->lock);
+        if (!(lock & ~TB_CONCURRENT_HASH_MAP_LOCK_WAITING))
+        {
+            if (tb_atomic_fetch_and_pset(&shard->lock, lock, TB_CONCURRENT_HASH_MAP_LOCK_WRITER) == lock) break;
+        }
+        // mark the waiting flag to stop the new readers, the other waiting writers will mark it again
+        else if (!(lock & TB_CONCURRENT_HASH_MAP_LOCK_WAITING)) 
+            tb_atomic_fetch_and_or(&shard->lock, TB_CONCURRENT_HASH_MAP_LOCK_WAITING);
+
+        // wait it
+        tb_concurrent_hash_map_lock_wait(&tryn);
+    }
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_leave_write(tb_concurrent_hash_map_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // unlock it and keep the waiting flag of other writers
+    tb_atomic_fetch_and_and(&shard->lock, ~TB_CONCURRENT_HASH_MAP_LOCK_WRITER);
+}
+static __tb_inline__ tb_concurrent_hash_map_shard_t* tb_concurrent_hash_map_shard(tb_concurrent_hash_map_t* hash_map, tb_cpointer_t name)
+{
+    // check
+    tb_assert(hash_map && hash_map->shards);
+
+    // compute the hash of name
+    tb_uint32_t hash = (tb_uint32_t)hash_map->element_name.hash(&hash_map->element_name, name, (tb_size_t)-1, 0);
+
+    /* mix the hash bits, the hash map of shard will mix the hash by itself, 
+     * so the items in the same shard are still distributed evenly
+     */
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash_map->shards + (hash & (hash_map->shard_count - 1));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_concurrent_hash_map_ref_t tb_concurrent_hash_map_init(tb_size_t shard_count, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.hash, tb_null);
+
+    // the default shard count
+    if (!shard_count) shard_count = tb_processor_count() * TB_CONCURRENT_HASH_MAP_SHARD_PER_PROCESSOR;
+    shard_count = tb_min(tb_align_pow2(shard_count), TB_CONCURRENT_HASH_MAP_SHARD_MAXN);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_concurrent_hash_map_t*   hash_map = tb_null;
+    do
+    {
+        // make hash map
+        hash_map = tb_malloc0_type(tb_concurrent_hash_map_t);
+        tb_assert_and_check_break(hash_map);
+
+        // init hash map
+        hash_map->shard_count   = shard_count;
+        hash_map->element_name  = element_name;
+
+        // make shards
+        hash_map->shards = (tb_concurrent_hash_map_shard_t*)tb_align_nalloc0(shard_count, sizeof(tb_concurrent_hash_map_shard_t), TB_SMP_CACHE_BYTES);
+        tb_assert_and_check_break(hash_map->shards);
+
+        // init shards
+        tb_size_t i = 0;
+        for (i = 0; i < shard_count; i++)
+        {
+            hash_map->shards[i].hash_map = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, element_name, element_data);
+            tb_assert_and_check_break(hash_map->shards[i].hash_map);
+        }
+        tb_check_break(i == shard_count);
+
+        // trace
+        tb_trace_d("init: shards: %lu", shard_count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_concurrent_hash_map_exit((tb_concurrent_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_concurrent_hash_map_ref_t)hash_map;
+}
+tb_void_t tb_concurrent_hash_map_exit(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // exit shards
+    if (hash_map->shards)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < hash_map->shard_count; i++)
+        {
+            if (hash_map->shards[i].hash_map) tb_hash_map_exit(hash_map->shards[i].hash_map);
+            hash_map->shards[i].hash_map = tb_null;
+        }
+        tb_align_free(hash_map->shards);
+        hash_map->shards = tb_null;
+    }
+
+    // exit it
+    tb_free(hash_map);
+}
+tb_void_t tb_concurrent_hash_map_clear(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->shards);
+
+    // clear shards
+    tb_size_t i = 0;
+    for (i = 0; i < hash_map->shard_count; i++)
+    {
+        tb_concurrent_hash_map_shard_t* shard = hash_map->shards + i;
+        tb_concurrent_hash_map_enter_write(shard);
+        tb_hash_map_clear(shard->hash_map);
+        *((__tb_volatile__ tb_atomic_t*)&shard->size) = 0;
+        tb_concurrent_hash_map_leave_write(shard);
+    }
+}
+tb_bool_t tb_concurrent_hash_map_get(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name, tb_pointer_t* pdata)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(hash_map, name);
+
+    // find it, the cached item of the hash map cannot be used by the multiple readers
+    tb_hash_map_item_t item;
+    tb_concurrent_hash_map_enter_read(shard);
+    tb_size_t itor = tb_hash_map_find(shard->hash_map, name);
+    tb_bool_t ok = itor != tb_iterator_tail(shard->hash_map) && tb_hash_map_load(shard->hash_map, itor, &item);
+    if (ok && pdata) *pdata = item.data;
+    tb_concurrent_hash_map_leave_read(shard);
+
+    // ok?
+    return ok;
+}
+tb_bool_t tb_concurrent_hash_map_load(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name, tb_concurrent_hash_map_load_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && func, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(hash_map, name);
+
+    // find and load it
+    tb_hash_map_item_t item;
+    tb_concurrent_hash_map_enter_read(shard);
+    tb_size_t itor = tb_hash_map_find(shard->hash_map, name);
+    tb_bool_t ok = itor != tb_iterator_tail(shard->hash_map) && tb_hash_map_load(shard->hash_map, itor, &item);
+    if (ok) func(&item, priv);
+    tb_concurrent_hash_map_leave_read(shard);
+
+    // ok?
+    return ok;
+}
+tb_bool_t tb_concurrent_hash_map_insert(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(hash_map, name);
+
+    // insert it
+    tb_concurrent_hash_map_enter_write(shard);
+    tb_bool_t ok = tb_hash_map_insert(shard->hash_map, name, data) != 0;
+    *((__tb_volatile__ tb_atomic_t*)&shard->size) = tb_hash_map_size(shard->hash_map);
+    tb_concurrent_hash_map_leave_write(shard);
+
+    // ok?
+    return ok;
+}
+tb_bool_t tb_concurrent_hash_map_remove(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(hash_map, name);
+
+    // remove it
+    tb_concurrent_hash_map_enter_write(shard);
+    tb_size_t size = tb_hash_map_size(shard->hash_map);
+    tb_hash_map_remove(shard->hash_map, name);
+    tb_bool_t ok = tb_hash_map_size(shard->hash_map) != size;
+    if (ok) *((__tb_volatile__ tb_atomic_t*)&shard->size) = size - 1;
+    tb_concurrent_hash_map_leave_write(shard);
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_concurrent_hash_map_remove_if(tb_concurrent_hash_map_ref_t self, tb_concurrent_hash_map_pred_func_t pred, tb_cpointer_t priv)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->shards && pred);
+
+    // remove items for all shards
+    tb_size_t i = 0;
+    for (i = 0; i < hash_map->shard_count; i++)
+    {
+        // lock this shard
+        tb_concurrent_hash_map_shard_t* shard = hash_map->shards + i;
+        tb_concurrent_hash_map_enter_write(shard);
+
+        // remove items, the removed slots will not move the other items
+        tb_hash_map_ref_t   map = shard->hash_map;
+        tb_size_t           itor = tb_iterator_head(map);
+        tb_size_t           tail = tb_iterator_tail(map);
+        while (itor != tail)
+        {
+            // the next itor
+            tb_size_t next = tb_iterator_next(map, itor);
+
+            // remove it?
+            if (pred((tb_hash_map_item_ref_t)tb_iterator_item(map, itor), priv)) tb_iterator_remove(map, itor);
+
+            // next
+            itor = next;
+        }
+        *((__tb_volatile__ tb_atomic_t*)&shard->size) = tb_hash_map_size(map);
+
+        // unlock this shard
+        tb_concurrent_hash_map_leave_write(shard);
+    }
+}
+tb_void_t tb_concurrent_hash_map_walk(tb_concurrent_hash_map_ref_t self, tb_concurrent_hash_map_walk_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->shards && func);
+
+    // walk all shards
+    tb_bool_t           ok = tb_true;
+    tb_size_t           i = 0;
+    tb_hash_map_item_t  item;
+    for (i = 0; i < hash_map->shard_count && ok; i++)
+    {
+        // lock this shard
+        tb_concurrent_hash_map_shard_t* shard = hash_map->shards + i;
+        tb_concurrent_hash_map_enter_read(shard);
+
+        // walk items, we cannot use tb_iterator_item() because the cached item of the hash map will be changed by the other readers
+        tb_hash_map_ref_t   map = shard->hash_map;
+        tb_size_t           itor = tb_iterator_head(map);
+        tb_size_t           tail = tb_iterator_tail(map);
+        for (; itor != tail && ok; itor = tb_iterator_next(map, itor))
+        {
+            if (tb_hash_map_load(map, itor, &item)) ok = func(&item, priv);
+        }
+
+        // unlock this shard
+        tb_concurrent_hash_map_leave_read(shard);
+    }
+}
+tb_size_t tb_concurrent_hash_map_size(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && hash_map->shards, 0);
+
+    // sum the sizes of all shards
+    tb_size_t size = 0;
+    tb_size_t i = 0;
+    for (i = 0; i < hash_map->shard_count; i++) size += (tb_size_t)tb_concurrent_hash_map_load_value(&hash_map->shards[i].size);
+    return size;
+}
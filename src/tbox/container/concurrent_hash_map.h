@@ -0,0 +1,189 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_CONCURRENT_HASH_MAP_H
+#define TB_CONTAINER_CONCURRENT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "hash_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the concurrent hash map ref type
+ *
+ * <pre>
+ *
+ * the thread-safe hash map, the items are distributed to the shards by the hash of name
+ *
+ * shards: |   lock   |   lock   |   lock   | ... |   lock   |
+ *         | hash_map | hash_map | hash_map | ... | hash_map |
+ *              |
+ *         hash(name) & (shard_count - 1)
+ *
+ * each shard is guarded by a reader-writer spinlock at its own cache line, 
+ * so the readers of the same shard do not block each other and the threads accessing 
+ * the different shards do not contend at all.
+ *
+ * </pre>
+ */
+typedef __tb_typeref__(concurrent_hash_map);
+
+/// the load func type, the item is only valid in this func
+typedef tb_void_t       (*tb_concurrent_hash_map_load_func_t)(tb_hash_map_item_ref_t item, tb_cpointer_t priv);
+
+/// the walk func type, return tb_false for breaking it
+typedef tb_bool_t       (*tb_concurrent_hash_map_walk_func_t)(tb_hash_map_item_ref_t item, tb_cpointer_t priv);
+
+/// the predicate func type, return tb_true for removing the item
+typedef tb_bool_t       (*tb_concurrent_hash_map_pred_func_t)(tb_hash_map_item_ref_t item, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init concurrent hash map
+ *
+ * @param shard_count   the shard count, using the default count for the processors if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the concurrent hash map
+ */
+tb_concurrent_hash_map_ref_t    tb_concurrent_hash_map_init(tb_size_t shard_count, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit concurrent hash map
+ *
+ * @param hash_map      the concurrent hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_exit(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! clear concurrent hash map
+ *
+ * @param hash_map      the concurrent hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_clear(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! get item data from name
+ *
+ * @note 
+ * the item data will be returned directly, so it is only safe for the data without the owned memory, 
+ * .e.g long, size, uint32 and ptr, the owned data (str, mem and obj) may be freed by other threads 
+ * after returning, please use tb_concurrent_hash_map_load() for it
+ *
+ * @code
+ * tb_pointer_t data = tb_null;
+ * if (tb_concurrent_hash_map_get(hash_map, name, &data))
+ * {
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param hash_map      the concurrent hash map
+ * @param name          the item name
+ * @param pdata         the item data pointer, optional
+ *
+ * @return              tb_true if the item exists
+ */
+tb_bool_t                       tb_concurrent_hash_map_get(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_pointer_t* pdata);
+
+/*! load item from name and access it in the given func
+ *
+ * the func is called with the shared lock of the shard, so it can copy the owned data safely,
+ * but it must not modify this hash map
+ *
+ * @param hash_map      the concurrent hash map
+ * @param name          the item name
+ * @param func          the load func
+ * @param priv          the user private data
+ *
+ * @return              tb_true if the item exists
+ */
+tb_bool_t                       tb_concurrent_hash_map_load(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_concurrent_hash_map_load_func_t func, tb_cpointer_t priv);
+
+/*! insert item data from name, the data will be replaced if the name exists
+ *
+ * @param hash_map      the concurrent hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t                       tb_concurrent_hash_map_insert(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map      the concurrent hash map
+ * @param name          the item name
+ *
+ * @return              tb_true if the item has been removed
+ */
+tb_bool_t                       tb_concurrent_hash_map_remove(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! remove items if the predicate is true
+ *
+ * @note the shards are locked one by one, so it is not an atomic snapshot of all items
+ *
+ * @param hash_map      the concurrent hash map
+ * @param pred          the predicate func
+ * @param priv          the user private data
+ */
+tb_void_t                       tb_concurrent_hash_map_remove_if(tb_concurrent_hash_map_ref_t hash_map, tb_concurrent_hash_map_pred_func_t pred, tb_cpointer_t priv);
+
+/*! walk all items
+ *
+ * @note the shards are locked one by one with the shared lock, the func must not modify this hash map
+ *
+ * @param hash_map      the concurrent hash map
+ * @param func          the walk func
+ * @param priv          the user private data
+ */
+tb_void_t                       tb_concurrent_hash_map_walk(tb_concurrent_hash_map_ref_t hash_map, tb_concurrent_hash_map_walk_func_t func, tb_cpointer_t priv);
+
+/*! the concurrent hash map size without locking
+ *
+ * @param hash_map      the concurrent hash map
+ *
+ * @return              the item count, it may be changed by other threads after returning
+ */
+tb_size_t                       tb_concurrent_hash_map_size(tb_concurrent_hash_map_ref_t hash_map);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
@@ -37,13 +37,20 @@
 #include "vector.h"
 #include "hash_set.h"
 #include "hash_map.h"
+#include "concurrent_hash_map.h"
+#include "tree_map.h"
+#include "tree_set.h"
 #include "queue.h"
 #include "circle_queue.h"
+#include "spsc_queue.h"
+#include "mpmc_queue.h"
 #include "priority_queue.h"
 #include "list.h"
 #include "list_entry.h"
+#include "heap_entry.h"
 #include "single_list.h"
 #include "single_list_entry.h"
 #include "bloom_filter.h"
+#include "typed/typed.h"
 
 #endif
@@ -36,6 +36,13 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the element data is trivially copyable?
+#define tb_element_is_pod(element)      ((element)->flag & TB_ELEMENT_FLAG_POD)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -182,6 +189,20 @@ typedef enum __tb_element_type_t
 
 }tb_element_type_t;
 
+/*! the element flag enum
+ *
+ * the pod element is trivially copyable and relocatable, 
+ * so the containers can move and copy the items by memcpy/memmove and need not free them.
+ *
+ * @note the low bits are used by the element type, e.g. the case flag of the string element
+ */
+typedef enum __tb_element_flag_e
+{
+    TB_ELEMENT_FLAG_NONE           = 0
+,   TB_ELEMENT_FLAG_POD            = 0x8000 //!< the trivially copyable data
+
+}tb_element_flag_e;
+
 /// the element type
 typedef struct __tb_element_t
 {
@@ -101,7 +101,7 @@ tb_element_t tb_element_long()
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_LONG;
-    element.flag   = 0;
+    element.flag   = TB_ELEMENT_FLAG_POD;
     element.hash   = element_size.hash;
     element.comp   = tb_element_long_comp;
     element.data   = tb_element_long_data;
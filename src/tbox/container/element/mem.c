@@ -140,9 +140,21 @@ static tb_void_t tb_element_mem_ncopy(tb_element_ref_t element, tb_pointer_t buf
 {
     // check
     tb_assert_and_check_return(element && element->size && buff && data);
+    tb_check_return(size);
 
-    // copy elements
-    while (size--) tb_memcpy((tb_byte_t*)buff + size * element->size, data, element->size);
+    // copy the first element
+    tb_size_t   step = element->size;
+    tb_size_t   done = 1;
+    tb_byte_t*  items = (tb_byte_t*)buff;
+    tb_memcpy(items, data, step);
+
+    // fill the left elements by doubling the copied elements
+    while (done < size)
+    {
+        tb_size_t n = tb_min(done, size - done);
+        tb_memcpy(items + done * step, items, n * step);
+        done += n;
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -156,7 +168,7 @@ tb_element_t tb_element_mem(tb_size_t size, tb_element_free_func_t free, tb_cpoi
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_MEM;
-    element.flag   = 0;
+    element.flag   = free? TB_ELEMENT_FLAG_NONE : TB_ELEMENT_FLAG_POD;
     element.hash   = tb_element_mem_hash;
     element.comp   = tb_element_mem_comp;
     element.data   = tb_element_mem_data;
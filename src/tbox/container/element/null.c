@@ -80,7 +80,7 @@ tb_element_t tb_element_null()
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_NULL;
-    element.flag   = 0;
+    element.flag   = TB_ELEMENT_FLAG_POD;
     element.hash   = tb_element_null_hash;
     element.comp   = tb_element_null_comp;
     element.data   = tb_element_null_data;
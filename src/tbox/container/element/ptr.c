@@ -146,7 +146,7 @@ tb_element_t tb_element_ptr(tb_element_free_func_t free, tb_cpointer_t priv)
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_PTR;
-    element.flag   = 0;
+    element.flag   = free? TB_ELEMENT_FLAG_NONE : TB_ELEMENT_FLAG_POD;
     element.hash   = element_size.hash;
     element.comp   = tb_element_ptr_comp;
     element.data   = tb_element_ptr_data;
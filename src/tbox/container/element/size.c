@@ -110,7 +110,7 @@ tb_element_t tb_element_size()
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_SIZE;
-    element.flag   = 0;
+    element.flag   = TB_ELEMENT_FLAG_POD;
     element.hash   = tb_element_size_hash;
     element.comp   = tb_element_size_comp;
     element.data   = tb_element_size_data;
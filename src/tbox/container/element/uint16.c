@@ -103,7 +103,7 @@ tb_element_t tb_element_uint16()
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_UINT16;
-    element.flag   = 0;
+    element.flag   = TB_ELEMENT_FLAG_POD;
     element.hash   = tb_element_uint16_hash;
     element.comp   = tb_element_uint16_comp;
     element.data   = tb_element_uint16_data;
@@ -92,7 +92,7 @@ static tb_void_t tb_element_uint32_ncopy(tb_element_ref_t element, tb_pointer_t
     tb_assert_and_check_return(buff);
 
     // copy elements
-    tb_memset_u16(buff, tb_p2u32(data), size);
+    tb_memset_u32(buff, tb_p2u32(data), size);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -103,7 +103,7 @@ tb_element_t tb_element_uint32()
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_UINT32;
-    element.flag   = 0;
+    element.flag   = TB_ELEMENT_FLAG_POD;
     element.hash   = tb_element_uint32_hash;
     element.comp   = tb_element_uint32_comp;
     element.data   = tb_element_uint32_data;
@@ -103,7 +103,7 @@ tb_element_t tb_element_uint8()
     // init element
     tb_element_t element = {0};
     element.type   = TB_ELEMENT_TYPE_UINT8;
-    element.flag   = 0;
+    element.flag   = TB_ELEMENT_FLAG_POD;
     element.hash   = tb_element_uint8_hash;
     element.comp   = tb_element_uint8_comp;
     element.data   = tb_element_uint8_data;
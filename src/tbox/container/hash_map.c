@@ -41,22 +41,16 @@
 #include "../stream/stream.h"
 #include "../platform/platform.h"
 #include "../algorithm/algorithm.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#elif defined(TB_ARCH_ARM_NEON)
+#   include <arm_neon.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
 
-// index
-#if TB_CPU_BIT64
-#   define tb_hash_map_index_make(buck, item)           (((tb_size_t)((item) & 0xffffffff) << 32) | ((buck) & 0xffffffff))
-#   define tb_hash_map_index_buck(index)                ((index) & 0xffffffff)
-#   define tb_hash_map_index_item(index)                (((index) >> 32) & 0xffffffff)
-#else
-#   define tb_hash_map_index_make(buck, item)           (((tb_size_t)((item) & 0xffff) << 16) | ((buck) & 0xffff))
-#   define tb_hash_map_index_buck(index)                ((index) & 0xffff)
-#   define tb_hash_map_index_item(index)                (((index) >> 16) & 0xffff)
-#endif
-
 // the self bucket default size
 #ifdef __tb_small__
 #   define TB_HASH_MAP_BUCKET_SIZE_DEFAULT              TB_HASH_MAP_BUCKET_SIZE_MICRO
@@ -64,50 +58,103 @@
 #   define TB_HASH_MAP_BUCKET_SIZE_DEFAULT              TB_HASH_MAP_BUCKET_SIZE_SMALL
 #endif
 
-// the self bucket maximum size
-#define TB_HASH_MAP_BUCKET_MAXN                         (1 << 16)
+// the group size, the control bytes of one group are probed at once
+#define TB_HASH_MAP_GROUP_SIZE                          (16)
+
+// the control byte of the empty slot
+#define TB_HASH_MAP_CTRL_EMPTY                          (0x80)
+
+// the control byte of the deleted slot
+#define TB_HASH_MAP_CTRL_DELETED                        (0xfe)
+
+// is full slot? the control byte is the 7-bits hash of the name for the full slot
+#define tb_hash_map_ctrl_is_full(c)                     (!((c) & 0x80))
+
+// the maximum item count for the given slot count, the load factor is 7/8
+#define tb_hash_map_slot_limit(n)                       ((n) - ((n) >> 3))
 
-// the self bucket item maximum size
-#define TB_HASH_MAP_BUCKET_ITEM_MAXN                    (1 << 16)
+// the minimum slot count of the table for migrating it incrementally, the smaller table will be rehashed at once
+#ifdef __tb_small__
+#   define TB_HASH_MAP_MIGRATE_MINN                     (1 << 12)
+#else
+#   define TB_HASH_MAP_MIGRATE_MINN                     (1 << 13)
+#endif
+
+/* the migrated group count of the old table for each insert, get and remove
+ *
+ * get and remove only migrate the old slots which have not been walked while walking
+ */
+#define TB_HASH_MAP_MIGRATE_STEP                        (4)
+
+/* the cleared control bytes of the next table for each insert
+ *
+ * the next table will be made before the large table is full, and its control bytes are cleared gradually,
+ * so they have been cleared before the left slots (maxn / 16) are used up
+ */
+#define TB_HASH_MAP_CLEAR_STEP                          (TB_HASH_MAP_MIGRATE_STEP * TB_HASH_MAP_GROUP_SIZE)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the hash map item list type
-typedef struct __tb_hash_map_item_list_t
+// the hash map table type
+typedef struct __tb_hash_map_table_t
 {
-    // the list size
-    tb_size_t                       size;
+    // the control bytes, ctrl[i] is the 7-bits hash of the name if the slot i is full
+    tb_byte_t*                      ctrl;
+
+    // the slots, each slot stores the name and data items
+    tb_byte_t*                      slots;
 
-    // the list maxn
+    // the slot maxn, the power of 2 and not less than the group size
     tb_size_t                       maxn;
 
-}tb_hash_map_item_list_t;
+    // the left slot count for inserting new items before growing
+    tb_size_t                       left;
 
-// the hash map type
+    // the item size
+    tb_size_t                       size;
+
+}tb_hash_map_table_t;
+
+/* the hash map type
+ *
+ * the items of the old table will be migrated to the new table incrementally after growing the large table, 
+ * and the itor is the index of the slots of the old table and the new table:
+ *
+ * itor: 1 ... table_old.maxn, table_old.maxn + 1 ... table_old.maxn + table.maxn
+ */
 typedef struct __tb_hash_map_t
 {
     // the item itor
     tb_iterator_t                   itor;
 
-    // the hash list
-    tb_hash_map_item_list_t**       hash_list;
+    // the table
+    tb_hash_map_table_t             table;
 
-    // the hash list size
-    tb_size_t                       hash_size;
+    // the old table for migrating
+    tb_hash_map_table_t             table_old;
 
-    // the current item for iterator
-    tb_hash_map_item_t              item;
+    // the next table for growing
+    tb_hash_map_table_t             table_new;
 
-    // the item size
-    tb_size_t                       item_size;
+    // the cleared control bytes of the next table
+    tb_size_t                       cleared;
 
-    // the item maxn
-    tb_size_t                       item_maxn;
+    // the old slots are migrated from the tail to the head, all slots in [migrate, table_old.maxn) have been migrated
+    tb_size_t                       migrate;
 
-    // the item grow
-    tb_size_t                       item_grow;
+    // the count of the unfinished walkings, the walkings which are broken early will be finished by the next insert or clear
+    tb_size_t                       walking;
+
+    // the farthest itor of the walkings, get and remove only migrate the old slots after it
+    tb_size_t                       walked;
+
+    // the current item for iterator
+    tb_hash_map_item_t              item;
+
+    // the item step
+    tb_size_t                       item_step;
 
     // the element for name
     tb_element_t                    element_name;
@@ -120,124 +167,427 @@ typedef struct __tb_hash_map_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-#if 0
-// linear finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+#if defined(TB_ARCH_SSE2)
+static __tb_inline_force__ tb_uint32_t tb_hash_map_group_match(tb_byte_t const* group, tb_byte_t c)
 {
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
-    
-    // get step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return_val(step, tb_false);
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((tb_char_t)c), _mm_loadu_si128((__m128i const*)group)));
+}
+static __tb_inline_force__ tb_uint32_t tb_hash_map_group_match_free(tb_byte_t const* group)
+{
+    // the empty and deleted slots have the high bit
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)group));
+}
+#elif defined(TB_ARCH_ARM_NEON)
+static __tb_inline_force__ tb_uint32_t tb_hash_map_group_mask(uint8x16_t m)
+{
+    // the bit weights of the lanes
+    static tb_byte_t const s_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+    // sum the weighted lanes of the low and high halves to the 16-bits mask
+    uint8x8_t s;
+    m = vandq_u8(m, vld1q_u8(s_bits));
+    s = vpadd_u8(vget_low_u8(m), vget_high_u8(m));
+    s = vpadd_u8(s, s);
+    s = vpadd_u8(s, s);
+    return (tb_uint32_t)vget_lane_u16(vreinterpret_u16_u8(s), 0);
+}
+static __tb_inline_force__ tb_uint32_t tb_hash_map_group_match(tb_byte_t const* group, tb_byte_t c)
+{
+    return tb_hash_map_group_mask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(c)));
+}
+static __tb_inline_force__ tb_uint32_t tb_hash_map_group_match_free(tb_byte_t const* group)
+{
+    // the empty and deleted slots have the high bit
+    return tb_hash_map_group_mask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(group)), vdupq_n_s8(0)));
+}
+#else
+static __tb_inline__ tb_uint32_t tb_hash_map_group_match(tb_byte_t const* group, tb_byte_t c)
+{
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (i = 0; i < TB_HASH_MAP_GROUP_SIZE; i++)
+        if (group[i] == c) m |= (1 << i);
+    return m;
+}
+static __tb_inline__ tb_uint32_t tb_hash_map_group_match_free(tb_byte_t const* group)
+{
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (i = 0; i < TB_HASH_MAP_GROUP_SIZE; i++)
+        if (!tb_hash_map_ctrl_is_full(group[i])) m |= (1 << i);
+    return m;
+}
+#endif
+static __tb_inline__ tb_size_t tb_hash_map_hash(tb_hash_map_t* hash_map, tb_cpointer_t name)
+{
+    // compute the full hash value of the name
+    tb_size_t hash = hash_map->element_name.hash(&hash_map->element_name, name, (tb_size_t)-1, 0);
 
-    // comupte hash_map from name
-    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
+    /* mix all bits of the hash value
+     *
+     * the low 7-bits is saved to the control byte and the other bits are used to find the group, 
+     * so we need mix the poor element hash values (e.g. the integer) first
+     */
+#if TB_CPU_BIT64
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+#else
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+#endif
+    return hash;
+}
+static __tb_inline__ tb_byte_t* tb_hash_map_table_item(tb_hash_map_t* hash_map, tb_hash_map_table_t* table, tb_size_t slot)
+{
+    return table->slots + slot * hash_map->item_step;
+}
+static tb_bool_t tb_hash_map_table_init(tb_hash_map_t* hash_map, tb_hash_map_table_t* table, tb_size_t maxn, tb_bool_t clear)
+{
+    // check
+    tb_assert(hash_map && table && maxn >= TB_HASH_MAP_GROUP_SIZE && tb_ispow2(maxn));
+    tb_assert_and_check_return_val(maxn < ((tb_size_t)-1) / (hash_map->item_step + 1), tb_false);
 
-    // update buck
-    if (pbuck) *pbuck = buck;
+    // make the control bytes and slots
+    tb_byte_t* ctrl = (tb_byte_t*)tb_malloc(maxn * (hash_map->item_step + 1));
+    tb_assert_and_check_return_val(ctrl, tb_false);
 
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_check_return_val(list && list->size, tb_false);
+    // init table, the control bytes of the next table will be cleared later
+    if (clear) tb_memset(ctrl, TB_HASH_MAP_CTRL_EMPTY, maxn);
+    table->ctrl     = ctrl;
+    table->slots    = ctrl + maxn;
+    table->maxn     = maxn;
+    table->left     = tb_hash_map_slot_limit(maxn);
+    table->size     = 0;
 
-    // find item
-    tb_long_t   r = 1;
-    tb_size_t   i = 0;
-    tb_size_t   n = list->size;
-    for (i = 0; i < n; i++)
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_hash_map_table_exit(tb_hash_map_table_t* table)
+{
+    // check
+    tb_assert(table);
+
+    // exit it
+    if (table->ctrl) tb_free(table->ctrl);
+    tb_memset(table, 0, sizeof(tb_hash_map_table_t));
+}
+static tb_size_t tb_hash_map_table_find(tb_hash_map_t* hash_map, tb_hash_map_table_t* table, tb_cpointer_t name, tb_size_t hash)
+{
+    // check
+    tb_assert(hash_map && table);
+
+    // empty?
+    tb_check_return_val(table->size, table->maxn);
+
+    /* find it by probing the groups
+     *
+     * the group index: g(i) = (g(0) + i * (i + 1) / 2) & mask, it will walk all groups
+     */
+    tb_byte_t   h2 = (tb_byte_t)(hash & 0x7f);
+    tb_size_t   mask = (table->maxn / TB_HASH_MAP_GROUP_SIZE) - 1;
+    tb_size_t   group = (hash >> 7) & mask;
+    tb_size_t   probe = 0;
+    tb_size_t   step = hash_map->item_step;
+    tb_byte_t*  slots = table->slots;
+    while (1)
     {
-        // get item
-        tb_byte_t const* item = ((tb_byte_t*)&list[1]) + i * step;
+        // the control bytes of this group
+        tb_byte_t const* ctrl = table->ctrl + group * TB_HASH_MAP_GROUP_SIZE;
+
+        // compare all slots with the same 7-bits hash in this group
+        tb_uint32_t m = tb_hash_map_group_match(ctrl, h2);
+        while (m)
+        {
+            // the slot
+            tb_size_t slot = group * TB_HASH_MAP_GROUP_SIZE + tb_bits_fb1_u32_le(m);
+
+            // found?
+            if (!hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, slots + slot * step))) 
+                return slot;
+
+            // the next slot
+            m &= m - 1;
+        }
+
+        // exists empty slots in this group? not found
+        if (tb_hash_map_group_match(ctrl, TB_HASH_MAP_CTRL_EMPTY)) break;
 
-        // compare it
-        r = hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, item));
-        if (r <= 0) break;
+        // all groups have been probed?
+        if (probe++ == mask) break;
+
+        // the next group
+        group = (group + probe) & mask;
     }
 
-    // update item
-    if (pitem) *pitem = i;
+    // not found
+    return table->maxn;
+}
+static tb_size_t tb_hash_map_table_free(tb_hash_map_table_t* table, tb_size_t hash)
+{
+    // check
+    tb_assert(table && table->ctrl);
+
+    // find the first empty or deleted slot
+    tb_size_t mask = (table->maxn / TB_HASH_MAP_GROUP_SIZE) - 1;
+    tb_size_t group = (hash >> 7) & mask;
+    tb_size_t probe = 0;
+    while (1)
+    {
+        // found?
+        tb_uint32_t m = tb_hash_map_group_match_free(table->ctrl + group * TB_HASH_MAP_GROUP_SIZE);
+        if (m) return group * TB_HASH_MAP_GROUP_SIZE + tb_bits_fb1_u32_le(m);
+
+        // the next group
+        probe++;
+        tb_assert_and_check_break(probe <= mask);
+        group = (group + probe) & mask;
+    }
 
-    // ok?
-    return !r? tb_true : tb_false;
+    // no free slots
+    return table->maxn;
 }
-#else
-// binary finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+static tb_size_t tb_hash_map_table_next(tb_hash_map_table_t* table, tb_size_t slot)
 {
     // check
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
-    
-    // get step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return_val(step, tb_false);
-
-    // comupte hash_map from name
-    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
-
-    // update buck
-    if (pbuck) *pbuck = buck;
-
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_check_return_val(list && list->size, tb_false);
-
-    // find item
-    tb_long_t   t = 1;
-    tb_size_t   l = 0;
-    tb_size_t   r = list->size;
-    tb_size_t   m = (l + r) >> 1;
-    while (l < r)
+    tb_assert(table);
+
+    // find the next full slot from the given slot
+    tb_size_t maxn = table->size? table->maxn : 0;
+    while (slot < maxn)
     {
-        // get item
-        tb_byte_t const* item = ((tb_byte_t*)&list[1]) + m * step;
-
-        // compare it
-        t = hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, item));
-        if (t < 0) r = m;
-        else if (t > 0) l = m + 1;
-        else break;
-    
-        // next
-        m = (l + r) >> 1;
+        // the full slots of this group after the given slot
+        tb_size_t   group = slot & ~(TB_HASH_MAP_GROUP_SIZE - 1);
+        tb_uint32_t m = (~tb_hash_map_group_match_free(table->ctrl + group) & 0xffff) >> (slot - group);
+        if (m) return slot + tb_bits_fb1_u32_le(m);
+
+        // the next group
+        slot = group + TB_HASH_MAP_GROUP_SIZE;
     }
+    return table->maxn;
+}
+static tb_void_t tb_hash_map_table_move(tb_hash_map_t* hash_map, tb_hash_map_table_t* table, tb_byte_t const* item)
+{
+    // check
+    tb_assert(hash_map && table && table->left && item);
+
+    // move it to the free slot, the items are moved directly like the memmov() of vector
+    tb_size_t hash = tb_hash_map_hash(hash_map, hash_map->element_name.data(&hash_map->element_name, item));
+    tb_size_t slot = tb_hash_map_table_free(table, hash);
+    tb_assert(slot < table->maxn);
+    if (table->ctrl[slot] == TB_HASH_MAP_CTRL_EMPTY) table->left--;
+    table->ctrl[slot] = (tb_byte_t)(hash & 0x7f);
+    tb_memcpy(tb_hash_map_table_item(hash_map, table, slot), item, hash_map->item_step);
+    table->size++;
+}
+static tb_void_t tb_hash_map_table_remove(tb_hash_map_t* hash_map, tb_hash_map_table_t* table, tb_size_t slot)
+{
+    // check
+    tb_assert(hash_map && table && slot < table->maxn && tb_hash_map_ctrl_is_full(table->ctrl[slot]));
 
-    /* update item
+    // free item
+    tb_byte_t* item = tb_hash_map_table_item(hash_map, table, slot);
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+
+    /* mark this slot as empty if there are some empty slots in this group, 
+     * because the probing of all names never passed this group. 
      *
-     * @note: m is not the prev not same item if not finded and list has repeat items
-     * but this hash_map not exists repeat
+     * otherwise mark it as deleted for continuing to probe the next groups.
+     */
+    tb_size_t group = slot & ~(TB_HASH_MAP_GROUP_SIZE - 1);
+    if (tb_hash_map_group_match(table->ctrl + group, TB_HASH_MAP_CTRL_EMPTY))
+    {
+        table->ctrl[slot] = TB_HASH_MAP_CTRL_EMPTY;
+        table->left++;
+    }
+    else table->ctrl[slot] = TB_HASH_MAP_CTRL_DELETED;
+
+    // update the item size
+    table->size--;
+}
+static tb_void_t tb_hash_map_table_clear(tb_hash_map_t* hash_map, tb_hash_map_table_t* table)
+{
+    // check
+    tb_assert(hash_map && table);
+
+    // no slots?
+    tb_check_return(table->ctrl);
+
+    // free items
+    if (table->size && (hash_map->element_name.free || hash_map->element_data.free))
+    {
+        tb_size_t slot = tb_hash_map_table_next(table, 0);
+        while (slot < table->maxn)
+        {
+            tb_byte_t* item = tb_hash_map_table_item(hash_map, table, slot);
+            if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+            if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+            slot = tb_hash_map_table_next(table, slot + 1);
+        }
+    }
+
+    // clear slots
+    tb_memset(table->ctrl, TB_HASH_MAP_CTRL_EMPTY, table->maxn);
+    table->size = 0;
+    table->left = tb_hash_map_slot_limit(table->maxn);
+}
+static tb_void_t tb_hash_map_migrate(tb_hash_map_t* hash_map, tb_size_t groups)
+{
+    // check
+    tb_assert(hash_map && hash_map->table_old.ctrl);
+
+    /* move the items of the previous groups in the old table to the new table
      *
-     * @see tb_binary_pfind()
+     * the walked old slots will not be migrated, otherwise they will be walked again in the new table
      */
-    if (pitem) *pitem = m;
+    tb_hash_map_table_t*    table = &hash_map->table;
+    tb_hash_map_table_t*    table_old = &hash_map->table_old;
+    tb_size_t               tail = hash_map->migrate;
+    tb_size_t               slot = tail > groups * TB_HASH_MAP_GROUP_SIZE? tail - groups * TB_HASH_MAP_GROUP_SIZE : 0;
+    if (slot < hash_map->walked) slot = hash_map->walked;
+    if (slot < tail)
+    {
+        hash_map->migrate = slot;
+        for (; slot < tail && table_old->size; slot++)
+        {
+            // full slot?
+            tb_check_continue(tb_hash_map_ctrl_is_full(table_old->ctrl[slot]));
 
-    // ok?
-    return !t? tb_true : tb_false;
+            // move it
+            tb_hash_map_table_move(hash_map, table, tb_hash_map_table_item(hash_map, table_old, slot));
+            table_old->ctrl[slot] = TB_HASH_MAP_CTRL_DELETED;
+            table_old->size--;
+        }
+    }
+
+    // all items have been migrated? exit the old table if not walking, otherwise the itors will be changed
+    if (!hash_map->walking && (!hash_map->migrate || !table_old->size))
+    {
+        // trace
+        tb_trace_d("migrate: %lu => %lu, size: %lu: ok", table_old->maxn, table->maxn, table->size);
+
+        // exit it
+        tb_hash_map_table_exit(table_old);
+        hash_map->migrate = 0;
+        return ;
+    }
+
+    // release the migrated slots at the tail of the old table gradually instead of freeing the large table at once
+    tb_size_t keep = tb_align(hash_map->migrate, TB_HASH_MAP_MIGRATE_MINN);
+    if (keep < tb_align(tail, TB_HASH_MAP_MIGRATE_MINN))
+    {
+        tb_byte_t* ctrl = (tb_byte_t*)tb_ralloc(table_old->ctrl, table_old->maxn + keep * hash_map->item_step);
+        if (ctrl)
+        {
+            table_old->ctrl     = ctrl;
+            table_old->slots    = ctrl + table_old->maxn;
+        }
+    }
 }
-#endif
-static tb_bool_t tb_hash_map_item_at(tb_hash_map_t* hash_map, tb_size_t buck, tb_size_t item, tb_pointer_t* pname, tb_pointer_t* pdata)
+static tb_bool_t tb_hash_map_resize(tb_hash_map_t* hash_map, tb_size_t maxn)
 {
     // check
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size && buck < hash_map->hash_size, tb_false);
-    
-    // get step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return_val(step, tb_false);
+    tb_assert(hash_map);
 
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_check_return_val(list && list->size && item < list->size, tb_false);
+    // finish the previous migration first
+    if (hash_map->table_old.ctrl) tb_hash_map_migrate(hash_map, hash_map->table_old.maxn / TB_HASH_MAP_GROUP_SIZE);
+    tb_assert(!hash_map->table_old.ctrl);
 
-    // get name
-    if (pname) *pname = hash_map->element_name.data(&hash_map->element_name, ((tb_byte_t*)&list[1]) + item * step);
-    
-    // get data
-    if (pdata) *pdata = hash_map->element_data.data(&hash_map->element_data, ((tb_byte_t*)&list[1]) + item * step + hash_map->element_name.size);
+    // make the new table, use the next table directly if it has been made
+    tb_hash_map_table_t table;
+    if (hash_map->table_new.ctrl && hash_map->table_new.maxn == maxn)
+    {
+        // clear the left control bytes
+        table = hash_map->table_new;
+        tb_memset(table.ctrl + hash_map->cleared, TB_HASH_MAP_CTRL_EMPTY, maxn - hash_map->cleared);
+        tb_memset(&hash_map->table_new, 0, sizeof(tb_hash_map_table_t));
+    }
+    else
+    {
+        tb_hash_map_table_exit(&hash_map->table_new);
+        if (!tb_hash_map_table_init(hash_map, &table, maxn, tb_true)) return tb_false;
+    }
+    hash_map->cleared = 0;
+
+    // trace
+    tb_trace_d("resize: %lu => %lu, size: %lu", hash_map->table.maxn, maxn, hash_map->table.size);
+
+    // the old table will be migrated incrementally if it is large
+    hash_map->table_old = hash_map->table;
+    hash_map->table     = table;
+    hash_map->migrate   = hash_map->table_old.maxn;
+    if (hash_map->table_old.maxn < TB_HASH_MAP_MIGRATE_MINN && hash_map->table_old.ctrl) 
+        tb_hash_map_migrate(hash_map, hash_map->table_old.maxn / TB_HASH_MAP_GROUP_SIZE);
 
     // ok
     return tb_true;
 }
+static tb_void_t tb_hash_map_prepare(tb_hash_map_t* hash_map)
+{
+    // check
+    tb_assert(hash_map);
+
+    // make the next table if the large table will be grown soon
+    tb_hash_map_table_t* table = &hash_map->table;
+    tb_hash_map_table_t* table_new = &hash_map->table_new;
+    if (!table_new->ctrl)
+    {
+        tb_check_return(table->maxn >= TB_HASH_MAP_MIGRATE_MINN && table->left <= (table->maxn >> 4));
+        tb_check_return(table->size + hash_map->table_old.size >= (tb_hash_map_slot_limit(table->maxn) >> 1));
+        if (!tb_hash_map_table_init(hash_map, table_new, table->maxn << 1, tb_false)) return ;
+        hash_map->cleared = 0;
+    }
+
+    // clear the control bytes of the next table gradually instead of clearing them at once when growing
+    tb_size_t cleared = tb_min(hash_map->cleared + TB_HASH_MAP_CLEAR_STEP, table_new->maxn);
+    if (cleared > hash_map->cleared)
+    {
+        tb_memset(table_new->ctrl + hash_map->cleared, TB_HASH_MAP_CTRL_EMPTY, cleared - hash_map->cleared);
+        hash_map->cleared = cleared;
+    }
+}
+static tb_hash_map_table_t* tb_hash_map_itor_table(tb_hash_map_t* hash_map, tb_size_t itor, tb_size_t* pslot)
+{
+    // check
+    tb_assert(hash_map && itor && pslot);
+
+    // the slot index
+    tb_size_t index = itor - 1;
+
+    // in the old table?
+    if (index < hash_map->table_old.maxn)
+    {
+        *pslot = index;
+        return &hash_map->table_old;
+    }
+
+    // in the table
+    *pslot = index - hash_map->table_old.maxn;
+    return *pslot < hash_map->table.maxn? &hash_map->table : tb_null;
+}
+static tb_size_t tb_hash_map_itor_from(tb_hash_map_t* hash_map, tb_size_t index)
+{
+    // check
+    tb_assert(hash_map);
+
+    // find the next full slot from the old table
+    tb_size_t maxn_old = hash_map->table_old.maxn;
+    if (index < maxn_old)
+    {
+        tb_size_t slot = tb_hash_map_table_next(&hash_map->table_old, index);
+        if (slot < maxn_old) return slot + 1;
+        index = maxn_old;
+    }
+
+    // find the next full slot from the table
+    tb_size_t slot = tb_hash_map_table_next(&hash_map->table, index - maxn_old);
+    if (slot < hash_map->table.maxn) return maxn_old + slot + 1;
+
+    // end
+    return 0;
+}
 static tb_size_t tb_hash_map_itor_size(tb_iterator_ref_t iterator)
 {
     // check
@@ -245,7 +595,7 @@ static tb_size_t tb_hash_map_itor_size(tb_iterator_ref_t iterator)
     tb_assert(hash_map);
 
     // the size
-    return hash_map->item_size;
+    return hash_map->table.size + hash_map->table_old.size;
 }
 static tb_size_t tb_hash_map_itor_head(tb_iterator_ref_t iterator)
 {
@@ -254,14 +604,15 @@ static tb_size_t tb_hash_map_itor_head(tb_iterator_ref_t iterator)
     tb_assert(hash_map);
 
     // find the head
-    tb_size_t i = 0;
-    tb_size_t n = hash_map->hash_size;
-    for (i = 0; i < n; i++)
+    tb_size_t itor = tb_hash_map_itor_from(hash_map, 0);
+
+    // start walking, get and remove will not migrate the walked old slots until all walkings are finished
+    if (itor && hash_map->table_old.ctrl)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
-        if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
+        hash_map->walking++;
+        if (itor > hash_map->walked) hash_map->walked = itor;
     }
-    return 0;
+    return itor;
 }
 static tb_size_t tb_hash_map_itor_tail(tb_iterator_ref_t iterator)
 {
@@ -271,32 +622,18 @@ static tb_size_t tb_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t ito
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)iterator;
-    tb_assert(hash_map && hash_map->hash_list && hash_map->hash_size);
-
-    // the current buck and item
-    tb_size_t buck = tb_hash_map_index_buck(itor);
-    tb_size_t item = tb_hash_map_index_item(itor);
-    tb_assert(buck && item);
-
-    // compute index
-    buck--;
-    item--;
-    tb_assert(buck < hash_map->hash_size && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(hash_map && itor);
 
-    // find the next from the current buck first
-    if (hash_map->hash_list[buck] && item + 1 < hash_map->hash_list[buck]->size) return tb_hash_map_index_make(buck + 1, item + 2);
+    // find the next from the next slot, the itor is the slot index + 1
+    tb_size_t next = tb_hash_map_itor_from(hash_map, itor);
 
-    // find the next from the next buckets
-    tb_size_t i;
-    tb_size_t n = hash_map->hash_size;
-    for (i = buck + 1; i < n; i++)
+    // update the farthest walked itor, or finish this walking if it is the end
+    if (hash_map->walking)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
-        if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
+        if (next > hash_map->walked) hash_map->walked = next;
+        else if (!next && !--hash_map->walking) hash_map->walked = 0;
     }
-
-    // tail
-    return 0;
+    return next;
 }
 static tb_pointer_t tb_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
 {
@@ -304,38 +641,22 @@ static tb_pointer_t tb_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t
     tb_hash_map_t* hash_map = (tb_hash_map_t*)iterator;
     tb_assert(hash_map && itor);
 
-    // get the buck and item
-    tb_size_t buck = tb_hash_map_index_buck(itor);
-    tb_size_t item = tb_hash_map_index_item(itor);
-    tb_assert_and_check_return_val(buck && item, tb_null);
-
-    // get item
-    if (tb_hash_map_item_at(hash_map, buck - 1, item - 1, &((tb_hash_map_t*)hash_map)->item.name, &((tb_hash_map_t*)hash_map)->item.data))
-        return &(hash_map->item);
-    return tb_null;
+    // load the item to the cached item
+    return tb_hash_map_load((tb_hash_map_ref_t)hash_map, itor, &hash_map->item)? &(hash_map->item) : tb_null;
 }
 static tb_void_t tb_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)iterator;
-    tb_assert(hash_map && hash_map->hash_list && hash_map->hash_size);
-    
-    // the buck and item
-    tb_size_t b = tb_hash_map_index_buck(itor);
-    tb_size_t i = tb_hash_map_index_item(itor);
-    tb_assert(b && i); b--; i--;
-    tb_assert(b < hash_map->hash_size);
-
-    // step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert(step);
+    tb_assert(hash_map && itor);
 
-    // list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[b];
-    tb_check_return(list && list->size && i < list->size);
+    // the slot
+    tb_size_t               slot = 0;
+    tb_hash_map_table_t*    table = tb_hash_map_itor_table(hash_map, itor, &slot);
+    tb_check_return(table && tb_hash_map_ctrl_is_full(table->ctrl[slot]));
 
     // note: copy data only, will destroy hash_map index if copy name
-    hash_map->element_data.copy(&hash_map->element_data, ((tb_byte_t*)&list[1]) + i * step + hash_map->element_name.size, item);
+    hash_map->element_data.copy(&hash_map->element_data, tb_hash_map_table_item(hash_map, table, slot) + hash_map->element_name.size, item);
 }
 static tb_long_t tb_hash_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
 {
@@ -350,131 +671,66 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)iterator;
-    tb_assert(hash_map && hash_map->hash_list && hash_map->hash_size);
-    
-    // buck & item
-    tb_size_t buck = tb_hash_map_index_buck(itor);
-    tb_size_t item = tb_hash_map_index_item(itor);
-    tb_assert(buck && item); buck--; item--;
-    tb_assert(buck < hash_map->hash_size);
-
-    // the step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert(step);
-
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_assert(list && list->size && item < list->size);
-
-    // free item
-    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, ((tb_byte_t*)&list[1]) + item * step);
-    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, ((tb_byte_t*)&list[1]) + item * step + hash_map->element_name.size);
-
-    // remove item from the list
-    if (list->size > 1)
-    {
-        // move items
-        if (item < list->size - 1) tb_memmov(((tb_byte_t*)&list[1]) + item * step, ((tb_byte_t*)&list[1]) + (item + 1) * step, (list->size - item - 1) * step);
-
-        // update size
-        list->size--;
-    }
-    // remove list
-    else 
-    {
-        // free it
-        tb_free(list);
+    tb_assert(hash_map && itor);
 
-        // reset
-        hash_map->hash_list[buck] = tb_null;
-    }
+    // the slot
+    tb_size_t               slot = 0;
+    tb_hash_map_table_t*    table = tb_hash_map_itor_table(hash_map, itor, &slot);
+    tb_assert_and_check_return(table);
 
-    // update the hash_map item size
-    hash_map->item_size--;
+    // remove it, the other items will not be moved
+    tb_hash_map_table_remove(hash_map, table, slot);
 }
 static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)iterator;
-    tb_assert(hash_map && hash_map->hash_list && hash_map->hash_size);
+    tb_assert(hash_map);
 
     // no size
     tb_check_return(size);
 
-    // the step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert(step);
-
-    // the first itor
-    tb_size_t itor = prev? tb_hash_map_itor_next(iterator, prev) : tb_hash_map_itor_head(iterator);
-
-    // the head buck and item
-    tb_size_t buck_head = tb_hash_map_index_buck(itor);
-    tb_size_t item_head = tb_hash_map_index_item(itor);
-    tb_assert(buck_head && item_head);
+    // remove items: [itor, next)
+    tb_size_t itor = tb_hash_map_itor_from(hash_map, prev);
+    while (itor && itor != next && size--)
+    {
+        // the next itor, the removed slot will be skipped
+        tb_size_t itor_next = tb_hash_map_itor_from(hash_map, itor);
 
-    // compute index
-    buck_head--;
-    item_head--;
-    tb_assert(buck_head < hash_map->hash_size && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+        // remove it
+        tb_hash_map_itor_remove(iterator, itor);
 
-    // the last buck and the tail item
-    tb_size_t buck_last;
-    tb_size_t item_tail;
-    if (next)
-    {
-        // next => buck and item
-        buck_last = tb_hash_map_index_buck(next);
-        item_tail = tb_hash_map_index_item(next);
-        tb_assert(buck_last && item_tail);
-
-        // compute index
-        buck_last--;
-        item_tail--;
-        tb_assert(buck_last < hash_map->hash_size && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+        // next
+        itor = itor_next;
     }
-    else 
+}
+static tb_size_t tb_hash_map_find_impl(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t hash, tb_hash_map_table_t** ptable)
+{
+    // check
+    tb_assert(hash_map && ptable);
+
+    // find it from the table
+    tb_size_t slot = tb_hash_map_table_find(hash_map, &hash_map->table, name, hash);
+    if (slot < hash_map->table.maxn)
     {
-        buck_last = hash_map->hash_size - 1;
-        item_tail = -1;
+        *ptable = &hash_map->table;
+        return slot;
     }
 
-    // remove items: [itor, next)
-    tb_size_t buck;
-    tb_size_t item;
-    tb_element_free_func_t name_free = hash_map->element_name.free;
-    tb_element_free_func_t data_free = hash_map->element_data.free;
-    for (buck = buck_head, item = item_head; buck <= buck_last; buck++, item = 0)
+    // find it from the old table
+    if (hash_map->table_old.ctrl)
     {
-        // the list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-        tb_check_continue(list && list->size);
-
-        // the tail
-        tb_size_t tail = (buck == buck_last && next)? item_tail : list->size;
-        tb_assert(tail != -1);
-        tb_check_continue(item < tail);
-
-        // the data
-        tb_byte_t* data = (tb_byte_t*)&list[1];
-
-        // free items
-        tb_size_t i = 0;
-        for (i = item; i < tail; i++)
+        slot = tb_hash_map_table_find(hash_map, &hash_map->table_old, name, hash);
+        if (slot < hash_map->table_old.maxn)
         {
-            if (name_free) name_free(&hash_map->element_name, data + i * step);
-            if (data_free) data_free(&hash_map->element_data, data + i * step + hash_map->element_name.size);
+            *ptable = &hash_map->table_old;
+            return slot;
         }
-
-        // move items
-        if (buck == buck_last && tail < list->size) tb_memmov(data + item * step, data + tail * step, (list->size - tail) * step);
-
-        // update the list size
-        list->size -= tail - item;
-
-        // update the item size
-        hash_map->item_size -= tail - item;
     }
+
+    // not found
+    *ptable = tb_null;
+    return 0;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -518,18 +774,11 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
         hash_map->itor.remove           = tb_hash_map_itor_remove;
         hash_map->itor.remove_range     = tb_hash_map_itor_remove_range;
 
-        // init self size
-        hash_map->hash_size = tb_align_pow2(bucket_size);
-        tb_assert_and_check_break(hash_map->hash_size <= TB_HASH_MAP_BUCKET_MAXN);
-
-        // init self list
-        hash_map->hash_list = (tb_hash_map_item_list_t**)tb_nalloc0(hash_map->hash_size, sizeof(tb_size_t));
-        tb_assert_and_check_break(hash_map->hash_list);
+        // init item step
+        hash_map->item_step = element_name.size + element_data.size;
 
-        // init item grow
-        hash_map->item_grow = tb_isqrti((tb_uint32_t)bucket_size);
-        if (hash_map->item_grow < 8) hash_map->item_grow = 8;
-        hash_map->item_grow = tb_align_pow2(hash_map->item_grow);
+        // init table
+        if (!tb_hash_map_table_init(hash_map, &hash_map->table, tb_max(tb_align_pow2(bucket_size), TB_HASH_MAP_GROUP_SIZE), tb_true)) break;
 
         // ok
         ok = tb_true;
@@ -556,8 +805,10 @@ tb_void_t tb_hash_map_exit(tb_hash_map_ref_t self)
     // clear it
     tb_hash_map_clear(self);
 
-    // free hash_map list
-    if (hash_map->hash_list) tb_free(hash_map->hash_list);
+    // exit tables
+    tb_hash_map_table_exit(&hash_map->table);
+    tb_hash_map_table_exit(&hash_map->table_old);
+    tb_hash_map_table_exit(&hash_map->table_new);
 
     // free it
     tb_free(hash_map);
@@ -566,42 +817,26 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
-    tb_assert_and_check_return(hash_map && hash_map->hash_list);
+    tb_assert_and_check_return(hash_map);
 
-    // step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return(step);
+    // clear the table
+    tb_hash_map_table_clear(hash_map, &hash_map->table);
 
-    // clear hash_map
-    tb_size_t i = 0;
-    tb_size_t n = hash_map->hash_size;
-    for (i = 0; i < n; i++)
+    // clear and exit the old table
+    if (hash_map->table_old.ctrl)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
-        if (list)
-        {
-            // free items
-            if (hash_map->element_name.free || hash_map->element_data.free)
-            {
-                tb_size_t j = 0;
-                tb_size_t m = list->size;
-                for (j = 0; j < m; j++)
-                {
-                    tb_byte_t* item = ((tb_byte_t*)&list[1]) + j * step;
-                    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
-                    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
-                }
-            }
-
-            // free list
-            tb_free(list);
-        }
-        hash_map->hash_list[i] = tb_null;
+        tb_hash_map_table_clear(hash_map, &hash_map->table_old);
+        tb_hash_map_table_exit(&hash_map->table_old);
     }
 
+    // exit the next table
+    tb_hash_map_table_exit(&hash_map->table_new);
+
     // reset info
-    hash_map->item_size = 0;
-    hash_map->item_maxn = 0;
+    hash_map->migrate = 0;
+    hash_map->cleared = 0;
+    hash_map->walking = 0;
+    hash_map->walked  = 0;
     tb_memset(&hash_map->item, 0, sizeof(tb_hash_map_item_t));
 }
 tb_pointer_t tb_hash_map_get(tb_hash_map_ref_t self, tb_cpointer_t name)
@@ -610,14 +845,13 @@ tb_pointer_t tb_hash_map_get(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, tb_null);
 
-    // find it
-    tb_size_t buck = 0;
-    tb_size_t item = 0;
-    if (!tb_hash_map_item_find(hash_map, name, &buck, &item)) return tb_null;
+    // migrate some items, only the old slots which have not been walked will be moved
+    if (hash_map->table_old.ctrl) tb_hash_map_migrate(hash_map, TB_HASH_MAP_MIGRATE_STEP);
 
-    // get data
-    tb_pointer_t data = tb_null;
-    return tb_hash_map_item_at(hash_map, buck, item, tb_null, &data)? data : tb_null;
+    // find it
+    tb_hash_map_table_t*    table = tb_null;
+    tb_size_t               slot = tb_hash_map_find_impl(hash_map, name, tb_hash_map_hash(hash_map, name), &table);
+    return table? hash_map->element_data.data(&hash_map->element_data, tb_hash_map_table_item(hash_map, table, slot) + hash_map->element_name.size) : tb_null;
 }
 tb_size_t tb_hash_map_find(tb_hash_map_ref_t self, tb_cpointer_t name)
 {
@@ -625,10 +859,30 @@ tb_size_t tb_hash_map_find(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, 0);
 
-    // find
-    tb_size_t buck = 0;
-    tb_size_t item = 0;
-    return tb_hash_map_item_find(hash_map, name, &buck, &item)? tb_hash_map_index_make(buck + 1, item + 1) : 0;
+    // find it
+    tb_hash_map_table_t*    table = tb_null;
+    tb_size_t               slot = tb_hash_map_find_impl(hash_map, name, tb_hash_map_hash(hash_map, name), &table);
+    tb_check_return_val(table, 0);
+
+    // the itor
+    return table == &hash_map->table? hash_map->table_old.maxn + slot + 1 : slot + 1;
+}
+tb_bool_t tb_hash_map_load(tb_hash_map_ref_t self, tb_size_t itor, tb_hash_map_item_ref_t item)
+{
+    // check
+    tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && itor && item, tb_false);
+
+    // the slot
+    tb_size_t               slot = 0;
+    tb_hash_map_table_t*    table = tb_hash_map_itor_table(hash_map, itor, &slot);
+    tb_assert_and_check_return_val(table && tb_hash_map_ctrl_is_full(table->ctrl[slot]), tb_false);
+
+    // load it
+    tb_byte_t* data = tb_hash_map_table_item(hash_map, table, slot);
+    item->name = hash_map->element_name.data(&hash_map->element_name, data);
+    item->data = hash_map->element_data.data(&hash_map->element_data, data + hash_map->element_name.size);
+    return tb_true;
 }
 tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
 {
@@ -636,99 +890,55 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpoi
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, 0);
 
-    // the step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return_val(step, 0);
+    // the inserting will change all itors and finish all walkings
+    hash_map->walking = 0;
+    hash_map->walked  = 0;
+
+    // migrate some items
+    if (hash_map->table_old.ctrl) tb_hash_map_migrate(hash_map, TB_HASH_MAP_MIGRATE_STEP);
 
     // find it
-    tb_size_t buck = 0;
-    tb_size_t item = 0;
-    if (tb_hash_map_item_find(hash_map, name, &buck, &item))
+    tb_hash_map_table_t*    table = tb_null;
+    tb_size_t               hash = tb_hash_map_hash(hash_map, name);
+    tb_size_t               slot = tb_hash_map_find_impl(hash_map, name, hash, &table);
+    if (table)
     {
-        // check
-        tb_assert_and_check_return_val(buck < hash_map->hash_size, 0);
-
-        // get list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-        tb_assert_and_check_return_val(list && list->size && item < list->size, 0);
-
         // replace data
-        hash_map->element_data.repl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + item * step + hash_map->element_name.size, data);
+        hash_map->element_data.repl(&hash_map->element_data, tb_hash_map_table_item(hash_map, table, slot) + hash_map->element_name.size, data);
     }
     else
     {
-        // check
-        tb_assert_and_check_return_val(buck < hash_map->hash_size, 0);
-
-        // get list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-        
-        // insert item
-        if (list)
-        {
-            // grow?
-            if (list->size >= list->maxn)
-            {
-                // check
-                tb_assert_and_check_return_val(hash_map->item_grow, 0);
+        // prepare the next table before growing it
+        tb_hash_map_prepare(hash_map);
 
-                // resize maxn
-                tb_size_t maxn = tb_align_pow2(list->maxn + hash_map->item_grow);
-                tb_assert_and_check_return_val(maxn > list->maxn, 0);
-
-                // realloc it
-                list = (tb_hash_map_item_list_t*)tb_ralloc(list, sizeof(tb_hash_map_item_list_t) + maxn * step);  
-                tb_assert_and_check_return_val(list, 0);
-
-                // update the hash_map item maxn
-                hash_map->item_maxn += maxn - list->maxn;
-
-                // update maxn
-                list->maxn = maxn;
-
-                // reattach list
-                hash_map->hash_list[buck] = list;
-            }
-            tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, 0);
-
-            // move items
-            if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
-
-            // dupl item
-            list->size++;
-            hash_map->element_name.dupl(&hash_map->element_name, ((tb_byte_t*)&list[1]) + item * step, name);
-            hash_map->element_data.dupl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + item * step + hash_map->element_name.size, data);
-
-        }
-        // create list for adding item
-        else
+        // no left slots? grow it or only drop the deleted slots if there are too many deleted slots
+        table = &hash_map->table;
+        if (!table->left)
         {
-            // check
-            tb_assert_and_check_return_val(hash_map->item_grow, 0);
-
-            // make list
-            list = (tb_hash_map_item_list_t*)tb_malloc0(sizeof(tb_hash_map_item_list_t) + hash_map->item_grow * step);
-            tb_assert_and_check_return_val(list, 0);
+            tb_size_t maxn = table->maxn;
+            if (table->size + hash_map->table_old.size >= (tb_hash_map_slot_limit(maxn) >> 1)) maxn <<= 1;
+            if (!tb_hash_map_resize(hash_map, maxn)) return 0;
+        }
 
-            // init list
-            list->size = 1;
-            list->maxn = hash_map->item_grow;
-            hash_map->element_name.dupl(&hash_map->element_name, ((tb_byte_t*)&list[1]), name);
-            hash_map->element_data.dupl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + hash_map->element_name.size, data);
+        // get a free slot
+        slot = tb_hash_map_table_free(table, hash);
+        tb_assert_and_check_return_val(slot < table->maxn, 0);
 
-            // attach list
-            hash_map->hash_list[buck] = list;
+        // the deleted slot will be reused directly
+        if (table->ctrl[slot] == TB_HASH_MAP_CTRL_EMPTY) table->left--;
 
-            // update the hash_map item maxn
-            hash_map->item_maxn += list->maxn;
-        }
+        // dupl item
+        tb_byte_t* item = tb_hash_map_table_item(hash_map, table, slot);
+        table->ctrl[slot] = (tb_byte_t)(hash & 0x7f);
+        hash_map->element_name.dupl(&hash_map->element_name, item, name);
+        hash_map->element_data.dupl(&hash_map->element_data, item + hash_map->element_name.size, data);
 
-        // update the hash_map item size
-        hash_map->item_size++;
+        // update the table size
+        table->size++;
     }
 
     // ok?
-    return tb_hash_map_index_make(buck + 1, item + 1);
+    return table == &hash_map->table? hash_map->table_old.maxn + slot + 1 : slot + 1;
 }
 tb_void_t tb_hash_map_remove(tb_hash_map_ref_t self, tb_cpointer_t name)
 {
@@ -736,11 +946,13 @@ tb_void_t tb_hash_map_remove(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return(hash_map);
 
-    // find it
-    tb_size_t buck = 0;
-    tb_size_t item = 0;
-    if (tb_hash_map_item_find(hash_map, name, &buck, &item))
-        tb_hash_map_itor_remove((tb_iterator_ref_t)hash_map, tb_hash_map_index_make(buck + 1, item + 1));
+    // migrate some items, only the old slots which have not been walked will be moved
+    if (hash_map->table_old.ctrl) tb_hash_map_migrate(hash_map, TB_HASH_MAP_MIGRATE_STEP);
+
+    // find and remove it
+    tb_hash_map_table_t*    table = tb_null;
+    tb_size_t               slot = tb_hash_map_find_impl(hash_map, name, tb_hash_map_hash(hash_map, name), &table);
+    if (table) tb_hash_map_table_remove(hash_map, table, slot);
 }
 tb_size_t tb_hash_map_size(tb_hash_map_ref_t self)
 {
@@ -749,7 +961,7 @@ tb_size_t tb_hash_map_size(tb_hash_map_ref_t self)
     tb_assert_and_check_return_val(hash_map, 0);
 
     // the size
-    return hash_map->item_size;
+    return hash_map->table.size + hash_map->table_old.size;
 }
 tb_size_t tb_hash_map_maxn(tb_hash_map_ref_t self)
 {
@@ -758,68 +970,49 @@ tb_size_t tb_hash_map_maxn(tb_hash_map_ref_t self)
     tb_assert_and_check_return_val(hash_map, 0);
 
     // the maxn
-    return hash_map->item_maxn;
+    return hash_map->table.maxn;
 }
 #ifdef __tb_debug__
 tb_void_t tb_hash_map_dump(tb_hash_map_ref_t self)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
-    tb_assert_and_check_return(hash_map && hash_map->hash_list);
-
-    // the step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return(step);
+    tb_assert_and_check_return(hash_map);
 
     // trace
     tb_trace_i("");
-    tb_trace_i("self: size: %lu", tb_hash_map_size(self));
+    tb_trace_i("self: size: %lu, maxn: %lu, migrating: %lu/%lu", tb_hash_map_size(self), tb_hash_map_maxn(self), hash_map->migrate, hash_map->table_old.maxn);
 
     // done
-    tb_size_t i = 0;
     tb_char_t name[4096];
     tb_char_t data[4096];
-    for (i = 0; i < hash_map->hash_size; i++)
+    tb_size_t itor = tb_hash_map_itor_from(hash_map, 0);
+    while (itor)
     {
-        // the list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
-        if (list)
+        // the item
+        tb_hash_map_item_ref_t item = (tb_hash_map_item_ref_t)tb_hash_map_itor_item((tb_iterator_ref_t)hash_map, itor);
+        tb_assert_and_check_break(item);
+
+        // trace
+        if (hash_map->element_name.cstr && hash_map->element_data.cstr)
         {
-            // trace
-            tb_trace_i("buck[%u]: size: %u, maxn: %u", i, list->size, list->maxn);
-
-            // done 
-            tb_size_t j = 0;
-            for (j = 0; j < list->size; j++)
-            {
-                // the item
-                tb_byte_t const* item = ((tb_byte_t*)&list[1]) + j * step;
-
-                // the item name
-                tb_pointer_t element_name = hash_map->element_name.data(&hash_map->element_name, item);
-
-                // the item data
-                tb_pointer_t element_data = hash_map->element_data.data(&hash_map->element_data, item + hash_map->element_name.size);
-
-                // trace
-                if (hash_map->element_name.cstr && hash_map->element_data.cstr)
-                {
-                    tb_trace_i("    %s => %s", hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
-                }
-                else if (hash_map->element_name.cstr) 
-                {
-                    tb_trace_i("    %s => %p", hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), element_data);
-                }
-                else if (hash_map->element_data.cstr) 
-                {
-                    tb_trace_i("    %x => %p", element_name, hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
-                }
-                else 
-                {
-                    tb_trace_i("    %p => %p", element_name, element_data);
-                }
-            }
+            tb_trace_i("    slot[%lu]: %s => %s", itor - 1, hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
         }
+        else if (hash_map->element_name.cstr) 
+        {
+            tb_trace_i("    slot[%lu]: %s => %p", itor - 1, hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), item->data);
+        }
+        else if (hash_map->element_data.cstr) 
+        {
+            tb_trace_i("    slot[%lu]: %x => %p", itor - 1, item->name, hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else 
+        {
+            tb_trace_i("    slot[%lu]: %p => %p", itor - 1, item->name, item->data);
+        }
+
+        // next
+        itor = tb_hash_map_itor_from(hash_map, itor);
     }
 }
 #endif
@@ -69,30 +69,27 @@ typedef struct __tb_hash_map_item_t
 /*! the hash map ref type
  *
  * <pre>
- *                 0        1        3       ...     ...                n       n + 1
- * hash_list: |--------|--------|--------|--------|--------|--------|--------|--------|
- *                         |
- *                       -----    
- * item_list:           |     |       key:0                                      
- *                       -----   
- *                      |     |       key:1                                              
- *                       -----               <= insert by binary search algorithm
- *                      |     |       key:2                                               
- *                       -----  
- *                      |     |       key:3                                               
- *                       -----   
- *                      |     |       key:4                                               
- *                       -----  
- *                      |     |                                              
- *                       -----  
- *                      |     |                                              
- *                       -----  
- *                      |     |                                              
- *                       -----  
+ *
+ * the open addressing hash map, the control bytes of 16 slots are probed at once by simd
+ *
+ *                  group: 0                    group: 1                         group: n
+ * ctrl:  |--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|--|...|--|--|--|--|
+ *          |     |                                 |
+ *       7-bits hash of name, empty or deleted      |
+ *          |     |                                 |
+ * slots: |-----|-----|-----|-----|-----|-----|-----|-----|-----|-----|-----|...|-----|-----|
+ *          |
+ *        name + data
+ *
+ * hash(name): |   group index and probe sequence   | 7-bits hash |
+ *
+ * the large table will be grown incrementally, the items of the old table are migrated 
+ * to the new table by a few groups for each insert, get and remove.
  *
  * </pre>
  *
- * @note the itor of the same item is mutable
+ * @note the itor of the same item is mutable, all itors will be changed after inserting,
+ * and get and remove only migrate the items which have not been walked while walking it
  */
 typedef tb_iterator_ref_t tb_hash_map_ref_t;
 
@@ -102,7 +99,7 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
 
 /*! init hash map
  *
- * @param bucket_size   the hash bucket size, using the default size if be zero
+ * @param bucket_size   the initial slot count, using the default size if be zero
  * @param element_name  the item for name
  * @param element_data  the item for data
  *
@@ -169,6 +166,32 @@ tb_pointer_t            tb_hash_map_get(tb_hash_map_ref_t hash_map, tb_cpointer_
  */
 tb_size_t               tb_hash_map_find(tb_hash_map_ref_t hash_map, tb_cpointer_t name);
 
+/*! load the name and data of the given itor to the item
+ *
+ * tb_iterator_item() returns the item cached in the hash map, 
+ * but this interface does not change the hash map, so it can be called from multiple readers.
+ *
+ * @note tb_hash_map_get, tb_hash_map_find, tb_hash_map_load, tb_iterator_head and tb_iterator_next are read-only
+ *
+ * @code
+ *
+ * // find item and load it
+ * tb_hash_map_item_t item;
+ * tb_size_t itor = tb_hash_map_find(hash_map, name);
+ * if (itor != tb_iterator_tail(hash_map) && tb_hash_map_load(hash_map, itor, &item))
+ * {
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param hash_map      the hash map
+ * @param itor          the item itor
+ * @param item          the loaded item
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_hash_map_load(tb_hash_map_ref_t hash_map, tb_size_t itor, tb_hash_map_item_ref_t item);
+
 /*! insert item data from name
  *
  * @note the pair (name => data) is unique
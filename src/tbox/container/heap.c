@@ -428,7 +428,7 @@ static tb_void_t tb_heap_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
     tb_assert(step);
 
     // free the item first
-    if (heap->element.free) heap->element.free(&heap->element, heap->data + itor * step);
+    if (heap->element.free && !tb_element_is_pod(&heap->element)) heap->element.free(&heap->element, heap->data + itor * step);
 
     // the removed item is not the last item?
     if (itor != heap->size - 1)
@@ -554,8 +554,8 @@ tb_void_t tb_heap_clear(tb_heap_ref_t self)
     tb_heap_t* heap = (tb_heap_t*)self;
     tb_assert_and_check_return(heap);
 
-    // free data
-    if (heap->element.nfree)
+    // free data, the pod items need not be freed
+    if (heap->element.nfree && !tb_element_is_pod(&heap->element))
         heap->element.nfree(&heap->element, heap->data, heap->size);
 
     // reset size 
@@ -592,8 +592,9 @@ tb_void_t tb_heap_put(tb_heap_ref_t self, tb_cpointer_t data)
     // no enough? grow it
     if (heap->size == heap->maxn)
     {
-        // the maxn
-        tb_size_t maxn = tb_align4(heap->maxn + heap->grow);
+        // the maxn, the grow of the large heap is proportional to its size
+        tb_size_t maxn = tb_align4(heap->maxn + (heap->maxn >> 1) + heap->grow);
+        if (maxn >= TB_HEAP_MAXN) maxn = tb_align4(heap->maxn + heap->grow);
         tb_assert_and_check_return(maxn < TB_HEAP_MAXN);
 
         // realloc data
@@ -635,7 +636,7 @@ tb_void_t tb_heap_pop(tb_heap_ref_t self)
     tb_assert_and_check_return(heap && heap->data && heap->size);
 
     // free the top item first
-    if (heap->element.free) heap->element.free(&heap->element, heap->data);
+    if (heap->element.free && !tb_element_is_pod(&heap->element)) heap->element.free(&heap->element, heap->data);
 
     // the last item is not in top 
     if (heap->size > 1)
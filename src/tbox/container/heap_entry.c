@@ -0,0 +1,229 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        heap_entry.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "heap_entry.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the heap grow
+#ifdef __tb_small__ 
+#   define TB_HEAP_ENTRY_GROW       (128)
+#else
+#   define TB_HEAP_ENTRY_GROW       (256)
+#endif
+
+// the heap maxn
+#ifdef __tb_small__
+#   define TB_HEAP_ENTRY_MAXN       (1 << 16)
+#else
+#   define TB_HEAP_ENTRY_MAXN       (1 << 30)
+#endif
+
+// the parent index
+#define tb_heap_entry_parent(index)     (((index) - 1) >> 2)
+
+// the first child index
+#define tb_heap_entry_child(index)      (((index) << 2) + 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_heap_entry_comp(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t lentry, tb_heap_entry_ref_t rentry)
+{
+    return heap->comp(tb_heap_entry(heap, lentry), tb_heap_entry(heap, rentry));
+}
+static tb_void_t tb_heap_entry_shift_up(tb_heap_entry_head_ref_t heap, tb_size_t index, tb_heap_entry_ref_t entry)
+{
+    // move the hole up until the parent is not greater than the entry
+    tb_heap_entry_ref_t* data = heap->data;
+    while (index)
+    {
+        // the parent
+        tb_size_t           parent = tb_heap_entry_parent(index);
+        tb_heap_entry_ref_t parent_entry = data[parent];
+        tb_check_break(tb_heap_entry_comp(heap, parent_entry, entry) > 0);
+
+        // move the parent down to the hole
+        data[index] = parent_entry;
+        parent_entry->index = index;
+        index = parent;
+    }
+
+    // save the entry to the hole
+    data[index] = entry;
+    entry->index = index;
+}
+static tb_void_t tb_heap_entry_shift_down(tb_heap_entry_head_ref_t heap, tb_size_t index, tb_heap_entry_ref_t entry)
+{
+    // move the hole down until the smallest child is not less than the entry
+    tb_size_t               size = heap->size;
+    tb_heap_entry_ref_t*    data = heap->data;
+    tb_size_t               child = 0;
+    while ((child = tb_heap_entry_child(index)) < size)
+    {
+        // find the smallest child of the four children
+        tb_size_t           tail = tb_min(child + 4, size);
+        tb_size_t           small = child;
+        tb_heap_entry_ref_t small_entry = data[child];
+        for (child++; child < tail; child++)
+        {
+            if (tb_heap_entry_comp(heap, data[child], small_entry) < 0)
+            {
+                small = child;
+                small_entry = data[child];
+            }
+        }
+        tb_check_break(tb_heap_entry_comp(heap, small_entry, entry) < 0);
+
+        // move the smallest child up to the hole
+        data[index] = small_entry;
+        small_entry->index = index;
+        index = small;
+    }
+
+    // save the entry to the hole
+    data[index] = entry;
+    entry->index = index;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_heap_entry_init_(tb_heap_entry_head_ref_t heap, tb_size_t entry_offset, tb_size_t grow, tb_heap_entry_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(heap && comp);
+
+    // init it
+    heap->data  = tb_null;
+    heap->size  = 0;
+    heap->maxn  = 0;
+    heap->grow  = grow? grow : TB_HEAP_ENTRY_GROW;
+    heap->eoff  = entry_offset;
+    heap->comp  = comp;
+}
+tb_void_t tb_heap_entry_exit(tb_heap_entry_head_ref_t heap)
+{
+    // check
+    tb_assert_and_check_return(heap);
+
+    // clear it
+    tb_heap_entry_clear(heap);
+
+    // exit data
+    if (heap->data) tb_free(heap->data);
+    heap->data = tb_null;
+    heap->maxn = 0;
+}
+tb_void_t tb_heap_entry_clear(tb_heap_entry_head_ref_t heap)
+{
+    // check
+    tb_assert_and_check_return(heap);
+
+    // detach all entries
+    tb_size_t i = 0;
+    for (i = 0; i < heap->size; i++) heap->data[i]->index = TB_HEAP_ENTRY_INDEX_NONE;
+
+    // clear size
+    heap->size = 0;
+}
+tb_bool_t tb_heap_entry_put(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t entry)
+{
+    // check
+    tb_assert_and_check_return_val(heap && entry, tb_false);
+
+    // no enough? grow it
+    if (heap->size == heap->maxn)
+    {
+        // the maxn, the grow of the large heap is proportional to its size
+        tb_size_t maxn = tb_align4(heap->maxn + (heap->maxn >> 1) + heap->grow);
+        if (maxn >= TB_HEAP_ENTRY_MAXN) maxn = tb_align4(heap->maxn + heap->grow);
+        tb_assert_and_check_return_val(maxn < TB_HEAP_ENTRY_MAXN, tb_false);
+
+        // realloc data
+        tb_heap_entry_ref_t* data = (tb_heap_entry_ref_t*)tb_ralloc(heap->data, maxn * sizeof(tb_heap_entry_ref_t));
+        tb_assert_and_check_return_val(data, tb_false);
+
+        // save data
+        heap->data = data;
+        heap->maxn = maxn;
+    }
+
+    // shift up the entry from the tail hole
+    tb_heap_entry_shift_up(heap, heap->size++, entry);
+    return tb_true;
+}
+tb_void_t tb_heap_entry_pop(tb_heap_entry_head_ref_t heap)
+{
+    // check
+    tb_assert_and_check_return(heap && heap->size);
+
+    // remove the top entry
+    tb_heap_entry_remove(heap, heap->data[0]);
+}
+tb_void_t tb_heap_entry_remove(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t entry)
+{
+    // check
+    tb_assert_and_check_return(heap && entry);
+
+    // the index
+    tb_size_t index = entry->index;
+    tb_assert_and_check_return(index < heap->size && heap->data[index] == entry);
+
+    // detach it
+    entry->index = TB_HEAP_ENTRY_INDEX_NONE;
+
+    // move the last entry to the hole
+    tb_size_t last = --heap->size;
+    if (index != last)
+    {
+        // shift up or down the last entry from the hole
+        tb_heap_entry_ref_t last_entry = heap->data[last];
+        if (index && tb_heap_entry_comp(heap, heap->data[tb_heap_entry_parent(index)], last_entry) > 0)
+            tb_heap_entry_shift_up(heap, index, last_entry);
+        else tb_heap_entry_shift_down(heap, index, last_entry);
+    }
+}
+tb_void_t tb_heap_entry_update(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t entry)
+{
+    // check
+    tb_assert_and_check_return(heap && entry);
+
+    // the index
+    tb_size_t index = entry->index;
+    tb_assert_and_check_return(index < heap->size && heap->data[index] == entry);
+
+    // shift up or down the entry from its position
+    if (index && tb_heap_entry_comp(heap, heap->data[tb_heap_entry_parent(index)], entry) > 0)
+        tb_heap_entry_shift_up(heap, index, entry);
+    else tb_heap_entry_shift_down(heap, index, entry);
+}
@@ -0,0 +1,288 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        heap_entry.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_HEAP_ENTRY_H
+#define TB_CONTAINER_HEAP_ENTRY_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the index of the entry which is not in the heap
+#define TB_HEAP_ENTRY_INDEX_NONE        ((tb_size_t)-1)
+
+/// get the heap item from the entry
+#define tb_heap_entry(head, entry)      ((((tb_byte_t*)(entry)) - (head)->eoff))
+
+/*! init the heap entry 
+ *
+ * @code
+ *
+    // the xxxx entry type
+    typedef struct __tb_xxxx_entry_t 
+    {
+        // the heap entry
+        tb_heap_entry_t     entry;
+
+        // the when
+        tb_hong_t           when;
+
+    }tb_xxxx_entry_t;
+
+    // the xxxx entry comp func
+    static tb_long_t tb_xxxx_entry_comp(tb_cpointer_t litem, tb_cpointer_t ritem)
+    {
+        // check
+        tb_assert(litem && ritem);
+
+        // comp it
+        tb_hong_t lwhen = ((tb_xxxx_entry_t*)litem)->when;
+        tb_hong_t rwhen = ((tb_xxxx_entry_t*)ritem)->when;
+        return lwhen > rwhen? 1 : (lwhen < rwhen? -1 : 0);
+    }
+
+    // init the heap
+    tb_heap_entry_head_t heap;
+    tb_heap_entry_init(&heap, tb_xxxx_entry_t, entry, 0, tb_xxxx_entry_comp);
+
+    // init the entry, it is not in the heap
+    tb_heap_entry_entry_init(&xxxx->entry);
+
+    // put a entry
+    tb_heap_entry_put(&heap, &xxxx->entry);
+
+    // update the entry after changing its when
+    xxxx->when = 10;
+    tb_heap_entry_update(&heap, &xxxx->entry);
+
+    // remove the entry
+    tb_heap_entry_remove(&heap, &xxxx->entry);
+
+ * @endcode
+ */
+#define tb_heap_entry_init(heap, type, entry, grow, comp)     tb_heap_entry_init_(heap, tb_offsetof(type, entry), grow, comp)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the heap entry comp func type
+ *
+ * @param litem                             the left-hand item
+ * @param ritem                             the right-hand item
+ *
+ * @return                                  equal: 0, 1: >, -1: <
+ */
+typedef tb_long_t                           (*tb_heap_entry_comp_t)(tb_cpointer_t litem, tb_cpointer_t ritem);
+
+/*! the heap entry type
+ *
+ * @note the entry must be initialized by tb_heap_entry_entry_init() before using it, 
+ * the zeroed entry will be regarded as the top entry of the heap.
+ */
+typedef struct __tb_heap_entry_t 
+{
+    /// the index in the heap, TB_HEAP_ENTRY_INDEX_NONE if not in the heap
+    tb_size_t                   index;
+
+}tb_heap_entry_t, *tb_heap_entry_ref_t;
+
+/*! the heap entry head type
+ *
+ * the min heap of the 4-ary layout, each entry stores its index in the heap,
+ * so the entry can be removed or updated directly without finding it.
+ *
+ * <pre>
+ * heap:                              0(top)
+ *                 --------------------------------------------
+ *                |             |               |              |
+ *                1             2               3              4
+ *          -------------   -------------
+ *         |    |    |   | |    |    |   |
+ *         5    6    7   8 9    10   11  12 
+ *
+ * parent: (i - 1) / 4, children: 4 * i + 1 ... 4 * i + 4
+ * </pre>
+ *
+ * performance: 
+ *
+ * put: O(lgn)
+ * pop: O(lgn)
+ * top: O(1)
+ * remove: O(lgn)
+ * update: O(lgn)
+ *
+ * the 4-ary heap is shallower than the binary heap, so the entries are moved less times for put and pop.
+ */
+typedef struct __tb_heap_entry_head_t 
+{
+    /// the entries
+    tb_heap_entry_ref_t*        data;
+
+    /// the entry count
+    tb_size_t                   size;
+
+    /// the entry maxn
+    tb_size_t                   maxn;
+
+    /// the grow
+    tb_size_t                   grow;
+
+    /// the entry offset
+    tb_size_t                   eoff;
+
+    /// the entry comp func
+    tb_heap_entry_comp_t        comp;
+
+}tb_heap_entry_head_t, *tb_heap_entry_head_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init heap
+ *
+ * @param heap                              the heap
+ * @param entry_offset                      the entry offset 
+ * @param grow                              the grow size, using the default grow if be zero
+ * @param comp                              the comp func of the items
+ */
+tb_void_t                                   tb_heap_entry_init_(tb_heap_entry_head_ref_t heap, tb_size_t entry_offset, tb_size_t grow, tb_heap_entry_comp_t comp);
+
+/*! exit heap
+ *
+ * @param heap                              the heap
+ */ 
+tb_void_t                                   tb_heap_entry_exit(tb_heap_entry_head_ref_t heap);
+
+/*! clear heap
+ *
+ * @param heap                              the heap
+ */
+tb_void_t                                   tb_heap_entry_clear(tb_heap_entry_head_ref_t heap);
+
+/*! put the entry
+ *
+ * @param heap                              the heap
+ * @param entry                             the entry, must not be in the heap
+ *
+ * @return                                  tb_true or tb_false
+ */
+tb_bool_t                                   tb_heap_entry_put(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t entry);
+
+/*! pop the top entry
+ *
+ * @param heap                              the heap
+ */
+tb_void_t                                   tb_heap_entry_pop(tb_heap_entry_head_ref_t heap);
+
+/*! remove the entry
+ *
+ * @param heap                              the heap
+ * @param entry                             the entry, must be in the heap
+ */
+tb_void_t                                   tb_heap_entry_remove(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t entry);
+
+/*! update the position of the entry after its key has been changed
+ *
+ * @param heap                              the heap
+ * @param entry                             the entry, must be in the heap
+ */
+tb_void_t                                   tb_heap_entry_update(tb_heap_entry_head_ref_t heap, tb_heap_entry_ref_t entry);
+
+/*! the heap entry count
+ *
+ * @param heap                              the heap
+ *
+ * @return                                  the heap entry count
+ */
+static __tb_inline__ tb_size_t              tb_heap_entry_size(tb_heap_entry_head_ref_t heap)
+{ 
+    // check
+    tb_assert(heap);
+
+    // done
+    return heap->size;
+}
+
+/*! the top entry
+ *
+ * @param heap                              the heap
+ *
+ * @return                                  the top entry, tb_null if the heap is empty
+ */
+static __tb_inline__ tb_heap_entry_ref_t    tb_heap_entry_top(tb_heap_entry_head_ref_t heap)
+{ 
+    // check
+    tb_assert(heap);
+
+    // done
+    return heap->size? heap->data[0] : tb_null;
+}
+
+/*! init the entry which is not in the heap
+ *
+ * @param entry                             the entry
+ */
+static __tb_inline__ tb_void_t              tb_heap_entry_entry_init(tb_heap_entry_ref_t entry)
+{ 
+    // check
+    tb_assert(entry);
+
+    // init it
+    entry->index = TB_HEAP_ENTRY_INDEX_NONE;
+}
+
+/*! the entry is in the heap?
+ *
+ * @param entry                             the entry, it must be initialized by tb_heap_entry_entry_init() or be put
+ *
+ * @return                                  tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t              tb_heap_entry_is_in(tb_heap_entry_ref_t entry)
+{ 
+    // check
+    tb_assert(entry);
+
+    // done
+    return entry->index != TB_HEAP_ENTRY_INDEX_NONE;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -137,4 +137,12 @@ tb_long_t tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_c
     // comp
     return iterator->comp(iterator, litem, ritem);
 }
+tb_pointer_t tb_iterator_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator && ptype);
+
+    // the contiguous integer items
+    return iterator->data? iterator->data(iterator, ptype) : tb_null;
+}
 
@@ -96,6 +96,9 @@ typedef struct __tb_iterator_t
     /// the iterator remove range
     tb_void_t               (*remove_range)(struct __tb_iterator_t* iterator, tb_size_t prev, tb_size_t next, tb_size_t size);
 
+    /// the iterator data, get the contiguous integer items in the natural order and the element type of them, optional
+    tb_pointer_t            (*data)(struct __tb_iterator_t* iterator, tb_size_t* ptype);
+
 }tb_iterator_t;
 
 /// the array iterator type
@@ -292,6 +295,18 @@ tb_void_t           tb_iterator_copy(tb_iterator_ref_t iterator, tb_size_t itor,
  */
 tb_long_t           tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem);
 
+/*! the iterator data
+ *
+ * the items of [head, tail) are placed at data + itor * step, 
+ * and the default comparer of the iterator is the natural order of the integer element type.
+ *
+ * @param iterator  the iterator
+ * @param ptype     the element type of the items, e.g. TB_ELEMENT_TYPE_LONG, TB_ELEMENT_TYPE_UINT32, ...
+ *
+ * @return          the contiguous integer items, tb_null if the items are not the contiguous integers
+ */
+tb_pointer_t        tb_iterator_data(tb_iterator_ref_t iterator, tb_size_t* ptype);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
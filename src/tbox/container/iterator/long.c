@@ -28,6 +28,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../element.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -36,6 +37,15 @@ static tb_long_t tb_iterator_long_comp(tb_iterator_ref_t iterator, tb_cpointer_t
 {
     return ((tb_long_t)litem < (tb_long_t)ritem)? -1 : ((tb_long_t)litem > (tb_long_t)ritem);
 }
+static tb_pointer_t tb_iterator_long_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator && ptype);
+
+    // the long items
+    *ptype = TB_ELEMENT_TYPE_LONG;
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -47,6 +57,7 @@ tb_iterator_ref_t tb_iterator_make_for_long(tb_array_iterator_ref_t iterator, tb
 
     // init
     iterator->base.comp = tb_iterator_long_comp;
+    iterator->base.data = tb_iterator_long_data;
 
     // ok
     return (tb_iterator_ref_t)iterator;
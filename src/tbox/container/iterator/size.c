@@ -28,6 +28,20 @@
  * includes
  */
 #include "prefix.h"
+#include "../element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_pointer_t tb_iterator_size_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator && ptype);
+
+    // the size items
+    *ptype = TB_ELEMENT_TYPE_SIZE;
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -35,5 +49,11 @@
 tb_iterator_ref_t tb_iterator_make_for_size(tb_array_iterator_ref_t iterator, tb_size_t* items, tb_size_t count)
 {
     // make iterator for the pointer array
-    return tb_iterator_make_for_ptr(iterator, (tb_pointer_t*)items, count);
+    if (!tb_iterator_make_for_ptr(iterator, (tb_pointer_t*)items, count)) return tb_null;
+
+    // init
+    iterator->base.data = tb_iterator_size_data;
+
+    // ok
+    return (tb_iterator_ref_t)iterator;
 }
@@ -0,0 +1,457 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mpmc_queue.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "mpmc_queue"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mpmc_queue.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default item maxn
+#ifdef __tb_small__
+#   define TB_MPMC_QUEUE_MAXN_DEFAULT                   (256)
+#else
+#   define TB_MPMC_QUEUE_MAXN_DEFAULT                   (4096)
+#endif
+
+// load the sequence with the acquire semantics and store it with the release semantics
+#if (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 7)) || defined(TB_COMPILER_IS_CLANG)
+#   define tb_mpmc_queue_load(a)                        __atomic_load_n(a, __ATOMIC_ACQUIRE)
+#   define tb_mpmc_queue_store(a, v)                    __atomic_store_n(a, v, __ATOMIC_RELEASE)
+#endif
+
+// load the index directly without the locked instruction, the stale index will be validated by the next compare-and-swap
+#define tb_mpmc_queue_index(a)                          ((tb_size_t)*((__tb_volatile__ tb_atomic_t*)(a)))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the queue cell type
+typedef struct __tb_mpmc_queue_cell_t
+{
+    /* the sequence
+     *
+     * == index: it is empty and can be put at the index
+     * == index + 1: it is full and can be got at the index
+     */
+    tb_size_t               seq;
+
+    // the item data
+    tb_cpointer_t           data;
+
+}tb_mpmc_queue_cell_t;
+
+// the queue index type, it is placed at its own cache line
+typedef __tb_cacheline_aligned__ struct __tb_mpmc_queue_index_t
+{
+    // the index
+    tb_atomic_t             index;
+
+}__tb_cacheline_aligned__ tb_mpmc_queue_index_t;
+
+// the mpmc queue type
+typedef __tb_cacheline_aligned__ struct __tb_mpmc_queue_t
+{
+    // the tail index for the producers
+    tb_mpmc_queue_index_t   tail;
+
+    // the head index for the consumers
+    tb_mpmc_queue_index_t   head;
+
+    // the cells
+    tb_mpmc_queue_cell_t*   cells;
+
+    // the cell maxn - 1
+    tb_size_t               mask;
+
+    // the semaphore for the waiting producers, only for the blocking queue
+    tb_semaphore_ref_t      semaphore_put;
+
+    // the semaphore for the waiting consumers, only for the blocking queue
+    tb_semaphore_ref_t      semaphore_get;
+
+    // the waiting producer count
+    tb_atomic_t             waiting_put;
+
+    // the waiting consumer count
+    tb_atomic_t             waiting_get;
+
+}__tb_cacheline_aligned__ tb_mpmc_queue_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifndef tb_mpmc_queue_load
+static __tb_inline__ tb_size_t tb_mpmc_queue_load(tb_size_t* seq)
+{
+    tb_size_t value = *((__tb_volatile__ tb_size_t*)seq);
+    tb_barrier();
+    return value;
+}
+static __tb_inline__ tb_void_t tb_mpmc_queue_store(tb_size_t* seq, tb_size_t value)
+{
+    tb_barrier();
+    *((__tb_volatile__ tb_size_t*)seq) = value;
+}
+#endif
+static __tb_inline__ tb_void_t tb_mpmc_queue_notify(tb_atomic_t* waiting, tb_semaphore_ref_t semaphore, tb_size_t count)
+{
+    // the published cells must be visible before checking the waiting count
+    tb_barrier();
+
+    // no waiters?
+    tb_long_t waiters = *((__tb_volatile__ tb_atomic_t*)waiting);
+    tb_check_return(waiters > 0);
+
+    // wake up the waiters which have not been posted
+    tb_long_t posted = tb_semaphore_value(semaphore);
+    if (posted >= 0 && posted < waiters) tb_semaphore_post(semaphore, tb_min(count, (tb_size_t)(waiters - posted)));
+}
+static tb_long_t tb_mpmc_queue_wait(tb_mpmc_queue_t* queue, tb_atomic_t* waiting, tb_semaphore_ref_t semaphore, tb_bool_t put, tb_cpointer_t data, tb_pointer_t* pdata, tb_long_t timeout)
+{
+    // the deadline
+    tb_hong_t deadline = timeout > 0? tb_mclock() + timeout : 0;
+
+    // register this waiter, and try it again to avoid missing the notification
+    tb_long_t ok = -1;
+    tb_atomic_fetch_and_inc(waiting);
+    while (1)
+    {
+        // try it
+        if (put? tb_mpmc_queue_try_put((tb_mpmc_queue_ref_t)queue, data) : tb_mpmc_queue_try_get((tb_mpmc_queue_ref_t)queue, pdata)) 
+        {
+            ok = 1;
+            break;
+        }
+
+        // the left time
+        tb_long_t left = -1;
+        if (timeout >= 0)
+        {
+            left = timeout > 0? (tb_long_t)(deadline - tb_mclock()) : 0;
+            if (left <= 0) 
+            {
+                ok = 0;
+                break;
+            }
+        }
+
+        // wait it
+        if (tb_semaphore_wait(semaphore, left) < 0) break;
+    }
+
+    // unregister this waiter
+    tb_atomic_fetch_and_dec(waiting);
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_mpmc_queue_ref_t tb_mpmc_queue_init(tb_size_t maxn, tb_bool_t blocking)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_mpmc_queue_t*    queue = tb_null;
+    do
+    {
+        // make queue
+        queue = (tb_mpmc_queue_t*)tb_align_malloc0(sizeof(tb_mpmc_queue_t), TB_SMP_CACHE_BYTES);
+        tb_assert_and_check_break(queue);
+
+        // init maxn, the cell sequences cannot distinguish the empty and full states if it is one
+        if (!maxn) maxn = TB_MPMC_QUEUE_MAXN_DEFAULT;
+        if (maxn < 2) maxn = 2;
+        maxn = tb_align_pow2(maxn);
+        queue->mask = maxn - 1;
+
+        // make cells
+        queue->cells = tb_nalloc_type(maxn, tb_mpmc_queue_cell_t);
+        tb_assert_and_check_break(queue->cells);
+
+        // init cells
+        tb_size_t i = 0;
+        for (i = 0; i < maxn; i++)
+        {
+            queue->cells[i].seq     = i;
+            queue->cells[i].data    = tb_null;
+        }
+
+        // init semaphores
+        if (blocking)
+        {
+            queue->semaphore_put = tb_semaphore_init(0);
+            queue->semaphore_get = tb_semaphore_init(0);
+            tb_assert_and_check_break(queue->semaphore_put && queue->semaphore_get);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (queue) tb_mpmc_queue_exit((tb_mpmc_queue_ref_t)queue);
+        queue = tb_null;
+    }
+
+    // ok?
+    return (tb_mpmc_queue_ref_t)queue;
+}
+tb_void_t tb_mpmc_queue_exit(tb_mpmc_queue_ref_t self)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return(queue);
+
+    // exit semaphores
+    if (queue->semaphore_put) tb_semaphore_exit(queue->semaphore_put);
+    if (queue->semaphore_get) tb_semaphore_exit(queue->semaphore_get);
+    queue->semaphore_put = tb_null;
+    queue->semaphore_get = tb_null;
+
+    // exit cells
+    if (queue->cells) tb_free(queue->cells);
+    queue->cells = tb_null;
+
+    // exit it
+    tb_align_free(queue);
+}
+tb_bool_t tb_mpmc_queue_try_put(tb_mpmc_queue_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert(queue);
+
+    // claim the empty cell at the tail
+    tb_size_t               tail = tb_mpmc_queue_index(&queue->tail.index);
+    tb_mpmc_queue_cell_t*   cell = tb_null;
+    while (1)
+    {
+        cell = &queue->cells[tail & queue->mask];
+        tb_long_t diff = (tb_long_t)(tb_mpmc_queue_load(&cell->seq) - tail);
+        if (!diff)
+        {
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->tail.index, (tb_long_t)tail, (tb_long_t)(tail + 1));
+            if (prev == tail) break;
+            tail = prev;
+        }
+        // full?
+        else if (diff < 0) return tb_false;
+        // it has been claimed by other producers
+        else tail = tb_mpmc_queue_index(&queue->tail.index);
+    }
+
+    // put it
+    cell->data = data;
+    tb_mpmc_queue_store(&cell->seq, tail + 1);
+
+    // notify the waiting consumers
+    if (queue->semaphore_get) tb_mpmc_queue_notify(&queue->waiting_get, queue->semaphore_get, 1);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_mpmc_queue_try_get(tb_mpmc_queue_ref_t self, tb_pointer_t* pdata)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert(queue && pdata);
+
+    // claim the full cell at the head
+    tb_size_t               head = tb_mpmc_queue_index(&queue->head.index);
+    tb_mpmc_queue_cell_t*   cell = tb_null;
+    while (1)
+    {
+        cell = &queue->cells[head & queue->mask];
+        tb_long_t diff = (tb_long_t)(tb_mpmc_queue_load(&cell->seq) - (head + 1));
+        if (!diff)
+        {
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->head.index, (tb_long_t)head, (tb_long_t)(head + 1));
+            if (prev == head) break;
+            head = prev;
+        }
+        // empty?
+        else if (diff < 0) return tb_false;
+        // it has been claimed by other consumers
+        else head = tb_mpmc_queue_index(&queue->head.index);
+    }
+
+    // get it and release the cell for the next round
+    *pdata = (tb_pointer_t)cell->data;
+    tb_mpmc_queue_store(&cell->seq, head + queue->mask + 1);
+
+    // notify the waiting producers
+    if (queue->semaphore_put) tb_mpmc_queue_notify(&queue->waiting_put, queue->semaphore_put, 1);
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_mpmc_queue_put_list(tb_mpmc_queue_ref_t self, tb_cpointer_t const* list, tb_size_t size)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert(queue && list);
+    tb_check_return_val(size, 0);
+
+    // claim the contiguous empty cells at the tail
+    tb_size_t n = 0;
+    tb_size_t tail = tb_mpmc_queue_index(&queue->tail.index);
+    while (1)
+    {
+        tb_long_t diff = (tb_long_t)(tb_mpmc_queue_load(&queue->cells[tail & queue->mask].seq) - tail);
+        if (!diff)
+        {
+            // the following cells have been empty too if their sequences are matched, nobody can claim them before we move the tail
+            n = 1;
+            while (n < size && tb_mpmc_queue_load(&queue->cells[(tail + n) & queue->mask].seq) == tail + n) n++;
+
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->tail.index, (tb_long_t)tail, (tb_long_t)(tail + n));
+            if (prev == tail) break;
+            tail = prev;
+        }
+        // full?
+        else if (diff < 0) return 0;
+        // it has been claimed by other producers
+        else tail = tb_mpmc_queue_index(&queue->tail.index);
+    }
+
+    // put them
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_mpmc_queue_cell_t* cell = &queue->cells[(tail + i) & queue->mask];
+        cell->data = list[i];
+        tb_mpmc_queue_store(&cell->seq, tail + i + 1);
+    }
+
+    // notify the waiting consumers
+    if (queue->semaphore_get) tb_mpmc_queue_notify(&queue->waiting_get, queue->semaphore_get, n);
+
+    // ok
+    return n;
+}
+tb_size_t tb_mpmc_queue_get_list(tb_mpmc_queue_ref_t self, tb_pointer_t* list, tb_size_t maxn)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert(queue && list);
+    tb_check_return_val(maxn, 0);
+
+    // claim the contiguous full cells at the head
+    tb_size_t n = 0;
+    tb_size_t head = tb_mpmc_queue_index(&queue->head.index);
+    while (1)
+    {
+        tb_long_t diff = (tb_long_t)(tb_mpmc_queue_load(&queue->cells[head & queue->mask].seq) - (head + 1));
+        if (!diff)
+        {
+            // the following cells have been full too if their sequences are matched, nobody can claim them before we move the head
+            n = 1;
+            while (n < maxn && tb_mpmc_queue_load(&queue->cells[(head + n) & queue->mask].seq) == head + n + 1) n++;
+
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->head.index, (tb_long_t)head, (tb_long_t)(head + n));
+            if (prev == head) break;
+            head = prev;
+        }
+        // empty?
+        else if (diff < 0) return 0;
+        // it has been claimed by other consumers
+        else head = tb_mpmc_queue_index(&queue->head.index);
+    }
+
+    // get them and release the cells for the next round
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_mpmc_queue_cell_t* cell = &queue->cells[(head + i) & queue->mask];
+        list[i] = (tb_pointer_t)cell->data;
+        tb_mpmc_queue_store(&cell->seq, head + i + queue->mask + 1);
+    }
+
+    // notify the waiting producers
+    if (queue->semaphore_put) tb_mpmc_queue_notify(&queue->waiting_put, queue->semaphore_put, n);
+
+    // ok
+    return n;
+}
+tb_long_t tb_mpmc_queue_put(tb_mpmc_queue_ref_t self, tb_cpointer_t data, tb_long_t timeout)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->semaphore_put, -1);
+
+    // put it directly or wait it
+    return tb_mpmc_queue_try_put(self, data)? 1 : tb_mpmc_queue_wait(queue, &queue->waiting_put, queue->semaphore_put, tb_true, data, tb_null, timeout);
+}
+tb_long_t tb_mpmc_queue_get(tb_mpmc_queue_ref_t self, tb_pointer_t* pdata, tb_long_t timeout)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->semaphore_get && pdata, -1);
+
+    // get it directly or wait it
+    return tb_mpmc_queue_try_get(self, pdata)? 1 : tb_mpmc_queue_wait(queue, &queue->waiting_get, queue->semaphore_get, tb_false, tb_null, pdata, timeout);
+}
+tb_size_t tb_mpmc_queue_size(tb_mpmc_queue_ref_t self)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the size, load the head first for keeping it not less than zero
+    tb_size_t head = tb_mpmc_queue_index(&queue->head.index);
+    tb_barrier();
+    tb_size_t tail = tb_mpmc_queue_index(&queue->tail.index);
+    tb_size_t size = tail - head;
+    return tb_min(size, queue->mask + 1);
+}
+tb_size_t tb_mpmc_queue_maxn(tb_mpmc_queue_ref_t self)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the maxn
+    return queue->mask + 1;
+}
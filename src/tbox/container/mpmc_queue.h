@@ -0,0 +1,175 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mpmc_queue.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_MPMC_QUEUE_H
+#define TB_CONTAINER_MPMC_QUEUE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the lock-free multi-producer multi-consumer queue ref type
+ *
+ * <pre>
+ *
+ * the bounded ring buffer of pointers, like tb_circle_queue, for any producer and consumer threads (dmitry vyukov's algorithm)
+ *
+ * cells: | seq data | seq data | seq data | ... | seq data |
+ *            |
+ *        (tail | head) & (maxn - 1)
+ *
+ * the producers claim the cell at tail by one compare-and-swap if cell.seq == tail, 
+ * and publish it by cell.seq = tail + 1. 
+ *
+ * the consumers claim the cell at head if cell.seq == head + 1,
+ * and release it for the next round by cell.seq = head + maxn. 
+ *
+ * the head and tail are placed at their own cache lines, the producers and consumers only 
+ * contend with each other at the same side.
+ *
+ * performance: 
+ *
+ * put: O(1), lock-free
+ * get: O(1), lock-free
+ *
+ * </pre>
+ *
+ * @note the items are the raw pointers or the integers casted to the pointer, the queue does not own them
+ */
+typedef __tb_typeref__(mpmc_queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init queue
+ *
+ * @param maxn          the item maxn, it will be aligned to the power of 2, using the default maxn if be zero
+ * @param blocking      enable the blocking put and get? tb_mpmc_queue_put() and tb_mpmc_queue_get() need it
+ *
+ * @return              the queue
+ */
+tb_mpmc_queue_ref_t     tb_mpmc_queue_init(tb_size_t maxn, tb_bool_t blocking);
+
+/*! exit queue
+ *
+ * @param queue         the queue
+ */
+tb_void_t               tb_mpmc_queue_exit(tb_mpmc_queue_ref_t queue);
+
+/*! try to put the queue item
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ *
+ * @return              tb_false if the queue is full
+ */
+tb_bool_t               tb_mpmc_queue_try_put(tb_mpmc_queue_ref_t queue, tb_cpointer_t data);
+
+/*! try to get the queue item
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ *
+ * @return              tb_false if the queue is empty
+ */
+tb_bool_t               tb_mpmc_queue_try_get(tb_mpmc_queue_ref_t queue, tb_pointer_t* pdata);
+
+/*! put the queue items as many as possible
+ *
+ * @note the items are claimed by one compare-and-swap, so they are contiguous in the queue
+ *
+ * @param queue         the queue
+ * @param list          the item list
+ * @param size          the item count
+ *
+ * @return              the put count, it is less than the size if the queue is full
+ */
+tb_size_t               tb_mpmc_queue_put_list(tb_mpmc_queue_ref_t queue, tb_cpointer_t const* list, tb_size_t size);
+
+/*! get the queue items as many as possible
+ *
+ * @note the items are claimed by one compare-and-swap, so they are contiguous in the queue
+ *
+ * @param queue         the queue
+ * @param list          the item list
+ * @param maxn          the item maxn of the list
+ *
+ * @return              the got count, it is zero if the queue is empty
+ */
+tb_size_t               tb_mpmc_queue_get_list(tb_mpmc_queue_ref_t queue, tb_pointer_t* list, tb_size_t maxn);
+
+/*! put the queue item and wait it if the queue is full, only for the blocking queue
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              ok: 1, timeout: 0, failed: -1
+ */
+tb_long_t               tb_mpmc_queue_put(tb_mpmc_queue_ref_t queue, tb_cpointer_t data, tb_long_t timeout);
+
+/*! get the queue item and wait it if the queue is empty, only for the blocking queue
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              ok: 1, timeout: 0, failed: -1
+ */
+tb_long_t               tb_mpmc_queue_get(tb_mpmc_queue_ref_t queue, tb_pointer_t* pdata, tb_long_t timeout);
+
+/*! the queue size
+ *
+ * @param queue         the queue
+ *
+ * @return              the item count, it may be changed by other threads after returning
+ */
+tb_size_t               tb_mpmc_queue_size(tb_mpmc_queue_ref_t queue);
+
+/*! the queue maxn
+ *
+ * @param queue         the queue
+ *
+ * @return              the queue maxn
+ */
+tb_size_t               tb_mpmc_queue_maxn(tb_mpmc_queue_ref_t queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
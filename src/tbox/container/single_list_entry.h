@@ -387,7 +387,7 @@ static __tb_inline__ tb_void_t                  tb_single_list_entry_remove_safe
     tb_assert(list && list->size && prev);
 
     // update last
-    if (prev->next == list->last) list->last = next;
+    if (prev->next == list->last) list->last = (prev != (tb_single_list_entry_ref_t)list)? prev : tb_null;
 
     // remove entries
     prev->next = next;
@@ -0,0 +1,390 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        spsc_queue.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "spsc_queue"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "spsc_queue.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default item maxn
+#ifdef __tb_small__
+#   define TB_SPSC_QUEUE_MAXN_DEFAULT                   (256)
+#else
+#   define TB_SPSC_QUEUE_MAXN_DEFAULT                   (4096)
+#endif
+
+// load the index with the acquire semantics and store it with the release semantics
+#if (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 7)) || defined(TB_COMPILER_IS_CLANG)
+#   define tb_spsc_queue_load(a)                        __atomic_load_n(a, __ATOMIC_ACQUIRE)
+#   define tb_spsc_queue_store(a, v)                    __atomic_store_n(a, v, __ATOMIC_RELEASE)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the producer side, it is placed at its own cache line
+typedef __tb_cacheline_aligned__ struct __tb_spsc_queue_producer_t
+{
+    // the tail index, it is only written by the producer
+    tb_size_t               tail;
+
+    // the cached head index of the consumer
+    tb_size_t               head;
+
+}__tb_cacheline_aligned__ tb_spsc_queue_producer_t;
+
+// the consumer side, it is placed at its own cache line
+typedef __tb_cacheline_aligned__ struct __tb_spsc_queue_consumer_t
+{
+    // the head index, it is only written by the consumer
+    tb_size_t               head;
+
+    // the cached tail index of the producer
+    tb_size_t               tail;
+
+}__tb_cacheline_aligned__ tb_spsc_queue_consumer_t;
+
+// the spsc queue type
+typedef __tb_cacheline_aligned__ struct __tb_spsc_queue_t
+{
+    // the producer
+    tb_spsc_queue_producer_t    producer;
+
+    // the consumer
+    tb_spsc_queue_consumer_t    consumer;
+
+    // the items
+    tb_cpointer_t*              data;
+
+    // the item maxn - 1
+    tb_size_t                   mask;
+
+    // the event for the waiting producer, only for the blocking queue
+    tb_event_ref_t              event_put;
+
+    // the event for the waiting consumer, only for the blocking queue
+    tb_event_ref_t              event_get;
+
+    // is the producer waiting?
+    tb_atomic_t                 waiting_put;
+
+    // is the consumer waiting?
+    tb_atomic_t                 waiting_get;
+
+}__tb_cacheline_aligned__ tb_spsc_queue_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifndef tb_spsc_queue_load
+static __tb_inline__ tb_size_t tb_spsc_queue_load(tb_size_t* index)
+{
+    tb_size_t value = *((__tb_volatile__ tb_size_t*)index);
+    tb_barrier();
+    return value;
+}
+static __tb_inline__ tb_void_t tb_spsc_queue_store(tb_size_t* index, tb_size_t value)
+{
+    tb_barrier();
+    *((__tb_volatile__ tb_size_t*)index) = value;
+}
+#endif
+static __tb_inline__ tb_void_t tb_spsc_queue_notify(tb_atomic_t* waiting, tb_event_ref_t event)
+{
+    // the published index must be visible before checking the waiting flag
+    tb_barrier();
+
+    // wake up the waiting side only once
+    if (*((__tb_volatile__ tb_atomic_t*)waiting) && tb_atomic_fetch_and_set0(waiting)) 
+        tb_event_post(event);
+}
+static tb_long_t tb_spsc_queue_wait(tb_spsc_queue_t* queue, tb_atomic_t* waiting, tb_event_ref_t event, tb_bool_t put, tb_cpointer_t data, tb_pointer_t* pdata, tb_long_t timeout)
+{
+    // the deadline
+    tb_hong_t deadline = timeout > 0? tb_mclock() + timeout : 0;
+    while (1)
+    {
+        // mark it as waiting, and try it again to avoid missing the notification
+        tb_atomic_set(waiting, 1);
+        tb_barrier();
+        if (put? tb_spsc_queue_try_put((tb_spsc_queue_ref_t)queue, data) : tb_spsc_queue_try_get((tb_spsc_queue_ref_t)queue, pdata)) 
+        {
+            tb_atomic_set0(waiting);
+            return 1;
+        }
+
+        // the left time
+        tb_long_t left = -1;
+        if (timeout >= 0)
+        {
+            left = timeout > 0? (tb_long_t)(deadline - tb_mclock()) : 0;
+            if (left <= 0) 
+            {
+                tb_atomic_set0(waiting);
+                return 0;
+            }
+        }
+
+        // wait it
+        if (tb_event_wait(event, left) < 0) 
+        {
+            tb_atomic_set0(waiting);
+            return -1;
+        }
+    }
+
+    // unreachable
+    return -1;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_spsc_queue_ref_t tb_spsc_queue_init(tb_size_t maxn, tb_bool_t blocking)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_spsc_queue_t*    queue = tb_null;
+    do
+    {
+        // make queue
+        queue = (tb_spsc_queue_t*)tb_align_malloc0(sizeof(tb_spsc_queue_t), TB_SMP_CACHE_BYTES);
+        tb_assert_and_check_break(queue);
+
+        // init maxn
+        if (!maxn) maxn = TB_SPSC_QUEUE_MAXN_DEFAULT;
+        maxn = tb_align_pow2(maxn);
+        queue->mask = maxn - 1;
+
+        // make items
+        queue->data = tb_nalloc0_type(maxn, tb_cpointer_t);
+        tb_assert_and_check_break(queue->data);
+
+        // init events
+        if (blocking)
+        {
+            queue->event_put = tb_event_init();
+            queue->event_get = tb_event_init();
+            tb_assert_and_check_break(queue->event_put && queue->event_get);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (queue) tb_spsc_queue_exit((tb_spsc_queue_ref_t)queue);
+        queue = tb_null;
+    }
+
+    // ok?
+    return (tb_spsc_queue_ref_t)queue;
+}
+tb_void_t tb_spsc_queue_exit(tb_spsc_queue_ref_t self)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return(queue);
+
+    // exit events
+    if (queue->event_put) tb_event_exit(queue->event_put);
+    if (queue->event_get) tb_event_exit(queue->event_get);
+    queue->event_put = tb_null;
+    queue->event_get = tb_null;
+
+    // exit items
+    if (queue->data) tb_free(queue->data);
+    queue->data = tb_null;
+
+    // exit it
+    tb_align_free(queue);
+}
+tb_bool_t tb_spsc_queue_try_put(tb_spsc_queue_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert(queue);
+
+    // full? reload the head of the consumer
+    tb_spsc_queue_producer_t* producer = &queue->producer;
+    tb_size_t tail = producer->tail;
+    if (tail - producer->head > queue->mask)
+    {
+        producer->head = tb_spsc_queue_load(&queue->consumer.head);
+        tb_check_return_val(tail - producer->head <= queue->mask, tb_false);
+    }
+
+    // put it
+    queue->data[tail & queue->mask] = data;
+    tb_spsc_queue_store(&producer->tail, tail + 1);
+
+    // notify the waiting consumer
+    if (queue->event_get) tb_spsc_queue_notify(&queue->waiting_get, queue->event_get);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_spsc_queue_try_get(tb_spsc_queue_ref_t self, tb_pointer_t* pdata)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert(queue && pdata);
+
+    // empty? reload the tail of the producer
+    tb_spsc_queue_consumer_t* consumer = &queue->consumer;
+    tb_size_t head = consumer->head;
+    if (head == consumer->tail)
+    {
+        consumer->tail = tb_spsc_queue_load(&queue->producer.tail);
+        tb_check_return_val(head != consumer->tail, tb_false);
+    }
+
+    // get it
+    *pdata = (tb_pointer_t)queue->data[head & queue->mask];
+    tb_spsc_queue_store(&consumer->head, head + 1);
+
+    // notify the waiting producer
+    if (queue->event_put) tb_spsc_queue_notify(&queue->waiting_put, queue->event_put);
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_spsc_queue_put_list(tb_spsc_queue_ref_t self, tb_cpointer_t const* list, tb_size_t size)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert(queue && list);
+
+    // not enough space? reload the head of the consumer
+    tb_spsc_queue_producer_t* producer = &queue->producer;
+    tb_size_t tail = producer->tail;
+    tb_size_t left = queue->mask + 1 - (tail - producer->head);
+    if (left < size)
+    {
+        producer->head = tb_spsc_queue_load(&queue->consumer.head);
+        left = queue->mask + 1 - (tail - producer->head);
+    }
+    if (size > left) size = left;
+    tb_check_return_val(size, 0);
+
+    // put them
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) queue->data[(tail + i) & queue->mask] = list[i];
+    tb_spsc_queue_store(&producer->tail, tail + size);
+
+    // notify the waiting consumer
+    if (queue->event_get) tb_spsc_queue_notify(&queue->waiting_get, queue->event_get);
+
+    // ok
+    return size;
+}
+tb_size_t tb_spsc_queue_get_list(tb_spsc_queue_ref_t self, tb_pointer_t* list, tb_size_t maxn)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert(queue && list);
+
+    // not enough items? reload the tail of the producer
+    tb_spsc_queue_consumer_t* consumer = &queue->consumer;
+    tb_size_t head = consumer->head;
+    tb_size_t size = consumer->tail - head;
+    if (size < maxn)
+    {
+        consumer->tail = tb_spsc_queue_load(&queue->producer.tail);
+        size = consumer->tail - head;
+    }
+    if (size > maxn) size = maxn;
+    tb_check_return_val(size, 0);
+
+    // get them
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) list[i] = (tb_pointer_t)queue->data[(head + i) & queue->mask];
+    tb_spsc_queue_store(&consumer->head, head + size);
+
+    // notify the waiting producer
+    if (queue->event_put) tb_spsc_queue_notify(&queue->waiting_put, queue->event_put);
+
+    // ok
+    return size;
+}
+tb_long_t tb_spsc_queue_put(tb_spsc_queue_ref_t self, tb_cpointer_t data, tb_long_t timeout)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->event_put, -1);
+
+    // put it directly or wait it
+    return tb_spsc_queue_try_put(self, data)? 1 : tb_spsc_queue_wait(queue, &queue->waiting_put, queue->event_put, tb_true, data, tb_null, timeout);
+}
+tb_long_t tb_spsc_queue_get(tb_spsc_queue_ref_t self, tb_pointer_t* pdata, tb_long_t timeout)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->event_get && pdata, -1);
+
+    // get it directly or wait it
+    return tb_spsc_queue_try_get(self, pdata)? 1 : tb_spsc_queue_wait(queue, &queue->waiting_get, queue->event_get, tb_false, tb_null, pdata, timeout);
+}
+tb_size_t tb_spsc_queue_size(tb_spsc_queue_ref_t self)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the size, load the head first for keeping it not less than zero
+    tb_size_t head = tb_spsc_queue_load(&queue->consumer.head);
+    tb_size_t tail = tb_spsc_queue_load(&queue->producer.tail);
+    tb_size_t size = tail - head;
+    return tb_min(size, queue->mask + 1);
+}
+tb_size_t tb_spsc_queue_maxn(tb_spsc_queue_ref_t self)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the maxn
+    return queue->mask + 1;
+}
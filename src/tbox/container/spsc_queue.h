@@ -0,0 +1,165 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        spsc_queue.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_SPSC_QUEUE_H
+#define TB_CONTAINER_SPSC_QUEUE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the lock-free single-producer single-consumer queue ref type
+ *
+ * <pre>
+ *
+ * the bounded ring buffer of pointers, like tb_circle_queue, for one producer thread and one consumer thread
+ *
+ * queue: ||||||||||||||||||||||||||||||||||||||||||||||||||||||||------------|
+ *       head                                                  tail
+ *       consumer                                              producer
+ *
+ * the head and tail are placed at their own cache lines with the cached copy of the other side,
+ * so the producer and the consumer only touch the shared line when the cached copy is exhausted.
+ *
+ * performance: 
+ *
+ * put: O(1), wait-free
+ * get: O(1), wait-free
+ *
+ * </pre>
+ *
+ * @note the items are the raw pointers or the integers casted to the pointer, the queue does not own them
+ */
+typedef __tb_typeref__(spsc_queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init queue
+ *
+ * @param maxn          the item maxn, it will be aligned to the power of 2, using the default maxn if be zero
+ * @param blocking      enable the blocking put and get? tb_spsc_queue_put() and tb_spsc_queue_get() need it
+ *
+ * @return              the queue
+ */
+tb_spsc_queue_ref_t     tb_spsc_queue_init(tb_size_t maxn, tb_bool_t blocking);
+
+/*! exit queue
+ *
+ * @param queue         the queue
+ */
+tb_void_t               tb_spsc_queue_exit(tb_spsc_queue_ref_t queue);
+
+/*! try to put the queue item, only for the producer thread
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ *
+ * @return              tb_false if the queue is full
+ */
+tb_bool_t               tb_spsc_queue_try_put(tb_spsc_queue_ref_t queue, tb_cpointer_t data);
+
+/*! try to get the queue item, only for the consumer thread
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ *
+ * @return              tb_false if the queue is empty
+ */
+tb_bool_t               tb_spsc_queue_try_get(tb_spsc_queue_ref_t queue, tb_pointer_t* pdata);
+
+/*! put the queue items as many as possible, only for the producer thread
+ *
+ * @param queue         the queue
+ * @param list          the item list
+ * @param size          the item count
+ *
+ * @return              the put count, it is less than the size if the queue is full
+ */
+tb_size_t               tb_spsc_queue_put_list(tb_spsc_queue_ref_t queue, tb_cpointer_t const* list, tb_size_t size);
+
+/*! get the queue items as many as possible, only for the consumer thread
+ *
+ * @param queue         the queue
+ * @param list          the item list
+ * @param maxn          the item maxn of the list
+ *
+ * @return              the got count, it is zero if the queue is empty
+ */
+tb_size_t               tb_spsc_queue_get_list(tb_spsc_queue_ref_t queue, tb_pointer_t* list, tb_size_t maxn);
+
+/*! put the queue item and wait it if the queue is full, only for the blocking queue
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              ok: 1, timeout: 0, failed: -1
+ */
+tb_long_t               tb_spsc_queue_put(tb_spsc_queue_ref_t queue, tb_cpointer_t data, tb_long_t timeout);
+
+/*! get the queue item and wait it if the queue is empty, only for the blocking queue
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              ok: 1, timeout: 0, failed: -1
+ */
+tb_long_t               tb_spsc_queue_get(tb_spsc_queue_ref_t queue, tb_pointer_t* pdata, tb_long_t timeout);
+
+/*! the queue size
+ *
+ * @param queue         the queue
+ *
+ * @return              the item count, it may be changed by other threads after returning
+ */
+tb_size_t               tb_spsc_queue_size(tb_spsc_queue_ref_t queue);
+
+/*! the queue maxn
+ *
+ * @param queue         the queue
+ *
+ * @return              the queue maxn
+ */
+tb_size_t               tb_spsc_queue_maxn(tb_spsc_queue_ref_t queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
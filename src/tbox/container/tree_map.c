@@ -0,0 +1,925 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tree_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "tree_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tree_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the node size, some cache lines for the binary searching in the node
+#define TB_TREE_MAP_NODE_SIZE                   (TB_L1_CACHE_BYTES << 2)
+
+// the leaf alignment, the low bits of the leaf address are used for the item index of itor
+#define TB_TREE_MAP_LEAF_ALIGN                  (64)
+
+// the maximum depth of the tree
+#define TB_TREE_MAP_DEPTH_MAXN                  (32)
+
+// the itor of the item in the leaf
+#define tb_tree_map_itor_make(leaf, index)      ((tb_size_t)(leaf) | (tb_size_t)(index))
+#define tb_tree_map_itor_leaf(itor)             ((tb_tree_map_leaf_t*)((itor) & ~(tb_size_t)(TB_TREE_MAP_LEAF_ALIGN - 1)))
+#define tb_tree_map_itor_index(itor)            ((itor) & (TB_TREE_MAP_LEAF_ALIGN - 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tree map node type
+typedef struct __tb_tree_map_node_t
+{
+    // the item count for leaf or the key count for inner node
+    tb_uint32_t                 size;
+
+    // is leaf?
+    tb_uint32_t                 leaf;
+
+}tb_tree_map_node_t;
+
+/* the tree map leaf type
+ *
+ * | node | prev | next | item0 | item1 | ... | item(leaf_maxn) |
+ *
+ * @note the last item is only used for splitting the full leaf
+ */
+typedef struct __tb_tree_map_leaf_t
+{
+    // the node
+    tb_tree_map_node_t              node;
+
+    // the prev leaf
+    struct __tb_tree_map_leaf_t*    prev;
+
+    // the next leaf
+    struct __tb_tree_map_leaf_t*    next;
+
+}tb_tree_map_leaf_t;
+
+/* the tree map inner node type
+ *
+ * | node | child0 | child1 | ... | child(inner_maxn + 1) | key0 | key1 | ... | key(inner_maxn) |
+ *
+ * the keys of child(i) are less than key(i) and the keys of child(i + 1) are not less than key(i) 
+ *
+ * @note the last key and child are only used for splitting the full node
+ */
+typedef struct __tb_tree_map_inner_t
+{
+    // the node
+    tb_tree_map_node_t              node;
+
+}tb_tree_map_inner_t;
+
+// the tree map path type
+typedef struct __tb_tree_map_path_t
+{
+    // the inner node
+    tb_tree_map_inner_t*            inner;
+
+    // the child index
+    tb_size_t                       index;
+
+}tb_tree_map_path_t;
+
+// the tree map type
+typedef struct __tb_tree_map_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the root node
+    tb_tree_map_node_t*             root;
+
+    // the first leaf
+    tb_tree_map_leaf_t*             head;
+
+    // the last leaf
+    tb_tree_map_leaf_t*             last;
+
+    // the item size
+    tb_size_t                       size;
+
+    // the maximum item count of leaf
+    tb_size_t                       leaf_maxn;
+
+    // the maximum key count of inner node
+    tb_size_t                       inner_maxn;
+
+    // the item step
+    tb_size_t                       item_step;
+
+    // the key for splitting node
+    tb_byte_t*                      key;
+
+    // the current item for iterator
+    tb_tree_map_item_t              item;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_tree_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_byte_t* tb_tree_map_leaf_item(tb_tree_map_t* tree_map, tb_tree_map_leaf_t* leaf, tb_size_t index)
+{
+    return (tb_byte_t*)(leaf + 1) + index * tree_map->item_step;
+}
+static __tb_inline__ tb_tree_map_node_t** tb_tree_map_inner_childs(tb_tree_map_inner_t* inner)
+{
+    return (tb_tree_map_node_t**)(inner + 1);
+}
+static __tb_inline__ tb_byte_t* tb_tree_map_inner_key(tb_tree_map_t* tree_map, tb_tree_map_inner_t* inner, tb_size_t index)
+{
+    return (tb_byte_t*)(tb_tree_map_inner_childs(inner) + tree_map->inner_maxn + 2) + index * tree_map->element_name.size;
+}
+static __tb_inline__ tb_long_t tb_tree_map_comp(tb_tree_map_t* tree_map, tb_cpointer_t name, tb_byte_t const* key)
+{
+    return tree_map->element_name.comp(&tree_map->element_name, name, tree_map->element_name.data(&tree_map->element_name, key));
+}
+static tb_tree_map_leaf_t* tb_tree_map_leaf_init(tb_tree_map_t* tree_map)
+{
+    // make leaf
+    tb_tree_map_leaf_t* leaf = (tb_tree_map_leaf_t*)tb_align_malloc0(sizeof(tb_tree_map_leaf_t) + (tree_map->leaf_maxn + 1) * tree_map->item_step, TB_TREE_MAP_LEAF_ALIGN);
+    tb_assert_and_check_return_val(leaf, tb_null);
+
+    // init leaf
+    leaf->node.leaf = 1;
+    return leaf;
+}
+static tb_tree_map_inner_t* tb_tree_map_inner_init(tb_tree_map_t* tree_map)
+{
+    // make inner node
+    return (tb_tree_map_inner_t*)tb_malloc0(sizeof(tb_tree_map_inner_t) + (tree_map->inner_maxn + 2) * sizeof(tb_tree_map_node_t*) + (tree_map->inner_maxn + 1) * tree_map->element_name.size);
+}
+static tb_void_t tb_tree_map_node_exit(tb_tree_map_t* tree_map, tb_tree_map_node_t* node)
+{
+    // check
+    tb_assert(tree_map && node);
+
+    // exit leaf
+    tb_size_t i = 0;
+    if (node->leaf)
+    {
+        // free items
+        tb_tree_map_leaf_t* leaf = (tb_tree_map_leaf_t*)node;
+        if (tree_map->element_name.free || tree_map->element_data.free)
+        {
+            for (i = 0; i < leaf->node.size; i++)
+            {
+                tb_byte_t* item = tb_tree_map_leaf_item(tree_map, leaf, i);
+                if (tree_map->element_name.free) tree_map->element_name.free(&tree_map->element_name, item);
+                if (tree_map->element_data.free) tree_map->element_data.free(&tree_map->element_data, item + tree_map->element_name.size);
+            }
+        }
+        tb_align_free(leaf);
+    }
+    // exit inner node
+    else
+    {
+        // exit childs
+        tb_tree_map_inner_t*    inner = (tb_tree_map_inner_t*)node;
+        tb_tree_map_node_t**    childs = tb_tree_map_inner_childs(inner);
+        for (i = 0; i <= inner->node.size; i++) tb_tree_map_node_exit(tree_map, childs[i]);
+
+        // free keys
+        if (tree_map->element_name.free)
+        {
+            for (i = 0; i < inner->node.size; i++) 
+                tree_map->element_name.free(&tree_map->element_name, tb_tree_map_inner_key(tree_map, inner, i));
+        }
+        tb_free(inner);
+    }
+}
+static tb_size_t tb_tree_map_inner_find(tb_tree_map_t* tree_map, tb_tree_map_inner_t* inner, tb_cpointer_t name)
+{
+    // find the child index: the count of the keys which are not greater than the name
+    tb_size_t l = 0;
+    tb_size_t r = inner->node.size;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (tb_tree_map_comp(tree_map, name, tb_tree_map_inner_key(tree_map, inner, m)) >= 0) l = m + 1;
+        else r = m;
+    }
+    return l;
+}
+static tb_size_t tb_tree_map_leaf_find(tb_tree_map_t* tree_map, tb_tree_map_leaf_t* leaf, tb_cpointer_t name, tb_bool_t upper)
+{
+    // find the first item which is greater than the name for the upper bound or not less than the name for the lower bound
+    tb_size_t l = 0;
+    tb_size_t r = leaf->node.size;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        tb_long_t c = tb_tree_map_comp(tree_map, name, tb_tree_map_leaf_item(tree_map, leaf, m));
+        if (c > 0 || (upper && !c)) l = m + 1;
+        else r = m;
+    }
+    return l;
+}
+static tb_tree_map_leaf_t* tb_tree_map_leaf_from(tb_tree_map_t* tree_map, tb_cpointer_t name, tb_tree_map_path_t* path, tb_size_t* pdepth)
+{
+    // check
+    tb_assert(tree_map && tree_map->root);
+
+    // find the leaf from the root
+    tb_size_t           depth = 0;
+    tb_tree_map_node_t* node = tree_map->root;
+    while (!node->leaf)
+    {
+        // the child index
+        tb_tree_map_inner_t*    inner = (tb_tree_map_inner_t*)node;
+        tb_size_t               index = tb_tree_map_inner_find(tree_map, inner, name);
+
+        // save path
+        if (path)
+        {
+            tb_assert_and_check_return_val(depth < TB_TREE_MAP_DEPTH_MAXN, tb_null);
+            path[depth].inner = inner;
+            path[depth].index = index;
+        }
+        depth++;
+
+        // the child
+        node = tb_tree_map_inner_childs(inner)[index];
+    }
+
+    // save depth
+    if (pdepth) *pdepth = depth;
+
+    // ok
+    return (tb_tree_map_leaf_t*)node;
+}
+static tb_void_t tb_tree_map_leaf_unlink(tb_tree_map_t* tree_map, tb_tree_map_leaf_t* leaf)
+{
+    // remove it from the leaf list
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else tree_map->head = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else tree_map->last = leaf->prev;
+
+    // free it
+    tb_align_free(leaf);
+}
+static tb_bool_t tb_tree_map_insert_parent(tb_tree_map_t* tree_map, tb_tree_map_path_t* path, tb_size_t depth, tb_tree_map_node_t* right)
+{
+    // insert the splitted key and the right node to the parent
+    tb_size_t key_size = tree_map->element_name.size;
+    while (1)
+    {
+        // split the root? make a new root
+        if (!depth)
+        {
+            // make root
+            tb_tree_map_inner_t* root = tb_tree_map_inner_init(tree_map);
+            tb_assert_and_check_return_val(root, tb_false);
+
+            // init root
+            tb_tree_map_inner_childs(root)[0] = tree_map->root;
+            tb_tree_map_inner_childs(root)[1] = right;
+            tb_memcpy(tb_tree_map_inner_key(tree_map, root, 0), tree_map->key, key_size);
+            root->node.size = 1;
+            tree_map->root = (tb_tree_map_node_t*)root;
+            break;
+        }
+
+        // insert the key and right node after the left node
+        tb_tree_map_inner_t*    inner = path[depth - 1].inner;
+        tb_size_t               index = path[depth - 1].index;
+        tb_size_t               size = inner->node.size;
+        tb_tree_map_node_t**    childs = tb_tree_map_inner_childs(inner);
+        tb_byte_t*              key = tb_tree_map_inner_key(tree_map, inner, index);
+        if (index < size) 
+        {
+            tb_memmov(key + key_size, key, (size - index) * key_size);
+            tb_memmov(childs + index + 2, childs + index + 1, (size - index) * sizeof(tb_tree_map_node_t*));
+        }
+        tb_memcpy(key, tree_map->key, key_size);
+        childs[index + 1] = right;
+        inner->node.size = ++size;
+
+        // ok?
+        tb_check_break(size > tree_map->inner_maxn);
+
+        // make the right node
+        tb_tree_map_inner_t* inner_right = tb_tree_map_inner_init(tree_map);
+        tb_assert_and_check_return_val(inner_right, tb_false);
+
+        // split it, the middle key will be moved to the parent
+        tb_size_t middle = size >> 1;
+        tb_memcpy(tree_map->key, tb_tree_map_inner_key(tree_map, inner, middle), key_size);
+        tb_memcpy(tb_tree_map_inner_key(tree_map, inner_right, 0), tb_tree_map_inner_key(tree_map, inner, middle + 1), (size - middle - 1) * key_size);
+        tb_memcpy(tb_tree_map_inner_childs(inner_right), childs + middle + 1, (size - middle) * sizeof(tb_tree_map_node_t*));
+        inner_right->node.size  = (tb_uint32_t)(size - middle - 1);
+        inner->node.size        = (tb_uint32_t)middle;
+
+        // insert it to the parent
+        right = (tb_tree_map_node_t*)inner_right;
+        depth--;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_tree_map_remove_child(tb_tree_map_t* tree_map, tb_tree_map_path_t* path, tb_size_t depth, tb_size_t index, tb_bool_t free_key)
+{
+    // remove the child and the key before it from the parent
+    tb_size_t key_size = tree_map->element_name.size;
+    while (depth)
+    {
+        // the inner node
+        tb_tree_map_inner_t*    inner = path[depth - 1].inner;
+        tb_size_t               size = inner->node.size;
+        tb_tree_map_node_t**    childs = tb_tree_map_inner_childs(inner);
+
+        // no keys? remove this node from its parent
+        if (!size)
+        {
+            // check
+            tb_assert_and_check_break(!index && depth > 1);
+
+            // free it
+            tb_free(inner);
+
+            // remove it from its parent
+            depth--;
+            index       = path[depth - 1].index;
+            free_key    = tb_true;
+            continue;
+        }
+
+        // remove the key and child
+        tb_size_t   key_index = index? index - 1 : 0;
+        tb_byte_t*  key = tb_tree_map_inner_key(tree_map, inner, key_index);
+        if (free_key && tree_map->element_name.free) tree_map->element_name.free(&tree_map->element_name, key);
+        if (key_index + 1 < size) tb_memmov(key, key + key_size, (size - key_index - 1) * key_size);
+        if (index < size) tb_memmov(childs + index, childs + index + 1, (size - index) * sizeof(tb_tree_map_node_t*));
+        inner->node.size = (tb_uint32_t)--size;
+
+        // the root node? remove it if only one child is left
+        if (depth == 1)
+        {
+            if (!size)
+            {
+                tree_map->root = childs[0];
+                tb_free(inner);
+            }
+            break;
+        }
+
+        // too few keys? merge it with the sibling
+        tb_check_break(size < (tree_map->inner_maxn >> 2));
+
+        // the parent and the siblings
+        tb_tree_map_inner_t*    parent = path[depth - 2].inner;
+        tb_size_t               parent_index = path[depth - 2].index;
+        tb_check_break(parent->node.size);
+        tb_size_t               right_index = parent_index < parent->node.size? parent_index + 1 : parent_index;
+        tb_tree_map_inner_t*    left = (tb_tree_map_inner_t*)tb_tree_map_inner_childs(parent)[right_index - 1];
+        tb_tree_map_inner_t*    right = (tb_tree_map_inner_t*)tb_tree_map_inner_childs(parent)[right_index];
+        tb_size_t               left_size = left->node.size;
+        tb_size_t               right_size = right->node.size;
+        tb_check_break(left_size + right_size + 1 <= tree_map->inner_maxn);
+
+        // move the parent key and the right node to the left node
+        tb_memcpy(tb_tree_map_inner_key(tree_map, left, left_size), tb_tree_map_inner_key(tree_map, parent, right_index - 1), key_size);
+        tb_memcpy(tb_tree_map_inner_key(tree_map, left, left_size + 1), tb_tree_map_inner_key(tree_map, right, 0), right_size * key_size);
+        tb_memcpy(tb_tree_map_inner_childs(left) + left_size + 1, tb_tree_map_inner_childs(right), (right_size + 1) * sizeof(tb_tree_map_node_t*));
+        left->node.size = (tb_uint32_t)(left_size + right_size + 1);
+        tb_free(right);
+
+        // remove the right node from the parent, the parent key has been moved
+        depth--;
+        index       = right_index;
+        free_key    = tb_false;
+    }
+}
+static tb_size_t tb_tree_map_remove_item(tb_tree_map_t* tree_map, tb_tree_map_leaf_t* leaf, tb_size_t index, tb_tree_map_path_t* path, tb_size_t depth)
+{
+    // check
+    tb_assert(tree_map && leaf && index < leaf->node.size);
+
+    // free item
+    tb_byte_t* item = tb_tree_map_leaf_item(tree_map, leaf, index);
+    if (tree_map->element_name.free) tree_map->element_name.free(&tree_map->element_name, item);
+    if (tree_map->element_data.free) tree_map->element_data.free(&tree_map->element_data, item + tree_map->element_name.size);
+
+    // remove item
+    tb_size_t size = leaf->node.size;
+    if (index + 1 < size) tb_memmov(item, item + tree_map->item_step, (size - index - 1) * tree_map->item_step);
+    leaf->node.size = (tb_uint32_t)--size;
+    tree_map->size--;
+
+    /* the leaf is empty? remove it
+     *
+     * @note only the right sibling will be merged to this leaf, 
+     * so the itors of the items before the removed item are not changed
+     */
+    if (!size && depth)
+    {
+        // remove it from the parent
+        tb_tree_map_leaf_t* next = leaf->next;
+        tb_tree_map_leaf_unlink(tree_map, leaf);
+        tb_tree_map_remove_child(tree_map, path, depth, path[depth - 1].index, tb_true);
+
+        // the next itor
+        return next? tb_tree_map_itor_make(next, 0) : 0;
+    }
+    // too few items? merge the right sibling to this leaf
+    else if (depth && size < (tree_map->leaf_maxn >> 2) && path[depth - 1].index < path[depth - 1].inner->node.size)
+    {
+        tb_tree_map_leaf_t* right = leaf->next;
+        tb_size_t           right_size = right->node.size;
+        tb_assert(right == (tb_tree_map_leaf_t*)tb_tree_map_inner_childs(path[depth - 1].inner)[path[depth - 1].index + 1]);
+        if (size + right_size <= tree_map->leaf_maxn)
+        {
+            // move items
+            tb_memcpy(tb_tree_map_leaf_item(tree_map, leaf, size), tb_tree_map_leaf_item(tree_map, right, 0), right_size * tree_map->item_step);
+            leaf->node.size = (tb_uint32_t)(size += right_size);
+
+            // remove the right leaf
+            tb_tree_map_leaf_unlink(tree_map, right);
+            tb_tree_map_remove_child(tree_map, path, depth, path[depth - 1].index + 1, tb_true);
+        }
+    }
+
+    // the next itor
+    if (index < size) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+static tb_size_t tb_tree_map_remove_itor(tb_tree_map_t* tree_map, tb_size_t itor)
+{
+    // check
+    tb_assert(tree_map && itor);
+
+    // the leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    tb_size_t           index = tb_tree_map_itor_index(itor);
+    tb_assert_and_check_return_val(index < leaf->node.size, 0);
+
+    // find the path of this leaf
+    tb_size_t           depth = 0;
+    tb_tree_map_path_t  path[TB_TREE_MAP_DEPTH_MAXN];
+    tb_cpointer_t       name = tree_map->element_name.data(&tree_map->element_name, tb_tree_map_leaf_item(tree_map, leaf, index));
+    tb_tree_map_leaf_t* found = tb_tree_map_leaf_from(tree_map, name, path, &depth);
+    tb_assert_and_check_return_val(found == leaf, 0);
+
+    // remove it
+    return tb_tree_map_remove_item(tree_map, leaf, index, path, depth);
+}
+static tb_size_t tb_tree_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map);
+
+    // the size
+    return tree_map->size;
+}
+static tb_size_t tb_tree_map_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map && tree_map->head);
+
+    // the first item
+    return tree_map->head->node.size? tb_tree_map_itor_make(tree_map->head, 0) : 0;
+}
+static tb_size_t tb_tree_map_itor_last(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map && tree_map->last);
+
+    // the last item
+    return tree_map->last->node.size? tb_tree_map_itor_make(tree_map->last, tree_map->last->node.size - 1) : 0;
+}
+static tb_size_t tb_tree_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_tree_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(itor);
+
+    // the next item in this leaf or the next leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    tb_size_t           index = tb_tree_map_itor_index(itor) + 1;
+    if (index < leaf->node.size) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+static tb_size_t tb_tree_map_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // the tail? the last item
+    tb_check_return_val(itor, tb_tree_map_itor_last(iterator));
+
+    // the prev item in this leaf or the prev leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    tb_size_t           index = tb_tree_map_itor_index(itor);
+    if (index) return tb_tree_map_itor_make(leaf, index - 1);
+    return leaf->prev? tb_tree_map_itor_make(leaf->prev, leaf->prev->node.size - 1) : 0;
+}
+static tb_pointer_t tb_tree_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map && itor);
+
+    // the item
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    tb_size_t           index = tb_tree_map_itor_index(itor);
+    tb_assert_and_check_return_val(index < leaf->node.size, tb_null);
+
+    // get item
+    tb_byte_t* item = tb_tree_map_leaf_item(tree_map, leaf, index);
+    tree_map->item.name = tree_map->element_name.data(&tree_map->element_name, item);
+    tree_map->item.data = tree_map->element_data.data(&tree_map->element_data, item + tree_map->element_name.size);
+    return &(tree_map->item);
+}
+static tb_void_t tb_tree_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map && itor);
+
+    // the item
+    tb_tree_map_leaf_t* leaf = tb_tree_map_itor_leaf(itor);
+    tb_size_t           index = tb_tree_map_itor_index(itor);
+    tb_assert_and_check_return(index < leaf->node.size);
+
+    // note: copy data only, will destroy the order if copy name
+    tree_map->element_data.copy(&tree_map->element_data, tb_tree_map_leaf_item(tree_map, leaf, index) + tree_map->element_name.size, item);
+}
+static tb_long_t tb_tree_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map && tree_map->element_name.comp && lelement && relement);
+    
+    // done
+    return tree_map->element_name.comp(&tree_map->element_name, ((tb_tree_map_item_ref_t)lelement)->name, ((tb_tree_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_tree_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map && itor);
+
+    // remove it
+    tb_tree_map_remove_itor(tree_map, itor);
+}
+static tb_void_t tb_tree_map_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)iterator;
+    tb_assert(tree_map);
+
+    // remove items: [itor, next), the items before the removed item are not moved
+    tb_size_t itor = prev? tb_tree_map_itor_next(iterator, prev) : tb_tree_map_itor_head(iterator);
+    while (itor && size--) itor = tb_tree_map_remove_itor(tree_map, itor);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_tree_map_ref_t tb_tree_map_init(tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_tree_map_t*  tree_map = tb_null;
+    do
+    {
+        // make self
+        tree_map = tb_malloc0_type(tb_tree_map_t);
+        tb_assert_and_check_break(tree_map);
+
+        // init self func
+        tree_map->element_name = element_name;
+        tree_map->element_data = element_data;
+
+        // init item itor
+        tree_map->itor.mode             = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_MUTABLE;
+        tree_map->itor.priv             = tb_null;
+        tree_map->itor.step             = sizeof(tb_tree_map_item_t);
+        tree_map->itor.size             = tb_tree_map_itor_size;
+        tree_map->itor.head             = tb_tree_map_itor_head;
+        tree_map->itor.last             = tb_tree_map_itor_last;
+        tree_map->itor.tail             = tb_tree_map_itor_tail;
+        tree_map->itor.prev             = tb_tree_map_itor_prev;
+        tree_map->itor.next             = tb_tree_map_itor_next;
+        tree_map->itor.item             = tb_tree_map_itor_item;
+        tree_map->itor.copy             = tb_tree_map_itor_copy;
+        tree_map->itor.comp             = tb_tree_map_itor_comp;
+        tree_map->itor.remove           = tb_tree_map_itor_remove;
+        tree_map->itor.remove_range     = tb_tree_map_itor_remove_range;
+
+        /* init the maximum item count of leaf and the maximum key count of inner node for the node size
+         *
+         * the item index of leaf must be less than the leaf alignment
+         */
+        tree_map->item_step     = element_name.size + element_data.size;
+        tree_map->leaf_maxn     = (TB_TREE_MAP_NODE_SIZE - sizeof(tb_tree_map_leaf_t)) / tree_map->item_step;
+        tree_map->leaf_maxn     = tb_max(tb_min(tree_map->leaf_maxn, TB_TREE_MAP_LEAF_ALIGN - 1), 4);
+        tree_map->inner_maxn    = (TB_TREE_MAP_NODE_SIZE - sizeof(tb_tree_map_inner_t) - sizeof(tb_tree_map_node_t*)) / (element_name.size + sizeof(tb_tree_map_node_t*));
+        tree_map->inner_maxn    = tb_max(tree_map->inner_maxn, 4);
+
+        // make the key for splitting node
+        tree_map->key = (tb_byte_t*)tb_malloc0(element_name.size);
+        tb_assert_and_check_break(tree_map->key);
+
+        // make the root leaf
+        tree_map->root = (tb_tree_map_node_t*)tb_tree_map_leaf_init(tree_map);
+        tb_assert_and_check_break(tree_map->root);
+        tree_map->head = (tb_tree_map_leaf_t*)tree_map->root;
+        tree_map->last = (tb_tree_map_leaf_t*)tree_map->root;
+
+        // trace
+        tb_trace_d("init: leaf_maxn: %lu, inner_maxn: %lu", tree_map->leaf_maxn, tree_map->inner_maxn);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (tree_map) tb_tree_map_exit((tb_tree_map_ref_t)tree_map);
+        tree_map = tb_null;
+    }
+
+    // ok?
+    return (tb_tree_map_ref_t)tree_map;
+}
+tb_void_t tb_tree_map_exit(tb_tree_map_ref_t self)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return(tree_map);
+
+    // exit all nodes
+    if (tree_map->root) tb_tree_map_node_exit(tree_map, tree_map->root);
+    tree_map->root = tb_null;
+
+    // exit key
+    if (tree_map->key) tb_free(tree_map->key);
+    tree_map->key = tb_null;
+
+    // free it
+    tb_free(tree_map);
+}
+tb_void_t tb_tree_map_clear(tb_tree_map_ref_t self)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return(tree_map && tree_map->root);
+
+    // make a new root leaf
+    tb_tree_map_leaf_t* root = tb_tree_map_leaf_init(tree_map);
+    tb_assert_and_check_return(root);
+
+    // exit all nodes
+    tb_tree_map_node_exit(tree_map, tree_map->root);
+
+    // reset it
+    tree_map->root  = (tb_tree_map_node_t*)root;
+    tree_map->head  = root;
+    tree_map->last  = root;
+    tree_map->size  = 0;
+}
+tb_pointer_t tb_tree_map_get(tb_tree_map_ref_t self, tb_cpointer_t name)
+{
+    // find it
+    tb_size_t itor = tb_tree_map_find(self, name);
+    tb_check_return_val(itor, tb_null);
+
+    // get data
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_byte_t* item = tb_tree_map_leaf_item(tree_map, tb_tree_map_itor_leaf(itor), tb_tree_map_itor_index(itor));
+    return tree_map->element_data.data(&tree_map->element_data, item + tree_map->element_name.size);
+}
+tb_size_t tb_tree_map_find(tb_tree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return_val(tree_map, 0);
+
+    // find the leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_from(tree_map, name, tb_null, tb_null);
+    tb_assert_and_check_return_val(leaf, 0);
+
+    // find the item
+    tb_size_t index = tb_tree_map_leaf_find(tree_map, leaf, name, tb_false);
+    return (index < leaf->node.size && !tb_tree_map_comp(tree_map, name, tb_tree_map_leaf_item(tree_map, leaf, index)))? tb_tree_map_itor_make(leaf, index) : 0;
+}
+tb_size_t tb_tree_map_lower_bound(tb_tree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return_val(tree_map, 0);
+
+    // find the leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_from(tree_map, name, tb_null, tb_null);
+    tb_assert_and_check_return_val(leaf, 0);
+
+    // find the item in this leaf or the first item of the next leaf
+    tb_size_t index = tb_tree_map_leaf_find(tree_map, leaf, name, tb_false);
+    if (index < leaf->node.size) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+tb_size_t tb_tree_map_upper_bound(tb_tree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return_val(tree_map, 0);
+
+    // find the leaf
+    tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_from(tree_map, name, tb_null, tb_null);
+    tb_assert_and_check_return_val(leaf, 0);
+
+    // find the item in this leaf or the first item of the next leaf
+    tb_size_t index = tb_tree_map_leaf_find(tree_map, leaf, name, tb_true);
+    if (index < leaf->node.size) return tb_tree_map_itor_make(leaf, index);
+    return leaf->next? tb_tree_map_itor_make(leaf->next, 0) : 0;
+}
+tb_size_t tb_tree_map_insert(tb_tree_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return_val(tree_map, 0);
+
+    // find the leaf
+    tb_size_t           depth = 0;
+    tb_tree_map_path_t  path[TB_TREE_MAP_DEPTH_MAXN];
+    tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_from(tree_map, name, path, &depth);
+    tb_assert_and_check_return_val(leaf, 0);
+
+    // exists? replace data
+    tb_size_t   index = tb_tree_map_leaf_find(tree_map, leaf, name, tb_false);
+    tb_size_t   size = leaf->node.size;
+    tb_byte_t*  item = tb_tree_map_leaf_item(tree_map, leaf, index);
+    if (index < size && !tb_tree_map_comp(tree_map, name, item))
+    {
+        tree_map->element_data.repl(&tree_map->element_data, item + tree_map->element_name.size, data);
+        return tb_tree_map_itor_make(leaf, index);
+    }
+
+    // insert item, the leaf has an extra item for splitting
+    if (index < size) tb_memmov(item + tree_map->item_step, item, (size - index) * tree_map->item_step);
+    tree_map->element_name.dupl(&tree_map->element_name, item, name);
+    tree_map->element_data.dupl(&tree_map->element_data, item + tree_map->element_name.size, data);
+    leaf->node.size = (tb_uint32_t)++size;
+    tree_map->size++;
+
+    // not full? ok
+    tb_check_return_val(size > tree_map->leaf_maxn, tb_tree_map_itor_make(leaf, index));
+
+    // make the right leaf
+    tb_tree_map_leaf_t* right = tb_tree_map_leaf_init(tree_map);
+    tb_assert_and_check_return_val(right, 0);
+
+    // split it
+    tb_size_t middle = size >> 1;
+    tb_memcpy(tb_tree_map_leaf_item(tree_map, right, 0), tb_tree_map_leaf_item(tree_map, leaf, middle), (size - middle) * tree_map->item_step);
+    right->node.size    = (tb_uint32_t)(size - middle);
+    leaf->node.size     = (tb_uint32_t)middle;
+
+    // insert the right leaf to the leaf list
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next) leaf->next->prev = right;
+    else tree_map->last = right;
+    leaf->next = right;
+
+    // insert the first name of the right leaf to the parent
+    tree_map->element_name.dupl(&tree_map->element_name, tree_map->key, tree_map->element_name.data(&tree_map->element_name, tb_tree_map_leaf_item(tree_map, right, 0)));
+    if (!tb_tree_map_insert_parent(tree_map, path, depth, (tb_tree_map_node_t*)right)) return 0;
+
+    // ok
+    return index < middle? tb_tree_map_itor_make(leaf, index) : tb_tree_map_itor_make(right, index - middle);
+}
+tb_void_t tb_tree_map_remove(tb_tree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return(tree_map);
+
+    // find the leaf
+    tb_size_t           depth = 0;
+    tb_tree_map_path_t  path[TB_TREE_MAP_DEPTH_MAXN];
+    tb_tree_map_leaf_t* leaf = tb_tree_map_leaf_from(tree_map, name, path, &depth);
+    tb_assert_and_check_return(leaf);
+
+    // find the item
+    tb_size_t index = tb_tree_map_leaf_find(tree_map, leaf, name, tb_false);
+    tb_check_return(index < leaf->node.size && !tb_tree_map_comp(tree_map, name, tb_tree_map_leaf_item(tree_map, leaf, index)));
+
+    // remove it
+    tb_tree_map_remove_item(tree_map, leaf, index, path, depth);
+}
+tb_size_t tb_tree_map_size(tb_tree_map_ref_t self)
+{
+    // check
+    tb_tree_map_t const* tree_map = (tb_tree_map_t const*)self;
+    tb_assert_and_check_return_val(tree_map, 0);
+
+    // the size
+    return tree_map->size;
+}
+#ifdef __tb_debug__
+tb_void_t tb_tree_map_dump(tb_tree_map_ref_t self)
+{
+    // check
+    tb_tree_map_t* tree_map = (tb_tree_map_t*)self;
+    tb_assert_and_check_return(tree_map);
+
+    // the depth
+    tb_size_t depth = 0;
+    tb_tree_map_node_t* node = tree_map->root;
+    while (node && !node->leaf) 
+    {
+        node = tb_tree_map_inner_childs((tb_tree_map_inner_t*)node)[0];
+        depth++;
+    }
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, depth: %lu, leaf_maxn: %lu, inner_maxn: %lu", tree_map->size, depth, tree_map->leaf_maxn, tree_map->inner_maxn);
+
+    // done
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    tb_size_t itor = tb_tree_map_itor_head((tb_iterator_ref_t)tree_map);
+    for (; itor; itor = tb_tree_map_itor_next((tb_iterator_ref_t)tree_map, itor))
+    {
+        // the item, @note the item func of iterator may be hooked by the tree set
+        tb_tree_map_item_ref_t item = (tb_tree_map_item_ref_t)tb_tree_map_itor_item((tb_iterator_ref_t)tree_map, itor);
+        tb_assert_and_check_break(item);
+
+        // trace
+        if (tree_map->element_name.cstr && tree_map->element_data.cstr)
+        {
+            tb_trace_i("    %s => %s", tree_map->element_name.cstr(&tree_map->element_name, item->name, name, sizeof(name)), tree_map->element_data.cstr(&tree_map->element_data, item->data, data, sizeof(data)));
+        }
+        else if (tree_map->element_name.cstr) 
+        {
+            tb_trace_i("    %s => %p", tree_map->element_name.cstr(&tree_map->element_name, item->name, name, sizeof(name)), item->data);
+        }
+        else if (tree_map->element_data.cstr) 
+        {
+            tb_trace_i("    %x => %p", item->name, tree_map->element_data.cstr(&tree_map->element_data, item->data, data, sizeof(data)));
+        }
+        else 
+        {
+            tb_trace_i("    %p => %p", item->name, item->data);
+        }
+    }
+}
+#endif
@@ -0,0 +1,183 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tree_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TREE_MAP_H
+#define TB_CONTAINER_TREE_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+#include "hash_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the tree map item type
+typedef tb_hash_map_item_t      tb_tree_map_item_t;
+
+/// the tree map item ref type
+typedef tb_hash_map_item_ref_t  tb_tree_map_item_ref_t;
+
+/*! the tree map ref type
+ *
+ * <pre>
+ *
+ * the ordered map of the b+tree, the items are sorted by the name comparator of the element
+ *
+ *                              inner: |  c0  | k0 |  c1  | k1 |  c2  |
+ *                                        |           |           |
+ *                 -----------------------            |            -----------------------
+ *                |                                   |                                   |
+ * leaf: | item0 | item1 | ... | <=> | itemk | itemk+1 | ... | <=> | itemn | itemn+1 | ... |
+ *
+ * the node size is some cache lines, and the itor is the leaf address and the item index
+ *
+ * </pre>
+ *
+ * @note the itor of the same item is mutable, all itors will be changed after inserting
+ */
+typedef tb_iterator_ref_t tb_tree_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init tree map
+ *
+ * @param element_name  the item for name, the comp func is required
+ * @param element_data  the item for data
+ *
+ * @return              the tree map
+ */
+tb_tree_map_ref_t       tb_tree_map_init(tb_element_t element_name, tb_element_t element_data);
+
+/*! exit tree map
+ *
+ * @param tree_map      the tree map
+ */
+tb_void_t               tb_tree_map_exit(tb_tree_map_ref_t tree_map);
+
+/*! clear tree map
+ *
+ * @param tree_map      the tree map
+ */
+tb_void_t               tb_tree_map_clear(tb_tree_map_ref_t tree_map);
+
+/*! get item data from name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_tree_map_get(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ *
+ * @return              the item itor, return tb_iterator_tail(tree_map) if not found
+ */
+tb_size_t               tb_tree_map_find(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! find the first item whose name is not less than the given name
+ *
+ * @code
+ *
+ * // walk all items in the range: [lname, rname]
+ * tb_size_t head = tb_tree_map_lower_bound(tree_map, lname);
+ * tb_size_t tail = tb_tree_map_upper_bound(tree_map, rname);
+ * tb_for (tb_tree_map_item_ref_t, item, head, tail, tree_map)
+ * {
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ *
+ * @return              the item itor, return tb_iterator_tail(tree_map) if not found
+ */
+tb_size_t               tb_tree_map_lower_bound(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! find the first item whose name is greater than the given name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ *
+ * @return              the item itor, return tb_iterator_tail(tree_map) if not found
+ */
+tb_size_t               tb_tree_map_upper_bound(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! insert item data from name, the data will be replaced if the name exists
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_tree_map_insert(tb_tree_map_ref_t tree_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param tree_map      the tree map
+ * @param name          the item name
+ */
+tb_void_t               tb_tree_map_remove(tb_tree_map_ref_t tree_map, tb_cpointer_t name);
+
+/*! the tree map size
+ *
+ * @param tree_map      the tree map
+ *
+ * @return              the tree map size
+ */
+tb_size_t               tb_tree_map_size(tb_tree_map_ref_t tree_map);
+
+#ifdef __tb_debug__
+/*! dump tree map
+ *
+ * @param tree_map      the tree map
+ */
+tb_void_t               tb_tree_map_dump(tb_tree_map_ref_t tree_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
@@ -0,0 +1,123 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tree_set.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "tree_set"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tree_set.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tree map itor item func type
+typedef tb_pointer_t (*tb_tree_map_item_func_t)(tb_iterator_ref_t, tb_size_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_pointer_t tb_tree_set_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(iterator && iterator->priv);
+
+    // the item func for the tree map
+    tb_tree_map_item_func_t func = (tb_tree_map_item_func_t)iterator->priv;
+
+    // get the item of the tree map
+    tb_tree_map_item_ref_t item = (tb_tree_map_item_ref_t)func(iterator, itor);
+    
+    // get the item of the tree set
+    return item? item->name : tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_tree_set_ref_t tb_tree_set_init(tb_element_t element)
+{
+    // init tree set
+    tb_iterator_ref_t tree_set = (tb_iterator_ref_t)tb_tree_map_init(element, tb_element_true());
+    tb_assert_and_check_return_val(tree_set, tb_null);
+
+    // @note the private data of the tree map iterator cannot be used
+    tb_assert(!tree_set->priv);
+
+    // hacking tree_map and hook the item
+    tree_set->priv = (tb_pointer_t)tree_set->item;
+    tree_set->item = tb_tree_set_itor_item;
+
+    // ok?
+    return (tb_tree_set_ref_t)tree_set;
+}
+tb_void_t tb_tree_set_exit(tb_tree_set_ref_t self)
+{
+    tb_tree_map_exit((tb_tree_map_ref_t)self);
+}
+tb_void_t tb_tree_set_clear(tb_tree_set_ref_t self)
+{
+    tb_tree_map_clear((tb_tree_map_ref_t)self);
+}
+tb_bool_t tb_tree_set_get(tb_tree_set_ref_t self, tb_cpointer_t data)
+{
+    return tb_p2b(tb_tree_map_get((tb_tree_map_ref_t)self, data));
+}
+tb_size_t tb_tree_set_find(tb_tree_set_ref_t self, tb_cpointer_t data)
+{
+    return tb_tree_map_find((tb_tree_map_ref_t)self, data);
+}
+tb_size_t tb_tree_set_lower_bound(tb_tree_set_ref_t self, tb_cpointer_t data)
+{
+    return tb_tree_map_lower_bound((tb_tree_map_ref_t)self, data);
+}
+tb_size_t tb_tree_set_upper_bound(tb_tree_set_ref_t self, tb_cpointer_t data)
+{
+    return tb_tree_map_upper_bound((tb_tree_map_ref_t)self, data);
+}
+tb_size_t tb_tree_set_insert(tb_tree_set_ref_t self, tb_cpointer_t data)
+{
+    return tb_tree_map_insert((tb_tree_map_ref_t)self, data, tb_b2p(tb_true));
+}
+tb_void_t tb_tree_set_remove(tb_tree_set_ref_t self, tb_cpointer_t data)
+{
+    tb_tree_map_remove((tb_tree_map_ref_t)self, data);
+}
+tb_size_t tb_tree_set_size(tb_tree_set_ref_t self)
+{
+    return tb_tree_map_size((tb_tree_map_ref_t)self);
+}
+#ifdef __tb_debug__
+tb_void_t tb_tree_set_dump(tb_tree_set_ref_t self)
+{
+    tb_tree_map_dump((tb_tree_map_ref_t)self);
+}
+#endif
@@ -0,0 +1,148 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tree_set.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TREE_SET_H
+#define TB_CONTAINER_TREE_SET_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tree_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the tree set ref type, the items are sorted
+ *
+ * @note the itor of the same item is mutable
+ */
+typedef tb_iterator_ref_t tb_tree_set_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init tree set
+ *
+ * @param element       the element, the comp func is required
+ *
+ * @return              the tree set
+ */
+tb_tree_set_ref_t       tb_tree_set_init(tb_element_t element);
+
+/*! exit tree set
+ *
+ * @param tree_set      the tree set
+ */
+tb_void_t               tb_tree_set_exit(tb_tree_set_ref_t tree_set);
+
+/*! clear tree set
+ *
+ * @param tree_set      the tree set
+ */
+tb_void_t               tb_tree_set_clear(tb_tree_set_ref_t tree_set);
+
+/*! get item?
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_tree_set_get(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! find item 
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, return tb_iterator_tail(tree_set) if not found
+ */
+tb_size_t               tb_tree_set_find(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! find the first item which is not less than the given data
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, return tb_iterator_tail(tree_set) if not found
+ */
+tb_size_t               tb_tree_set_lower_bound(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! find the first item which is greater than the given data
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, return tb_iterator_tail(tree_set) if not found
+ */
+tb_size_t               tb_tree_set_upper_bound(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! insert item
+ *
+ * @note each item is unique
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_tree_set_insert(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! remove item
+ *
+ * @param tree_set      the tree set
+ * @param data          the item data
+ */
+tb_void_t               tb_tree_set_remove(tb_tree_set_ref_t tree_set, tb_cpointer_t data);
+
+/*! the tree set size
+ *
+ * @param tree_set      the tree set
+ *
+ * @return              the tree set size
+ */
+tb_size_t               tb_tree_set_size(tb_tree_set_ref_t tree_set);
+
+#ifdef __tb_debug__
+/*! dump tree set
+ *
+ * @param tree_set      the tree set
+ */
+tb_void_t               tb_tree_set_dump(tb_tree_set_ref_t tree_set);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,286 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_HASH_MAP_H
+#define TB_CONTAINER_TYPED_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the typed hash map slot is empty
+#define TB_TYPED_HASH_MAP_SLOT_EMPTY        (0)
+
+/// the typed hash map slot is full
+#define TB_TYPED_HASH_MAP_SLOT_FULL         (1)
+
+/// the typed hash map slot is deleted
+#define TB_TYPED_HASH_MAP_SLOT_DELETED      (2)
+
+/*! define the typed hash map
+ *
+ * the open addressing hash map with the linear probing, the names and the data are stored 
+ * in the plain arrays of the given types and the names are hashed and compared directly.
+ *
+ * @code
+ *
+ * // define tb_hash_map_u32_t
+ * TB_HASH_MAP_DEFINE(u32, tb_uint32_t, tb_size_t, tb_typed_hash_uint32, tb_typed_equal)
+ *
+ * tb_hash_map_u32_t hash_map;
+ * tb_hash_map_u32_init(&hash_map, 0);
+ * tb_hash_map_u32_insert(&hash_map, 10, 100);
+ *
+ * tb_size_t* data = tb_hash_map_u32_get(&hash_map, 10);
+ * if (data) tb_trace_i("%lu", *data);
+ *
+ * tb_size_t slot = 0;
+ * for (slot = tb_hash_map_u32_head(&hash_map); slot != tb_hash_map_u32_tail(&hash_map); slot = tb_hash_map_u32_next(&hash_map, slot))
+ * {
+ *      tb_trace_i("%u => %lu", hash_map.names[slot], hash_map.datas[slot]);
+ * }
+ * tb_hash_map_u32_exit(&hash_map);
+ *
+ * @endcode
+ *
+ * @param name          the name suffix, will define tb_hash_map_[name]_t and tb_hash_map_[name]_xxx()
+ * @param name_type     the name type, must be trivially copyable
+ * @param data_type     the data type, must be trivially copyable
+ * @param hash          the hasher: hash(name) returns tb_size_t
+ * @param equal         the equality: equal(a, b) returns tb_true if they are same
+ */
+#define TB_HASH_MAP_DEFINE(name, name_type, data_type, hash, equal) \
+    \
+    /* the typed hash map type */ \
+    typedef struct __tb_hash_map_##name##_t \
+    { \
+        /* the slot states */ \
+        tb_byte_t*      slots; \
+        \
+        /* the names */ \
+        name_type*      names; \
+        \
+        /* the datas */ \
+        data_type*      datas; \
+        \
+        /* the item count */ \
+        tb_size_t       size; \
+        \
+        /* the used slot count, the full and deleted slots */ \
+        tb_size_t       used; \
+        \
+        /* the slot count, the power of 2 */ \
+        tb_size_t       maxn; \
+        \
+        /* the initial slot count */ \
+        tb_size_t       init; \
+        \
+    }tb_hash_map_##name##_t; \
+    \
+    /* init hash map, using the default slot count if be zero */ \
+    static __tb_inline__ tb_void_t tb_hash_map_##name##_init(tb_hash_map_##name##_t* hash_map, tb_size_t bucket_size) \
+    { \
+        tb_assert(hash_map); \
+        tb_memset(hash_map, 0, sizeof(tb_hash_map_##name##_t)); \
+        hash_map->init = tb_align_pow2(tb_max(bucket_size, 16)); \
+    } \
+    \
+    /* exit hash map */ \
+    static __tb_inline__ tb_void_t tb_hash_map_##name##_exit(tb_hash_map_##name##_t* hash_map) \
+    { \
+        tb_assert(hash_map); \
+        if (hash_map->slots) tb_free(hash_map->slots); \
+        if (hash_map->names) tb_free(hash_map->names); \
+        if (hash_map->datas) tb_free(hash_map->datas); \
+        hash_map->slots = tb_null; \
+        hash_map->names = tb_null; \
+        hash_map->datas = tb_null; \
+        hash_map->size  = 0; \
+        hash_map->used  = 0; \
+        hash_map->maxn  = 0; \
+    } \
+    \
+    /* clear hash map */ \
+    static __tb_inline__ tb_void_t tb_hash_map_##name##_clear(tb_hash_map_##name##_t* hash_map) \
+    { \
+        tb_assert(hash_map); \
+        if (hash_map->slots) tb_memset(hash_map->slots, TB_TYPED_HASH_MAP_SLOT_EMPTY, hash_map->maxn); \
+        hash_map->size = 0; \
+        hash_map->used = 0; \
+    } \
+    \
+    /* the item count */ \
+    static __tb_inline__ tb_size_t tb_hash_map_##name##_size(tb_hash_map_##name##_t const* hash_map) \
+    { \
+        tb_assert(hash_map); \
+        return hash_map->size; \
+    } \
+    \
+    /* find the slot of the name, return the slot count if not found */ \
+    static __tb_inline__ tb_size_t tb_hash_map_##name##_find(tb_hash_map_##name##_t const* hash_map, name_type name) \
+    { \
+        tb_assert(hash_map); \
+        tb_check_return_val(hash_map->size, hash_map->maxn); \
+        tb_size_t mask = hash_map->maxn - 1; \
+        tb_size_t slot = (tb_size_t)(hash(name)) & mask; \
+        while (1) \
+        { \
+            tb_byte_t state = hash_map->slots[slot]; \
+            if (state == TB_TYPED_HASH_MAP_SLOT_EMPTY) return hash_map->maxn; \
+            if (state == TB_TYPED_HASH_MAP_SLOT_FULL && equal(hash_map->names[slot], name)) return slot; \
+            slot = (slot + 1) & mask; \
+        } \
+        return hash_map->maxn; \
+    } \
+    \
+    /* get the data of the name, return tb_null if not found */ \
+    static __tb_inline__ data_type* tb_hash_map_##name##_get(tb_hash_map_##name##_t const* hash_map, name_type name) \
+    { \
+        tb_size_t slot = tb_hash_map_##name##_find(hash_map, name); \
+        return slot != hash_map->maxn? hash_map->datas + slot : tb_null; \
+    } \
+    \
+    /* rehash all items to the new slots */ \
+    static tb_bool_t tb_hash_map_##name##_rehash(tb_hash_map_##name##_t* hash_map, tb_size_t maxn) \
+    { \
+        tb_byte_t*  slots = tb_nalloc0_type(maxn, tb_byte_t); \
+        name_type*  names = tb_nalloc_type(maxn, name_type); \
+        data_type*  datas = tb_nalloc_type(maxn, data_type); \
+        if (!slots || !names || !datas) \
+        { \
+            if (slots) tb_free(slots); \
+            if (names) tb_free(names); \
+            if (datas) tb_free(datas); \
+            return tb_false; \
+        } \
+        tb_size_t i = 0; \
+        tb_size_t mask = maxn - 1; \
+        for (i = 0; i < hash_map->maxn; i++) \
+        { \
+            tb_check_continue(hash_map->slots[i] == TB_TYPED_HASH_MAP_SLOT_FULL); \
+            tb_size_t slot = (tb_size_t)(hash(hash_map->names[i])) & mask; \
+            while (slots[slot]) slot = (slot + 1) & mask; \
+            slots[slot] = TB_TYPED_HASH_MAP_SLOT_FULL; \
+            names[slot] = hash_map->names[i]; \
+            datas[slot] = hash_map->datas[i]; \
+        } \
+        if (hash_map->slots) tb_free(hash_map->slots); \
+        if (hash_map->names) tb_free(hash_map->names); \
+        if (hash_map->datas) tb_free(hash_map->datas); \
+        hash_map->slots = slots; \
+        hash_map->names = names; \
+        hash_map->datas = datas; \
+        hash_map->maxn  = maxn; \
+        hash_map->used  = hash_map->size; \
+        return tb_true; \
+    } \
+    \
+    /* insert or replace the data of the name, return the data address or tb_null if failed */ \
+    static __tb_inline__ data_type* tb_hash_map_##name##_insert(tb_hash_map_##name##_t* hash_map, name_type name, data_type data) \
+    { \
+        tb_assert(hash_map); \
+        \
+        /* the load factor of the used slots is 3/4 at most, grow it or remove the deleted slots */ \
+        if (((hash_map->used + 1) << 2) > hash_map->maxn * 3) \
+        { \
+            tb_size_t maxn = hash_map->maxn? hash_map->maxn : hash_map->init; \
+            if (((hash_map->size + 1) << 1) > maxn) maxn <<= 1; \
+            if (!tb_hash_map_##name##_rehash(hash_map, maxn)) return tb_null; \
+        } \
+        \
+        /* find the name or the first free slot */ \
+        tb_size_t mask = hash_map->maxn - 1; \
+        tb_size_t slot = (tb_size_t)(hash(name)) & mask; \
+        tb_size_t hole = hash_map->maxn; \
+        while (1) \
+        { \
+            tb_byte_t state = hash_map->slots[slot]; \
+            if (state == TB_TYPED_HASH_MAP_SLOT_EMPTY) break; \
+            if (state == TB_TYPED_HASH_MAP_SLOT_FULL) \
+            { \
+                if (equal(hash_map->names[slot], name)) \
+                { \
+                    hash_map->datas[slot] = data; \
+                    return hash_map->datas + slot; \
+                } \
+            } \
+            else if (hole == hash_map->maxn) hole = slot; \
+            slot = (slot + 1) & mask; \
+        } \
+        \
+        /* reuse the deleted slot first */ \
+        if (hole != hash_map->maxn) slot = hole; \
+        else hash_map->used++; \
+        hash_map->slots[slot] = TB_TYPED_HASH_MAP_SLOT_FULL; \
+        hash_map->names[slot] = name; \
+        hash_map->datas[slot] = data; \
+        hash_map->size++; \
+        return hash_map->datas + slot; \
+    } \
+    \
+    /* remove the name, return tb_false if not found */ \
+    static __tb_inline__ tb_bool_t tb_hash_map_##name##_remove(tb_hash_map_##name##_t* hash_map, name_type name) \
+    { \
+        tb_size_t slot = tb_hash_map_##name##_find(hash_map, name); \
+        tb_check_return_val(slot != hash_map->maxn, tb_false); \
+        \
+        /* mark it as empty directly if the next slot is empty, the probe sequence need not pass it */ \
+        if (hash_map->slots[(slot + 1) & (hash_map->maxn - 1)] == TB_TYPED_HASH_MAP_SLOT_EMPTY) \
+        { \
+            hash_map->slots[slot] = TB_TYPED_HASH_MAP_SLOT_EMPTY; \
+            hash_map->used--; \
+        } \
+        else hash_map->slots[slot] = TB_TYPED_HASH_MAP_SLOT_DELETED; \
+        hash_map->size--; \
+        return tb_true; \
+    } \
+    \
+    /* the next full slot from the given slot, return the slot count if no more */ \
+    static __tb_inline__ tb_size_t tb_hash_map_##name##_next(tb_hash_map_##name##_t const* hash_map, tb_size_t slot) \
+    { \
+        tb_assert(hash_map); \
+        for (slot++; slot < hash_map->maxn && hash_map->slots[slot] != TB_TYPED_HASH_MAP_SLOT_FULL; slot++) ; \
+        return slot; \
+    } \
+    \
+    /* the first full slot */ \
+    static __tb_inline__ tb_size_t tb_hash_map_##name##_head(tb_hash_map_##name##_t const* hash_map) \
+    { \
+        return tb_hash_map_##name##_next(hash_map, (tb_size_t)-1); \
+    } \
+    \
+    /* the tail slot */ \
+    static __tb_inline__ tb_size_t tb_hash_map_##name##_tail(tb_hash_map_##name##_t const* hash_map) \
+    { \
+        tb_assert(hash_map); \
+        return hash_map->maxn; \
+    }
+
+#endif
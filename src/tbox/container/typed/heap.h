@@ -0,0 +1,175 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        heap.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_HEAP_H
+#define TB_CONTAINER_TYPED_HEAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! define the typed heap
+ *
+ * the min heap of the given type, the top is the smallest item for the comp, 
+ * using tb_typed_comp_greater for the max heap.
+ *
+ * @code
+ *
+ * // define tb_heap_u32_t
+ * TB_HEAP_DEFINE(u32, tb_uint32_t, tb_typed_comp)
+ *
+ * tb_heap_u32_t heap;
+ * tb_heap_u32_init(&heap, 0);
+ * tb_heap_u32_put(&heap, 10);
+ * tb_heap_u32_put(&heap, 5);
+ * while (tb_heap_u32_size(&heap))
+ * {
+ *      tb_trace_i("%u", tb_heap_u32_top(&heap));
+ *      tb_heap_u32_pop(&heap);
+ * }
+ * tb_heap_u32_exit(&heap);
+ *
+ * @endcode
+ *
+ * @param name          the name suffix, will define tb_heap_[name]_t and tb_heap_[name]_xxx()
+ * @param type          the item type, must be trivially copyable
+ * @param comp          the comparer: comp(a, b) returns the negative, zero or positive value
+ */
+#define TB_HEAP_DEFINE(name, type, comp) \
+    \
+    /* the typed heap type */ \
+    typedef struct __tb_heap_##name##_t \
+    { \
+        /* the items */ \
+        type*           data; \
+        \
+        /* the item count */ \
+        tb_size_t       size; \
+        \
+        /* the item maxn */ \
+        tb_size_t       maxn; \
+        \
+        /* the grow */ \
+        tb_size_t       grow; \
+        \
+    }tb_heap_##name##_t; \
+    \
+    /* init heap, using the default grow if be zero */ \
+    static __tb_inline__ tb_void_t tb_heap_##name##_init(tb_heap_##name##_t* heap, tb_size_t grow) \
+    { \
+        tb_assert(heap); \
+        heap->data = tb_null; \
+        heap->size = 0; \
+        heap->maxn = 0; \
+        heap->grow = grow? grow : TB_TYPED_GROW; \
+    } \
+    \
+    /* exit heap */ \
+    static __tb_inline__ tb_void_t tb_heap_##name##_exit(tb_heap_##name##_t* heap) \
+    { \
+        tb_assert(heap); \
+        if (heap->data) tb_free(heap->data); \
+        heap->data = tb_null; \
+        heap->size = 0; \
+        heap->maxn = 0; \
+    } \
+    \
+    /* clear heap */ \
+    static __tb_inline__ tb_void_t tb_heap_##name##_clear(tb_heap_##name##_t* heap) \
+    { \
+        tb_assert(heap); \
+        heap->size = 0; \
+    } \
+    \
+    /* the item count */ \
+    static __tb_inline__ tb_size_t tb_heap_##name##_size(tb_heap_##name##_t const* heap) \
+    { \
+        tb_assert(heap); \
+        return heap->size; \
+    } \
+    \
+    /* the top item */ \
+    static __tb_inline__ type tb_heap_##name##_top(tb_heap_##name##_t const* heap) \
+    { \
+        tb_assert(heap && heap->size); \
+        return heap->data[0]; \
+    } \
+    \
+    /* put the item */ \
+    static __tb_inline__ tb_bool_t tb_heap_##name##_put(tb_heap_##name##_t* heap, type data) \
+    { \
+        tb_assert(heap); \
+        \
+        /* grow the items, the grow of the large heap is proportional to its size */ \
+        if (heap->size >= heap->maxn) \
+        { \
+            tb_size_t   maxn = tb_align4(heap->maxn + (heap->maxn >> 1) + heap->grow); \
+            type*       items = tb_ralloc_type(heap->data, maxn, type); \
+            tb_assert_and_check_return_val(items, tb_false); \
+            heap->data = items; \
+            heap->maxn = maxn; \
+        } \
+        \
+        /* shift up the hole from the tail */ \
+        type*       items = heap->data; \
+        tb_size_t   index = heap->size++; \
+        while (index) \
+        { \
+            tb_size_t parent = (index - 1) >> 1; \
+            if (comp(items[parent], data) <= 0) break; \
+            items[index] = items[parent]; \
+            index = parent; \
+        } \
+        items[index] = data; \
+        return tb_true; \
+    } \
+    \
+    /* pop the top item */ \
+    static __tb_inline__ tb_void_t tb_heap_##name##_pop(tb_heap_##name##_t* heap) \
+    { \
+        tb_assert(heap && heap->size); \
+        \
+        /* shift down the hole from the head and fill the last item */ \
+        type*       items = heap->data; \
+        tb_size_t   size = --heap->size; \
+        type        last = items[size]; \
+        tb_size_t   index = 0; \
+        tb_size_t   child = 0; \
+        while ((child = (index << 1) + 1) < size) \
+        { \
+            if (child + 1 < size && comp(items[child + 1], items[child]) < 0) child++; \
+            if (comp(last, items[child]) <= 0) break; \
+            items[index] = items[child]; \
+            index = child; \
+        } \
+        if (size) items[index] = last; \
+    }
+
+#endif
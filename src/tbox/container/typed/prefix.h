@@ -0,0 +1,81 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        prefix.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_PREFIX_H
+#define TB_CONTAINER_TYPED_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include "../../libc/libc.h"
+#include "../../utils/utils.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default grow of the typed containers
+#ifdef __tb_small__
+#   define TB_TYPED_GROW                    (128)
+#else
+#   define TB_TYPED_GROW                    (256)
+#endif
+
+/*! compare the integers directly
+ *
+ * @param a             the left value
+ * @param b             the right value
+ *
+ * @return              -1, 0 or 1
+ */
+#define tb_typed_comp(a, b)                 (((a) > (b)) - ((a) < (b)))
+
+/*! compare the integers in the reverse order
+ *
+ * @param a             the left value
+ * @param b             the right value
+ *
+ * @return              -1, 0 or 1
+ */
+#define tb_typed_comp_greater(a, b)         (((a) < (b)) - ((a) > (b)))
+
+/// the integers are equal?
+#define tb_typed_equal(a, b)                ((a) == (b))
+
+/// the hash of the uint32 integer, the multiplicative hash with the golden ratio
+#define tb_typed_hash_uint32(v)             ((tb_size_t)(((tb_uint64_t)(tb_uint32_t)(v) * 2654435761ul) >> 16))
+
+/// the hash of the uint64 integer
+#define tb_typed_hash_uint64(v)             ((tb_size_t)(((tb_uint64_t)(v) * 0x9e3779b97f4a7c15ull) >> 24))
+
+/// the hash of the size integer
+#if TB_CPU_BIT64
+#   define tb_typed_hash_size(v)            tb_typed_hash_uint64(v)
+#else
+#   define tb_typed_hash_size(v)            tb_typed_hash_uint32(v)
+#endif
+
+#endif
@@ -0,0 +1,414 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        vector.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_VECTOR_H
+#define TB_CONTAINER_TYPED_VECTOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../algorithm/radix_sort.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the minimum item count for sorting the integer items by the radix sort
+#define TB_VECTOR_RADIX_MINN                (256)
+
+/// sort the items by the comparison sort only
+#define tb_vector_sort_comp(name, type, vector)     (tb_false)
+
+/*! sort the integer items by the radix sort on the plain array
+ *
+ * the sorted items are skipped, the radix sort is slower than the comparison sort for them
+ */
+#define tb_vector_sort_radix(name, type, vector)    \
+    ((vector)->size >= TB_VECTOR_RADIX_MINN \
+    && (tb_vector_##name##_is_sorted(vector) || tb_radix_sort_items((vector)->data, (vector)->size, sizeof(type), ((type)-1) < (type)0)))
+
+/*! define the typed vector
+ *
+ * the items are stored in the plain array of the given type, they are moved by memcpy/memmove 
+ * and compared by the comp macro or function directly, so the hot integer paths need not call 
+ * the callbacks of tb_element_t.
+ *
+ * @note tb_vector_[name]_sort() only uses the comparison sort with the given comp,
+ * please use TB_VECTOR_DEFINE_INTEGER() for the integer items to sort them by the radix sort.
+ *
+ * @code
+ *
+ * // define tb_vector_u32_t
+ * TB_VECTOR_DEFINE(u32, tb_uint32_t, tb_typed_comp)
+ *
+ * tb_vector_u32_t vector;
+ * tb_vector_u32_init(&vector, 0);
+ * tb_vector_u32_insert_tail(&vector, 10);
+ * tb_vector_u32_insert_tail(&vector, 5);
+ * tb_vector_u32_sort(&vector);
+ *
+ * tb_size_t i = 0;
+ * for (i = 0; i < tb_vector_u32_size(&vector); i++)
+ * {
+ *      tb_trace_i("%u", tb_vector_u32_at(&vector, i));
+ * }
+ * tb_vector_u32_exit(&vector);
+ *
+ * @endcode
+ *
+ * @param name          the name suffix, will define tb_vector_[name]_t and tb_vector_[name]_xxx()
+ * @param type          the item type, must be trivially copyable
+ * @param comp          the comparer: comp(a, b) returns the negative, zero or positive value
+ */
+#define TB_VECTOR_DEFINE(name, type, comp)          TB_VECTOR_DEFINE_IMPL(name, type, comp, tb_vector_sort_comp)
+
+/*! define the typed vector of the integer items
+ *
+ * the items are compared by tb_typed_comp() in the natural order, 
+ * and the large vector will be sorted by the radix sort on the plain array.
+ *
+ * @code
+ *
+ * // define tb_vector_u32_t
+ * TB_VECTOR_DEFINE_INTEGER(u32, tb_uint32_t)
+ *
+ * @endcode
+ *
+ * @param name          the name suffix, will define tb_vector_[name]_t and tb_vector_[name]_xxx()
+ * @param type          the integer type with 1, 2, 4 or 8 bytes
+ */
+#define TB_VECTOR_DEFINE_INTEGER(name, type)        TB_VECTOR_DEFINE_IMPL(name, type, tb_typed_comp, tb_vector_sort_radix)
+
+/* define the typed vector with the given sorter
+ *
+ * sort(name, type, vector) returns tb_true if the items have been sorted, 
+ * otherwise they will be sorted by the comparison sort.
+ */
+#define TB_VECTOR_DEFINE_IMPL(name, type, comp, sort) \
+    \
+    /* the typed vector type */ \
+    typedef struct __tb_vector_##name##_t \
+    { \
+        /* the items */ \
+        type*           data; \
+        \
+        /* the item count */ \
+        tb_size_t       size; \
+        \
+        /* the item maxn */ \
+        tb_size_t       maxn; \
+        \
+        /* the grow */ \
+        tb_size_t       grow; \
+        \
+    }tb_vector_##name##_t; \
+    \
+    /* init vector, using the default grow if be zero */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_init(tb_vector_##name##_t* vector, tb_size_t grow) \
+    { \
+        tb_assert(vector); \
+        vector->data = tb_null; \
+        vector->size = 0; \
+        vector->maxn = 0; \
+        vector->grow = grow? grow : TB_TYPED_GROW; \
+    } \
+    \
+    /* exit vector */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_exit(tb_vector_##name##_t* vector) \
+    { \
+        tb_assert(vector); \
+        if (vector->data) tb_free(vector->data); \
+        vector->data = tb_null; \
+        vector->size = 0; \
+        vector->maxn = 0; \
+    } \
+    \
+    /* clear vector */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_clear(tb_vector_##name##_t* vector) \
+    { \
+        tb_assert(vector); \
+        vector->size = 0; \
+    } \
+    \
+    /* the item count */ \
+    static __tb_inline__ tb_size_t tb_vector_##name##_size(tb_vector_##name##_t const* vector) \
+    { \
+        tb_assert(vector); \
+        return vector->size; \
+    } \
+    \
+    /* the item maxn */ \
+    static __tb_inline__ tb_size_t tb_vector_##name##_maxn(tb_vector_##name##_t const* vector) \
+    { \
+        tb_assert(vector); \
+        return vector->maxn; \
+    } \
+    \
+    /* the item array */ \
+    static __tb_inline__ type* tb_vector_##name##_data(tb_vector_##name##_t* vector) \
+    { \
+        tb_assert(vector); \
+        return vector->data; \
+    } \
+    \
+    /* the item at the given index */ \
+    static __tb_inline__ type tb_vector_##name##_at(tb_vector_##name##_t const* vector, tb_size_t index) \
+    { \
+        tb_assert(vector && index < vector->size); \
+        return vector->data[index]; \
+    } \
+    \
+    /* the head item */ \
+    static __tb_inline__ type tb_vector_##name##_head(tb_vector_##name##_t const* vector) \
+    { \
+        tb_assert(vector && vector->size); \
+        return vector->data[0]; \
+    } \
+    \
+    /* the last item */ \
+    static __tb_inline__ type tb_vector_##name##_last(tb_vector_##name##_t const* vector) \
+    { \
+        tb_assert(vector && vector->size); \
+        return vector->data[vector->size - 1]; \
+    } \
+    \
+    /* reserve the item space */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_reserve(tb_vector_##name##_t* vector, tb_size_t maxn) \
+    { \
+        tb_assert(vector); \
+        tb_check_return_val(maxn > vector->maxn, tb_true); \
+        \
+        /* grow the items, the grow of the large vector is proportional to its size */ \
+        maxn = tb_align4(tb_max(maxn, vector->maxn + (vector->maxn >> 1)) + vector->grow); \
+        type* data = tb_ralloc_type(vector->data, maxn, type); \
+        tb_assert_and_check_return_val(data, tb_false); \
+        vector->data = data; \
+        vector->maxn = maxn; \
+        return tb_true; \
+    } \
+    \
+    /* resize the vector, the appended items are not initialized */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_resize(tb_vector_##name##_t* vector, tb_size_t size) \
+    { \
+        tb_assert(vector); \
+        if (!tb_vector_##name##_reserve(vector, size)) return tb_false; \
+        vector->size = size; \
+        return tb_true; \
+    } \
+    \
+    /* insert the item to the tail */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_insert_tail(tb_vector_##name##_t* vector, type data) \
+    { \
+        tb_assert(vector); \
+        if (vector->size >= vector->maxn && !tb_vector_##name##_reserve(vector, vector->size + 1)) return tb_false; \
+        vector->data[vector->size++] = data; \
+        return tb_true; \
+    } \
+    \
+    /* insert the item before the given index */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_insert_prev(tb_vector_##name##_t* vector, tb_size_t index, type data) \
+    { \
+        tb_assert(vector && index <= vector->size); \
+        if (vector->size >= vector->maxn && !tb_vector_##name##_reserve(vector, vector->size + 1)) return tb_false; \
+        if (index < vector->size) tb_memmov(vector->data + index + 1, vector->data + index, (vector->size - index) * sizeof(type)); \
+        vector->data[index] = data; \
+        vector->size++; \
+        return tb_true; \
+    } \
+    \
+    /* insert the item to the head */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_insert_head(tb_vector_##name##_t* vector, type data) \
+    { \
+        return tb_vector_##name##_insert_prev(vector, 0, data); \
+    } \
+    \
+    /* insert the items to the tail */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_ninsert_tail(tb_vector_##name##_t* vector, type const* data, tb_size_t size) \
+    { \
+        tb_assert(vector && (data || !size)); \
+        if (!tb_vector_##name##_reserve(vector, vector->size + size)) return tb_false; \
+        if (size) tb_memcpy(vector->data + vector->size, data, size * sizeof(type)); \
+        vector->size += size; \
+        return tb_true; \
+    } \
+    \
+    /* replace the item at the given index */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_replace(tb_vector_##name##_t* vector, tb_size_t index, type data) \
+    { \
+        tb_assert(vector && index < vector->size); \
+        vector->data[index] = data; \
+    } \
+    \
+    /* remove the item at the given index */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_remove(tb_vector_##name##_t* vector, tb_size_t index) \
+    { \
+        tb_assert(vector && index < vector->size); \
+        if (index + 1 < vector->size) tb_memmov(vector->data + index, vector->data + index + 1, (vector->size - index - 1) * sizeof(type)); \
+        vector->size--; \
+    } \
+    \
+    /* remove the head item */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_remove_head(tb_vector_##name##_t* vector) \
+    { \
+        tb_vector_##name##_remove(vector, 0); \
+    } \
+    \
+    /* remove the last item */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_remove_last(tb_vector_##name##_t* vector) \
+    { \
+        tb_assert(vector && vector->size); \
+        vector->size--; \
+    } \
+    \
+    /* find the item, return the size if not found */ \
+    static __tb_inline__ tb_size_t tb_vector_##name##_find(tb_vector_##name##_t const* vector, type data) \
+    { \
+        tb_assert(vector); \
+        tb_size_t i = 0; \
+        tb_size_t n = vector->size; \
+        for (i = 0; i < n && comp(vector->data[i], data); i++) ; \
+        return i; \
+    } \
+    \
+    /* find the item from the sorted vector by the binary search, return the size if not found */ \
+    static __tb_inline__ tb_size_t tb_vector_##name##_bfind(tb_vector_##name##_t const* vector, type data) \
+    { \
+        tb_assert(vector); \
+        tb_size_t l = 0; \
+        tb_size_t r = vector->size; \
+        while (l < r) \
+        { \
+            tb_size_t m = (l + r) >> 1; \
+            if (comp(vector->data[m], data) < 0) l = m + 1; \
+            else r = m; \
+        } \
+        return (l < vector->size && !comp(vector->data[l], data))? l : vector->size; \
+    } \
+    \
+    /* is sorted? */ \
+    static __tb_inline__ tb_bool_t tb_vector_##name##_is_sorted(tb_vector_##name##_t const* vector) \
+    { \
+        tb_assert(vector); \
+        tb_size_t i = 1; \
+        tb_size_t n = vector->size; \
+        for (i = 1; i < n && comp(vector->data[i - 1], vector->data[i]) <= 0; i++) ; \
+        return i >= n; \
+    } \
+    \
+    /* sift down the item for the heap sort */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_sort_sift(type* data, tb_size_t index, tb_size_t size) \
+    { \
+        type item = data[index]; \
+        tb_size_t child = 0; \
+        while ((child = (index << 1) + 1) < size) \
+        { \
+            if (child + 1 < size && comp(data[child], data[child + 1]) < 0) child++; \
+            if (comp(item, data[child]) >= 0) break; \
+            data[index] = data[child]; \
+            index = child; \
+        } \
+        data[index] = item; \
+    } \
+    \
+    /* sort the items by the introspective sort */ \
+    static tb_void_t tb_vector_##name##_sort_impl(type* data, tb_size_t size, tb_size_t depth) \
+    { \
+        type temp; \
+        while (size > 16) \
+        { \
+            /* too deep? using the heap sort */ \
+            if (!depth--) \
+            { \
+                tb_size_t i = size >> 1; \
+                while (i--) tb_vector_##name##_sort_sift(data, i, size); \
+                while (size > 1) \
+                { \
+                    temp = data[0]; data[0] = data[--size]; data[size] = temp; \
+                    tb_vector_##name##_sort_sift(data, 0, size); \
+                } \
+                return ; \
+            } \
+            \
+            /* the median of three */ \
+            tb_size_t m = size >> 1; \
+            if (comp(data[m], data[0]) < 0) { temp = data[m]; data[m] = data[0]; data[0] = temp; } \
+            if (comp(data[size - 1], data[m]) < 0) \
+            { \
+                temp = data[m]; data[m] = data[size - 1]; data[size - 1] = temp; \
+                if (comp(data[m], data[0]) < 0) { temp = data[m]; data[m] = data[0]; data[0] = temp; } \
+            } \
+            \
+            /* partition: [0, r] <= pivot <= [r + 1, size) */ \
+            type        pivot = data[m]; \
+            tb_size_t   l = 0; \
+            tb_size_t   r = size - 1; \
+            while (1) \
+            { \
+                while (comp(data[l], pivot) < 0) l++; \
+                while (comp(pivot, data[r]) < 0) r--; \
+                if (l >= r) break; \
+                temp = data[l]; data[l] = data[r]; data[r] = temp; \
+                l++; \
+                r--; \
+            } \
+            \
+            /* sort the smaller part recursively and continue the larger part */ \
+            if (r + 1 < size - r - 1) \
+            { \
+                tb_vector_##name##_sort_impl(data, r + 1, depth); \
+                data += r + 1; \
+                size -= r + 1; \
+            } \
+            else \
+            { \
+                tb_vector_##name##_sort_impl(data + r + 1, size - r - 1, depth); \
+                size = r + 1; \
+            } \
+        } \
+        \
+        /* the insertion sort for the small part */ \
+        tb_size_t i = 1; \
+        for (i = 1; i < size; i++) \
+        { \
+            tb_size_t j = i; \
+            temp = data[i]; \
+            for (; j && comp(temp, data[j - 1]) < 0; j--) data[j] = data[j - 1]; \
+            data[j] = temp; \
+        } \
+    } \
+    \
+    /* sort all items */ \
+    static __tb_inline__ tb_void_t tb_vector_##name##_sort(tb_vector_##name##_t* vector) \
+    { \
+        tb_assert(vector); \
+        if (sort(name, type, vector)) return ; \
+        tb_size_t depth = 0; \
+        tb_size_t size = vector->size; \
+        for (; size > 1; size >>= 1) depth += 2; \
+        if (vector->size > 1) tb_vector_##name##_sort_impl(vector->data, vector->size, depth); \
+    }
+
+#endif
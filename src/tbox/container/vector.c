@@ -168,6 +168,29 @@ static tb_long_t tb_vector_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t l
     // comp
     return vector->element.comp(&vector->element, litem, ritem);
 }
+static tb_pointer_t tb_vector_itor_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_vector_t* vector = (tb_vector_t*)iterator;
+    tb_assert(vector && ptype);
+
+    // only the integer items with the default comparer are ordered by their values
+    tb_element_t element;
+    switch (vector->element.type)
+    {
+    case TB_ELEMENT_TYPE_LONG:      element = tb_element_long();    break;
+    case TB_ELEMENT_TYPE_SIZE:      element = tb_element_size();    break;
+    case TB_ELEMENT_TYPE_UINT8:     element = tb_element_uint8();   break;
+    case TB_ELEMENT_TYPE_UINT16:    element = tb_element_uint16();  break;
+    case TB_ELEMENT_TYPE_UINT32:    element = tb_element_uint32();  break;
+    default:                        return tb_null;
+    }
+    tb_check_return_val(vector->element.comp == element.comp && vector->element.size == element.size, tb_null);
+
+    // the items
+    *ptype = vector->element.type;
+    return vector->data;
+}
 static tb_void_t tb_vector_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
 {
     // remove it
@@ -223,6 +246,7 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
         vector->itor.item         = tb_vector_itor_item;
         vector->itor.copy         = tb_vector_itor_copy;
         vector->itor.comp         = tb_vector_itor_comp;
+        vector->itor.data         = tb_vector_itor_data;
         vector->itor.remove       = tb_vector_itor_remove;
         vector->itor.remove_range = tb_vector_itor_remove_range;
 
@@ -268,8 +292,8 @@ tb_void_t tb_vector_clear(tb_vector_ref_t self)
     tb_vector_t* vector = (tb_vector_t*)self;
     tb_assert_and_check_return(vector);
 
-    // free data
-    if (vector->element.nfree)
+    // free data, the pod items need not be freed
+    if (vector->element.nfree && !tb_element_is_pod(&vector->element))
         vector->element.nfree(&vector->element, vector->data, vector->size);
 
     // reset size 
@@ -361,14 +385,16 @@ tb_bool_t tb_vector_resize(tb_vector_ref_t self, tb_size_t size)
     if (size < vector->size)
     {
         // free data
-        if (vector->element.nfree) 
+        if (vector->element.nfree && !tb_element_is_pod(&vector->element)) 
             vector->element.nfree(&vector->element, vector->data + size * vector->element.size, vector->size - size);
     }
 
     // resize buffer
     if (size > vector->maxn)
     {
-        tb_size_t maxn = tb_align4(size + vector->grow);
+        // the grow of the large vector is proportional to its size for the batched appends
+        tb_size_t maxn = tb_align4(tb_max(size, vector->maxn + (vector->maxn >> 1)) + vector->grow);
+        if (maxn >= TB_VECTOR_MAXN) maxn = tb_align4(size + vector->grow);
         tb_assert_and_check_return_val(maxn < TB_VECTOR_MAXN, tb_false);
 
         // realloc data
@@ -513,7 +539,7 @@ tb_void_t tb_vector_remove(tb_vector_ref_t self, tb_size_t itor)
     if (vector->size)
     {
         // do free
-        if (vector->element.free) vector->element.free(&vector->element, vector->data + itor * vector->element.size);
+        if (vector->element.free && !tb_element_is_pod(&vector->element)) vector->element.free(&vector->element, vector->data + itor * vector->element.size);
 
         // move data if itor is not last
         if (itor < vector->size - 1) tb_memmov(vector->data + itor * vector->element.size, vector->data + (itor + 1) * vector->element.size, (vector->size - itor - 1) * vector->element.size);
@@ -535,7 +561,7 @@ tb_void_t tb_vector_remove_last(tb_vector_ref_t self)
     if (vector->size)
     {
         // do free
-        if (vector->element.free) vector->element.free(&vector->element, vector->data + (vector->size - 1) * vector->element.size);
+        if (vector->element.free && !tb_element_is_pod(&vector->element)) vector->element.free(&vector->element, vector->data + (vector->size - 1) * vector->element.size);
 
         // resize
         vector->size--;
@@ -561,7 +587,7 @@ tb_void_t tb_vector_nremove(tb_vector_ref_t self, tb_size_t itor, tb_size_t size
     tb_size_t left = vector->size - itor - size;
 
     // free data
-    if (vector->element.nfree)
+    if (vector->element.nfree && !tb_element_is_pod(&vector->element))
         vector->element.nfree(&vector->element, vector->data + itor * vector->element.size, size);
 
     // move the left data
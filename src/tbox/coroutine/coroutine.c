@@ -46,7 +46,23 @@ tb_bool_t tb_coroutine_start(tb_co_scheduler_ref_t scheduler, tb_coroutine_func_
     tb_assert_and_check_return_val(func, tb_false);
 
     // start it
-    return tb_co_scheduler_start((tb_co_scheduler_t*)scheduler, func, priv, stacksize);
+    return tb_co_scheduler_start((tb_co_scheduler_t*)scheduler, func, priv, stacksize) != tb_null;
+}
+tb_bool_t tb_coroutine_spawn(tb_co_scheduler_group_ref_t group, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_assert_and_check_return_val(func, tb_false);
+
+    // uses the group of the current scheduler if be null
+    if (!group)
+    {
+        tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+        group = scheduler? (tb_co_scheduler_group_ref_t)scheduler->group : tb_null;
+    }
+    tb_assert_and_check_return_val(group, tb_false);
+
+    // spawn it
+    return tb_co_scheduler_group_spawn((tb_co_scheduler_group_t*)group, func, priv, stacksize);
 }
 tb_bool_t tb_coroutine_yield()
 {
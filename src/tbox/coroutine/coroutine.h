@@ -33,6 +33,7 @@
 #include "channel.h"
 #include "semaphore.h"
 #include "scheduler.h"
+#include "scheduler_group.h"
 #include "stackless/stackless.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +66,19 @@ typedef tb_void_t       (*tb_coroutine_func_t)(tb_cpointer_t priv);
  */
 tb_bool_t               tb_coroutine_start(tb_co_scheduler_ref_t scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
+/*! start coroutine on the least-loaded scheduler in the scheduler group
+ *
+ * it can be called on any thread before or during tb_co_scheduler_group_loop().
+ *
+ * @param group         the scheduler group, uses the group of the current scheduler if be null
+ * @param func          the coroutine function
+ * @param priv          the passed user private data as the argument of function
+ * @param stacksize     the stack size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_coroutine_spawn(tb_co_scheduler_group_ref_t group, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
 /*! yield the current coroutine
  * 
  * @return              tb_true(yield ok) or tb_false(yield failed, no more coroutines)
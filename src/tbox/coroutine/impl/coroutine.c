@@ -46,9 +46,85 @@
 // the default stack size
 #define TB_COROUTINE_STACK_DEFSIZE          (8192 << 1)
 
+// the saved stack data align
+#define TB_COROUTINE_SAVED_ALIGN            (64)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * private implementation
+ */
+
+/* make the coroutine and it's stack
+ *
+ * we map the stack pages first, the physical pages will be committed lazily when they are touched,
+ * so the memory usage depends on the actual stack depth instead of the stack size.
+ *
+ *  ---------------------------------------------------------------
+ * | guard page | ... stacksize ... | guard(u16) |    coroutine    |
+ *  ---------------------------------------------------------------
+ * |                    |                         |
+ * no access        grows down <-- stackbase      the top of the mapped pages
+ *
+ * the stack overflow will crash on the guard page instead of corrupting the other memory.
+ *
+ * we will allocate them from the heap if the virtual memory mapping is not supported.
+ *
+ *  ---------------------------------------------
+ * | coroutine | ... stacksize ... | guard(u16) |
+ *  ---------------------------------------------
  */
+static tb_coroutine_t* tb_coroutine_stack_init(tb_size_t stacksize)
+{
+    // the page size
+    tb_size_t pagesize = tb_page_size();
+
+    // map the guard page, stack and coroutine
+    tb_coroutine_t* coroutine = tb_null;
+    if (pagesize)
+    {
+        // map them
+        tb_size_t   mapsize = tb_align(pagesize + stacksize + sizeof(tb_uint16_t) + sizeof(tb_coroutine_t), pagesize);
+        tb_byte_t*  mapdata = (tb_byte_t*)tb_native_memory_map(mapsize);
+        if (mapdata)
+        {
+            // make the guard page
+            if (tb_native_memory_guard(mapdata, pagesize))
+            {
+                // init the coroutine at the top of the mapped pages
+                coroutine = (tb_coroutine_t*)(mapdata + mapsize - sizeof(tb_coroutine_t));
+                coroutine->mapsize   = mapsize;
+                coroutine->stackbase = (tb_byte_t*)coroutine - sizeof(tb_uint16_t);
+                coroutine->stacksize = coroutine->stackbase - (mapdata + pagesize);
+            }
+            else tb_native_memory_unmap(mapdata, mapsize);
+        }
+    }
+
+    // make them from the heap
+    if (!coroutine)
+    {
+        // make it
+        coroutine = (tb_coroutine_t*)tb_malloc_bytes(sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
+        tb_assert_and_check_return_val(coroutine, tb_null);
+
+        // init stack
+        coroutine->mapsize   = 0;
+        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
+        coroutine->stacksize = stacksize;
+    }
+
+    // ok
+    return coroutine;
+}
+static tb_void_t tb_coroutine_stack_exit(tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert_and_check_return(coroutine);
+
+    // unmap it
+    if (coroutine->mapsize) tb_native_memory_unmap((tb_byte_t*)&(coroutine[1]) - coroutine->mapsize, coroutine->mapsize);
+    // free it
+    else tb_free(coroutine);
+}
 static tb_void_t tb_coroutine_entry(tb_context_from_t from)
 {
     // get the from-coroutine 
@@ -107,37 +183,42 @@ tb_coroutine_t* tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_coroutine_
         stacksize <<= 1;
 #endif
 
-        /* make coroutine
-         *
-         * TODO: 
-         *
-         * - segment stack 
-         *
-         *  -----------------------------------------------
-         * | coroutine | guard | ... stacksize ... | guard |
-         *  -----------------------------------------------
-         */
-        coroutine = (tb_coroutine_t*)tb_malloc_bytes(sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
+        // make coroutine and stack
+        if (tb_co_scheduler_is_shared((tb_co_scheduler_t*)scheduler))
+        {
+            // make coroutine only, it will run on the shared stack of the scheduler
+            coroutine = tb_malloc0_type(tb_coroutine_t);
+            tb_assert_and_check_break(coroutine);
+
+            // init stack
+            coroutine->stackbase = ((tb_co_scheduler_t*)scheduler)->shared_stackbase;
+            coroutine->stacksize = ((tb_co_scheduler_t*)scheduler)->shared_stacksize;
+        }
+        else coroutine = tb_coroutine_stack_init(stacksize);
         tb_assert_and_check_break(coroutine);
 
         // save scheduler
         coroutine->scheduler = scheduler;
 
-        // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
-
         // fill guard
         coroutine->guard = TB_COROUTINE_STACK_GUARD;
         tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
 
+        // clear the group flags
+        coroutine->grouped  = 0;
+        coroutine->pinned   = 0;
+
         // init function and user private data
         coroutine->rs.func.func = func;
         coroutine->rs.func.priv = priv;
 
-        // make context
-        coroutine->context = tb_context_make(coroutine->stackbase - stacksize, stacksize, tb_coroutine_entry);
-        tb_assert_and_check_break(coroutine->context);
+        // make context, it will be made when it is loaded to the shared stack for the shared stack mode
+        if (!tb_co_scheduler_is_shared((tb_co_scheduler_t*)coroutine->scheduler))
+        {
+            coroutine->context = tb_context_make(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize, tb_coroutine_entry);
+            tb_assert_and_check_break(coroutine->context);
+        }
+        else coroutine->context = tb_null;
 
         // ok
         ok = tb_true;
@@ -178,27 +259,32 @@ tb_coroutine_t* tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func
         tb_coroutine_check(coroutine);
 #endif
 
-        // remake coroutine
-        if (stacksize > coroutine->stacksize)
-            coroutine = (tb_coroutine_t*)tb_ralloc_bytes(coroutine, sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
-        else stacksize = coroutine->stacksize;
-        tb_assert_and_check_break(coroutine && coroutine->scheduler);
+        // the stack is too small? it will be exited and we need make a new coroutine
+        tb_assert_and_check_break(coroutine->scheduler);
+        tb_check_break(stacksize <= coroutine->stacksize || tb_co_scheduler_is_shared((tb_co_scheduler_t*)coroutine->scheduler));
 
-        // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
+        // clear the saved stack data
+        coroutine->saved_size = 0;
 
         // fill guard
         coroutine->guard = TB_COROUTINE_STACK_GUARD;
         tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
 
+        // clear the group flags
+        coroutine->grouped  = 0;
+        coroutine->pinned   = 0;
+
         // init function and user private data
         coroutine->rs.func.func = func;
         coroutine->rs.func.priv = priv;
 
-        // make context
-        coroutine->context = tb_context_make(coroutine->stackbase - stacksize, stacksize, tb_coroutine_entry);
-        tb_assert_and_check_break(coroutine->context);
+        // make context, it will be made when it is loaded to the shared stack for the shared stack mode
+        if (!tb_co_scheduler_is_shared((tb_co_scheduler_t*)coroutine->scheduler))
+        {
+            coroutine->context = tb_context_make(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize, tb_coroutine_entry);
+            tb_assert_and_check_break(coroutine->context);
+        }
+        else coroutine->context = tb_null;
 
         // ok
         ok = tb_true;
@@ -227,14 +313,87 @@ tb_void_t tb_coroutine_exit(tb_coroutine_t* coroutine)
     tb_coroutine_check(coroutine);
 #endif
 
+    // exit the saved stack data
+    if (coroutine->saved_data) tb_free(coroutine->saved_data);
+    coroutine->saved_data = tb_null;
+
     // exit it
-    tb_free(coroutine);
+    tb_coroutine_stack_exit(coroutine);
+}
+tb_void_t tb_coroutine_purge(tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert_and_check_return(coroutine && !tb_coroutine_is_original(coroutine));
+
+    // the shared stack mode? free the saved stack data only
+    if (tb_co_scheduler_is_shared((tb_co_scheduler_t*)coroutine->scheduler))
+    {
+        if (coroutine->saved_data) tb_free(coroutine->saved_data);
+        coroutine->saved_data = tb_null;
+        coroutine->saved_size = 0;
+        coroutine->saved_maxn = 0;
+        return ;
+    }
+
+    // purge the whole stack pages, the page of the stack base will be kept
+    tb_native_memory_purge(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize);
+}
+tb_bool_t tb_coroutine_stack_save(tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(coroutine && coroutine->context && !tb_coroutine_is_original(coroutine));
+
+    // the used stack size, from the saved context (stack pointer) to the stack base
+    tb_byte_t*  stacktop = (tb_byte_t*)coroutine->context;
+    tb_size_t   usedsize = coroutine->stackbase - stacktop;
+    tb_assert_and_check_return_val(stacktop > coroutine->stackbase - coroutine->stacksize && usedsize <= coroutine->stacksize, tb_false);
+
+    /* make the saved stack data with the right size
+     *
+     * we shrink it if the saved data is too large now, 
+     * so the idle coroutines with the shallow stacks will only take up the less memory
+     */
+    tb_size_t maxn = tb_align(usedsize, TB_COROUTINE_SAVED_ALIGN);
+    if (maxn > coroutine->saved_maxn || maxn < (coroutine->saved_maxn >> 2))
+    {
+        coroutine->saved_data = (tb_byte_t*)tb_ralloc_bytes(coroutine->saved_data, maxn);
+        coroutine->saved_maxn = coroutine->saved_data? maxn : 0;
+        tb_assert_and_check_return_val(coroutine->saved_data, tb_false);
+    }
+
+    // save it
+    tb_memcpy(coroutine->saved_data, stacktop, usedsize);
+    coroutine->saved_size = usedsize;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_coroutine_stack_load(tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(coroutine && !tb_coroutine_is_original(coroutine));
+
+    // the new coroutine? make context on the shared stack
+    if (!coroutine->context)
+    {
+        coroutine->context = tb_context_make(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize, tb_coroutine_entry);
+        return coroutine->context != tb_null;
+    }
+
+    // check
+    tb_assert_and_check_return_val(coroutine->saved_data && coroutine->saved_size == (tb_size_t)(coroutine->stackbase - (tb_byte_t*)coroutine->context), tb_false);
+
+    // load the saved stack data
+    tb_memcpy((tb_byte_t*)coroutine->context, coroutine->saved_data, coroutine->saved_size);
+
+    // ok
+    return tb_true;
 }
 #ifdef __tb_debug__
 tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
 {
-    // check
-    tb_assert(coroutine && coroutine->context);
+    // check, the context of the new coroutine is null in the shared stack mode
+    tb_assert(coroutine && (coroutine->context || tb_co_scheduler_is_shared((tb_co_scheduler_t*)coroutine->scheduler)));
 
     // this coroutine is original for scheduler?
     tb_check_return(!tb_coroutine_is_original(coroutine));
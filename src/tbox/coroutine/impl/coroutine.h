@@ -106,6 +106,18 @@ typedef struct __tb_coroutine_t
     // the stack size
     tb_size_t                       stacksize;
 
+    // the mapped size of the coroutine and stack, it is zero if they are allocated from the heap
+    tb_size_t                       mapsize;
+
+    // the saved stack data from the shared stack, only for the shared stack mode
+    tb_byte_t*                      saved_data;
+
+    // the saved stack size
+    tb_size_t                       saved_size;
+
+    // the saved stack maxn
+    tb_size_t                       saved_maxn;
+
     // the passed user private data between priv = resume(priv) and priv = suspend(priv)
     tb_cpointer_t                   rs_priv;
 
@@ -126,6 +138,15 @@ typedef struct __tb_coroutine_t
 
     }                               rs;
 
+    /* is started by the scheduler group? 
+     *
+     * it will be counted in the load of the scheduler and can be migrated to the other schedulers in the group if it is not pinned
+     */
+    tb_uint16_t                     grouped         : 1;
+
+    // is pinned to the current scheduler? it will be pinned after it is suspended or waiting io at first time
+    tb_uint16_t                     pinned          : 1;
+
     // the guard
     tb_uint16_t                     guard;
 
@@ -153,10 +174,34 @@ tb_coroutine_t*         tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_co
  * @param priv          the passed user private data as the argument of function
  * @param stacksize     the stack size, uses the default stack size if be zero
  *
- * @return              the coroutine
+ * @return              the coroutine, return tb_null if the stack of the given coroutine is too small
  */
 tb_coroutine_t*         tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
+/* purge the unused stack pages of the dead coroutine and return them to the system
+ *
+ * @param coroutine     the coroutine
+ */
+tb_void_t               tb_coroutine_purge(tb_coroutine_t* coroutine);
+
+/* save the used stack of the coroutine from the shared stack
+ *
+ * @param coroutine     the coroutine
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_coroutine_stack_save(tb_coroutine_t* coroutine);
+
+/* load the saved stack of the coroutine to the shared stack 
+ *
+ * it will make the context on the shared stack if it is a new coroutine.
+ *
+ * @param coroutine     the coroutine
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_coroutine_stack_load(tb_coroutine_t* coroutine);
+
 /* exit coroutine
  *
  * @param coroutine     the coroutine
@@ -36,6 +36,7 @@
 #include "scheduler.h"
 #include "coroutine.h"
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -48,6 +49,13 @@
 #   define TB_SCHEDULER_DEAD_CACHE_MAXN     (256)
 #endif
 
+// the stack cache maximum count, the purged stacks only take up the virtual memory
+#ifdef __tb_small__
+#   define TB_SCHEDULER_STACK_CACHE_MAXN    (1024)
+#else
+#   define TB_SCHEDULER_STACK_CACHE_MAXN    (8192)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -74,25 +82,8 @@ static tb_void_t tb_co_scheduler_make_dead(tb_co_scheduler_t* scheduler, tb_coro
     // remove this coroutine from the ready coroutines
     tb_list_entry_remove(&scheduler->coroutines_ready, (tb_list_entry_ref_t)coroutine);
 
-    // append this coroutine to dead coroutines
-    tb_list_entry_insert_tail(&scheduler->coroutines_dead, (tb_list_entry_ref_t)coroutine);
-}
-static tb_void_t tb_co_scheduler_make_ready(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
-{
-    // check
-    tb_assert(scheduler && coroutine);
-
-    // insert this coroutine to ready coroutines 
-    if (__tb_unlikely__(tb_coroutine_is_original(scheduler->running)))
-    {
-        // .. last -> coroutine(inserted)
-        tb_list_entry_insert_tail(&scheduler->coroutines_ready, (tb_list_entry_ref_t)coroutine);
-    }
-    else
-    {
-        // .. -> coroutine(inserted) -> running -> ..
-        tb_list_entry_insert_prev(&scheduler->coroutines_ready, (tb_list_entry_ref_t)scheduler->running, (tb_list_entry_ref_t)coroutine);
-    }
+    // insert this coroutine to the head of the dead coroutines, the stack of the recent dead coroutine is hotter
+    tb_list_entry_insert_head(&scheduler->coroutines_dead, (tb_list_entry_ref_t)coroutine);
 }
 static tb_void_t tb_co_scheduler_make_suspend(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
 {
@@ -108,6 +99,101 @@ static tb_void_t tb_co_scheduler_make_suspend(tb_co_scheduler_t* scheduler, tb_c
     // append this coroutine to suspend coroutines
     tb_list_entry_insert_tail(&scheduler->coroutines_suspend, (tb_list_entry_ref_t)coroutine);
 }
+/* switch to the given coroutine for the shared stack mode
+ *
+ * we cannot copy the stack data of the coroutines on the shared stack which is running,
+ * so the coroutine switches to the original coroutine (on the thread stack) first,
+ * and the original coroutine saves the stack of the current owner and loads the stack of the next coroutine.
+ *
+ * coroutine(a) -> original: save a, load b -> coroutine(b)
+ *
+ * we need not copy anything if the next coroutine owns the shared stack already.
+ *
+ * if the stack cannot be saved or loaded, the original coroutine will stop switching and return tb_false,
+ * the stack of the current coroutine is still kept on the shared stack or in the saved data,
+ * so it will be parked and continue to run when it is switched to again.
+ */
+static tb_bool_t tb_co_scheduler_switch_shared(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(scheduler && scheduler->running && coroutine);
+
+    // the current running coroutine
+    tb_coroutine_t* running = scheduler->running;
+
+    // is running on the shared stack? switch to the original coroutine first
+    if (!tb_coroutine_is_original(running))
+    {
+        // save the next coroutine, the original coroutine will switch to it
+        scheduler->shared_next = tb_coroutine_is_original(coroutine)? tb_null : coroutine;
+
+        // mark the original coroutine as running
+        scheduler->running = &scheduler->original;
+
+        // jump to the original coroutine
+        tb_context_from_t from = tb_context_jump(scheduler->original.context, running);
+
+        // we are resumed from the original coroutine, update the context of it
+        tb_assert(from.priv == &scheduler->original && from.context);
+        scheduler->original.context = from.context;
+        return tb_true;
+    }
+
+    // switch to the given coroutine and the next coroutines from it
+    tb_bool_t       ok = tb_true;
+    tb_coroutine_t* next = coroutine;
+    while (next)
+    {
+        // trace
+        tb_trace_d("switch to coroutine(%p) on the shared stack owned by coroutine(%p)", next, scheduler->shared_owner);
+
+        // load the stack of the next coroutine to the shared stack
+        if (scheduler->shared_owner != next)
+        {
+            // save the stack of the current owner, it is still kept on the shared stack if failed
+            if (scheduler->shared_owner) ok = tb_coroutine_stack_save(scheduler->shared_owner);
+            tb_assertf_and_check_break(ok, "save the shared stack of coroutine(%p) failed!", scheduler->shared_owner);
+            scheduler->shared_owner = tb_null;
+
+            // load the stack of the next coroutine
+            ok = tb_coroutine_stack_load(next);
+            tb_assertf_and_check_break(ok, "load the shared stack of coroutine(%p) failed!", next);
+            scheduler->shared_owner = next;
+        }
+
+        // mark the next coroutine as running
+        scheduler->running = next;
+
+        // jump to the next coroutine
+        tb_context_from_t from = tb_context_jump(next->context, running);
+
+        // the from-coroutine 
+        tb_coroutine_t* coroutine_from = (tb_coroutine_t*)from.priv;
+        tb_assert(coroutine_from && from.context);
+
+#ifdef __tb_debug__
+        // check it
+        tb_coroutine_check(coroutine_from);
+#endif
+
+        // update the context
+        coroutine_from->context = from.context;
+
+        // get the next coroutine 
+        next = scheduler->shared_next;
+        scheduler->shared_next = tb_null;
+    }
+
+    // the running coroutine is the original coroutine now if failed
+    if (!ok)
+    {
+        scheduler->running      = running;
+        scheduler->shared_next  = tb_null;
+    }
+
+    // ok?
+    return ok;
+}
 static __tb_inline__ tb_coroutine_t* tb_co_scheduler_next_ready(tb_co_scheduler_t* scheduler)
 {
     // check
@@ -128,7 +214,24 @@ static __tb_inline__ tb_coroutine_t* tb_co_scheduler_next_ready(tb_co_scheduler_
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+tb_void_t tb_co_scheduler_make_ready(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(scheduler && coroutine);
+
+    // insert this coroutine to ready coroutines 
+    if (__tb_unlikely__(tb_coroutine_is_original(scheduler->running)))
+    {
+        // .. last -> coroutine(inserted)
+        tb_list_entry_insert_tail(&scheduler->coroutines_ready, (tb_list_entry_ref_t)coroutine);
+    }
+    else
+    {
+        // .. -> coroutine(inserted) -> running -> ..
+        tb_list_entry_insert_prev(&scheduler->coroutines_ready, (tb_list_entry_ref_t)scheduler->running, (tb_list_entry_ref_t)coroutine);
+    }
+}
+tb_coroutine_t* tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
 {
     // check
     tb_assert(func);
@@ -148,15 +251,16 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         // have been stopped? do not continue to start new coroutines
         tb_check_break(!scheduler->stopped);
 
-        // reuses dead coroutines in init function
-        if (tb_list_entry_size(&scheduler->coroutines_dead))
+        // reuses dead coroutines or the cached stacks in init function
+        tb_list_entry_head_ref_t coroutines = tb_list_entry_size(&scheduler->coroutines_dead)? &scheduler->coroutines_dead : &scheduler->coroutines_stack;
+        if (tb_list_entry_size(coroutines))
         {
             // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+            tb_list_entry_ref_t entry = tb_list_entry_head(coroutines);
             tb_assert_and_check_break(entry);
 
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            // remove it from the dead coroutines
+            tb_list_entry_remove_head(coroutines);
 
             // get the dead coroutine
             tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
@@ -175,18 +279,32 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         // ready coroutine
         tb_co_scheduler_make_ready(scheduler, coroutine);
 
-        // the dead coroutines is too much? free some coroutines
+        /* the dead coroutines is too much? purge the colder stacks and cache them
+         *
+         * we need not commit the pages of them again if they are reused, 
+         * so we can cache much more stacks than the dead coroutines.
+         */
         while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
         {
-            // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+            // get the last entry
+            tb_list_entry_ref_t entry = tb_list_entry_last(&scheduler->coroutines_dead);
             tb_assert(entry);
 
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            // remove it from the dead coroutines
+            tb_list_entry_remove_last(&scheduler->coroutines_dead);
 
-            // exit this coroutine
-            tb_coroutine_exit((tb_coroutine_t*)tb_list_entry0(entry));
+            // the stack cache is full? exit this coroutine
+            tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
+            if (tb_list_entry_size(&scheduler->coroutines_stack) >= TB_SCHEDULER_STACK_CACHE_MAXN)
+                tb_coroutine_exit(coroutine_dead);
+            else
+            {
+                // purge the stack pages
+                tb_coroutine_purge(coroutine_dead);
+
+                // cache this stack
+                tb_list_entry_insert_head(&scheduler->coroutines_stack, entry);
+            }
         }
 
         // ok
@@ -198,7 +316,7 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
     tb_trace_d("start %s", ok? "ok" : "no");
 
     // ok?
-    return ok;
+    return ok? coroutine : tb_null;
 }
 tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
 {
@@ -267,6 +385,9 @@ tb_pointer_t tb_co_scheduler_suspend(tb_co_scheduler_t* scheduler, tb_cpointer_t
     // trace
     tb_trace_d("suspend coroutine(%p)", scheduler->running);
 
+    // pin it, the suspended coroutine may be referenced by the channel, lock, timer and poller of this scheduler
+    scheduler->running->pinned = 1;
+
     // pass the private data to resume() first
     scheduler->running->rs_priv = priv;
 
@@ -303,12 +424,18 @@ tb_void_t tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
     // trace
     tb_trace_d("finish coroutine(%p)", scheduler->running);
 
+    // the coroutine started by the scheduler group? update the load of the group
+    if (scheduler->running->grouped && scheduler->group) tb_co_scheduler_group_done(scheduler);
+
     // get the next ready coroutine first
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
 
     // make the running coroutine as dead
     tb_co_scheduler_make_dead(scheduler, scheduler->running);
 
+    // the stack of the dead coroutine need not be saved for the shared stack mode
+    if (scheduler->shared_owner == scheduler->running) scheduler->shared_owner = tb_null;
+
     // switch to next coroutine 
     if (coroutine_next != scheduler->running) tb_co_scheduler_switch(scheduler, coroutine_next);
     // no more coroutine?
@@ -336,11 +463,16 @@ tb_pointer_t tb_co_scheduler_sleep(tb_co_scheduler_t* scheduler, tb_long_t inter
     // sleep it
     return tb_co_scheduler_io_sleep(scheduler->scheduler_io, interval);
 }
-tb_void_t tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+tb_bool_t tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
 {
     // check
-    tb_assert(scheduler && scheduler->running);
-    tb_assert(coroutine && coroutine->context);
+    tb_assert(scheduler && scheduler->running && coroutine);
+
+    // the shared stack mode? switch it via the original coroutine
+    if (tb_co_scheduler_is_shared(scheduler)) return tb_co_scheduler_switch_shared(scheduler, coroutine);
+
+    // check
+    tb_assert(coroutine->context);
 
     // the current running coroutine
     tb_coroutine_t* running = scheduler->running;
@@ -365,6 +497,9 @@ tb_void_t tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* c
 
     // update the context
     coroutine_from->context = from.context;
+
+    // ok
+    return tb_true;
 }
 tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout)
 {
@@ -378,6 +513,9 @@ tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t soc
     // need io scheduler
     if (!tb_co_scheduler_need_io(scheduler)) return -1;
 
+    // pin it, the socket will be inserted to the poller of this scheduler with the running coroutine
+    scheduler->running->pinned = 1;
+
     // sleep it
     return tb_co_scheduler_io_wait(scheduler->scheduler_io, sock, events, timeout);
 }
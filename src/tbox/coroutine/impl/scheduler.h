@@ -53,6 +53,9 @@ __tb_extern_c_enter__
 // get the io scheduler
 #define tb_co_scheduler_io(scheduler)                  ((scheduler)->scheduler_io)
 
+// is the shared stack mode?
+#define tb_co_scheduler_is_shared(scheduler)           ((scheduler)->shared_stackbase != tb_null)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -60,6 +63,9 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_co_scheduler_io_t;
 
+// the scheduler group type
+struct __tb_co_scheduler_group_t;
+
 // the scheduler type
 typedef struct __tb_co_scheduler_t
 {   
@@ -78,9 +84,12 @@ typedef struct __tb_co_scheduler_t
     // the io scheduler
     struct __tb_co_scheduler_io_t*  scheduler_io;
 
-    // the dead coroutines
+    // the dead coroutines, the stack pages of them are still cached
     tb_list_entry_head_t            coroutines_dead;
 
+    // the dead coroutines for caching the stacks only, the stack pages of them have been purged
+    tb_list_entry_head_t            coroutines_stack;
+
     /* the ready coroutines
      * 
      * ready: head -> ready -> .. -> running -> .. -> ready -> ..->
@@ -92,12 +101,53 @@ typedef struct __tb_co_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    // the shared stack base (top), all coroutines will run on it if it is not null
+    tb_byte_t*                      shared_stackbase;
+
+    // the shared stack size
+    tb_size_t                       shared_stacksize;
+
+    // the mapped size of the shared stack, it is zero if it is allocated from the heap
+    tb_size_t                       shared_mapsize;
+
+    // the coroutine whose stack is on the shared stack now
+    tb_coroutine_t*                 shared_owner;
+
+    // the next coroutine which will be switched to from the original coroutine
+    tb_coroutine_t*                 shared_next;
+
+    // the scheduler group, it is null if this scheduler is not in a group
+    struct __tb_co_scheduler_group_t* group;
+
+    // the lock of the run queue
+    tb_spinlock_t                   runq_lock;
+
+    /* the run queue of the migratable coroutines, only for the scheduler group
+     *
+     * the new coroutines started from the other threads and the shared ready coroutines are pushed to it,
+     * and they will be pulled to the ready coroutines by this scheduler or stolen by the other idle schedulers.
+     */
+    tb_list_entry_head_t            coroutines_runq;
+
+    // is idle? it is waiting io events without any ready coroutines, be protected by runq_lock
+    tb_bool_t                       idle;
+
+    // the load, the count of the alive coroutines started by the scheduler group on this scheduler
+    tb_atomic_t                     load;
+
 }tb_co_scheduler_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
 
+/* make the given coroutine as ready
+ *
+ * @param scheduler         the scheduler
+ * @param coroutine         the coroutine which is not in any list
+ */
+tb_void_t                   tb_co_scheduler_make_ready(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+
 /* start the coroutine function 
  *
  * @param scheduler         the scheduler, uses the default scheduler if be null
@@ -105,9 +155,9 @@ typedef struct __tb_co_scheduler_t
  * @param priv              the passed user private data as the argument of function
  * @param stacksize         the stack size
  *
- * @return                  tb_true or tb_false
+ * @return                  the started coroutine, return tb_null if failed
  */
-tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+tb_coroutine_t*             tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
 /* yield the current coroutine
  *
@@ -155,8 +205,11 @@ tb_pointer_t                tb_co_scheduler_sleep(tb_co_scheduler_t* scheduler,
  *
  * @param scheduler         the scheduler
  * @param coroutine         the coroutine
+ *
+ * @return                  tb_true or tb_false, it only fails in the original coroutine 
+ *                          if the shared stack cannot be saved or loaded for the shared stack mode
  */
-tb_void_t                   tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+tb_bool_t                   tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
 
 /*! wait io events 
  *
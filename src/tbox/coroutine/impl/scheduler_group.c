@@ -0,0 +1,347 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "scheduler_io.h"
+#include "coroutine.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_co_scheduler_group_wake(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // spak the poller to break the waiting of the io loop
+    if (scheduler->scheduler_io && scheduler->scheduler_io->poller) 
+        tb_poller_spak(scheduler->scheduler_io->poller);
+}
+static __tb_inline__ tb_bool_t tb_co_scheduler_group_migratable(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // only the coroutines started by the group and not pinned can be migrated, the running coroutine cannot be migrated
+    return coroutine->grouped && !coroutine->pinned && coroutine != scheduler->running;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_co_scheduler_group_spawn(tb_co_scheduler_group_t* group, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_assert_and_check_return_val(group && group->schedulers && group->count && func, tb_false);
+
+    // have been stopped? do not continue to start new coroutines
+    tb_check_return_val(!tb_atomic_get(&group->stopped), tb_false);
+
+    // the current scheduler
+    tb_co_scheduler_t* self = (tb_co_scheduler_t*)tb_co_scheduler_self();
+
+    // find the least-loaded scheduler, the current scheduler is preferred
+    tb_size_t           i = 0;
+    tb_co_scheduler_t*  scheduler = (self && self->group == group)? self : group->schedulers[0];
+    tb_long_t           load = tb_atomic_get(&scheduler->load);
+    for (i = 0; i < group->count && load; i++)
+    {
+        tb_long_t load_cur = tb_atomic_get(&group->schedulers[i]->load);
+        if (load_cur < load)
+        {
+            scheduler   = group->schedulers[i];
+            load        = load_cur;
+        }
+    }
+
+    // update the load first, the group cannot be stopped before this coroutine is finished
+    tb_atomic_fetch_and_inc(&group->alive);
+    tb_atomic_fetch_and_inc(&scheduler->load);
+
+    // start it on the current scheduler directly and reuse the cached coroutines
+    tb_coroutine_t* coroutine = tb_null;
+    if (scheduler == self) 
+    {
+        coroutine = tb_co_scheduler_start(scheduler, func, priv, stacksize);
+        if (coroutine) coroutine->grouped = 1;
+    }
+    // make a new coroutine and push it to the run queue of the other scheduler
+    else if ((coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize)))
+    {
+        coroutine->grouped = 1;
+        tb_co_scheduler_group_push(scheduler, coroutine);
+    }
+
+    // failed? restore the load
+    if (!coroutine)
+    {
+        tb_atomic_fetch_and_dec(&scheduler->load);
+        tb_atomic_fetch_and_dec(&group->alive);
+    }
+
+    // trace
+    tb_trace_d("spawn coroutine(%p) on scheduler(%p), load: %ld", coroutine, scheduler, load);
+
+    // ok?
+    return coroutine != tb_null;
+}
+tb_void_t tb_co_scheduler_group_push(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(scheduler && scheduler->group && coroutine);
+
+    // push it to the run queue
+    tb_spinlock_enter(&scheduler->runq_lock);
+    tb_list_entry_insert_tail(&scheduler->coroutines_runq, (tb_list_entry_ref_t)coroutine);
+    tb_bool_t idle = scheduler->idle;
+    tb_spinlock_leave(&scheduler->runq_lock);
+
+    // trace
+    tb_trace_d("push coroutine(%p) to scheduler(%p), idle: %d", coroutine, scheduler, idle);
+
+    // wake it up if it is waiting io events
+    if (idle) tb_co_scheduler_group_wake(scheduler);
+}
+tb_size_t tb_co_scheduler_group_pull(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler && scheduler->group);
+
+    // no coroutines? 
+    tb_check_return_val(tb_list_entry_size(&scheduler->coroutines_runq), 0);
+
+    // pull all coroutines from the run queue
+    tb_size_t count = 0;
+    tb_spinlock_enter(&scheduler->runq_lock);
+    while (tb_list_entry_size(&scheduler->coroutines_runq))
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_runq);
+        tb_assert(entry);
+
+        // remove it from the run queue
+        tb_list_entry_remove_head(&scheduler->coroutines_runq);
+
+        // make it as ready
+        tb_co_scheduler_make_ready(scheduler, (tb_coroutine_t*)tb_list_entry0(entry));
+        count++;
+    }
+    tb_spinlock_leave(&scheduler->runq_lock);
+
+    // trace
+    tb_trace_d("scheduler(%p): pull %lu coroutines", scheduler, count);
+
+    // ok
+    return count;
+}
+tb_size_t tb_co_scheduler_group_steal(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert(group && group->schedulers);
+
+    // find the position of the current scheduler
+    tb_size_t self = 0;
+    while (self < group->count && group->schedulers[self] != scheduler) self++;
+    tb_assert(self < group->count);
+
+    // steal the coroutines from the next schedulers
+    tb_size_t i = 0;
+    tb_size_t count = 0;
+    for (i = 1; i < group->count && !count; i++)
+    {
+        // the victim scheduler
+        tb_co_scheduler_t* victim = group->schedulers[(self + i) % group->count];
+        tb_assert(victim && victim != scheduler);
+
+        // no coroutines?
+        tb_check_continue(tb_list_entry_size(&victim->coroutines_runq));
+
+        // steal the half of the run queue
+        tb_spinlock_enter(&victim->runq_lock);
+        tb_size_t steal = (tb_list_entry_size(&victim->coroutines_runq) + 1) >> 1;
+        while (count < steal)
+        {
+            // get the last entry, the head entries are hotter for the victim
+            tb_list_entry_ref_t entry = tb_list_entry_last(&victim->coroutines_runq);
+            tb_assert(entry);
+
+            // remove it from the run queue of the victim
+            tb_list_entry_remove_last(&victim->coroutines_runq);
+
+            // migrate it to the current scheduler
+            tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_list_entry0(entry);
+            tb_assert(coroutine->grouped && !coroutine->pinned);
+            coroutine->scheduler = (tb_co_scheduler_ref_t)scheduler;
+
+            // make it as ready
+            tb_co_scheduler_make_ready(scheduler, coroutine);
+            count++;
+        }
+        tb_spinlock_leave(&victim->runq_lock);
+
+        // update the loads
+        if (count)
+        {
+            tb_atomic_fetch_and_add(&victim->load, -(tb_long_t)count);
+            tb_atomic_fetch_and_add(&scheduler->load, count);
+        }
+
+        // trace
+        tb_trace_d("scheduler(%p): steal %lu coroutines from scheduler(%p)", scheduler, count, victim);
+    }
+
+    // ok
+    return count;
+}
+tb_void_t tb_co_scheduler_group_share(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert(group && group->schedulers);
+
+    // no idle schedulers? 
+    tb_check_return(tb_atomic_get(&group->idle));
+
+    // the run queue is empty? share the half of the migratable ready coroutines
+    if (!tb_list_entry_size(&scheduler->coroutines_runq))
+    {
+        // walk the ready coroutines
+        tb_size_t               count = 0;
+        tb_size_t               share = tb_list_entry_size(&scheduler->coroutines_ready) >> 1;
+        tb_list_entry_head_ref_t ready = &scheduler->coroutines_ready;
+        tb_list_entry_ref_t     entry = tb_list_entry_head(ready);
+        tb_spinlock_enter(&scheduler->runq_lock);
+        while (entry != (tb_list_entry_ref_t)ready && count < share)
+        {
+            // get the next entry first
+            tb_list_entry_ref_t next = tb_list_entry_next(entry);
+
+            // move this coroutine to the run queue if it can be migrated
+            tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_list_entry0(entry);
+            if (tb_co_scheduler_group_migratable(scheduler, coroutine))
+            {
+                tb_list_entry_remove(ready, entry);
+                tb_list_entry_insert_tail(&scheduler->coroutines_runq, entry);
+                count++;
+            }
+
+            // the next entry
+            entry = next;
+        }
+        tb_spinlock_leave(&scheduler->runq_lock);
+
+        // trace
+        tb_trace_d("scheduler(%p): share %lu coroutines", scheduler, count);
+    }
+
+    // wake up an idle scheduler to steal them
+    if (tb_list_entry_size(&scheduler->coroutines_runq))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            tb_co_scheduler_t* idle = group->schedulers[i];
+            if (idle != scheduler && idle->idle)
+            {
+                tb_co_scheduler_group_wake(idle);
+                break;
+            }
+        }
+    }
+}
+tb_bool_t tb_co_scheduler_group_idle(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert(group);
+
+    // pull or steal some coroutines first
+    if (tb_co_scheduler_group_pull(scheduler) || tb_co_scheduler_group_steal(scheduler)) return tb_false;
+
+    // enter the idle state if the run queue is still empty, the pusher will wake us up
+    tb_bool_t idle = tb_false;
+    tb_spinlock_enter(&scheduler->runq_lock);
+    if (!tb_list_entry_size(&scheduler->coroutines_runq)) 
+    {
+        scheduler->idle = tb_true;
+        idle = tb_true;
+    }
+    tb_spinlock_leave(&scheduler->runq_lock);
+
+    // update the idle count
+    if (idle) tb_atomic_fetch_and_inc(&group->idle);
+
+    // ok?
+    return idle;
+}
+tb_void_t tb_co_scheduler_group_busy(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert(group);
+
+    // leave the idle state
+    tb_spinlock_enter(&scheduler->runq_lock);
+    tb_bool_t idle = scheduler->idle;
+    scheduler->idle = tb_false;
+    tb_spinlock_leave(&scheduler->runq_lock);
+
+    // update the idle count
+    if (idle) tb_atomic_fetch_and_dec(&group->idle);
+}
+tb_void_t tb_co_scheduler_group_done(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert(group && group->schedulers);
+
+    // update the load
+    tb_atomic_fetch_and_dec(&scheduler->load);
+
+    // all coroutines of the group are finished? stop all schedulers
+    if (!tb_atomic_dec_and_fetch(&group->alive))
+    {
+        // trace
+        tb_trace_d("all coroutines are finished, stop the group");
+
+        // stop it
+        tb_atomic_set(&group->stopped, 1);
+
+        // wake up all schedulers
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            if (group->schedulers[i] != scheduler) tb_co_scheduler_group_wake(group->schedulers[i]);
+        }
+    }
+}
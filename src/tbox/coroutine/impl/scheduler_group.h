@@ -0,0 +1,142 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_IMPL_SCHEDULER_GROUP_H
+#define TB_COROUTINE_IMPL_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// get the scheduler group
+#define tb_co_scheduler_group(scheduler)                ((scheduler)->group)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the scheduler group type
+typedef struct __tb_co_scheduler_group_t
+{
+    // the schedulers
+    tb_co_scheduler_t**             schedulers;
+
+    // the schedulers count
+    tb_size_t                       count;
+
+    // the threads for running the schedulers, the first scheduler runs on the thread of loop()
+    tb_thread_ref_t*                threads;
+
+    // the count of the alive coroutines started by this group
+    tb_atomic_t                     alive;
+
+    // the count of the idle schedulers
+    tb_atomic_t                     idle;
+
+    // is stopped?
+    tb_atomic_t                     stopped;
+
+}tb_co_scheduler_group_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* start coroutine on the least-loaded scheduler in the group
+ *
+ * @param group             the scheduler group
+ * @param func              the coroutine function
+ * @param priv              the passed user private data as the argument of function
+ * @param stacksize         the stack size
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_co_scheduler_group_spawn(tb_co_scheduler_group_t* group, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
+/* push the migratable coroutine to the run queue of the given scheduler and wake it up if it is idle
+ *
+ * @param scheduler         the scheduler in the group
+ * @param coroutine         the coroutine
+ */
+tb_void_t                   tb_co_scheduler_group_push(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+
+/* pull the coroutines from the run queue of the current scheduler to the ready coroutines
+ *
+ * @param scheduler         the current scheduler in the group
+ *
+ * @return                  the pulled coroutines count
+ */
+tb_size_t                   tb_co_scheduler_group_pull(tb_co_scheduler_t* scheduler);
+
+/* steal the coroutines from the run queues of the other schedulers in the group
+ *
+ * @param scheduler         the current scheduler in the group
+ *
+ * @return                  the stolen coroutines count
+ */
+tb_size_t                   tb_co_scheduler_group_steal(tb_co_scheduler_t* scheduler);
+
+/* share the migratable ready coroutines of the current scheduler if there are some idle schedulers
+ *
+ * @param scheduler         the current scheduler in the group
+ */
+tb_void_t                   tb_co_scheduler_group_share(tb_co_scheduler_t* scheduler);
+
+/* enter the idle state before waiting io events
+ *
+ * @param scheduler         the current scheduler in the group
+ *
+ * @return                  tb_true: idle now, tb_false: there are some new ready coroutines
+ */
+tb_bool_t                   tb_co_scheduler_group_idle(tb_co_scheduler_t* scheduler);
+
+/* leave the idle state after waiting io events
+ *
+ * @param scheduler         the current scheduler in the group
+ */
+tb_void_t                   tb_co_scheduler_group_busy(tb_co_scheduler_t* scheduler);
+
+/* the coroutine started by the group is finished on the current scheduler
+ *
+ * @param scheduler         the current scheduler in the group
+ */
+tb_void_t                   tb_co_scheduler_group_done(tb_co_scheduler_t* scheduler);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -34,6 +34,7 @@
  * includes
  */
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 #include "coroutine.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +51,9 @@
 // the timer grow
 #define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
 
+// the maximum waiting time (ms) of the idle scheduler in the group, it will check the run queues of the other schedulers again
+#define TB_SCHEDULER_IO_GROUP_IDLE_MAXN     (100)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -158,18 +162,28 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
     tb_poller_ref_t poller = scheduler_io->poller;
     tb_assert_and_check_return(poller);
 
+    // the scheduler group
+    tb_co_scheduler_group_t* group = tb_co_scheduler_group(scheduler);
+
     // loop
     while (!scheduler->stopped)
     {
+        // pull the new coroutines started from the other threads
+        if (group) tb_co_scheduler_group_pull(scheduler);
+
         // finish all other ready coroutines first
         while (tb_co_scheduler_yield(scheduler)) 
         {
             // spak timer
             if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
-        }
 
-        // no more suspended coroutines? loop end
-        tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+            // share the migratable coroutines to the idle schedulers or pull the new coroutines
+            if (group)
+            {
+                if (tb_atomic_get(&group->idle)) tb_co_scheduler_group_share(scheduler);
+                else tb_co_scheduler_group_pull(scheduler);
+            }
+        }
 
         // the delay
         tb_size_t delay = tb_timer_delay(scheduler_io->timer);
@@ -177,11 +191,35 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
         // the ldelay
         tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
 
+        // the waiting time
+        tb_size_t timeout = tb_min(delay, ldelay);
+
+        // in the scheduler group?
+        if (group)
+        {
+            // all coroutines of the group are finished and no more suspended coroutines? loop end
+            if (tb_atomic_get(&group->stopped) && !tb_co_scheduler_suspend_count(scheduler)) break;
+
+            // there are some new ready coroutines? continue to run them
+            if (!tb_co_scheduler_group_idle(scheduler)) continue;
+
+            // we need check the run queues of the other schedulers periodically
+            timeout = tb_min(timeout, TB_SCHEDULER_IO_GROUP_IDLE_MAXN);
+        }
+        // no more suspended coroutines? loop end
+        else tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+
         // trace
-        tb_trace_d("loop: wait %lu ms ..", tb_min(delay, ldelay));
+        tb_trace_d("loop: wait %lu ms ..", timeout);
 
         // no more ready coroutines? wait io events and timers
-        if (tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay)) < 0) break;
+        tb_long_t wait = tb_poller_wait(poller, tb_co_scheduler_io_events, timeout);
+
+        // leave the idle state
+        if (group) tb_co_scheduler_group_busy(scheduler);
+
+        // failed?
+        tb_check_break(wait >= 0);
 
         // spak timer
         if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
@@ -37,6 +37,13 @@
 #include "impl/impl.h"
 #include "../algorithm/algorithm.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default shared stack size
+#define TB_CO_SCHEDULER_SHARED_STACK_DEFSIZE        (256 << 10)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -87,12 +94,21 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
         // init dead coroutines
         tb_list_entry_init(&scheduler->coroutines_dead, tb_coroutine_t, entry, tb_null);
 
+        // init the dead coroutines for caching stacks
+        tb_list_entry_init(&scheduler->coroutines_stack, tb_coroutine_t, entry, tb_null);
+
         // init ready coroutines
         tb_list_entry_init(&scheduler->coroutines_ready, tb_coroutine_t, entry, tb_null);
 
         // init suspend coroutines
         tb_list_entry_init(&scheduler->coroutines_suspend, tb_coroutine_t, entry, tb_null);
 
+        // init the run queue for the scheduler group
+        tb_list_entry_init(&scheduler->coroutines_runq, tb_coroutine_t, entry, tb_null);
+
+        // init the lock of the run queue
+        if (!tb_spinlock_init(&scheduler->runq_lock)) break;
+
         // init original coroutine
         scheduler->original.scheduler = (tb_co_scheduler_ref_t)scheduler;
 
@@ -115,6 +131,70 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
     // ok?
     return (tb_co_scheduler_ref_t)scheduler;
 }
+tb_co_scheduler_ref_t tb_co_scheduler_init_with_shared_stack(tb_size_t stacksize)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_co_scheduler_t*  scheduler = tb_null;
+    do
+    {
+        // init scheduler
+        scheduler = (tb_co_scheduler_t*)tb_co_scheduler_init();
+        tb_assert_and_check_break(scheduler);
+
+        // init stack size
+        if (!stacksize) stacksize = TB_CO_SCHEDULER_SHARED_STACK_DEFSIZE;
+
+        /* map the shared stack with the guard page
+         *
+         *  --------------------------------------------
+         * | guard page | ... stacksize ... | guard(u16) |
+         *  --------------------------------------------
+         */
+        tb_size_t pagesize = tb_page_size();
+        if (pagesize)
+        {
+            tb_size_t   mapsize = tb_align(pagesize + stacksize + sizeof(tb_uint16_t), pagesize);
+            tb_byte_t*  mapdata = (tb_byte_t*)tb_native_memory_map(mapsize);
+            if (mapdata)
+            {
+                // make the guard page
+                if (tb_native_memory_guard(mapdata, pagesize))
+                {
+                    scheduler->shared_mapsize   = mapsize;
+                    scheduler->shared_stackbase = mapdata + mapsize - sizeof(tb_uint16_t);
+                    scheduler->shared_stacksize = scheduler->shared_stackbase - (mapdata + pagesize);
+                }
+                else tb_native_memory_unmap(mapdata, mapsize);
+            }
+        }
+
+        // make the shared stack from the heap
+        if (!scheduler->shared_stackbase)
+        {
+            tb_byte_t* stackdata = (tb_byte_t*)tb_malloc_bytes(stacksize + sizeof(tb_uint16_t));
+            tb_assert_and_check_break(stackdata);
+
+            scheduler->shared_stackbase = stackdata + stacksize;
+            scheduler->shared_stacksize = stacksize;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (scheduler) tb_co_scheduler_exit((tb_co_scheduler_ref_t)scheduler);
+        scheduler = tb_null;
+    }
+
+    // ok?
+    return (tb_co_scheduler_ref_t)scheduler;
+}
 tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
 {
     // check
@@ -138,21 +218,45 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // free all dead coroutines 
     tb_co_scheduler_free(&scheduler->coroutines_dead);
 
+    // free all cached stacks
+    tb_co_scheduler_free(&scheduler->coroutines_stack);
+
     // free all ready coroutines 
     tb_co_scheduler_free(&scheduler->coroutines_ready);
 
     // free all suspend coroutines 
     tb_co_scheduler_free(&scheduler->coroutines_suspend);
 
+    // free all coroutines in the run queue
+    tb_co_scheduler_free(&scheduler->coroutines_runq);
+
     // exit dead coroutines
     tb_list_entry_exit(&scheduler->coroutines_dead);
 
+    // exit the dead coroutines for caching stacks
+    tb_list_entry_exit(&scheduler->coroutines_stack);
+
     // exit ready coroutines
     tb_list_entry_exit(&scheduler->coroutines_ready);
 
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // exit the run queue
+    tb_list_entry_exit(&scheduler->coroutines_runq);
+
+    // exit the lock of the run queue
+    tb_spinlock_exit(&scheduler->runq_lock);
+
+    // exit the shared stack
+    if (scheduler->shared_stackbase)
+    {
+        if (scheduler->shared_mapsize) tb_native_memory_unmap(scheduler->shared_stackbase + sizeof(tb_uint16_t) - scheduler->shared_mapsize, scheduler->shared_mapsize);
+        else tb_free(scheduler->shared_stackbase - scheduler->shared_stacksize);
+    }
+    scheduler->shared_stackbase = tb_null;
+    scheduler->shared_owner     = tb_null;
+
     // exit the scheduler
     tb_free(scheduler);
 }
@@ -195,8 +299,13 @@ tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
         tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_ready);
         tb_assert(entry);
 
-        // switch to the next coroutine 
-        tb_co_scheduler_switch(scheduler, (tb_coroutine_t*)tb_list_entry0(entry));
+        // switch to the next coroutine, stop it if the shared stack cannot be switched
+        if (!tb_co_scheduler_switch(scheduler, (tb_coroutine_t*)tb_list_entry0(entry)))
+        {
+            // trace
+            tb_trace_e("[loop]: switch to coroutine(%p) failed!", tb_list_entry0(entry));
+            break;
+        }
 
         // trace
         tb_trace_d("[loop]: ready %lu", tb_list_entry_size(&scheduler->coroutines_ready));
@@ -53,6 +53,22 @@ typedef __tb_typeref__(co_scheduler);
  */
 tb_co_scheduler_ref_t   tb_co_scheduler_init(tb_noarg_t);
 
+/*! init scheduler with the shared stack (copy stack)
+ *
+ * all coroutines of this scheduler will run on one shared stack,
+ * and only the used stack of the coroutine will be saved to the heap when it is switched out.
+ *
+ * it will take up much less memory for lots of the idle coroutines with the shallow stacks (.e.g waiting io),
+ * but the switch will be slower because the stack data need be copied.
+ *
+ * @note the address of the local variables on the stack cannot be passed to the other coroutines
+ *
+ * @param stacksize     the shared stack size, uses the default stack size if be zero
+ *
+ * @return              the scheduler 
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_init_with_shared_stack(tb_size_t stacksize);
+
 /*! exit scheduler
  *
  * @param scheduler     the scheduler
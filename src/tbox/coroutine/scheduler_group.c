@@ -0,0 +1,199 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     scheduler
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum schedulers count
+#define TB_CO_SCHEDULER_GROUP_MAXN          (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_int_t tb_co_scheduler_group_loop_thread(tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_ref_t scheduler = (tb_co_scheduler_ref_t)priv;
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // run the scheduler loop on this thread
+    tb_co_scheduler_loop(scheduler, tb_false);
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_scheduler_group_ref_t tb_co_scheduler_group_init(tb_size_t count)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_co_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // init count
+        if (!count) count = tb_processor_count();
+        if (!count) count = 1;
+        tb_assert_and_check_break(count <= TB_CO_SCHEDULER_GROUP_MAXN);
+
+        // make group
+        group = tb_malloc0_type(tb_co_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // make schedulers
+        group->schedulers = tb_nalloc0_type(count, tb_co_scheduler_t*);
+        tb_assert_and_check_break(group->schedulers);
+
+        // make threads
+        group->threads = tb_nalloc0_type(count, tb_thread_ref_t);
+        tb_assert_and_check_break(group->threads);
+
+        // init schedulers
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // init scheduler
+            tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_init();
+            tb_assert_and_check_break(scheduler);
+
+            // save it
+            group->schedulers[i] = scheduler;
+            group->count++;
+
+            // bind the group
+            scheduler->group = group;
+
+            // init io scheduler, we need the poller to wait the new coroutines
+            scheduler->scheduler_io = tb_co_scheduler_io_init(scheduler);
+            tb_assert_and_check_break(scheduler->scheduler_io);
+        }
+        tb_check_break(i == count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (group) 
+        {
+            // the schedulers must be stopped before exiting them
+            tb_size_t i = 0;
+            for (i = 0; i < group->count; i++) group->schedulers[i]->stopped = tb_true;
+            tb_co_scheduler_group_exit((tb_co_scheduler_group_ref_t)group);
+        }
+        group = tb_null;
+    }
+
+    // ok?
+    return (tb_co_scheduler_group_ref_t)group;
+}
+tb_void_t tb_co_scheduler_group_exit(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group);
+
+    // exit schedulers
+    if (group->schedulers)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            if (group->schedulers[i]) tb_co_scheduler_exit((tb_co_scheduler_ref_t)group->schedulers[i]);
+            group->schedulers[i] = tb_null;
+        }
+        tb_free(group->schedulers);
+    }
+    group->schedulers = tb_null;
+    group->count = 0;
+
+    // exit threads
+    if (group->threads) tb_free(group->threads);
+    group->threads = tb_null;
+
+    // exit it
+    tb_free(group);
+}
+tb_void_t tb_co_scheduler_group_kill(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->schedulers);
+
+    // stop it
+    tb_atomic_set(&group->stopped, 1);
+
+    // kill all schedulers
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++) tb_co_scheduler_kill((tb_co_scheduler_ref_t)group->schedulers[i]);
+}
+tb_void_t tb_co_scheduler_group_loop(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->schedulers && group->threads && group->count);
+
+    // run the other schedulers on the new threads
+    tb_size_t i = 0;
+    for (i = 1; i < group->count; i++)
+    {
+        group->threads[i] = tb_thread_init(tb_null, tb_co_scheduler_group_loop_thread, group->schedulers[i], 0);
+        tb_assert(group->threads[i]);
+    }
+
+    // run the first scheduler on the current thread
+    tb_co_scheduler_loop((tb_co_scheduler_ref_t)group->schedulers[0], tb_false);
+
+    // wait all threads
+    for (i = 1; i < group->count; i++)
+    {
+        if (group->threads[i])
+        {
+            tb_thread_wait(group->threads[i], -1, tb_null);
+            tb_thread_exit(group->threads[i]);
+            group->threads[i] = tb_null;
+        }
+        // the thread was not started? stop this scheduler directly
+        else group->schedulers[i]->stopped = tb_true;
+    }
+}
@@ -0,0 +1,111 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_SCHEDULER_GROUP_H
+#define TB_COROUTINE_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the coroutine scheduler group ref type
+typedef __tb_typeref__(co_scheduler_group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the scheduler group (M:N)
+ *
+ * <pre>
+ *
+ *      thread: 0                thread: 1                       thread: n
+ *  -----------------        -----------------              -----------------
+ * |   scheduler: 0  |      |   scheduler: 1  |     ...    |   scheduler: n  |
+ * |-----------------|      |-----------------|            |-----------------|
+ * | ready | poller  |      | ready | poller  |            | ready | poller  |
+ * |-----------------|      |-----------------|            |-----------------|
+ * |  run queue      | <--> |  run queue      |    <-->    |  run queue      |
+ *  -----------------        -----------------              -----------------
+ *                     steal                      steal
+ *
+ * </pre>
+ *
+ * each scheduler runs on its own thread with its own ready coroutines, poller and timers.
+ *
+ * the new coroutine will be started on the least-loaded scheduler by tb_coroutine_spawn(), 
+ * and the busy scheduler will share the migratable ready coroutines to its run queue if there are some idle schedulers,
+ * then the idle schedulers will steal them from the run queue.
+ *
+ * @note only the coroutines started by tb_coroutine_spawn() can be migrated,
+ * and they will be pinned to the current scheduler after they are suspended or waiting io at first time,
+ * because they may be referenced by the channel, lock, semaphore, timer and poller of this scheduler.
+ * so these coroutines should not access the thread-unsafe data shared with the other coroutines before they are pinned,
+ * and the coroutines on the different schedulers cannot use the same channel, lock and semaphore.
+ *
+ * @param count         the schedulers count, uses the processors count if be zero
+ *
+ * @return              the scheduler group
+ */
+tb_co_scheduler_group_ref_t tb_co_scheduler_group_init(tb_size_t count);
+
+/*! exit the scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_exit(tb_co_scheduler_group_ref_t group);
+
+/*! kill the scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_kill(tb_co_scheduler_group_ref_t group);
+
+/*! run the loops of all schedulers in the group
+ *
+ * the first scheduler runs on the current thread and the others run on the new threads,
+ * it will return after all coroutines started by this group are finished or the group is killed.
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_loop(tb_co_scheduler_group_ref_t group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -38,6 +38,7 @@
 #include "../libc/libc.h"
 #include "../utils/utils.h"
 #include "../platform/platform.h"
+#include "../tbox.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
@@ -46,6 +47,21 @@
 // the allocator 
 __tb_extern_c__ tb_allocator_ref_t  g_allocator = tb_null;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifndef TB_CONFIG_MICRO_ENABLE
+static tb_void_t tb_allocator_trim_task(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // check
+    tb_allocator_ref_t allocator = (tb_allocator_ref_t)priv;
+    tb_check_return(allocator && !killed);
+
+    // trim it
+    tb_allocator_trim(allocator);
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -67,7 +83,8 @@ tb_pointer_t tb_allocator_malloc_(tb_allocator_ref_t allocator, tb_size_t size _
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // malloc it
     tb_pointer_t data = tb_null;
@@ -82,7 +99,7 @@ tb_pointer_t tb_allocator_malloc_(tb_allocator_ref_t allocator, tb_size_t size _
     tb_assertf(!(((tb_size_t)data) & (TB_POOL_DATA_ALIGN - 1)), "malloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data;
@@ -129,7 +146,8 @@ tb_pointer_t tb_allocator_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t dat
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // ralloc it
     tb_pointer_t data_new = tb_null;
@@ -158,7 +176,7 @@ tb_pointer_t tb_allocator_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t dat
     tb_assertf(!(((tb_size_t)data_new) & (TB_POOL_DATA_ALIGN - 1)), "ralloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data_new;
@@ -169,7 +187,8 @@ tb_bool_t tb_allocator_free_(tb_allocator_ref_t allocator, tb_pointer_t data __t
     tb_assert_and_check_return_val(allocator, tb_false);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // trace
     tb_trace_d("free(%p): at %s(): %d, %s", data __tb_debug_args__);
@@ -195,7 +214,7 @@ tb_bool_t tb_allocator_free_(tb_allocator_ref_t allocator, tb_pointer_t data __t
 #endif
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return ok;
@@ -206,7 +225,8 @@ tb_pointer_t tb_allocator_large_malloc_(tb_allocator_ref_t allocator, tb_size_t
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // malloc it
     tb_pointer_t data = tb_null;
@@ -227,7 +247,7 @@ tb_pointer_t tb_allocator_large_malloc_(tb_allocator_ref_t allocator, tb_size_t
     tb_assert(!real || *real >= size);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data;
@@ -274,7 +294,8 @@ tb_pointer_t tb_allocator_large_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // ralloc it
     tb_pointer_t data_new = tb_null;
@@ -309,7 +330,7 @@ tb_pointer_t tb_allocator_large_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     tb_assertf(!(((tb_size_t)data_new) & (TB_POOL_DATA_ALIGN - 1)), "ralloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data_new;
@@ -320,7 +341,8 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
     tb_assert_and_check_return_val(allocator, tb_false);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // trace
     tb_trace_d("large_free(%p): at %s(): %d, %s", data __tb_debug_args__);
@@ -346,7 +368,7 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
 #endif
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return ok;
@@ -472,19 +494,96 @@ tb_void_t tb_allocator_clear(tb_allocator_ref_t allocator)
     tb_assert_and_check_return(allocator);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // clear it
     if (allocator->clear) allocator->clear(allocator);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
+}
+tb_size_t tb_allocator_stat(tb_allocator_ref_t allocator, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(allocator && stats, 0);
+
+    // no stats?
+    tb_check_return_val(maxn && allocator->stat, 0);
+
+    // enter
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
+
+    // get stats
+    tb_size_t count = allocator->stat(allocator, stats, maxn);
+
+    // leave
+    if (lockit) tb_spinlock_leave(&allocator->lock);
+
+    // ok?
+    return count;
+}
+tb_size_t tb_allocator_trim(tb_allocator_ref_t allocator)
+{
+    // check
+    tb_assert_and_check_return_val(allocator, 0);
+
+    // enter
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
+
+    // trim it
+    tb_size_t size = allocator->trim? allocator->trim(allocator) : 0;
+
+    // leave
+    if (lockit) tb_spinlock_leave(&allocator->lock);
+
+    // trace
+    tb_trace_d("trim: %lu bytes", size);
+
+    // ok?
+    return size;
 }
+#ifndef TB_CONFIG_MICRO_ENABLE
+tb_bool_t tb_allocator_trim_auto(tb_allocator_ref_t allocator, tb_size_t interval)
+{
+    // check
+    tb_assert_and_check_return_val(allocator, tb_false);
+
+    // the global timer
+    tb_timer_ref_t timer = tb_timer();
+    tb_assert_and_check_return_val(timer, tb_false);
+
+    // cancel the previous trim task
+    if (allocator->trim_task) tb_timer_task_exit(timer, (tb_timer_task_ref_t)allocator->trim_task);
+    allocator->trim_task = tb_null;
+
+    // post the new trim task
+    if (interval) allocator->trim_task = (tb_pointer_t)tb_timer_task_init(timer, interval, tb_true, tb_allocator_trim_task, allocator);
+
+    // ok?
+    return (!interval || allocator->trim_task)? tb_true : tb_false;
+}
+#endif
 tb_void_t tb_allocator_exit(tb_allocator_ref_t allocator)
 {
     // check
     tb_assert_and_check_return(allocator);
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+    /* cancel the trim task first, otherwise the timer will trim the freed allocator
+     *
+     * @note the global timer and its tasks have been exited if tbox is exiting
+     */
+    if (allocator->trim_task && tb_state() == TB_STATE_OK) 
+    {
+        tb_timer_ref_t timer = tb_timer();
+        if (timer) tb_timer_task_exit(timer, (tb_timer_task_ref_t)allocator->trim_task);
+    }
+    allocator->trim_task = tb_null;
+#endif
+
     // clear it first
     tb_allocator_clear(allocator);
 
@@ -498,13 +597,14 @@ tb_void_t tb_allocator_dump(tb_allocator_ref_t allocator)
     tb_assert_and_check_return(allocator);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_bool_t lockit = !(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->lock);
 
     // dump it
     if (allocator->dump) allocator->dump(allocator);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (lockit) tb_spinlock_leave(&allocator->lock);
 }
 tb_bool_t tb_allocator_have(tb_allocator_ref_t allocator, tb_cpointer_t data)
 {
@@ -80,18 +80,69 @@ typedef enum __tb_allocator_type_e
 ,   TB_ALLOCATOR_STATIC     = 4
 ,   TB_ALLOCATOR_LARGE      = 5
 ,   TB_ALLOCATOR_SMALL      = 6
+,   TB_ALLOCATOR_CACHE      = 7
+,   TB_ALLOCATOR_ARENA      = 8
 
 }tb_allocator_type_e;
 
+/// the allocator flag enum
+typedef enum __tb_allocator_flag_e
+{
+    TB_ALLOCATOR_FLAG_NONE      = 0
+,   TB_ALLOCATOR_FLAG_NOLOCK    = 1     //!< the allocator is thread safe itself and need not the global lock
+
+}tb_allocator_flag_e;
+
+/*! the allocator stat type
+ *
+ * the fragmentation rate: (used_size - live_size) / used_size
+ */
+typedef struct __tb_allocator_stat_t
+{
+    /// the name, .e.g small, large, arena ..
+    tb_char_t const*        name;
+
+    /// the item size of the size class, it is zero if this stat is not for a size class
+    tb_size_t               item_size;
+
+    /// the live data size
+    tb_size_t               live_size;
+
+    /// the peak size of the live data
+    tb_size_t               peak_size;
+
+    /// the used memory size for the live data, includes the data heads, the padding and the free items in the slots
+    tb_size_t               used_size;
+
+    /// the malloc count
+    tb_size_t               malloc_count;
+
+    /// the ralloc count
+    tb_size_t               ralloc_count;
+
+    /// the free count
+    tb_size_t               free_count;
+
+    /// the slot count, .e.g the slots of the fixed pool and the chunks of the arena
+    tb_size_t               slot_count;
+
+}tb_allocator_stat_t;
+
 /// the allocator type
 typedef struct __tb_allocator_t
 {
     /// the type
     tb_size_t               type;
 
+    /// the flag
+    tb_size_t               flag;
+
     /// the lock
     tb_spinlock_t           lock;
 
+    /// the trim task in the global timer
+    tb_pointer_t            trim_task;
+
     /*! malloc data
      *
      * @param allocator     the allocator 
@@ -156,6 +207,24 @@ typedef struct __tb_allocator_t
      */
     tb_void_t               (*clear)(struct __tb_allocator_t* allocator);
 
+    /*! get the allocator stats
+     *
+     * @param allocator     the allocator 
+     * @param stats         the stats, the first one is the stat of this allocator and the next are the stats of the size classes or the sub-allocators
+     * @param maxn          the stats maxn
+     *
+     * @return              the stats count
+     */
+    tb_size_t               (*stat)(struct __tb_allocator_t* allocator, tb_allocator_stat_t* stats, tb_size_t maxn);
+
+    /*! trim allocator and return the free memory to the system
+     *
+     * @param allocator     the allocator 
+     *
+     * @return              the size of the returned memory
+     */
+    tb_size_t               (*trim)(struct __tb_allocator_t* allocator);
+
     /*! exit allocator
      *
      * @param allocator     the allocator 
@@ -393,6 +462,51 @@ tb_bool_t               tb_allocator_align_free_(tb_allocator_ref_t allocator, t
  */
 tb_void_t               tb_allocator_clear(tb_allocator_ref_t allocator);
 
+/*! get the stats of it
+ *
+ * the counters are always enabled and cheap, the stats of the sub-allocators will follow the stats of the allocator,
+ * .e.g the default allocator: 
+ *
+ * - small
+ * - small[16]
+ * - small[32]
+ * - ...
+ * - large
+ *
+ * @param allocator     the allocator 
+ * @param stats         the stats
+ * @param maxn          the stats maxn
+ *
+ * @return              the stats count
+ */
+tb_size_t               tb_allocator_stat(tb_allocator_ref_t allocator, tb_allocator_stat_t* stats, tb_size_t maxn);
+
+/*! trim it and return the free memory to the system
+ *
+ * the empty slots of the small data will be released to the large allocator,
+ * and the free pages of the large data will be returned to the system.
+ *
+ * @param allocator     the allocator 
+ *
+ * @return              the size of the returned memory, 
+ *                      it may be zero if the system allocator does not report it
+ */
+tb_size_t               tb_allocator_trim(tb_allocator_ref_t allocator);
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+/*! trim it periodically in the global timer
+ *
+ * @note the trim task will be cancelled when this allocator is exited,
+ * or it will be exited with the global timer if tbox is exiting.
+ *
+ * @param allocator     the allocator 
+ * @param interval      the trim interval (ms), cancel it if be zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_allocator_trim_auto(tb_allocator_ref_t allocator, tb_size_t interval);
+#endif
+
 /*! exit it
  *
  * @param allocator     the allocator 
@@ -0,0 +1,537 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena_allocator.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "arena_allocator"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena_allocator.h"
+#include "impl/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default chunk size
+#ifdef __tb_small__
+#   define TB_ARENA_ALLOCATOR_CHUNK_SIZE        (16384)
+#else
+#   define TB_ARENA_ALLOCATOR_CHUNK_SIZE        (65536)
+#endif
+
+// the chunk minimum size
+#define TB_ARENA_ALLOCATOR_CHUNK_MINN           (1024)
+
+// the data patch size for checking underflow
+#ifdef __tb_debug__
+#   define TB_ARENA_ALLOCATOR_DATA_PATCH        (1)
+#else
+#   define TB_ARENA_ALLOCATOR_DATA_PATCH        (0)
+#endif
+
+// the freed data magic number for checking double free
+#define TB_ARENA_ALLOCATOR_FREED_MAGIC          ((tb_uint16_t)~TB_POOL_DATA_MAGIC)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena allocator chunk type
+typedef __tb_pool_data_aligned__ struct __tb_arena_allocator_chunk_t
+{
+    // the next chunk
+    struct __tb_arena_allocator_chunk_t*    next;
+
+    // the data size
+    tb_size_t                               size;
+
+    // the used size
+    tb_size_t                               used;
+
+}__tb_pool_data_aligned__ tb_arena_allocator_chunk_t;
+
+// the arena allocator type
+typedef struct __tb_arena_allocator_t
+{
+    // the base
+    tb_allocator_t                          base;
+
+    // the large allocator
+    tb_allocator_ref_t                      large_allocator;
+
+    // the chunk size
+    tb_size_t                               chunk_size;
+
+    /* the chunks
+     *
+     * the first chunk is the current chunk for bumping allocation
+     */
+    tb_arena_allocator_chunk_t*             chunks;
+
+    // the last data of the current chunk, it can be freed or reallocated in place
+    tb_pointer_t                            last;
+
+    // the chunk count
+    tb_size_t                               chunk_count;
+
+    // the chunk space
+    tb_size_t                               chunk_space;
+
+    // the occupied size
+    tb_size_t                               occupied_size;
+
+    // the real size
+    tb_size_t                               real_size;
+
+    // the peak size
+    tb_size_t                               peak_size;
+
+    // the malloc count
+    tb_size_t                               malloc_count;
+
+    // the ralloc count
+    tb_size_t                               ralloc_count;
+
+    // the free count
+    tb_size_t                               free_count;
+
+}tb_arena_allocator_t, *tb_arena_allocator_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_byte_t* tb_arena_allocator_chunk_data(tb_arena_allocator_chunk_t* chunk)
+{
+    return (tb_byte_t*)&chunk[1];
+}
+static __tb_inline__ tb_size_t tb_arena_allocator_need(tb_size_t size)
+{
+    return tb_align(sizeof(tb_pool_data_head_t) + size + TB_ARENA_ALLOCATOR_DATA_PATCH, TB_POOL_DATA_ALIGN);
+}
+static tb_arena_allocator_chunk_t* tb_arena_allocator_chunk_init(tb_arena_allocator_ref_t allocator, tb_size_t size)
+{
+    // check
+    tb_assert(allocator && allocator->large_allocator);
+
+    // make chunk
+    tb_arena_allocator_chunk_t* chunk = (tb_arena_allocator_chunk_t*)tb_allocator_large_malloc(allocator->large_allocator, sizeof(tb_arena_allocator_chunk_t) + size, tb_null);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // init chunk
+    chunk->next = tb_null;
+    chunk->size = size;
+    chunk->used = 0;
+
+    // update the chunk count and space
+    allocator->chunk_count++;
+    allocator->chunk_space += sizeof(tb_arena_allocator_chunk_t) + size;
+
+    // ok
+    return chunk;
+}
+static tb_void_t tb_arena_allocator_chunk_exit(tb_arena_allocator_ref_t allocator, tb_arena_allocator_chunk_t* chunk)
+{
+    // check
+    tb_assert(allocator && allocator->large_allocator && chunk);
+
+    // update the chunk count and space
+    allocator->chunk_count--;
+    allocator->chunk_space -= sizeof(tb_arena_allocator_chunk_t) + chunk->size;
+
+    // exit chunk
+    tb_allocator_large_free(allocator->large_allocator, chunk);
+}
+static tb_pool_data_head_t* tb_arena_allocator_alloc(tb_arena_allocator_ref_t allocator, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_assert_and_check_return_val(allocator && size && size <= TB_POOL_DATA_SIZE_MAXN, tb_null);
+
+    // the need space
+    tb_size_t need = tb_arena_allocator_need(size);
+
+    // done
+    tb_pool_data_head_t* data_head = tb_null;
+    tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+    if (need > (allocator->chunk_size >> 2))
+    {
+        // make a standalone chunk for the large data
+        tb_arena_allocator_chunk_t* large_chunk = tb_arena_allocator_chunk_init(allocator, need);
+        tb_assert_and_check_return_val(large_chunk, tb_null);
+
+        /* insert it after the current chunk
+         *
+         * @note we need not bump the data of the current chunk,
+         * so the large data will be never the last data.
+         */
+        if (chunk)
+        {
+            large_chunk->next = chunk->next;
+            chunk->next = large_chunk;
+        }
+        else allocator->chunks = large_chunk;
+
+        // alloc it
+        large_chunk->used = need;
+        data_head = (tb_pool_data_head_t*)tb_arena_allocator_chunk_data(large_chunk);
+    }
+    else
+    {
+        // no enough space in the current chunk? make a new chunk
+        if (!chunk || chunk->used + need > chunk->size)
+        {
+            // make chunk
+            chunk = tb_arena_allocator_chunk_init(allocator, allocator->chunk_size);
+            tb_assert_and_check_return_val(chunk, tb_null);
+
+            // insert it to the head
+            chunk->next = allocator->chunks;
+            allocator->chunks = chunk;
+        }
+
+        // bump it
+        data_head = (tb_pool_data_head_t*)(tb_arena_allocator_chunk_data(chunk) + chunk->used);
+        chunk->used += need;
+
+        // save the last data
+        allocator->last = (tb_pointer_t)&data_head[1];
+    }
+
+    // init the data head
+    data_head->size = size;
+
+#ifdef __tb_debug__
+    data_head->debug.magic     = TB_POOL_DATA_MAGIC;
+    data_head->debug.file      = file_;
+    data_head->debug.func      = func_;
+    data_head->debug.line      = (tb_uint16_t)line_;
+
+    // save backtrace
+    tb_pool_data_save_backtrace(&data_head->debug, 3);
+
+    // make the dirty data and patch bytes for checking underflow
+    tb_memset_((tb_pointer_t)&data_head[1], TB_POOL_DATA_PATCH, need - sizeof(tb_pool_data_head_t));
+#endif
+
+    // update the occupied and real size
+    allocator->occupied_size += need;
+    allocator->real_size     += size;
+    if (allocator->occupied_size > allocator->peak_size) allocator->peak_size = allocator->occupied_size;
+
+    // ok
+    return data_head;
+}
+static tb_void_t tb_arena_allocator_exit(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->large_allocator);
+
+    // exit all chunks
+    while (allocator->chunks)
+    {
+        tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+        allocator->chunks = chunk->next;
+        tb_arena_allocator_chunk_exit(allocator, chunk);
+    }
+
+    // exit lock
+    tb_spinlock_exit(&allocator->base.lock);
+
+    // exit allocator
+    tb_allocator_large_free(allocator->large_allocator, allocator);
+}
+static tb_void_t tb_arena_allocator_clear(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // release all data together, only keep one normal chunk for reusing it
+    tb_arena_allocator_chunk_t* keep = tb_null;
+    while (allocator->chunks)
+    {
+        tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+        allocator->chunks = chunk->next;
+        if (!keep && chunk->size == allocator->chunk_size) keep = chunk;
+        else tb_arena_allocator_chunk_exit(allocator, chunk);
+    }
+    if (keep)
+    {
+        keep->next = tb_null;
+        keep->used = 0;
+    }
+    allocator->chunks   = keep;
+    allocator->last     = tb_null;
+
+    // clear info
+    allocator->occupied_size    = 0;
+    allocator->real_size        = 0;
+}
+static tb_pointer_t tb_arena_allocator_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator, tb_null);
+
+    // alloc it
+    tb_pool_data_head_t* data_head = tb_arena_allocator_alloc(allocator, size __tb_debug_args__);
+    tb_check_return_val(data_head, tb_null);
+
+    // update the malloc count
+    allocator->malloc_count++;
+
+    // ok
+    return (tb_pointer_t)&data_head[1];
+}
+static tb_pointer_t tb_arena_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && size, tb_null);
+
+    // no data? malloc it
+    if (!data) return tb_arena_allocator_malloc(self, size __tb_debug_args__);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
+    tb_assertf(!TB_ARENA_ALLOCATOR_DATA_PATCH || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+    // update the ralloc count
+    allocator->ralloc_count++;
+
+    // the old and new need space
+    tb_size_t need_old = tb_arena_allocator_need(data_head->size);
+    tb_size_t need_new = tb_arena_allocator_need(size);
+
+    // the last data of the current chunk? resize it in place
+    tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+    if (data == allocator->last && chunk && chunk->used - need_old + need_new <= chunk->size)
+    {
+        // resize it
+        chunk->used = chunk->used - need_old + need_new;
+
+#ifdef __tb_debug__
+        // make the patch bytes
+        if (size > data_head->size) tb_memset_((tb_byte_t*)data + data_head->size, TB_POOL_DATA_PATCH, need_new - sizeof(tb_pool_data_head_t) - data_head->size);
+        else ((tb_byte_t*)data)[size] = TB_POOL_DATA_PATCH;
+#endif
+
+        // update the occupied and real size
+        allocator->occupied_size = allocator->occupied_size - need_old + need_new;
+        allocator->real_size     = allocator->real_size - data_head->size + size;
+        if (allocator->occupied_size > allocator->peak_size) allocator->peak_size = allocator->occupied_size;
+
+        // update size
+        data_head->size = size;
+        return data;
+    }
+
+    // the old size
+    tb_size_t size_old = data_head->size;
+
+    // alloc the new data
+    tb_pool_data_head_t* data_head_new = tb_arena_allocator_alloc(allocator, size __tb_debug_args__);
+    tb_check_return_val(data_head_new, tb_null);
+
+    // copy the old data, the old data will be released together on clear or exit
+    tb_memcpy_((tb_pointer_t)&data_head_new[1], data, tb_min(size_old, size));
+
+    // update the real size, the old data is dead now
+    allocator->real_size -= size_old;
+
+#ifdef __tb_debug__
+    // mark the old data as freed
+    data_head->debug.magic = TB_ARENA_ALLOCATOR_FREED_MAGIC;
+#endif
+
+    // ok
+    return (tb_pointer_t)&data_head_new[1];
+}
+static tb_bool_t tb_arena_allocator_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && data, tb_false);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic != TB_ARENA_ALLOCATOR_FREED_MAGIC, "double free data: %p", data);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
+    tb_assertf(!TB_ARENA_ALLOCATOR_DATA_PATCH || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+    // the last data of the current chunk? reclaim it
+    if (data == allocator->last)
+    {
+        // check
+        tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+        tb_assert_and_check_return_val(chunk, tb_false);
+
+        // rollback the bump pointer
+        chunk->used -= tb_arena_allocator_need(data_head->size);
+        allocator->last = tb_null;
+
+        // update the occupied size
+        allocator->occupied_size -= tb_arena_allocator_need(data_head->size);
+    }
+
+    // update the real size
+    allocator->real_size -= data_head->size;
+
+    // update the free count
+    allocator->free_count++;
+
+#ifdef __tb_debug__
+    // mark it as freed
+    data_head->debug.magic = TB_ARENA_ALLOCATOR_FREED_MAGIC;
+#endif
+
+    // ok, the other data will be released together on clear or exit
+    return tb_true;
+}
+static tb_size_t tb_arena_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && stats && maxn, 0);
+
+    // get stat
+    tb_allocator_stat_t* stat = &stats[0];
+    tb_memset_(stat, 0, sizeof(tb_allocator_stat_t));
+    stat->name          = "arena";
+    stat->live_size     = allocator->real_size;
+    stat->peak_size     = allocator->peak_size;
+    stat->used_size     = allocator->chunk_space;
+    stat->malloc_count  = allocator->malloc_count;
+    stat->ralloc_count  = allocator->ralloc_count;
+    stat->free_count    = allocator->free_count;
+    stat->slot_count    = allocator->chunk_count;
+
+    // ok
+    return 1;
+}
+#ifdef __tb_debug__
+static tb_void_t tb_arena_allocator_dump(tb_allocator_ref_t self)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // trace
+    tb_trace_i("");
+
+    // trace debug info
+    tb_trace_i("chunk_size: %lu",           allocator->chunk_size);
+    tb_trace_i("chunk_count: %lu",          allocator->chunk_count);
+    tb_trace_i("occupied_size: %lu",        allocator->occupied_size);
+    tb_trace_i("peak_size: %lu",            allocator->peak_size);
+    tb_trace_i("wast_rate: %llu/10000",     allocator->occupied_size? (((tb_hize_t)allocator->occupied_size - allocator->real_size) * 10000) / (tb_hize_t)allocator->occupied_size : 0);
+    tb_trace_i("free_count: %lu",           allocator->free_count);
+    tb_trace_i("malloc_count: %lu",         allocator->malloc_count);
+    tb_trace_i("ralloc_count: %lu",         allocator->ralloc_count);
+}
+static tb_bool_t tb_arena_allocator_have(tb_allocator_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_arena_allocator_ref_t allocator = (tb_arena_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator, tb_false);
+
+    // find the chunk of this data
+    tb_arena_allocator_chunk_t* chunk = allocator->chunks;
+    while (chunk)
+    {
+        tb_byte_t const* head = tb_arena_allocator_chunk_data(chunk);
+        if ((tb_byte_t const*)data > head && (tb_byte_t const*)data < head + chunk->used) return tb_true;
+        chunk = chunk->next;
+    }
+    return tb_false;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_allocator_ref_t tb_arena_allocator_init(tb_allocator_ref_t large_allocator, tb_size_t chunk_size)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_arena_allocator_ref_t    allocator = tb_null;
+    do
+    {
+        // no allocator? uses the global allocator
+        if (!large_allocator) large_allocator = tb_allocator();
+        tb_assert_and_check_break(large_allocator);
+
+        // make allocator
+        allocator = (tb_arena_allocator_ref_t)tb_allocator_large_malloc0(large_allocator, sizeof(tb_arena_allocator_t), tb_null);
+        tb_assert_and_check_break(allocator);
+
+        // init base
+        allocator->base.type            = TB_ALLOCATOR_ARENA;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NONE;
+        allocator->base.malloc          = tb_arena_allocator_malloc;
+        allocator->base.ralloc          = tb_arena_allocator_ralloc;
+        allocator->base.free            = tb_arena_allocator_free;
+        allocator->base.clear           = tb_arena_allocator_clear;
+        allocator->base.stat            = tb_arena_allocator_stat;
+        allocator->base.exit            = tb_arena_allocator_exit;
+#ifdef __tb_debug__
+        allocator->base.dump            = tb_arena_allocator_dump;
+        allocator->base.have            = tb_arena_allocator_have;
+#endif
+
+        // init lock
+        if (!tb_spinlock_init(&allocator->base.lock)) break;
+
+        // init lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&allocator->base.lock, TB_TRACE_MODULE_NAME);
+#endif
+
+        // init allocator
+        allocator->large_allocator      = large_allocator;
+        allocator->chunk_size           = tb_align(tb_max(chunk_size? chunk_size : TB_ARENA_ALLOCATOR_CHUNK_SIZE, TB_ARENA_ALLOCATOR_CHUNK_MINN), TB_POOL_DATA_ALIGN);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (allocator) tb_arena_allocator_exit((tb_allocator_ref_t)allocator);
+        allocator = tb_null;
+    }
+
+    // ok?
+    return (tb_allocator_ref_t)allocator;
+}
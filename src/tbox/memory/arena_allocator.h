@@ -0,0 +1,72 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena_allocator.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_ARENA_ALLOCATOR_H
+#define TB_MEMORY_ARENA_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "large_allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the arena allocator
+ *
+ * <pre>
+ *
+ *  -------------------------      -------------------------             -------------------------
+ * | chunk: data|data|data|  | -> | chunk: data|data|...    | -> ... -> | chunk: data|.......     |
+ *  -------------------------      -------------------------             -------------------------
+ *                                                                                    |
+ *                                                                                 bump ptr
+ * </pre>
+ *
+ * the data is allocated by bumping the pointer of the current chunk,
+ * and free only reclaims the last allocated data, the other data are released together on clear or exit.
+ *
+ * it is suitable for the request-scoped objects which all die together,
+ * e.g. parsing one http request, decoding one json document or building one xml dom.
+ *
+ * @param large_allocator   the large allocator, uses the global allocator if be null
+ * @param chunk_size        the chunk size, uses the default size if be zero
+ *
+ * @return                  the allocator
+ */
+tb_allocator_ref_t          tb_arena_allocator_init(tb_allocator_ref_t large_allocator, tb_size_t chunk_size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,581 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache_allocator.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "cache_allocator"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "cache_allocator.h"
+#include "small_allocator.h"
+#include "impl/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the size class count
+#define TB_CACHE_ALLOCATOR_CLASS_MAXN       (12)
+
+// the magazine maximum count for each size class
+#ifdef __tb_small__
+#   define TB_CACHE_ALLOCATOR_MAGAZINE_MAXN (16)
+#else
+#   define TB_CACHE_ALLOCATOR_MAGAZINE_MAXN (64)
+#endif
+
+// the magazine minimum count for each size class
+#define TB_CACHE_ALLOCATOR_MAGAZINE_MINN    (8)
+
+// the cached bytes limit of the magazine for each size class
+#define TB_CACHE_ALLOCATOR_MAGAZINE_BYTES   (16384)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cache allocator magazine type
+typedef struct __tb_cache_allocator_magazine_t
+{
+    // the cached item count
+    tb_size_t                       count;
+
+    // the cached item maximum count, refill or flush half of it in batches
+    tb_size_t                       maxn;
+
+    // the cached items
+    tb_pointer_t                    items[TB_CACHE_ALLOCATOR_MAGAZINE_MAXN];
+
+}tb_cache_allocator_magazine_t;
+
+// the cache allocator local type for each thread
+typedef struct __tb_cache_allocator_local_t
+{
+    // the list entry
+    tb_list_entry_t                 entry;
+
+    // the allocator
+    struct __tb_cache_allocator_t*  allocator;
+
+    // the magazines for all size classes
+    tb_cache_allocator_magazine_t   magazines[TB_CACHE_ALLOCATOR_CLASS_MAXN];
+
+}tb_cache_allocator_local_t;
+
+// the cache allocator type
+typedef struct __tb_cache_allocator_t
+{
+    // the base
+    tb_allocator_t                  base;
+
+    // the large allocator
+    tb_allocator_ref_t              large_allocator;
+
+    // the small allocator
+    tb_allocator_ref_t              small_allocator;
+
+    // the thread local
+    tb_thread_local_t               local;
+
+    // the locals of all threads, be protected by base.lock
+    tb_list_entry_head_t            locals;
+
+}tb_cache_allocator_t, *tb_cache_allocator_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the space of all size classes, @see tb_small_allocator_init()
+static tb_size_t const g_cache_allocator_space[TB_CACHE_ALLOCATOR_CLASS_MAXN] =
+{
+    16, 32, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 3072
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_size_t tb_cache_allocator_class(tb_size_t size)
+{
+    // the size class of (size + 15) / 16 for size <= 512
+    static tb_uint8_t const s_class[] =
+    {
+        0, 0, 1, 2, 2, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6
+    ,   7, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 8, 8
+    };
+
+    // check
+    tb_assert(size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+
+    // get the size class
+    if (size <= 512) return s_class[(size + 15) >> 4];
+    return size <= 1024? 9 : (size <= 2048? 10 : 11);
+}
+static tb_void_t tb_cache_allocator_refill(tb_cache_allocator_ref_t allocator, tb_cache_allocator_magazine_t* magazine, tb_size_t index __tb_debug_decl__)
+{
+    // check
+    tb_assert(allocator && magazine && index < TB_CACHE_ALLOCATOR_CLASS_MAXN);
+
+    // the small allocator
+    tb_allocator_ref_t small_allocator = allocator->small_allocator;
+    tb_assert(small_allocator && small_allocator->malloc);
+
+    // the space and batch count
+    tb_size_t space = g_cache_allocator_space[index];
+    tb_size_t batch = magazine->maxn >> 1;
+
+    // refill the magazine from the shared small allocator in batches, only lock it once
+    tb_spinlock_enter(&small_allocator->lock);
+    while (magazine->count < batch)
+    {
+        // malloc it
+        tb_pointer_t data = small_allocator->malloc(small_allocator, space __tb_debug_args__);
+        tb_check_break(data);
+
+        // cache it
+        magazine->items[magazine->count++] = data;
+    }
+    tb_spinlock_leave(&small_allocator->lock);
+
+    // trace
+    tb_trace_d("refill: space: %lu, count: %lu", space, magazine->count);
+}
+static tb_void_t tb_cache_allocator_flush(tb_cache_allocator_ref_t allocator, tb_cache_allocator_magazine_t* magazine, tb_size_t count __tb_debug_decl__)
+{
+    // check
+    tb_assert(allocator && magazine && count <= magazine->count);
+
+    // the small allocator
+    tb_allocator_ref_t small_allocator = allocator->small_allocator;
+    tb_assert(small_allocator && small_allocator->free);
+
+    // flush the oldest items to the shared small allocator in batches, only lock it once
+    tb_size_t i = 0;
+    tb_spinlock_enter(&small_allocator->lock);
+    for (i = 0; i < count; i++) small_allocator->free(small_allocator, magazine->items[i] __tb_debug_args__);
+    tb_spinlock_leave(&small_allocator->lock);
+
+    // remove the flushed items
+    magazine->count -= count;
+    if (magazine->count) tb_memmov_(magazine->items, magazine->items + count, magazine->count * sizeof(tb_pointer_t));
+
+    // trace
+    tb_trace_d("flush: count: %lu, left: %lu", count, magazine->count);
+}
+static tb_void_t tb_cache_allocator_local_flush(tb_cache_allocator_local_t* local __tb_debug_decl__)
+{
+    // check
+    tb_assert(local && local->allocator);
+
+    // flush all magazines
+    tb_size_t i = 0;
+    for (i = 0; i < TB_CACHE_ALLOCATOR_CLASS_MAXN; i++)
+    {
+        tb_cache_allocator_magazine_t* magazine = &local->magazines[i];
+        if (magazine->count) tb_cache_allocator_flush(local->allocator, magazine, magazine->count __tb_debug_args__);
+    }
+}
+static tb_void_t tb_cache_allocator_local_free(tb_cpointer_t priv)
+{
+    // check
+    tb_cache_allocator_local_t* local = (tb_cache_allocator_local_t*)priv;
+    tb_assert_and_check_return(local && local->allocator);
+
+    // the allocator
+    tb_cache_allocator_ref_t allocator = local->allocator;
+
+    // flush all cached data to the small allocator
+    tb_cache_allocator_local_flush(local __tb_debug_vals__);
+
+    // remove this local
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_list_entry_remove(&allocator->locals, &local->entry);
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // exit this local
+    tb_allocator_large_free(allocator->large_allocator, local);
+}
+static tb_cache_allocator_local_t* tb_cache_allocator_local(tb_cache_allocator_ref_t allocator)
+{
+    // check
+    tb_assert(allocator);
+
+    // get the local of the current thread
+    tb_cache_allocator_local_t* local = (tb_cache_allocator_local_t*)tb_thread_local_get(&allocator->local);
+    tb_check_return_val(!local, local);
+
+    // make a new local
+    local = (tb_cache_allocator_local_t*)tb_allocator_large_malloc0(allocator->large_allocator, sizeof(tb_cache_allocator_local_t), tb_null);
+    tb_assert_and_check_return_val(local, tb_null);
+
+    // init magazines
+    tb_size_t i = 0;
+    for (i = 0; i < TB_CACHE_ALLOCATOR_CLASS_MAXN; i++)
+    {
+        tb_size_t maxn = TB_CACHE_ALLOCATOR_MAGAZINE_BYTES / g_cache_allocator_space[i];
+        local->magazines[i].maxn = tb_max(tb_min(maxn, TB_CACHE_ALLOCATOR_MAGAZINE_MAXN), TB_CACHE_ALLOCATOR_MAGAZINE_MINN);
+    }
+
+    // save this local
+    local->allocator = allocator;
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_list_entry_insert_tail(&allocator->locals, &local->entry);
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // bind it to the current thread
+    if (!tb_thread_local_set(&allocator->local, local))
+    {
+        tb_cache_allocator_local_free(local);
+        local = tb_null;
+    }
+
+    // ok?
+    return local;
+}
+static tb_void_t tb_cache_allocator_exit(tb_allocator_ref_t self)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->large_allocator);
+
+    // exit the thread local first, the thread will not free it when returning
+    tb_thread_local_exit(&allocator->local);
+
+    // exit all locals
+    tb_spinlock_enter(&allocator->base.lock);
+    while (!tb_list_entry_is_null(&allocator->locals))
+    {
+        // the local
+        tb_cache_allocator_local_t* local = (tb_cache_allocator_local_t*)tb_list_entry(&allocator->locals, tb_list_entry_head(&allocator->locals));
+        tb_assert_and_check_break(local);
+
+        // remove it
+        tb_list_entry_remove_head(&allocator->locals);
+
+        // exit it, the cached data will be freed when exiting the small allocator
+        tb_allocator_large_free(allocator->large_allocator, local);
+    }
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // exit small allocator
+    if (allocator->small_allocator) tb_allocator_exit(allocator->small_allocator);
+    allocator->small_allocator = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&allocator->base.lock);
+
+    // exit allocator
+    tb_allocator_large_free(allocator->large_allocator, allocator);
+}
+static tb_void_t tb_cache_allocator_clear(tb_allocator_ref_t self)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->small_allocator);
+
+    // clear the magazines of all threads
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_for_all_if (tb_cache_allocator_local_t*, local, tb_list_entry_itor(&allocator->locals), local)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < TB_CACHE_ALLOCATOR_CLASS_MAXN; i++) local->magazines[i].count = 0;
+    }
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // clear small allocator
+    tb_allocator_clear(allocator->small_allocator);
+}
+static tb_size_t tb_cache_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && allocator->small_allocator && stats && maxn, 0);
+
+    /* the data cached in the magazines of the threads are still counted as the live data of the small allocator
+     * because they have not been flushed to it
+     */
+    // get the stats of the small allocator
+    tb_size_t count = tb_allocator_stat(allocator->small_allocator, stats, maxn);
+
+    // get the stats of the large allocator
+    if (count < maxn) count += tb_allocator_stat(allocator->large_allocator, stats + count, maxn - count);
+
+    // ok
+    return count;
+}
+static tb_size_t tb_cache_allocator_trim(tb_allocator_ref_t self)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->small_allocator, 0);
+
+    /* flush the magazines of the current thread
+     *
+     * @note the magazines of other threads cannot be flushed safely here, 
+     * they will be flushed when these threads return.
+     */
+    tb_cache_allocator_local_t* local = (tb_cache_allocator_local_t*)tb_thread_local_get(&allocator->local);
+    if (local) tb_cache_allocator_local_flush(local __tb_debug_vals__);
+
+    // trim the small allocator and the large allocator shared by it
+    return tb_allocator_trim(allocator->small_allocator);
+}
+static tb_pointer_t tb_cache_allocator_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && allocator->small_allocator && size, tb_null);
+
+    // large data?
+    if (size > TB_SMALL_ALLOCATOR_DATA_MAXN) return tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+
+    // the local of the current thread, uses the shared small allocator directly if failed
+    tb_cache_allocator_local_t* local = tb_cache_allocator_local(allocator);
+    if (!local) return tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__);
+
+    // the magazine
+    tb_size_t                       index = tb_cache_allocator_class(size);
+    tb_cache_allocator_magazine_t*  magazine = &local->magazines[index];
+
+    // refill it if be empty
+    if (!magazine->count) tb_cache_allocator_refill(allocator, magazine, index __tb_debug_args__);
+    tb_assertf_and_check_return_val(magazine->count, tb_null, "malloc(%lu) failed!", size);
+
+    // get data from the magazine
+    tb_pointer_t data = magazine->items[--magazine->count];
+    tb_assert(data);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assert(data_head->debug.magic == TB_POOL_DATA_MAGIC);
+
+#ifdef __tb_debug__
+    // fill the patch bytes
+    tb_size_t space = g_cache_allocator_space[index];
+    if (space > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, space - size);
+
+    // update the debug info
+    data_head->debug.file = file_;
+    data_head->debug.func = func_;
+    data_head->debug.line = (tb_uint16_t)line_;
+
+    // save backtrace
+    tb_pool_data_save_backtrace(&data_head->debug, 3);
+#endif
+
+    // update size
+    data_head->size = size;
+
+    // ok
+    return data;
+}
+static tb_bool_t tb_cache_allocator_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && allocator->small_allocator && data, tb_false);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
+
+    // large data?
+    tb_size_t size = data_head->size;
+    if (size > TB_SMALL_ALLOCATOR_DATA_MAXN) return tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
+
+    // the size class
+    tb_size_t index = tb_cache_allocator_class(size);
+    tb_size_t space = g_cache_allocator_space[index];
+
+    // check underflow
+    tb_assertf(space == size || ((tb_byte_t*)data)[size] == TB_POOL_DATA_PATCH, "data underflow");
+
+    // the local of the current thread, uses the shared small allocator directly if failed
+    tb_cache_allocator_local_t* local = tb_cache_allocator_local(allocator);
+    if (!local) return tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__);
+
+    // the magazine is full? flush the oldest half of it
+    tb_cache_allocator_magazine_t* magazine = &local->magazines[index];
+    if (magazine->count >= magazine->maxn) tb_cache_allocator_flush(allocator, magazine, magazine->maxn >> 1 __tb_debug_args__);
+
+    /* cache it to the magazine of the current thread
+     *
+     * @note the data may be allocated from other threads,
+     * but all threads share the same small allocator, so we can cache it directly.
+     */
+    data_head->size = space;
+    magazine->items[magazine->count++] = data;
+
+    // ok
+    return tb_true;
+}
+static tb_pointer_t tb_cache_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && allocator->small_allocator && size, tb_null);
+
+    // no data? malloc it directly
+    if (!data) return tb_cache_allocator_malloc(self, size __tb_debug_args__);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
+    tb_assert_and_check_return_val(data_head->size, tb_null);
+
+    // the old size
+    tb_size_t size_old = data_head->size;
+
+    // large => large
+    if (size_old > TB_SMALL_ALLOCATOR_DATA_MAXN && size > TB_SMALL_ALLOCATOR_DATA_MAXN)
+        return tb_allocator_large_ralloc_(allocator->large_allocator, data, size, tb_null __tb_debug_args__);
+
+    // small => small with the same size class? only update size
+    if (size_old <= TB_SMALL_ALLOCATOR_DATA_MAXN && size <= TB_SMALL_ALLOCATOR_DATA_MAXN && tb_cache_allocator_class(size_old) == tb_cache_allocator_class(size))
+    {
+#ifdef __tb_debug__
+        // fill the patch bytes
+        if (size_old > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, size_old - size);
+#endif
+
+        // update size
+        data_head->size = size;
+        return data;
+    }
+
+    // make the new data
+    tb_pointer_t data_new = tb_cache_allocator_malloc(self, size __tb_debug_args__);
+    tb_assert_and_check_return_val(data_new, tb_null);
+
+    // copy the old data
+    tb_memcpy_(data_new, data, tb_min(size_old, size));
+
+    // free the old data
+    tb_cache_allocator_free(self, data __tb_debug_args__);
+
+    // ok
+    return data_new;
+}
+#ifdef __tb_debug__
+static tb_void_t tb_cache_allocator_dump(tb_allocator_ref_t self)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->small_allocator);
+
+    /* flush the magazines of all threads first, otherwise the cached data will be reported as leaks
+     *
+     * @note we need dump it after all other threads have stopped using it
+     */
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_for_all_if (tb_cache_allocator_local_t*, local, tb_list_entry_itor(&allocator->locals), local)
+    {
+        tb_cache_allocator_local_flush(local __tb_debug_vals__);
+    }
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // dump small allocator
+    tb_allocator_dump(allocator->small_allocator);
+}
+static tb_bool_t tb_cache_allocator_have(tb_allocator_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_cache_allocator_ref_t allocator = (tb_cache_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator, tb_false);
+
+    // have it?
+    return tb_allocator_have(allocator->large_allocator, data);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_allocator_ref_t tb_cache_allocator_init(tb_allocator_ref_t large_allocator)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_cache_allocator_ref_t    allocator = tb_null;
+    do
+    {
+        // no allocator? uses the global allocator
+        if (!large_allocator) large_allocator = tb_allocator();
+        tb_assert_and_check_break(large_allocator);
+
+        // make allocator
+        allocator = (tb_cache_allocator_ref_t)tb_allocator_large_malloc0(large_allocator, sizeof(tb_cache_allocator_t), tb_null);
+        tb_assert_and_check_break(allocator);
+
+        // init base, the thread-local magazines need not the global lock
+        allocator->base.type            = TB_ALLOCATOR_CACHE;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
+        allocator->base.malloc          = tb_cache_allocator_malloc;
+        allocator->base.ralloc          = tb_cache_allocator_ralloc;
+        allocator->base.free            = tb_cache_allocator_free;
+        allocator->base.clear           = tb_cache_allocator_clear;
+        allocator->base.stat            = tb_cache_allocator_stat;
+        allocator->base.trim            = tb_cache_allocator_trim;
+        allocator->base.exit            = tb_cache_allocator_exit;
+#ifdef __tb_debug__
+        allocator->base.dump            = tb_cache_allocator_dump;
+        allocator->base.have            = tb_cache_allocator_have;
+#endif
+
+        // init lock for the locals
+        if (!tb_spinlock_init(&allocator->base.lock)) break;
+
+        // init locals
+        tb_list_entry_init(&allocator->locals, tb_cache_allocator_local_t, entry, tb_null);
+
+        // init large allocator
+        allocator->large_allocator = large_allocator;
+
+        // init small allocator
+        allocator->small_allocator = tb_small_allocator_init(large_allocator);
+        tb_assert_and_check_break(allocator->small_allocator);
+
+        // init thread local
+        if (!tb_thread_local_init(&allocator->local, tb_cache_allocator_local_free)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (allocator) tb_cache_allocator_exit((tb_allocator_ref_t)allocator);
+        allocator = tb_null;
+    }
+
+    // ok?
+    return (tb_allocator_ref_t)allocator;
+}
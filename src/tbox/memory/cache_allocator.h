@@ -0,0 +1,87 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache_allocator.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_CACHE_ALLOCATOR_H
+#define TB_MEMORY_CACHE_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+#include "large_allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the cache allocator with the thread-local caches
+ *
+ * <pre>
+ *
+ *  -------------------      -------------------             -------------------
+ * |     thread: 0     |    |     thread: 1     |    ...    |     thread: n     |
+ *  -------------------      -------------------             -------------------
+ *           |                        |                               |
+ *  -------------------      -------------------             -------------------
+ * |  local magazines  |    |  local magazines  |    ...    |  local magazines  |
+ * |-------------------|    |-------------------|           |-------------------|
+ * | 16B | 32B | ...   |    | 16B | 32B | ...   |           | 16B | 32B | ...   |
+ *  -------------------      -------------------             -------------------
+ *           |                        |                               |
+ *           `----------------------------------------------------------'
+ *                          | batched refill and flush (locked)
+ *  -----------------------------------------------------------------------------
+ * |                  small allocator: <=3KB    |    large allocator: >3KB       |
+ *  -----------------------------------------------------------------------------
+ *
+ * </pre>
+ *
+ * the small data (<=3KB) is allocated from the magazines of the current thread without any lock,
+ * and the magazines will be refilled from or flushed to the shared small allocator in batches.
+ *
+ * the data can be freed on any thread, it will be cached into the magazines of the freeing thread.
+ *
+ * @note this allocator need be inited after tb_init() because it depends on the thread local,
+ * and all threads should stop using it before exiting it.
+ * the cached data of the tb_thread_init() threads will be flushed automatically when the thread returns.
+ *
+ * @param large_allocator   the large allocator, uses the global allocator if be null
+ *
+ * @return                  the allocator
+ */
+tb_allocator_ref_t          tb_cache_allocator_init(tb_allocator_ref_t large_allocator);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
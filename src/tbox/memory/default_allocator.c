@@ -182,6 +182,30 @@ static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t
     // ok?
     return ok;
 }
+static tb_size_t tb_default_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && allocator->small_allocator && stats && maxn, 0);
+
+    // get the stats of the small allocator
+    tb_size_t count = tb_allocator_stat(allocator->small_allocator, stats, maxn);
+
+    // get the stats of the large allocator
+    if (count < maxn) count += tb_allocator_stat(allocator->large_allocator, stats + count, maxn - count);
+
+    // ok
+    return count;
+}
+static tb_size_t tb_default_allocator_trim(tb_allocator_ref_t self)
+{
+    // check
+    tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->small_allocator, 0);
+
+    // trim the small allocator and the large allocator shared by it
+    return tb_allocator_trim(allocator->small_allocator);
+}
 #ifdef __tb_debug__
 static tb_void_t tb_default_allocator_dump(tb_allocator_ref_t self)
 {
@@ -321,16 +345,23 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_DEFAULT;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
         allocator->base.malloc          = tb_default_allocator_malloc;
         allocator->base.ralloc          = tb_default_allocator_ralloc;
         allocator->base.free            = tb_default_allocator_free;
+        allocator->base.stat            = tb_default_allocator_stat;
+        allocator->base.trim            = tb_default_allocator_trim;
         allocator->base.exit            = tb_default_allocator_exit;
 #ifdef __tb_debug__
         allocator->base.dump            = tb_default_allocator_dump;
         allocator->base.have            = tb_default_allocator_have;
 #endif
 
-        // init lock
+        /* init lock
+         *
+         * @note the small and large allocators have been locked themselves, 
+         * so we need not lock it again for malloc, ralloc and free (TB_ALLOCATOR_FLAG_NOLOCK)
+         */
         if (!tb_spinlock_init(&allocator->base.lock)) break;
 
         // init allocator
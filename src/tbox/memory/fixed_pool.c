@@ -61,6 +61,33 @@ typedef struct __tb_fixed_pool_slot_t
 
 }tb_fixed_pool_slot_t;
 
+/* the fixed pool page type
+ *
+ * the page size is not larger than the slot size,
+ * so one page will be overlapped by two slots at most.
+ *
+ * <pre>
+ *
+ *     page: 0        page: 1        page: 2        page: 3
+ * |--------------|--------------|--------------|--------------|
+ *     |------- slot: 0 -------|------- slot: 1 -------|
+ *
+ * page: 0 => slot: 0
+ * page: 1 => slot: 0, slot: 1
+ * page: 2 => slot: 1
+ *
+ * </pre>
+ */
+typedef struct __tb_fixed_pool_page_t
+{
+    // the page index: address >> page_shift
+    tb_size_t                       index;
+
+    // the slots of this page, the page is empty if no slots
+    tb_fixed_pool_slot_t*           slots[2];
+
+}tb_fixed_pool_page_t;
+
 // the fixed pool type
 typedef struct __tb_fixed_pool_impl_t
 {
@@ -94,15 +121,33 @@ typedef struct __tb_fixed_pool_impl_t
     // the full slot
     tb_list_entry_head_t            full_slots;
 
-    // the slot list
-    tb_fixed_pool_slot_t**          slot_list;
-
     // the slot count
     tb_size_t                       slot_count;
 
     // the slot space
     tb_size_t                       slot_space;
 
+    // the peak item count
+    tb_size_t                       peak_count;
+
+    // the malloc count
+    tb_size_t                       malloc_count;
+
+    // the free count
+    tb_size_t                       free_count;
+
+    // the page hash table for finding the slot of the given data in O(1), uses the linear probing
+    tb_fixed_pool_page_t*           page_list;
+
+    // the page count
+    tb_size_t                       page_count;
+
+    // the page maxn, must be power of 2
+    tb_size_t                       page_maxn;
+
+    // the page shift
+    tb_size_t                       page_shift;
+
     // for small allocator
     tb_bool_t                       for_small;
 
@@ -128,30 +173,166 @@ static tb_bool_t tb_fixed_pool_item_exit(tb_pointer_t data, tb_cpointer_t priv)
     // continue
     return tb_true;
 }
+static __tb_inline__ tb_size_t tb_fixed_pool_page_hash(tb_size_t index, tb_size_t mask)
+{
+    return (index ^ (index >> 11)) & mask;
+}
+static tb_fixed_pool_page_t* tb_fixed_pool_page_find(tb_fixed_pool_t* pool, tb_size_t index)
+{
+    // check
+    tb_assert(pool);
+
+    // empty?
+    tb_check_return_val(pool->page_list, tb_null);
+
+    // find it
+    tb_size_t               mask = pool->page_maxn - 1;
+    tb_size_t               i = tb_fixed_pool_page_hash(index, mask);
+    tb_fixed_pool_page_t*   page = tb_null;
+    while (1)
+    {
+        // the page
+        page = &pool->page_list[i];
+
+        // end?
+        if (!page->slots[0] && !page->slots[1]) return tb_null;
+
+        // found?
+        if (page->index == index) return page;
+
+        // next
+        i = (i + 1) & mask;
+    }
+
+    // no found
+    return tb_null;
+}
+static tb_bool_t tb_fixed_pool_page_grow(tb_fixed_pool_t* pool)
+{
+    // check
+    tb_assert(pool && pool->large_allocator);
+
+    // make the new page list
+    tb_size_t               maxn = pool->page_maxn? (pool->page_maxn << 1) : 64;
+    tb_fixed_pool_page_t*   list = (tb_fixed_pool_page_t*)tb_allocator_large_nalloc0(pool->large_allocator, maxn, sizeof(tb_fixed_pool_page_t), tb_null);
+    tb_assert_and_check_return_val(list, tb_false);
+
+    // move the old pages
+    tb_size_t i = 0;
+    tb_size_t mask = maxn - 1;
+    for (i = 0; i < pool->page_maxn; i++)
+    {
+        // the page
+        tb_fixed_pool_page_t* page = &pool->page_list[i];
+        tb_check_continue(page->slots[0] || page->slots[1]);
+
+        // move it
+        tb_size_t j = tb_fixed_pool_page_hash(page->index, mask);
+        while (list[j].slots[0] || list[j].slots[1]) j = (j + 1) & mask;
+        list[j] = *page;
+    }
+
+    // exit the old page list
+    if (pool->page_list) tb_allocator_large_free(pool->large_allocator, pool->page_list);
+
+    // update the page list
+    pool->page_list = list;
+    pool->page_maxn = maxn;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_fixed_pool_page_insert(tb_fixed_pool_t* pool, tb_size_t index, tb_fixed_pool_slot_t* slot)
+{
+    // check
+    tb_assert(pool && slot);
+
+    // exists? add this slot to it
+    tb_fixed_pool_page_t* page = tb_fixed_pool_page_find(pool, index);
+    if (page)
+    {
+        tb_assert_and_check_return_val(!page->slots[1], tb_false);
+        page->slots[1] = slot;
+        return tb_true;
+    }
+
+    // grow the page list if the load factor > 1/2
+    if ((pool->page_count + 1) << 1 > pool->page_maxn && !tb_fixed_pool_page_grow(pool)) return tb_false;
+
+    // find an empty page
+    tb_size_t mask = pool->page_maxn - 1;
+    tb_size_t i = tb_fixed_pool_page_hash(index, mask);
+    while (pool->page_list[i].slots[0] || pool->page_list[i].slots[1]) i = (i + 1) & mask;
+
+    // insert it
+    page = &pool->page_list[i];
+    page->index     = index;
+    page->slots[0]  = slot;
+    page->slots[1]  = tb_null;
+    pool->page_count++;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_fixed_pool_page_remove(tb_fixed_pool_t* pool, tb_size_t index, tb_fixed_pool_slot_t* slot)
+{
+    // check
+    tb_assert(pool && slot);
+
+    // find the page
+    tb_fixed_pool_page_t* page = tb_fixed_pool_page_find(pool, index);
+    tb_check_return(page);
+
+    // remove this slot
+    if (page->slots[0] == slot) page->slots[0] = page->slots[1];
+    else if (page->slots[1] != slot) return ;
+    page->slots[1] = tb_null;
+
+    // the page is not empty?
+    tb_check_return(!page->slots[0]);
+
+    // remove this page and shift the following pages backward for keeping the probing sequence
+    tb_size_t mask = pool->page_maxn - 1;
+    tb_size_t i = page - pool->page_list;
+    tb_size_t j = i;
+    while (1)
+    {
+        // the next page
+        j = (j + 1) & mask;
+        tb_fixed_pool_page_t* next = &pool->page_list[j];
+        tb_check_break(next->slots[0] || next->slots[1]);
+
+        // can this page be moved to the hole? the hash position is not in (i, j]
+        tb_size_t k = tb_fixed_pool_page_hash(next->index, mask);
+        if (i <= j? (i < k && k <= j) : (i < k || k <= j)) continue;
+
+        // move it to the hole
+        pool->page_list[i] = *next;
+        next->slots[0] = tb_null;
+        next->slots[1] = tb_null;
+        i = j;
+    }
+
+    // update the page count
+    pool->page_count--;
+}
 static tb_void_t tb_fixed_pool_slot_exit(tb_fixed_pool_t* pool, tb_fixed_pool_slot_t* slot)
 {
     // check
     tb_assert_and_check_return(pool && pool->large_allocator && slot);
-    tb_assert_and_check_return(pool->slot_list && pool->slot_count);
+    tb_assert_and_check_return(pool->slot_count);
 
     // trace
     tb_trace_d("slot[%lu]: exit: size: %lu", pool->item_size, slot->size);
 
-    // make the iterator
-    tb_array_iterator_t array_iterator;
-    tb_iterator_ref_t   iterator = tb_iterator_make_for_ptr(&array_iterator, (tb_pointer_t*)pool->slot_list, pool->slot_count);
-    tb_assert(iterator);
-
-    // find the slot from the slot list
-    tb_size_t itor = tb_binary_find_all(iterator, (tb_cpointer_t)slot);
-    tb_assert(itor != tb_iterator_tail(iterator) && itor < pool->slot_count && pool->slot_list[itor]);
-    tb_check_return(itor != tb_iterator_tail(iterator) && itor < pool->slot_count && pool->slot_list[itor]);
-    
-    // remove the slot
-    if (itor + 1 < pool->slot_count) tb_memmov_(pool->slot_list + itor, pool->slot_list + itor + 1, (pool->slot_count - itor - 1) * sizeof(tb_fixed_pool_slot_t*));
+    // remove the slot from all pages
+    tb_size_t index = (tb_size_t)slot >> pool->page_shift;
+    tb_size_t last = ((tb_size_t)slot + slot->size - 1) >> pool->page_shift;
+    for (; index <= last; index++) tb_fixed_pool_page_remove(pool, index, slot);
 
-    // update the slot count
+    // update the slot count and space
     pool->slot_count--;
+    pool->slot_space -= slot->size;
 
     // exit slot
     tb_allocator_large_free(pool->large_allocator, slot);
@@ -179,57 +360,39 @@ static tb_fixed_pool_slot_t* tb_fixed_pool_slot_init(tb_fixed_pool_t* pool)
         // the need space
         tb_size_t need_space = sizeof(tb_fixed_pool_slot_t) + pool->slot_size * item_space;
 
+        /* init the page shift
+         *
+         * the page size is not larger than the minimum slot size,
+         * so one page is overlapped by two slots at most.
+         */
+        if (!pool->page_shift) pool->page_shift = tb_ilog2i((tb_uint32_t)tb_min(need_space, TB_MAXU32));
+        tb_assert_and_check_break(pool->page_shift);
+
         // make slot
         tb_size_t real_space = 0;
         slot = (tb_fixed_pool_slot_t*)tb_allocator_large_malloc(pool->large_allocator, need_space, &real_space);
         tb_assert_and_check_break(slot);
-        tb_assert_and_check_break(real_space > sizeof(tb_fixed_pool_slot_t) + item_space);
 
-        // init slot
+        // init the slot size and update the slot count and space
         slot->size = real_space;
-        slot->pool = tb_static_fixed_pool_init((tb_byte_t*)&slot[1], real_space - sizeof(tb_fixed_pool_slot_t), pool->item_size, pool->for_small); 
-        tb_assert_and_check_break(slot->pool);
+        pool->slot_count++;
+        pool->slot_space += real_space;
 
-        // no list?
-        if (!pool->slot_list)
-        {
-            // init the slot list
-            tb_size_t size = 0;
-            pool->slot_list = (tb_fixed_pool_slot_t**)tb_allocator_large_nalloc(pool->large_allocator, 64, sizeof(tb_fixed_pool_slot_t*), &size);
-            tb_assert_and_check_break(pool->slot_list && size);
+        // check
+        tb_assert_and_check_break(real_space > sizeof(tb_fixed_pool_slot_t) + item_space);
 
-            // init the slot count
-            pool->slot_count = 0;
+        // init slot
+        slot->pool = tb_static_fixed_pool_init((tb_byte_t*)&slot[1], real_space - sizeof(tb_fixed_pool_slot_t), pool->item_size, pool->for_small);
+        tb_assert_and_check_break(slot->pool);
 
-            // init the slot space
-            pool->slot_space = size / sizeof(tb_fixed_pool_slot_t*);
-            tb_assert_and_check_break(pool->slot_space);
-        }
-        // no enough space?
-        else if (pool->slot_count == pool->slot_space)
+        // insert the slot to all pages
+        tb_size_t index = (tb_size_t)slot >> pool->page_shift;
+        tb_size_t last = ((tb_size_t)slot + slot->size - 1) >> pool->page_shift;
+        for (; index <= last; index++)
         {
-            // grow the slot list
-            tb_size_t size = 0;
-            pool->slot_list = (tb_fixed_pool_slot_t**)tb_allocator_large_ralloc(pool->large_allocator, pool->slot_list, (pool->slot_space << 1) * sizeof(tb_fixed_pool_slot_t*), &size);
-            tb_assert_and_check_break(pool->slot_list && size);
-
-            // update the slot space
-            pool->slot_space = size / sizeof(tb_fixed_pool_slot_t*);
-            tb_assert_and_check_break(pool->slot_space);
+            if (!tb_fixed_pool_page_insert(pool, index, slot)) break;
         }
-
-        // check
-        tb_assert_and_check_break(pool->slot_count < pool->slot_space);
-
-        // insert the slot to the slot list in the increasing order (TODO binary search)
-        tb_size_t i = 0;
-        tb_size_t n = pool->slot_count;
-        for (i = 0; i < n; i++) if (slot <= pool->slot_list[i]) break;
-        if (i < n) tb_memmov_(pool->slot_list + i + 1, pool->slot_list + i, (n - i) * sizeof(tb_fixed_pool_slot_t*));
-        pool->slot_list[i] = slot;
-
-        // update the slot count
-        pool->slot_count++;
+        tb_assert_and_check_break(index > last);
 
         // trace
         tb_trace_d("slot[%lu]: init: size: %lu => %lu, item: %lu => %lu", pool->item_size, need_space, real_space, pool->slot_size, tb_static_fixed_pool_maxn(slot->pool));
@@ -250,88 +413,25 @@ static tb_fixed_pool_slot_t* tb_fixed_pool_slot_init(tb_fixed_pool_t* pool)
     // ok?
     return slot;
 }
-#if 0
-static tb_fixed_pool_slot_t* tb_fixed_pool_slot_find(tb_fixed_pool_t* pool, tb_pointer_t data)
-{
-    // check
-    tb_assert_and_check_return_val(pool && data, tb_null);
-
-    // done
-    tb_fixed_pool_slot_t* slot = tb_null;
-    do
-    {
-        // belong to the current slot?
-        if (pool->current_slot && tb_fixed_pool_slot_exists(pool->current_slot, data))
-        {
-            slot = pool->current_slot;
-            break;
-        }
-            
-        // find the slot from the partial slots
-        tb_for_all_if(tb_fixed_pool_slot_t*, partial_slot, tb_list_entry_itor(&pool->partial_slots), partial_slot)
-        {
-            // is this?
-            if (tb_fixed_pool_slot_exists(partial_slot, data))
-            {
-                slot = partial_slot;
-                break;
-            }
-        }
-        
-        // no found?
-        tb_check_break(!slot);
-
-        // find the slot from the full slots
-        tb_for_all_if(tb_fixed_pool_slot_t*, full_slot, tb_list_entry_itor(&pool->full_slots), full_slot)
-        {
-            // is this?
-            if (tb_fixed_pool_slot_exists(full_slot, data))
-            {
-                slot = full_slot;
-                break;
-            }
-        }
-
-    } while (0);
-
-    // ok?
-    return slot;
-}
-#else
-static tb_long_t tb_fixed_pool_slot_comp(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t data)
-{
-    // the slot
-    tb_fixed_pool_slot_t* slot = (tb_fixed_pool_slot_t*)item;
-    tb_assert(slot);
-
-    // comp
-    return (tb_byte_t*)data < (tb_byte_t*)slot? 1 : ((tb_byte_t*)data >= (tb_byte_t*)slot + slot->size? -1 : 0);
-}
 static tb_fixed_pool_slot_t* tb_fixed_pool_slot_find(tb_fixed_pool_t* pool, tb_pointer_t data)
 {
     // check
     tb_assert_and_check_return_val(pool && data, tb_null);
 
-    // make the iterator
-    tb_array_iterator_t array_iterator;
-    tb_iterator_ref_t   iterator = tb_iterator_make_for_ptr(&array_iterator, (tb_pointer_t*)pool->slot_list, pool->slot_count);
-    tb_assert(iterator);
-
-    // find it
-    tb_size_t itor = tb_binary_find_all_if(iterator, tb_fixed_pool_slot_comp, data);
-    tb_check_return_val(itor != tb_iterator_tail(iterator), tb_null);
+    // belong to the current slot?
+    if (pool->current_slot && tb_fixed_pool_slot_exists(pool->current_slot, data)) return pool->current_slot;
 
-    // the slot
-    tb_fixed_pool_slot_t* slot = pool->slot_list[itor];
-    tb_assert_and_check_return_val(slot, tb_null);
+    // find the page of this data
+    tb_fixed_pool_page_t* page = tb_fixed_pool_page_find(pool, (tb_size_t)data >> pool->page_shift);
+    tb_check_return_val(page, tb_null);
 
-    // check
-    tb_assert(tb_fixed_pool_slot_exists(slot, data));
+    // find the slot from this page
+    if (page->slots[0] && tb_fixed_pool_slot_exists(page->slots[0], data)) return page->slots[0];
+    if (page->slots[1] && tb_fixed_pool_slot_exists(page->slots[1], data)) return page->slots[1];
 
-    // ok?
-    return slot;
+    // no found
+    return tb_null;
 }
-#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -403,11 +503,11 @@ tb_void_t tb_fixed_pool_exit(tb_fixed_pool_ref_t self)
     if (pool->current_slot) tb_fixed_pool_slot_exit(pool, pool->current_slot);
     pool->current_slot = tb_null;
 
-    // exit the slot list
-    if (pool->slot_list) tb_allocator_large_free(pool->large_allocator, pool->slot_list);
-    pool->slot_list = tb_null;
-    pool->slot_count = 0;
-    pool->slot_space = 0;
+    // exit the page list
+    if (pool->page_list) tb_allocator_large_free(pool->large_allocator, pool->page_list);
+    pool->page_list = tb_null;
+    pool->page_count = 0;
+    pool->page_maxn = 0;
 
     // exit it
     tb_allocator_large_free(pool->large_allocator, pool);
@@ -498,12 +598,87 @@ tb_void_t tb_fixed_pool_clear(tb_fixed_pool_ref_t self)
     // clear item count
     pool->item_count = 0;
 
+    // clear the counters
+    pool->peak_count    = 0;
+    pool->malloc_count  = 0;
+    pool->free_count    = 0;
+
     // clear partial slots
     tb_list_entry_clear(&pool->partial_slots);
 
     // clear full slots
     tb_list_entry_clear(&pool->full_slots);
 }
+tb_void_t tb_fixed_pool_stat(tb_fixed_pool_ref_t self, tb_allocator_stat_t* stat)
+{
+    // check
+    tb_fixed_pool_t* pool = (tb_fixed_pool_t*)self;
+    tb_assert_and_check_return(pool && stat);
+
+    // get stat
+    stat->name          = "fixed";
+    stat->item_size     = pool->item_size;
+    stat->live_size     = pool->item_count * pool->item_size;
+    stat->peak_size     = pool->peak_count * pool->item_size;
+    stat->used_size     = pool->slot_space;
+    stat->malloc_count  = pool->malloc_count;
+    stat->ralloc_count  = 0;
+    stat->free_count    = pool->free_count;
+    stat->slot_count    = pool->slot_count;
+}
+tb_size_t tb_fixed_pool_trim(tb_fixed_pool_ref_t self)
+{
+    // check
+    tb_fixed_pool_t* pool = (tb_fixed_pool_t*)self;
+    tb_assert_and_check_return_val(pool, 0);
+
+    // exit the empty partial slots, .e.g the full slot with only one item will be moved here after freeing it
+    tb_size_t           size = 0;
+    tb_iterator_ref_t   partial_iterator = tb_list_entry_itor(&pool->partial_slots);
+    if (partial_iterator)
+    {
+        // walk it
+        tb_size_t itor = tb_iterator_head(partial_iterator);
+        while (itor != tb_iterator_tail(partial_iterator))
+        {
+            // the slot
+            tb_fixed_pool_slot_t* slot = (tb_fixed_pool_slot_t*)tb_iterator_item(partial_iterator, itor);
+            tb_assert_and_check_break(slot && slot->pool);
+
+            // save next
+            tb_size_t next = tb_iterator_next(partial_iterator, itor);
+
+            // exit slot if be empty
+            if (tb_static_fixed_pool_null(slot->pool))
+            {
+                size += slot->size;
+                tb_list_entry_remove(&pool->partial_slots, &slot->entry);
+                tb_fixed_pool_slot_exit(pool, slot);
+            }
+
+            // next
+            itor = next;
+        }
+    }
+
+    /* exit the current slot if be empty
+     *
+     * @note the other empty slots have been exited when freeing data, 
+     * only the current slot will be kept for the next malloc
+     */
+    if (pool->current_slot && pool->current_slot->pool && tb_static_fixed_pool_null(pool->current_slot->pool))
+    {
+        size += pool->current_slot->size;
+        tb_fixed_pool_slot_exit(pool, pool->current_slot);
+        pool->current_slot = tb_null;
+    }
+
+    // trace
+    tb_trace_d("slot[%lu]: trim: %lu bytes", pool->item_size, size);
+
+    // ok?
+    return size;
+}
 tb_pointer_t tb_fixed_pool_malloc_(tb_fixed_pool_ref_t self __tb_debug_decl__)
 {
     // check
@@ -555,6 +730,10 @@ tb_pointer_t tb_fixed_pool_malloc_(tb_fixed_pool_ref_t self __tb_debug_decl__)
 
         // update the item count
         pool->item_count++;
+        if (pool->item_count > pool->peak_count) pool->peak_count = pool->item_count;
+
+        // update the malloc count
+        pool->malloc_count++;
 
         // ok
         ok = tb_true;
@@ -638,6 +817,9 @@ tb_bool_t tb_fixed_pool_free_(tb_fixed_pool_ref_t self, tb_pointer_t data __tb_d
 
         // update the item count
         pool->item_count--;
+
+        // update the free count
+        pool->free_count++;
  
         // ok
         ok = tb_true;
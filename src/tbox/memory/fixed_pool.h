@@ -180,6 +180,21 @@ tb_size_t                   tb_fixed_pool_item_size(tb_fixed_pool_ref_t pool);
  */
 tb_void_t                   tb_fixed_pool_clear(tb_fixed_pool_ref_t pool);
 
+/*! get the stat of pool
+ *
+ * @param pool              the pool 
+ * @param stat              the stat
+ */
+tb_void_t                   tb_fixed_pool_stat(tb_fixed_pool_ref_t pool, tb_allocator_stat_t* stat);
+
+/*! trim pool and release the empty slots to the large allocator
+ *
+ * @param pool              the pool 
+ *
+ * @return                  the size of the released slots
+ */
+tb_size_t                   tb_fixed_pool_trim(tb_fixed_pool_ref_t pool);
+
 /*! malloc data
  *
  * @param pool              the pool 
@@ -77,18 +77,14 @@ typedef struct __tb_native_large_allocator_t
     // the data list
     tb_list_entry_head_t            data_list;
 
-#ifdef __tb_debug__
     // the peak size
     tb_size_t                       peak_size;
 
     // the total size
     tb_size_t                       total_size;
 
-    // the real size
-    tb_size_t                       real_size;
-
-    // the occupied size
-    tb_size_t                       occupied_size;
+    // the used size of the allocated data, includes the data heads
+    tb_size_t                       used_size;
 
     // the malloc count
     tb_size_t                       malloc_count;
@@ -98,6 +94,13 @@ typedef struct __tb_native_large_allocator_t
 
     // the free count
     tb_size_t                       free_count;
+
+#ifdef __tb_debug__
+    // the real size
+    tb_size_t                       real_size;
+
+    // the occupied size
+    tb_size_t                       occupied_size;
 #endif
 
 }tb_native_large_allocator_t, *tb_native_large_allocator_ref_t;
@@ -265,16 +268,19 @@ static tb_pointer_t tb_native_large_allocator_malloc(tb_allocator_ref_t self, tb
 
         // update the occupied size
         allocator->occupied_size += need - TB_POOL_DATA_HEAD_DIFF_SIZE - patch;
+#endif
 
         // update the total size
         allocator->total_size    += size;
 
+        // update the used size
+        allocator->used_size     += need;
+
         // update the peak size
         if (allocator->total_size > allocator->peak_size) allocator->peak_size = allocator->total_size;
 
         // update the malloc count
         allocator->malloc_count++;
-#endif
 
         // ok
         ok = tb_true;
@@ -339,13 +345,10 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
 
         // update the occupied size
         allocator->occupied_size -= base_head->size;
+#endif
  
-        // update the total size
-        allocator->total_size -= base_head->size;
-
         // the previous size
         tb_size_t prev_size = base_head->size;
-#endif
 
         // remove the data from the data_list
         tb_list_entry_remove(&allocator->data_list, &data_head->entry);
@@ -399,16 +402,21 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
 
         // update the occupied size
         allocator->occupied_size += size;
+#endif
 
         // update the total size
         allocator->total_size    += size;
+        allocator->total_size    -= prev_size;
+
+        // update the used size
+        allocator->used_size     += size;
+        allocator->used_size     -= prev_size;
 
         // update the peak size
         if (allocator->total_size > allocator->peak_size) allocator->peak_size = allocator->total_size;
 
         // update the ralloc count
         allocator->ralloc_count++;
-#endif
 
         // ok
         ok = tb_true;
@@ -436,6 +444,11 @@ static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_poin
     tb_assert_and_check_return_val(allocator && data, tb_false);
 
     // done
+#ifdef __tb_debug__
+    tb_size_t                       patch = 1; // patch 0xcc
+#else
+    tb_size_t                       patch = 0;
+#endif
     tb_bool_t                       ok = tb_false;
     tb_native_large_data_head_t*    data_head = tb_null;
     do
@@ -443,10 +456,8 @@ static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_poin
         // the data head
         data_head = &(((tb_native_large_data_head_t*)data)[-1]);
 
-#ifdef __tb_debug__
         // the base head
         tb_pool_data_head_t* base_head = tb_native_large_allocator_data_base(data_head);
-#endif
 
         // check
         tb_assertf(base_head->debug.magic != (tb_uint16_t)~TB_POOL_DATA_MAGIC, "double free data: %p", data);
@@ -466,13 +477,16 @@ static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_poin
 
         // for checking double-free
         base_head->debug.magic = (tb_uint16_t)~TB_POOL_DATA_MAGIC;
+#endif
 
         // update the total size
         allocator->total_size    -= base_head->size;
+
+        // update the used size
+        allocator->used_size     -= sizeof(tb_native_large_data_head_t) + base_head->size + patch;
    
         // update the free count
         allocator->free_count++;
-#endif
 
         // remove the data from the data_list
         tb_list_entry_remove(&allocator->data_list, &data_head->entry);
@@ -522,16 +536,49 @@ static tb_void_t tb_native_large_allocator_clear(tb_allocator_ref_t self)
     } while (0);
 
     // clear info
-#ifdef __tb_debug__
     allocator->peak_size     = 0;
     allocator->total_size    = 0;
-    allocator->real_size     = 0;
-    allocator->occupied_size = 0;
+    allocator->used_size     = 0;
     allocator->malloc_count  = 0;
     allocator->ralloc_count  = 0;
     allocator->free_count    = 0;
+#ifdef __tb_debug__
+    allocator->real_size     = 0;
+    allocator->occupied_size = 0;
 #endif
 }
+static tb_size_t tb_native_large_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_native_large_allocator_ref_t allocator = (tb_native_large_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && stats && maxn, 0);
+
+    // get stat
+    tb_allocator_stat_t* stat = &stats[0];
+    tb_memset_(stat, 0, sizeof(tb_allocator_stat_t));
+    stat->name          = "large";
+    stat->live_size     = allocator->total_size;
+    stat->peak_size     = allocator->peak_size;
+    stat->used_size     = allocator->used_size;
+    stat->malloc_count  = allocator->malloc_count;
+    stat->ralloc_count  = allocator->ralloc_count;
+    stat->free_count    = allocator->free_count;
+
+    // ok
+    return 1;
+}
+static tb_size_t tb_native_large_allocator_trim(tb_allocator_ref_t self)
+{
+    // check
+    tb_native_large_allocator_ref_t allocator = (tb_native_large_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator, 0);
+
+    /* the free data have been returned to the native memory directly, 
+     * so we only trim the native heap here and it does not report the returned size
+     */
+    tb_native_memory_trim();
+    return 0;
+}
 static tb_void_t tb_native_large_allocator_exit(tb_allocator_ref_t self)
 {
     // check
@@ -611,6 +658,8 @@ tb_allocator_ref_t tb_native_large_allocator_init()
         allocator->base.large_ralloc     = tb_native_large_allocator_ralloc;
         allocator->base.large_free       = tb_native_large_allocator_free;
         allocator->base.clear            = tb_native_large_allocator_clear;
+        allocator->base.stat             = tb_native_large_allocator_stat;
+        allocator->base.trim             = tb_native_large_allocator_trim;
         allocator->base.exit             = tb_native_large_allocator_exit;
 #ifdef __tb_debug__
         allocator->base.dump             = tb_native_large_allocator_dump;
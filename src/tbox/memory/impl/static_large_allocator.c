@@ -40,6 +40,22 @@
 // the static large allocator data size
 #define tb_static_large_allocator_data_base(data_head)   (&(((tb_pool_data_head_t*)((tb_static_large_data_head_t*)(data_head) + 1))[-1]))
 
+// the static large allocator free data links
+#define tb_static_large_allocator_data_free(data_head)   ((tb_static_large_data_free_t*)((tb_static_large_data_head_t*)(data_head) + 1))
+
+// the second level index bits
+#ifdef TB_CONFIG_MICRO_ENABLE
+#   define TB_STATIC_LARGE_ALLOCATOR_SL_BITS            (2)
+#else
+#   define TB_STATIC_LARGE_ALLOCATOR_SL_BITS            (4)
+#endif
+
+// the second level count
+#define TB_STATIC_LARGE_ALLOCATOR_SL_COUNT              (1 << TB_STATIC_LARGE_ALLOCATOR_SL_BITS)
+
+// the first level count for the 32-bits page count
+#define TB_STATIC_LARGE_ALLOCATOR_FL_COUNT              (33 - TB_STATIC_LARGE_ALLOCATOR_SL_BITS)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -53,26 +69,27 @@ typedef __tb_pool_data_aligned__ struct __tb_static_large_data_head_t
     // is free?
     tb_uint32_t                     bfree : 1;
 
+    // the data space size of the previous data, only for merging the previous free data
+    tb_uint32_t                     prev;
+
     // the data head base
     tb_byte_t                       base[sizeof(tb_pool_data_head_t)];
 
 }__tb_pool_data_aligned__ tb_static_large_data_head_t;
 
-// the static large data pred type
-typedef struct __tb_static_large_data_pred_t
+// the static large free data links type, be stored in the space of the free data
+typedef struct __tb_static_large_data_free_t
 {
-    // the data head
-    tb_static_large_data_head_t*    data_head;
+    // the next free data
+    tb_static_large_data_head_t*    next;
 
-#ifdef __tb_debug__
-    // the total count
-    tb_size_t                       total_count;
+    // the prev free data
+    tb_static_large_data_head_t*    prev;
 
-    // the failed count
-    tb_size_t                       failed_count;
-#endif
+    // have the pages of this free data been purged?
+    tb_size_t                       bpurged;
 
-}tb_static_large_data_pred_t;
+}tb_static_large_data_free_t;
 
 /*! the static large allocator type
  *
@@ -89,33 +106,28 @@ typedef struct __tb_static_large_data_pred_t
  *        --------------------------------------------------------------------------
  *                       |                       |               |
  *                       |                       `---------------`
- *                       |                        merge free space when alloc or free
+ *                       |                        merge the prev and next free space when free
  *                       |
  *        ------------------------------------------
  *       | tb_static_large_data_head_t | data space |
  *        ------------------------------------------
- *                                                
- *        --------------------------------------
- * pred: | >0KB :      4KB       | > 0*page     | 1
- *       |-----------------------|--------------
- *       | >4KB :      8KB       | > 1*page     | 2
- *       |-----------------------|--------------
- *       | >8KB :    12-16KB     | > 2*page     | 3-4
- *       |-----------------------|--------------
- *       | >16KB :   20-32KB     | > 4*page     | 5-8
- *       |-----------------------|--------------
- *       | >32KB :   36-64KB     | > 8*page     | 9-16
- *       |-----------------------|--------------
- *       | >64KB :   68-128KB    | > 16*page    | 17-32
- *       |-----------------------|--------------
- *       | >128KB :  132-256KB   | > 32*page    | 33-64
- *       |-----------------------|--------------
- *       | >256KB :  260-512KB   | > 64*page    | 65 - 128
- *       |-----------------------|--------------
- *       | >512KB :  516-1024KB  | > 128*page   | 129 - 256
- *       |-----------------------|--------------
- *       | >1024KB : 1028-...KB  | > 256*page   | 257 - ..
- *        --------------------------------------
+ *
+ * the free data are segregated by the page count (TLSF), and all operations are O(1):
+ *
+ *        ------------------------------------------------------------
+ * free: | fl: 0 | 1 - 15 pages      | sl: 16 lists for 1 page each   |
+ *       |-------|-------------------|--------------------------------|
+ *       | fl: 1 | 16 - 31 pages     | sl: 16 lists for 1 page each   |
+ *       |-------|-------------------|--------------------------------|
+ *       | fl: 2 | 32 - 63 pages     | sl: 16 lists for 2 pages each  |
+ *       |-------|-------------------|--------------------------------|
+ *       | fl: 3 | 64 - 127 pages    | sl: 16 lists for 4 pages each  |
+ *       |-------|-------------------|--------------------------------|
+ *       | ...   | ...               | ...                            |
+ *        ------------------------------------------------------------
+ *
+ * fl_bitmap:    the non-empty first levels
+ * sl_bitmap[i]: the non-empty second levels of the first level i
  *
  * </pre>
  */
@@ -136,25 +148,23 @@ typedef __tb_pool_data_aligned__ struct __tb_static_large_allocator_t
     // the data tail
     tb_static_large_data_head_t*    data_tail;
 
-    // the data pred
-#ifdef TB_CONFIG_MICRO_ENABLE
-    tb_static_large_data_pred_t     data_pred[1];
-#else
-    tb_static_large_data_pred_t     data_pred[10];
-#endif
+    // the first level bitmap of the free lists
+    tb_uint32_t                     fl_bitmap;
+
+    // the second level bitmaps of the free lists
+    tb_uint32_t                     sl_bitmap[TB_STATIC_LARGE_ALLOCATOR_FL_COUNT];
+
+    // the free lists
+    tb_static_large_data_head_t*    free_list[TB_STATIC_LARGE_ALLOCATOR_FL_COUNT][TB_STATIC_LARGE_ALLOCATOR_SL_COUNT];
 
-#ifdef __tb_debug__
     // the peak size
     tb_size_t                       peak_size;
 
     // the total size
     tb_size_t                       total_size;
 
-    // the real size
-    tb_size_t                       real_size;
-
-    // the occupied size
-    tb_size_t                       occupied_size;
+    // the used size of the allocated data, includes the data heads
+    tb_size_t                       used_size;
 
     // the malloc count
     tb_size_t                       malloc_count;
@@ -164,6 +174,13 @@ typedef __tb_pool_data_aligned__ struct __tb_static_large_allocator_t
 
     // the free count
     tb_size_t                       free_count;
+
+#ifdef __tb_debug__
+    // the real size
+    tb_size_t                       real_size;
+
+    // the occupied size
+    tb_size_t                       occupied_size;
 #endif
 
 }__tb_pool_data_aligned__ tb_static_large_allocator_t, *tb_static_large_allocator_ref_t;
@@ -218,199 +235,181 @@ static tb_void_t tb_static_large_allocator_check_next(tb_static_large_allocator_
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * malloc implementation
+ * free list implementation
  */
-static __tb_inline__ tb_size_t tb_static_large_allocator_pred_index(tb_static_large_allocator_ref_t allocator, tb_size_t space)
+static __tb_inline__ tb_void_t tb_static_large_allocator_mapping(tb_size_t pages, tb_size_t* fl, tb_size_t* sl)
 {
-#ifndef TB_CONFIG_MICRO_ENABLE
-    // the size
-    tb_size_t size = sizeof(tb_static_large_data_head_t) + space;
-    tb_assert(!(size & (allocator->page_size - 1)));
-
-    // the page count
-    size /= allocator->page_size;
- 
-    // the pred index
-#if 0
-    tb_size_t indx = tb_ilog2i(tb_align_pow2(size));
-#else
-    // faster
-    tb_size_t indx = size > 1? (tb_ilog2i((tb_uint32_t)(size - 1)) + 1) : 0;
-#endif
-    if (indx >= tb_arrayn(allocator->data_pred)) indx = tb_arrayn(allocator->data_pred) - 1;
-    return indx;
-#else
-    return 0;
-#endif
+    // the small data? uses the first level: 0
+    if (pages < TB_STATIC_LARGE_ALLOCATOR_SL_COUNT)
+    {
+        *fl = 0;
+        *sl = pages;
+    }
+    else
+    {
+        tb_size_t l = tb_ilog2i((tb_uint32_t)pages);
+        *fl = l - TB_STATIC_LARGE_ALLOCATOR_SL_BITS + 1;
+        *sl = (pages >> (l - TB_STATIC_LARGE_ALLOCATOR_SL_BITS)) ^ TB_STATIC_LARGE_ALLOCATOR_SL_COUNT;
+    }
 }
-static __tb_inline__ tb_void_t tb_static_large_allocator_pred_update(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t* data_head)
+static __tb_inline__ tb_size_t tb_static_large_allocator_pages(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t const* data_head)
 {
     // check
-    tb_assert(allocator && data_head && data_head->bfree);
-
-    // cannot be tail
-    tb_check_return(data_head != allocator->data_tail);
+    tb_assert(!((sizeof(tb_static_large_data_head_t) + data_head->space) & (allocator->page_size - 1)));
 
-    // the pred index
-    tb_size_t indx = tb_static_large_allocator_pred_index(allocator, data_head->space);
+    // the page count
+    return (sizeof(tb_static_large_data_head_t) + data_head->space) / allocator->page_size;
+}
+static __tb_inline__ tb_static_large_data_head_t* tb_static_large_allocator_next(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t const* data_head)
+{
+    // the next data head
+    tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)&(data_head[1]) + data_head->space);
 
-    // the pred head
-    tb_static_large_data_head_t* pred_head = allocator->data_pred[indx].data_head;
+    // ok?
+    return next_head < allocator->data_tail? next_head : tb_null;
+}
+static __tb_inline__ tb_static_large_data_head_t* tb_static_large_allocator_prev(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t const* data_head)
+{
+    // the first data?
+    tb_check_return_val(data_head != allocator->data_head, tb_null);
 
-    // cache this data head
-    if (!pred_head || data_head->space > pred_head->space) allocator->data_pred[indx].data_head = data_head;
+    // the prev data head
+    return (tb_static_large_data_head_t*)((tb_byte_t*)data_head - data_head->prev - sizeof(tb_static_large_data_head_t));
 }
-static __tb_inline__ tb_void_t tb_static_large_allocator_pred_remove(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t* data_head)
+static __tb_inline__ tb_void_t tb_static_large_allocator_update_next(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t const* data_head)
+{
+    // update the prev space of the next data
+    tb_static_large_data_head_t* next_head = tb_static_large_allocator_next(allocator, data_head);
+    if (next_head) next_head->prev = data_head->space;
+}
+static tb_void_t tb_static_large_allocator_free_insert(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t* data_head)
 {
     // check
-    tb_assert(allocator && data_head);
-
-    // the pred index
-    tb_size_t indx = tb_static_large_allocator_pred_index(allocator, data_head->space);
+    tb_assert(allocator && data_head && data_head->bfree);
 
-    // clear this data head
-    if (allocator->data_pred[indx].data_head == data_head) allocator->data_pred[indx].data_head = tb_null;
+    // the free list index
+    tb_size_t fl = 0;
+    tb_size_t sl = 0;
+    tb_static_large_allocator_mapping(tb_static_large_allocator_pages(allocator, data_head), &fl, &sl);
+    tb_assert(fl < TB_STATIC_LARGE_ALLOCATOR_FL_COUNT);
+
+    // insert it to the head of the free list
+    tb_static_large_data_head_t* next_head = allocator->free_list[fl][sl];
+    tb_static_large_allocator_data_free(data_head)->next = next_head;
+    tb_static_large_allocator_data_free(data_head)->prev = tb_null;
+    tb_static_large_allocator_data_free(data_head)->bpurged = 0;
+    if (next_head) tb_static_large_allocator_data_free(next_head)->prev = data_head;
+    allocator->free_list[fl][sl] = data_head;
+
+    // mark this free list
+    allocator->fl_bitmap     |= (tb_uint32_t)1 << fl;
+    allocator->sl_bitmap[fl] |= (tb_uint32_t)1 << sl;
 }
-static tb_static_large_data_head_t* tb_static_large_allocator_malloc_find(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t* data_head, tb_size_t walk_size, tb_size_t space)
+static tb_void_t tb_static_large_allocator_free_remove(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t* data_head)
 {
     // check
-    tb_assert_and_check_return_val(allocator && data_head && space, tb_null);
-
-    // the data tail
-    tb_static_large_data_head_t* data_tail = allocator->data_tail;
-    tb_check_return_val(data_head < data_tail, tb_null);
+    tb_assert(allocator && data_head && data_head->bfree);
 
-    // find the free data 
-    while ((data_head + 1) <= data_tail && walk_size)
+    // the free list index
+    tb_size_t fl = 0;
+    tb_size_t sl = 0;
+    tb_static_large_allocator_mapping(tb_static_large_allocator_pages(allocator, data_head), &fl, &sl);
+    tb_assert(fl < TB_STATIC_LARGE_ALLOCATOR_FL_COUNT);
+
+    // remove it from the free list
+    tb_static_large_data_head_t* next_head = tb_static_large_allocator_data_free(data_head)->next;
+    tb_static_large_data_head_t* prev_head = tb_static_large_allocator_data_free(data_head)->prev;
+    if (next_head) tb_static_large_allocator_data_free(next_head)->prev = prev_head;
+    if (prev_head) tb_static_large_allocator_data_free(prev_head)->next = next_head;
+    else
     {
-        // the data space size
-        tb_size_t data_space = data_head->space;
+        // check
+        tb_assert(allocator->free_list[fl][sl] == data_head);
 
-        // check the space size
-        tb_assert(!((sizeof(tb_static_large_data_head_t) + data_space) & (allocator->page_size - 1)));
-            
-#ifdef __tb_debug__
-        // check the data
-        if (!data_head->bfree) tb_static_large_allocator_check_data(allocator, data_head);
-#endif
+        // update the list head
+        allocator->free_list[fl][sl] = next_head;
 
-        // allocate if the data is free
-        if (data_head->bfree)
+        // unmark this free list if be empty
+        if (!next_head)
         {
-            // is enough?           
-            if (data_space >= space)
-            {
-                // remove this free data from the pred cache
-                tb_static_large_allocator_pred_remove(allocator, data_head);
-
-                // split it if this free data is too large
-                if (data_space > sizeof(tb_static_large_data_head_t) + space)
-                {
-                    // split this free data 
-                    tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)(data_head + 1) + space);
-                    next_head->space = data_space - space - sizeof(tb_static_large_data_head_t);
-                    next_head->bfree = 1;
-                    data_head->space = space;
- 
-                    // add next free data to the pred cache
-                    tb_static_large_allocator_pred_update(allocator, next_head);
-                }
-                else
-                {
-                    // the next data head
-                    tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)(data_head + 1) + data_space);
-            
-                    // the next data is free?
-                    if (next_head + 1 < data_tail && next_head->bfree)
-                    {
-                        // add next free data to the pred cache
-                        tb_static_large_allocator_pred_update(allocator, next_head);
-                    }
-                }
-
-                // allocate the data 
-                data_head->bfree = 0;
-
-                // return the data head
-                return data_head;
-            }
-            else // attempt to merge next free data if this free data is too small
-            {
-                // the next data head
-                tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)(data_head + 1) + data_space);
-            
-                // break if doesn't exist next data
-                tb_check_break(next_head + 1 < data_tail);
-
-                // the next data is free?
-                if (next_head->bfree)
-                {
-                    // remove next free data from the pred cache
-                    tb_static_large_allocator_pred_remove(allocator, next_head);
-
-                    // remove this free data from the pred cache
-                    tb_static_large_allocator_pred_remove(allocator, data_head);
-
-                    // trace
-                    tb_trace_d("malloc: find: merge: %lu", next_head->space);
+            allocator->sl_bitmap[fl] &= ~((tb_uint32_t)1 << sl);
+            if (!allocator->sl_bitmap[fl]) allocator->fl_bitmap &= ~((tb_uint32_t)1 << fl);
+        }
+    }
+}
+static tb_static_large_data_head_t* tb_static_large_allocator_free_find(tb_static_large_allocator_ref_t allocator, tb_size_t pages)
+{
+    // check
+    tb_assert(allocator && pages);
 
-                    // merge next data
-                    data_head->space += sizeof(tb_static_large_data_head_t) + next_head->space;
+    // round up the page count to the next free list, so all free data in it are enough
+    if (pages >= TB_STATIC_LARGE_ALLOCATOR_SL_COUNT)
+        pages += ((tb_size_t)1 << (tb_ilog2i((tb_uint32_t)pages) - TB_STATIC_LARGE_ALLOCATOR_SL_BITS)) - 1;
 
-                    // add this free data to the pred cache
-                    tb_static_large_allocator_pred_update(allocator, data_head);
+    // the free list index
+    tb_size_t fl = 0;
+    tb_size_t sl = 0;
+    tb_static_large_allocator_mapping(pages, &fl, &sl);
+    tb_check_return_val(fl < TB_STATIC_LARGE_ALLOCATOR_FL_COUNT, tb_null);
 
-                    // continue handle this data 
-                    continue ;
-                }
-            }
-        }
+    // find the non-empty free list at this first level
+    tb_uint32_t sl_map = allocator->sl_bitmap[fl] & (~(tb_uint32_t)0 << sl);
+    if (!sl_map)
+    {
+        // find the non-empty free list at the next first levels
+        tb_uint32_t fl_map = allocator->fl_bitmap & (~(tb_uint32_t)0 << (fl + 1));
+        tb_check_return_val(fl_map, tb_null);
 
-        // walk_size--
-        walk_size--;
-    
-        // skip it if the data is non-free or too small
-        data_head = (tb_static_large_data_head_t*)((tb_byte_t*)(data_head + 1) + data_space);
+        // the first level
+        fl = tb_bits_fb1_u32_le(fl_map);
+        sl_map = allocator->sl_bitmap[fl];
     }
+    tb_assert(sl_map);
+
+    // the second level
+    sl = tb_bits_fb1_u32_le(sl_map);
 
-    // failed
-    return tb_null;
+    // the free data
+    return allocator->free_list[fl][sl];
 }
-static tb_static_large_data_head_t* tb_static_large_allocator_malloc_pred(tb_static_large_allocator_ref_t allocator, tb_size_t space)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * malloc implementation
+ */
+static tb_void_t tb_static_large_allocator_split(tb_static_large_allocator_ref_t allocator, tb_static_large_data_head_t* data_head, tb_size_t space)
 {
     // check
-    tb_assert_and_check_return_val(allocator && allocator->data_head, tb_null);
+    tb_assert(allocator && data_head && data_head->space >= space);
 
-    // walk the pred cache
-    tb_size_t                       indx = tb_static_large_allocator_pred_index(allocator, space);
-    tb_size_t                       size = tb_arrayn(allocator->data_pred);
-    tb_static_large_data_pred_t*    pred = allocator->data_pred;
-    tb_static_large_data_head_t*    data_head = tb_null;
-    tb_static_large_data_head_t*    pred_head = tb_null;
-    for (; indx < size && !data_head; indx++)
+    // too small to split it?
+    tb_check_return(data_head->space > sizeof(tb_static_large_data_head_t) + space);
+
+    // split the left free data
+    tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)(data_head + 1) + space);
+    next_head->space = data_head->space - space - sizeof(tb_static_large_data_head_t);
+    next_head->bfree = 1;
+    next_head->prev  = (tb_uint32_t)space;
+    data_head->space = space;
+
+    // merge the next free data of the left data
+    tb_static_large_data_head_t* free_head = tb_static_large_allocator_next(allocator, next_head);
+    if (free_head && free_head->bfree)
     {
-        // the pred data head
-        pred_head = pred[indx].data_head;
-        if (pred_head) 
-        {
-            // find the free data from the pred data head 
-            data_head = tb_static_large_allocator_malloc_find(allocator, pred_head, 1, space);
+        // remove it from the free list
+        tb_static_large_allocator_free_remove(allocator, free_head);
 
-#ifdef __tb_debug__
-            // update the total count
-            pred[indx].total_count++;
+        // trace
+        tb_trace_d("split: merge: %lu", free_head->space);
 
-            // update the failed count
-            if (!data_head) pred[indx].failed_count++;
-#endif
-        }
+        // merge it
+        next_head->space += sizeof(tb_static_large_data_head_t) + free_head->space;
     }
-   
-    // trace
-    tb_trace_d("malloc: pred: %lu: %s", space, data_head? "ok" : "no");
 
-    // ok?
-    return data_head;
+    // update the prev space of the next data
+    tb_static_large_allocator_update_next(allocator, next_head);
+
+    // add the left free data to the free list
+    tb_static_large_allocator_free_insert(allocator, next_head);
 }
 static tb_static_large_data_head_t* tb_static_large_allocator_malloc_done(tb_static_large_allocator_ref_t allocator, tb_size_t size, tb_size_t* real __tb_debug_decl__)
 {
@@ -433,16 +432,26 @@ static tb_static_large_data_head_t* tb_static_large_allocator_malloc_done(tb_sta
         tb_size_t need_space = tb_align(size + patch, allocator->page_size) - sizeof(tb_static_large_data_head_t);
         if (size + patch > need_space) need_space = tb_align(size + patch + allocator->page_size, allocator->page_size) - sizeof(tb_static_large_data_head_t);
 
-        // attempt to predict the free data first
-        data_head = tb_static_large_allocator_malloc_pred(allocator, need_space);
-        if (!data_head)
-        {
-            // find the free data from the first data head 
-            data_head = tb_static_large_allocator_malloc_find(allocator, allocator->data_head, -1, need_space);
-            tb_check_break(data_head);
-        }
+        // find the free data from the free lists
+        data_head = tb_static_large_allocator_free_find(allocator, (sizeof(tb_static_large_data_head_t) + need_space) / allocator->page_size);
+        tb_check_break(data_head);
+        tb_assert(data_head->bfree && data_head->space >= need_space);
+
+        // remove it from the free list
+        tb_static_large_allocator_free_remove(allocator, data_head);
+
+        // split it if this free data is too large
+        tb_static_large_allocator_split(allocator, data_head, need_space);
+
+        // allocate the data
+        data_head->bfree = 0;
         tb_assert(data_head->space >= size + patch);
 
+#ifdef __tb_debug__
+        // check the next data
+        tb_static_large_allocator_check_next(allocator, data_head);
+#endif
+
         // the base head
         tb_pool_data_head_t* base_head = tb_static_large_allocator_data_base(data_head);
 
@@ -468,22 +477,25 @@ static tb_static_large_data_head_t* tb_static_large_allocator_malloc_done(tb_sta
 
         // make the dirty data and patch 0xcc for checking underflow
         tb_memset_((tb_pointer_t)&(data_head[1]), TB_POOL_DATA_PATCH, size_real + patch);
- 
+
         // update the real size
         allocator->real_size     += base_head->size;
 
         // update the occupied size
         allocator->occupied_size += sizeof(tb_static_large_data_head_t) + data_head->space - 1 - TB_POOL_DATA_HEAD_DIFF_SIZE;
+#endif
 
         // update the total size
         allocator->total_size    += base_head->size;
 
+        // update the used size
+        allocator->used_size     += sizeof(tb_static_large_data_head_t) + data_head->space;
+
         // update the peak size
         if (allocator->total_size > allocator->peak_size) allocator->peak_size = allocator->total_size;
 
         // update the malloc count
         allocator->malloc_count++;
-#endif
 
         // ok
         ok = tb_true;
@@ -514,6 +526,10 @@ static tb_static_large_data_head_t* tb_static_large_allocator_ralloc_fast(tb_sta
 #ifdef __tb_debug__
         // patch 0xcc
         tb_size_t patch = 1;
+#else
+        // no patch
+        tb_size_t patch = 0;
+#endif
 
         // the prev size
         tb_size_t prev_size = base_head->size;
@@ -521,11 +537,6 @@ static tb_static_large_data_head_t* tb_static_large_allocator_ralloc_fast(tb_sta
         // the prev space
         tb_size_t prev_space = data_head->space;
 
-#else
-        // no patch
-        tb_size_t patch = 0;
-#endif
-
         // compile the need space for the page alignment
         tb_size_t need_space = tb_align(size + patch, allocator->page_size) - sizeof(tb_static_large_data_head_t);
         if (size + patch > need_space) need_space = tb_align(size + patch + allocator->page_size, allocator->page_size) - sizeof(tb_static_large_data_head_t);
@@ -533,41 +544,29 @@ static tb_static_large_data_head_t* tb_static_large_allocator_ralloc_fast(tb_sta
         // this data space is not enough?
         if (need_space > data_head->space)
         {
-            // attempt to merge the next free data
-            tb_static_large_data_head_t* data_tail = allocator->data_tail;
-            tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)&(data_head[1]) + data_head->space);
-            while (next_head < data_tail && next_head->bfree) 
-            {
-                // remove next free data from the pred cache
-                tb_static_large_allocator_pred_remove(allocator, next_head);
-
-                // trace
-                tb_trace_d("ralloc: fast: merge: %lu", next_head->space);
+            /* attempt to merge the next free data if it is enough
+             *
+             * @note the adjacent free data have been merged, so there is only one next free data at most
+             */
+            tb_static_large_data_head_t* next_head = tb_static_large_allocator_next(allocator, data_head);
+            tb_check_break(next_head && next_head->bfree && data_head->space + sizeof(tb_static_large_data_head_t) + next_head->space >= need_space);
 
-                // merge it
-                data_head->space += sizeof(tb_static_large_data_head_t) + next_head->space;
+            // remove next free data from the free list
+            tb_static_large_allocator_free_remove(allocator, next_head);
 
-                // the next data head
-                next_head = (tb_static_large_data_head_t*)((tb_byte_t*)&(data_head[1]) + data_head->space);
-            }
-        }
+            // trace
+            tb_trace_d("ralloc: fast: merge: %lu", next_head->space);
 
-        // enough?
-        tb_check_break(need_space <= data_head->space);
+            // merge it
+            data_head->space += sizeof(tb_static_large_data_head_t) + next_head->space;
 
-        // split it if this data is too large after merging 
-        if (data_head->space > sizeof(tb_static_large_data_head_t) + need_space)
-        {
-            // split this free data 
-            tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)(data_head + 1) + need_space);
-            next_head->space = data_head->space - need_space - sizeof(tb_static_large_data_head_t);
-            next_head->bfree = 1;
-            data_head->space = need_space;
-
-            // add next free data to the pred cache
-            tb_static_large_allocator_pred_update(allocator, next_head);
+            // update the prev space of the next data
+            tb_static_large_allocator_update_next(allocator, data_head);
         }
 
+        // split it if this data is too large after merging
+        tb_static_large_allocator_split(allocator, data_head, need_space);
+
         // the real size
         tb_size_t size_real = real? (data_head->space - patch) : size;
 
@@ -588,12 +587,12 @@ static tb_static_large_data_head_t* tb_static_large_allocator_ralloc_fast(tb_sta
         // save backtrace
         tb_pool_data_save_backtrace(&base_head->debug, skip_nframe);
 
-        // make the dirty data 
+        // make the dirty data
         if (size_real > prev_size) tb_memset_((tb_byte_t*)&(data_head[1]) + prev_size, TB_POOL_DATA_PATCH, size_real - prev_size);
 
         // patch 0xcc for checking underflow
         ((tb_byte_t*)&(data_head[1]))[size_real] = TB_POOL_DATA_PATCH;
- 
+
         // update the real size
         allocator->real_size     += size_real;
         allocator->real_size     -= prev_size;
@@ -601,14 +600,18 @@ static tb_static_large_data_head_t* tb_static_large_allocator_ralloc_fast(tb_sta
         // update the occupied size
         allocator->occupied_size += data_head->space;
         allocator->occupied_size -= prev_space;
+#endif
 
         // update the total size
         allocator->total_size    += size_real;
         allocator->total_size    -= prev_size;
 
+        // update the used size
+        allocator->used_size     += data_head->space;
+        allocator->used_size     -= prev_space;
+
         // update the peak size
         if (allocator->total_size > allocator->peak_size) allocator->peak_size = allocator->total_size;
-#endif
 
         // ok
         ok = tb_true;
@@ -638,10 +641,8 @@ static tb_bool_t tb_static_large_allocator_free(tb_allocator_ref_t self, tb_poin
         // the data head
         data_head = &(((tb_static_large_data_head_t*)data)[-1]);
 
-#ifdef __tb_debug__
         // the base head
         tb_pool_data_head_t* base_head = tb_static_large_allocator_data_base(data_head);
-#endif
 
         // check
         tb_assertf_and_check_break(!data_head->bfree, "double free data: %p", data);
@@ -652,36 +653,57 @@ static tb_bool_t tb_static_large_allocator_free(tb_allocator_ref_t self, tb_poin
 #ifdef __tb_debug__
         // check the next data
         tb_static_large_allocator_check_next(allocator, data_head);
+#endif
 
         // update the total size
         allocator->total_size -= base_head->size;
 
+        // update the used size
+        allocator->used_size  -= sizeof(tb_static_large_data_head_t) + data_head->space;
+
         // update the free count
         allocator->free_count++;
-#endif
 
         // trace
         tb_trace_d("free: %lu: %s", base_head->size, ok? "ok" : "no");
 
+        // free it
+        data_head->bfree = 1;
+
         // attempt merge the next free data
-        tb_static_large_data_head_t* next_head = (tb_static_large_data_head_t*)((tb_byte_t*)&(data_head[1]) + data_head->space);
-        if (next_head < allocator->data_tail && next_head->bfree) 
+        tb_static_large_data_head_t* next_head = tb_static_large_allocator_next(allocator, data_head);
+        if (next_head && next_head->bfree)
         {
-            // remove next free data from the pred cache
-            tb_static_large_allocator_pred_remove(allocator, next_head);
+            // remove next free data from the free list
+            tb_static_large_allocator_free_remove(allocator, next_head);
 
             // trace
-            tb_trace_d("free: merge: %lu", next_head->space);
+            tb_trace_d("free: merge: next: %lu", next_head->space);
 
             // merge it
             data_head->space += sizeof(tb_static_large_data_head_t) + next_head->space;
         }
 
-        // free it
-        data_head->bfree = 1;
+        // attempt merge the prev free data
+        tb_static_large_data_head_t* prev_head = tb_static_large_allocator_prev(allocator, data_head);
+        if (prev_head && prev_head->bfree)
+        {
+            // remove prev free data from the free list
+            tb_static_large_allocator_free_remove(allocator, prev_head);
+
+            // trace
+            tb_trace_d("free: merge: prev: %lu", prev_head->space);
+
+            // merge it
+            prev_head->space += sizeof(tb_static_large_data_head_t) + data_head->space;
+            data_head = prev_head;
+        }
+
+        // update the prev space of the next data
+        tb_static_large_allocator_update_next(allocator, data_head);
 
-        // add this free data to the pred cache
-        tb_static_large_allocator_pred_update(allocator, data_head);
+        // add this free data to the free list
+        tb_static_large_allocator_free_insert(allocator, data_head);
 
         // ok
         ok = tb_true;
@@ -757,10 +779,8 @@ static tb_pointer_t tb_static_large_allocator_ralloc(tb_allocator_ref_t self, tb
         // the real data
         data_real = (tb_byte_t*)&aloc_head[1];
 
-#ifdef __tb_debug__
         // update the ralloc count
         allocator->ralloc_count++;
-#endif
 
         // ok
         ok = tb_true;
@@ -784,25 +804,95 @@ static tb_void_t tb_static_large_allocator_clear(tb_allocator_ref_t self)
 
     // clear it
     allocator->data_head->bfree = 1;
+    allocator->data_head->prev  = 0;
     allocator->data_head->space = allocator->data_size - sizeof(tb_static_large_data_head_t);
 
-    // clear the pred cache
-    tb_memset_(allocator->data_pred, 0, sizeof(allocator->data_pred));
- 
-    // add this free data to the pred cache
-    tb_static_large_allocator_pred_update(allocator, allocator->data_head);
+    // clear the free lists
+    allocator->fl_bitmap = 0;
+    tb_memset_(allocator->sl_bitmap, 0, sizeof(allocator->sl_bitmap));
+    tb_memset_(allocator->free_list, 0, sizeof(allocator->free_list));
+
+    // add this free data to the free list
+    tb_static_large_allocator_free_insert(allocator, allocator->data_head);
 
     // clear info
-#ifdef __tb_debug__
     allocator->peak_size     = 0;
     allocator->total_size    = 0;
-    allocator->real_size     = 0;
-    allocator->occupied_size = 0;
+    allocator->used_size     = 0;
     allocator->malloc_count  = 0;
     allocator->ralloc_count  = 0;
     allocator->free_count    = 0;
+#ifdef __tb_debug__
+    allocator->real_size     = 0;
+    allocator->occupied_size = 0;
 #endif
 }
+static tb_size_t tb_static_large_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_static_large_allocator_ref_t allocator = (tb_static_large_allocator_t*)self;
+    tb_assert_and_check_return_val(allocator && stats && maxn, 0);
+
+    // get stat
+    tb_allocator_stat_t* stat = &stats[0];
+    tb_memset_(stat, 0, sizeof(tb_allocator_stat_t));
+    stat->name          = "large";
+    stat->live_size     = allocator->total_size;
+    stat->peak_size     = allocator->peak_size;
+    stat->used_size     = allocator->used_size;
+    stat->malloc_count  = allocator->malloc_count;
+    stat->ralloc_count  = allocator->ralloc_count;
+    stat->free_count    = allocator->free_count;
+
+    // ok
+    return 1;
+}
+static tb_size_t tb_static_large_allocator_trim(tb_allocator_ref_t self)
+{
+    // check
+    tb_static_large_allocator_ref_t allocator = (tb_static_large_allocator_t*)self;
+    tb_assert_and_check_return_val(allocator, 0);
+
+    // purge the free pages of all free data, the head and the free links of them will be kept
+    tb_size_t size = 0;
+    tb_size_t fl = 0;
+    tb_size_t sl = 0;
+    for (fl = 0; fl < TB_STATIC_LARGE_ALLOCATOR_FL_COUNT; fl++)
+    {
+        // this first level is empty?
+        tb_check_continue(allocator->fl_bitmap & ((tb_uint32_t)1 << fl));
+
+        for (sl = 0; sl < TB_STATIC_LARGE_ALLOCATOR_SL_COUNT; sl++)
+        {
+            tb_static_large_data_head_t* free_head = allocator->free_list[fl][sl];
+            while (free_head)
+            {
+                // the free links
+                tb_static_large_data_free_t* data_free = tb_static_large_allocator_data_free(free_head);
+
+                /* purge it if not been purged
+                 *
+                 * @note the merged or split free data will be re-inserted to the free list and purged again
+                 */
+                if (!data_free->bpurged)
+                {
+                    tb_byte_t* data = (tb_byte_t*)&data_free[1];
+                    size += tb_native_memory_purge(data, (tb_byte_t*)&free_head[1] + free_head->space - data);
+                    data_free->bpurged = 1;
+                }
+
+                // the next free data
+                free_head = data_free->next;
+            }
+        }
+    }
+
+    // trace
+    tb_trace_d("trim: %lu bytes", size);
+
+    // ok?
+    return size;
+}
 static tb_void_t tb_static_large_allocator_exit(tb_allocator_ref_t self)
 {
     // check
@@ -857,17 +947,33 @@ static tb_void_t tb_static_large_allocator_dump(tb_allocator_ref_t self)
     // trace
     tb_trace_i("");
 
-    // trace pred info
-    tb_size_t i = 0;
-    tb_size_t pred_size = tb_arrayn(allocator->data_pred);
-    for (i = 0; i < pred_size; i++)
+    // trace the free lists info
+    tb_size_t fl = 0;
+    tb_size_t sl = 0;
+    for (fl = 0; fl < TB_STATIC_LARGE_ALLOCATOR_FL_COUNT; fl++)
     {
-        // the pred info
-        tb_static_large_data_pred_t const* pred = &allocator->data_pred[i];
-        tb_assert_and_check_break(pred);
+        for (sl = 0; sl < TB_STATIC_LARGE_ALLOCATOR_SL_COUNT; sl++)
+        {
+            // the free list
+            tb_static_large_data_head_t* free_head = allocator->free_list[fl][sl];
+            tb_check_continue(free_head);
+
+            // the free count and space
+            tb_size_t free_count = 0;
+            tb_size_t free_space = 0;
+            while (free_head)
+            {
+                free_count++;
+                free_space += free_head->space;
+                free_head = tb_static_large_allocator_data_free(free_head)->next;
+            }
 
-        // trace
-        tb_trace_i("pred[>%04luKB]: data: %p, space: %lu, total_count: %lu, failed_count: %lu", ((allocator->page_size << (i - 1)) >> 10), pred->data_head? &pred->data_head[1] : tb_null, pred->data_head? pred->data_head->space : 0, pred->total_count, pred->failed_count);
+            // the minimum page count of this free list
+            tb_size_t pages = fl? ((TB_STATIC_LARGE_ALLOCATOR_SL_COUNT + sl) << (fl - 1)) : sl;
+
+            // trace
+            tb_trace_i("free[>=%04luKB]: count: %lu, space: %lu", (pages * allocator->page_size) >> 10, free_count, free_space);
+        }
     }
 
     // trace
@@ -918,6 +1024,8 @@ tb_allocator_ref_t tb_static_large_allocator_init(tb_byte_t* data, tb_size_t siz
     allocator->base.large_ralloc     = tb_static_large_allocator_ralloc;
     allocator->base.large_free       = tb_static_large_allocator_free;
     allocator->base.clear            = tb_static_large_allocator_clear;
+    allocator->base.stat             = tb_static_large_allocator_stat;
+    allocator->base.trim             = tb_static_large_allocator_trim;
     allocator->base.exit             = tb_static_large_allocator_exit;
 #ifdef __tb_debug__
     allocator->base.dump             = tb_static_large_allocator_dump;
@@ -930,9 +1038,9 @@ tb_allocator_ref_t tb_static_large_allocator_init(tb_byte_t* data, tb_size_t siz
     // init page_size
     allocator->page_size = pagesize? pagesize : tb_page_size();
 
-    // page_size must be larger than sizeof(tb_static_large_data_head_t)
-    if (allocator->page_size < sizeof(tb_static_large_data_head_t))
-        allocator->page_size += sizeof(tb_static_large_data_head_t);
+    // page_size must be larger than sizeof(tb_static_large_data_head_t) + the free data links
+    if (allocator->page_size < sizeof(tb_static_large_data_head_t) + sizeof(tb_static_large_data_free_t))
+        allocator->page_size += sizeof(tb_static_large_data_head_t) + sizeof(tb_static_large_data_free_t);
 
     // page_size must be aligned 
     allocator->page_size = tb_align_pow2(allocator->page_size);
@@ -949,15 +1057,16 @@ tb_allocator_ref_t tb_static_large_allocator_init(tb_byte_t* data, tb_size_t siz
     // init data head 
     allocator->data_head = (tb_static_large_data_head_t*)&allocator[1];
     allocator->data_head->bfree = 1;
+    allocator->data_head->prev  = 0;
     allocator->data_head->space = allocator->data_size - sizeof(tb_static_large_data_head_t);
     tb_assert_and_check_return_val(!((tb_size_t)allocator->data_head & (TB_POOL_DATA_ALIGN - 1)), tb_null);
- 
-    // add this free data to the pred cache
-    tb_static_large_allocator_pred_update(allocator, allocator->data_head);
 
     // init data tail
     allocator->data_tail = (tb_static_large_data_head_t*)((tb_byte_t*)&allocator->data_head[1] + allocator->data_head->space);
 
+    // add this free data to the free list
+    tb_static_large_allocator_free_insert(allocator, allocator->data_head);
+
     // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
     tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&allocator->base.lock, TB_TRACE_MODULE_NAME);
@@ -41,6 +41,8 @@
 #include "native_allocator.h"
 #include "static_allocator.h"
 #include "default_allocator.h"
+#include "cache_allocator.h"
+#include "arena_allocator.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * description
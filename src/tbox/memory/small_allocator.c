@@ -54,6 +54,21 @@ typedef struct __tb_small_allocator_t
     // the fixed pool
     tb_fixed_pool_ref_t     fixed_pool[12];
 
+    // the live size
+    tb_size_t               live_size;
+
+    // the peak size
+    tb_size_t               peak_size;
+
+    // the malloc count
+    tb_size_t               malloc_count;
+
+    // the ralloc count
+    tb_size_t               ralloc_count;
+
+    // the free count
+    tb_size_t               free_count;
+
 }tb_small_allocator_t, *tb_small_allocator_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -237,6 +252,73 @@ static tb_void_t tb_small_allocator_clear(tb_allocator_ref_t self)
         // clear it
         if (allocator->fixed_pool[i]) tb_fixed_pool_clear(allocator->fixed_pool[i]);
     }
+
+    // clear the counters
+    allocator->live_size    = 0;
+    allocator->peak_size    = 0;
+    allocator->malloc_count = 0;
+    allocator->ralloc_count = 0;
+    allocator->free_count   = 0;
+}
+static tb_size_t tb_small_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_t* stats, tb_size_t maxn)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && stats && maxn, 0);
+
+    // init the stat of this allocator
+    tb_allocator_stat_t* stat = &stats[0];
+    tb_memset_(stat, 0, sizeof(tb_allocator_stat_t));
+    stat->name          = "small";
+    stat->live_size     = allocator->live_size;
+    stat->peak_size     = allocator->peak_size;
+    stat->malloc_count  = allocator->malloc_count;
+    stat->ralloc_count  = allocator->ralloc_count;
+    stat->free_count    = allocator->free_count;
+
+    // get the stats of all size classes
+    tb_size_t i = 0;
+    tb_size_t k = 1;
+    tb_size_t n = tb_arrayn(allocator->fixed_pool);
+    for (i = 0; i < n; i++)
+    {
+        // the fixed pool
+        tb_fixed_pool_ref_t fixed_pool = allocator->fixed_pool[i];
+        tb_check_continue(fixed_pool);
+
+        // get the stat of this size class
+        tb_allocator_stat_t item = {0};
+        tb_fixed_pool_stat(fixed_pool, &item);
+        item.name = "small";
+
+        // update the stat of this allocator
+        stat->used_size  += item.used_size;
+        stat->slot_count += item.slot_count;
+
+        // save it
+        if (k < maxn) stats[k++] = item;
+    }
+
+    // ok
+    return k;
+}
+static tb_size_t tb_small_allocator_trim(tb_allocator_ref_t self)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator, 0);
+
+    // release the empty slots of all fixed pools to the large allocator
+    tb_size_t i = 0;
+    tb_size_t n = tb_arrayn(allocator->fixed_pool);
+    for (i = 0; i < n; i++)
+    {
+        // trim it
+        if (allocator->fixed_pool[i]) tb_fixed_pool_trim(allocator->fixed_pool[i]);
+    }
+
+    // return the free pages to the system
+    return tb_allocator_trim(allocator->large_allocator);
 }
 static tb_pointer_t tb_small_allocator_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
 {
@@ -269,6 +351,11 @@ static tb_pointer_t tb_small_allocator_malloc(tb_allocator_ref_t self, tb_size_t
         // update size
         data_head->size = size;
 
+        // update the live size and the malloc count
+        allocator->live_size += size;
+        if (allocator->live_size > allocator->peak_size) allocator->peak_size = allocator->live_size;
+        allocator->malloc_count++;
+
     } while (0);
 
     // check
@@ -314,6 +401,11 @@ static tb_pointer_t tb_small_allocator_ralloc(tb_allocator_ref_t self, tb_pointe
             // fill the patch bytes
             if (data_head_old->size > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, data_head_old->size - size);
 #endif
+            // update the live size
+            allocator->live_size = allocator->live_size - data_head_old->size + size;
+            if (allocator->live_size > allocator->peak_size) allocator->peak_size = allocator->live_size;
+            allocator->ralloc_count++;
+
             // only update size
             data_head_old->size = size;
 
@@ -341,6 +433,11 @@ static tb_pointer_t tb_small_allocator_ralloc(tb_allocator_ref_t self, tb_pointe
         // copy the old data
         tb_memcpy_(data_new, data, tb_min(data_head_old->size, size));
 
+        // update the live size
+        allocator->live_size = allocator->live_size - data_head_old->size + size;
+        if (allocator->live_size > allocator->peak_size) allocator->peak_size = allocator->live_size;
+        allocator->ralloc_count++;
+
         // free the old data
         tb_fixed_pool_free_(fixed_pool_old, data __tb_debug_args__);
 
@@ -374,8 +471,16 @@ static tb_bool_t tb_small_allocator_free(tb_allocator_ref_t self, tb_pointer_t d
         // check underflow
         tb_assertf(space == data_head->size || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
 
+        // the data size
+        tb_size_t size = data_head->size;
+
         // done
         ok = tb_fixed_pool_free_(fixed_pool, data __tb_debug_args__);
+        tb_check_break(ok);
+
+        // update the live size and the free count
+        allocator->live_size -= size;
+        allocator->free_count++;
 
     } while (0);
 
@@ -445,6 +550,8 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->base.ralloc          = tb_small_allocator_ralloc;
         allocator->base.free            = tb_small_allocator_free;
         allocator->base.clear           = tb_small_allocator_clear;
+        allocator->base.stat            = tb_small_allocator_stat;
+        allocator->base.trim            = tb_small_allocator_trim;
         allocator->base.exit            = tb_small_allocator_exit;
 #ifdef __tb_debug__
         allocator->base.dump            = tb_small_allocator_dump;
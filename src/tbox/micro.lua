@@ -51,6 +51,7 @@ target("tbox")
     add_files("libc/stdlib/stdlib.c") 
     add_files("libc/impl/libc.c") 
     add_files("libm/impl/libm.c") 
+    add_files("libm/ilog2i.c") 
     add_files("math/impl/math.c") 
     add_files("utils/used.c") 
     add_files("utils/bits.c") 
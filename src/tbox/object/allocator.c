@@ -0,0 +1,148 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        allocator.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "oc_allocator"
+#define TB_TRACE_MODULE_DEBUG       (0)
+ 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "object.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the stats maxn
+#define TB_OC_ALLOCATOR_STAT_MAXN       (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_object_ref_t tb_oc_allocator_stat_dict(tb_allocator_stat_t const* stat)
+{
+    // check
+    tb_assert_and_check_return_val(stat, tb_null);
+
+    // make dictionary
+    tb_object_ref_t dict = tb_oc_dictionary_init(TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
+    tb_assert_and_check_return_val(dict, tb_null);
+
+    // the fragmentation rate
+    tb_size_t frag_rate = (stat->used_size > stat->live_size)? (tb_size_t)((((tb_hize_t)stat->used_size - stat->live_size) * 10000) / (tb_hize_t)stat->used_size) : 0;
+
+    // insert the stat info
+    if (stat->item_size) tb_oc_dictionary_insert(dict, "item_size", tb_oc_number_init_from_uint64(stat->item_size));
+    tb_oc_dictionary_insert(dict, "live_size",      tb_oc_number_init_from_uint64(stat->live_size));
+    tb_oc_dictionary_insert(dict, "peak_size",      tb_oc_number_init_from_uint64(stat->peak_size));
+    tb_oc_dictionary_insert(dict, "used_size",      tb_oc_number_init_from_uint64(stat->used_size));
+    tb_oc_dictionary_insert(dict, "malloc_count",   tb_oc_number_init_from_uint64(stat->malloc_count));
+    tb_oc_dictionary_insert(dict, "ralloc_count",   tb_oc_number_init_from_uint64(stat->ralloc_count));
+    tb_oc_dictionary_insert(dict, "free_count",     tb_oc_number_init_from_uint64(stat->free_count));
+    tb_oc_dictionary_insert(dict, "slot_count",     tb_oc_number_init_from_uint64(stat->slot_count));
+    tb_oc_dictionary_insert(dict, "frag_rate",      tb_oc_number_init_from_uint64(frag_rate));
+
+    // ok
+    return dict;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_object_ref_t tb_oc_allocator_stat(tb_allocator_ref_t allocator)
+{
+    // check
+    tb_assert_and_check_return_val(allocator, tb_null);
+
+    /* get the stats
+     *
+     * @note we get them into the stack first and make the objects after leaving the allocator lock,
+     * because the objects may be allocated from this allocator.
+     */
+    tb_allocator_stat_t stats[TB_OC_ALLOCATOR_STAT_MAXN];
+    tb_size_t           count = tb_allocator_stat(allocator, stats, tb_arrayn(stats));
+
+    // make dictionary
+    tb_object_ref_t dict = tb_oc_dictionary_init(TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
+    tb_assert_and_check_return_val(dict, tb_null);
+
+    // done
+    tb_size_t       i = 0;
+    tb_size_t       index = 0;
+    tb_char_t       key[64];
+    tb_object_ref_t owner = tb_null;
+    tb_object_ref_t classes = tb_null;
+    for (i = 0; i < count; i++)
+    {
+        // make the stat object
+        tb_allocator_stat_t const*  stat = &stats[i];
+        tb_object_ref_t             item = tb_oc_allocator_stat_dict(stat);
+        tb_assert_and_check_continue(item);
+
+        // the size class? append it to the classes of the owner allocator
+        if (stat->item_size && owner)
+        {
+            // init classes
+            if (!classes)
+            {
+                classes = tb_oc_array_init(0, tb_false);
+                if (classes) tb_oc_dictionary_insert(owner, "classes", classes);
+            }
+
+            // append it
+            if (classes) tb_oc_array_append(classes, item);
+            else tb_object_exit(item);
+        }
+        else
+        {
+            // the allocator name
+            tb_char_t const* name = stat->name? stat->name : "unknown";
+            tb_oc_dictionary_insert(item, "name", tb_oc_string_init_from_cstr(name));
+
+            /* insert the allocator stat
+             *
+             * the allocators may have the same name, so the later one is keyed by name#index
+             */
+            if (tb_oc_dictionary_value(dict, name))
+            {
+                tb_snprintf(key, sizeof(key), "%s#%lu", name, index);
+                name = key;
+            }
+            tb_oc_dictionary_insert(dict, name, item);
+            index++;
+
+            // update the owner allocator
+            owner   = item;
+            classes = tb_null;
+        }
+    }
+
+    // ok
+    return dict;
+}
@@ -0,0 +1,94 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        allocator.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_ALLOCATOR_H
+#define TB_OBJECT_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! get the allocator stats as a dictionary object
+ *
+ * <pre>
+ *
+ * {
+ *     "small": 
+ *     {
+ *         "name": "small"
+ *     ,   "live_size": 1024
+ *     ,   "peak_size": 4096
+ *     ,   "used_size": 65536
+ *     ,   "malloc_count": 100
+ *     ,   "ralloc_count": 10
+ *     ,   "free_count": 90
+ *     ,   "slot_count": 2
+ *     ,   "frag_rate": 9843 (/10000)
+ *     ,   "classes": 
+ *         [
+ *             {"item_size": 16, "live_size": 512, ...}
+ *         ,   {"item_size": 32, "live_size": 512, ...}
+ *         ,   ...
+ *         ]
+ *     }
+ * ,   "large": 
+ *     {
+ *         ...
+ *     }
+ * ,   "large#2": 
+ *     {
+ *         "name": "large"
+ *     ,   ...
+ *     }
+ * }
+ *
+ * </pre>
+ *
+ * the allocator stat is keyed by its name, or by name#index if the name has been used by the previous allocator.
+ *
+ * @param allocator     the allocator
+ *
+ * @return              the dictionary object, need be exited by tb_object_exit()
+ */
+tb_object_ref_t         tb_oc_allocator_stat(tb_allocator_ref_t allocator);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
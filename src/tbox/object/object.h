@@ -38,6 +38,7 @@
 #include "number.h"
 #include "boolean.h"
 #include "dictionary.h"
+#include "allocator.h"
 #ifdef TB_CONFIG_API_HAVE_DEPRECATED
 #   include "deprecated/deprecated.h"
 #endif
@@ -117,6 +117,16 @@ tb_hize_t tb_file_size(tb_file_ref_t file)
     tb_trace_noimpl();
     return 0;
 }
+tb_byte_t const* tb_file_map(tb_file_ref_t file, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return tb_null;
+}
+tb_bool_t tb_file_unmap(tb_byte_t const* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
 tb_bool_t tb_file_info(tb_char_t const* path, tb_file_info_t* info)
 {
     tb_trace_noimpl();
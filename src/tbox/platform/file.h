@@ -255,6 +255,26 @@ tb_hize_t               tb_file_size(tb_file_ref_t file);
  */
 tb_hong_t               tb_file_offset(tb_file_ref_t file);
 
+/*! map the file data to the read-only memory
+ *
+ * the mapped pages are loaded lazily and shared by all processes which map the same file
+ * 
+ * @param file          the file 
+ * @param size          the mapped size from the file head
+ *
+ * @return              the mapped data, return tb_null if failed or not supported
+ */
+tb_byte_t const*        tb_file_map(tb_file_ref_t file, tb_size_t size);
+
+/*! unmap the file data
+ * 
+ * @param data          the mapped data from tb_file_map()
+ * @param size          the mapped size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_file_unmap(tb_byte_t const* data, tb_size_t size);
+
 /*! the file info for file or directory
  * 
  * @param file          the file handle
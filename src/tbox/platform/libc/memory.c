@@ -28,7 +28,14 @@
  */
 #include "prefix.h"
 #include "../memory.h"
+#include "../page.h"
 #include <stdlib.h>
+#ifdef TB_CONFIG_LIBC_HAVE_MALLOC_TRIM
+#   include <malloc.h>
+#endif
+#if defined(TB_CONFIG_POSIX_HAVE_MADVISE) || defined(TB_CONFIG_POSIX_HAVE_MMAP)
+#   include <sys/mman.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -93,4 +100,94 @@ tb_bool_t tb_native_memory_free(tb_pointer_t data)
     // ok
     return tb_true;
 }
+tb_size_t tb_native_memory_purge(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data && size, 0);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MADVISE
+    // the page size
+    tb_size_t page_size = tb_page_size();
+    tb_assert_and_check_return_val(page_size, 0);
+
+    // the whole pages in this range
+    tb_size_t head = tb_align((tb_size_t)data, page_size);
+    tb_size_t tail = ((tb_size_t)data + size) & ~(page_size - 1);
+    tb_check_return_val(head < tail, 0);
+
+    // purge them, MADV_FREE is faster but it may be not supported on the old kernel
+    tb_bool_t ok = tb_false;
+#   ifdef MADV_FREE
+    if (!madvise((tb_pointer_t)head, tail - head, MADV_FREE)) ok = tb_true;
+#   endif
+#   ifdef MADV_DONTNEED
+    if (!ok && !madvise((tb_pointer_t)head, tail - head, MADV_DONTNEED)) ok = tb_true;
+#   endif
+
+    // ok?
+    return ok? tail - head : 0;
+#else
+    return 0;
+#endif
+}
+tb_pointer_t tb_native_memory_map(tb_size_t size)
+{
+    // check
+    tb_check_return_val(size, tb_null);
+
+#if defined(TB_CONFIG_POSIX_HAVE_MMAP) && (defined(MAP_ANONYMOUS) || defined(MAP_ANON))
+    // the flags
+#   ifdef MAP_ANONYMOUS
+    tb_int_t flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#   else
+    tb_int_t flags = MAP_PRIVATE | MAP_ANON;
+#   endif
+
+    // do not reserve the swap space, the pages will be committed when they are accessed
+#   ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#   endif
+
+    // map it
+    tb_pointer_t data = mmap(tb_null, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return data != MAP_FAILED? data : tb_null;
+#else
+    return tb_null;
+#endif
+}
+tb_bool_t tb_native_memory_unmap(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data && size, tb_false);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // unmap it
+    return !munmap(data, size);
+#else
+    return tb_false;
+#endif
+}
+tb_bool_t tb_native_memory_guard(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data && size, tb_false);
 
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // disable to access them
+    return !mprotect(data, size, PROT_NONE);
+#else
+    return tb_false;
+#endif
+}
+tb_bool_t tb_native_memory_trim()
+{
+#ifdef TB_CONFIG_LIBC_HAVE_MALLOC_TRIM
+    // trim the top of the heap and the free pages in it
+    malloc_trim(0);
+
+    // ok
+    return tb_true;
+#else
+    return tb_false;
+#endif
+}
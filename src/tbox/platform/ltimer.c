@@ -42,13 +42,43 @@
  * macros
  */
 
-// the timer wheel maxn
+// the root wheel bits
 #ifdef __tb_small__
-#   define TB_LTIMER_WHEEL_MAXN             (4096)
+#   define TB_LTIMER_WHEEL_ROOT_BITS        (6)
 #else
-#   define TB_LTIMER_WHEEL_MAXN             (8192)
+#   define TB_LTIMER_WHEEL_ROOT_BITS        (8)
 #endif
 
+// the upper wheel bits
+#define TB_LTIMER_WHEEL_BITS                (6)
+
+// the wheel level count, the root wheel and four upper wheels
+#define TB_LTIMER_WHEEL_LEVEL               (5)
+
+// the root wheel maxn
+#define TB_LTIMER_WHEEL_ROOT_MAXN           (1 << TB_LTIMER_WHEEL_ROOT_BITS)
+
+// the upper wheel maxn
+#define TB_LTIMER_WHEEL_MAXN                (1 << TB_LTIMER_WHEEL_BITS)
+
+// the total slot count of all wheels
+#define TB_LTIMER_WHEEL_SLOTN               (TB_LTIMER_WHEEL_ROOT_MAXN + (TB_LTIMER_WHEEL_LEVEL - 1) * TB_LTIMER_WHEEL_MAXN)
+
+// the maximum tick range of all wheels, the farther tasks will be cascaded again
+#define TB_LTIMER_WHEEL_RANGE               (((tb_hong_t)1 << (TB_LTIMER_WHEEL_ROOT_BITS + (TB_LTIMER_WHEEL_LEVEL - 1) * TB_LTIMER_WHEEL_BITS)) - 1)
+
+// the tick shift of the given upper wheel level, level: [1, TB_LTIMER_WHEEL_LEVEL)
+#define tb_ltimer_wheel_shift(level)        (TB_LTIMER_WHEEL_ROOT_BITS + ((level) - 1) * TB_LTIMER_WHEEL_BITS)
+
+// the slot index of the given upper wheel level and the tick
+#define tb_ltimer_wheel_slot(level, tick)   (TB_LTIMER_WHEEL_ROOT_MAXN + ((level) - 1) * TB_LTIMER_WHEEL_MAXN + (tb_size_t)(((tick) >> tb_ltimer_wheel_shift(level)) & (TB_LTIMER_WHEEL_MAXN - 1)))
+
+// the task is not in the wheel
+#define TB_LTIMER_WHEEL_INDEX_NONE          ((tb_uint32_t)-1)
+
+// the task is in the expired list
+#define TB_LTIMER_WHEEL_INDEX_EXPIRED       ((tb_uint32_t)-2)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -56,6 +86,9 @@
 // the timer task type
 typedef struct __tb_ltimer_task_t
 {
+    // the list entry
+    tb_list_entry_t             entry;
+
     // the func
     tb_ltimer_task_func_t       func;
 
@@ -65,6 +98,9 @@ typedef struct __tb_ltimer_task_t
     // the when
     tb_hong_t                   when;
 
+    // the expired tick
+    tb_hong_t                   etick;
+
     // the period
     tb_uint32_t                 period  : 28;
 
@@ -77,7 +113,7 @@ typedef struct __tb_ltimer_task_t
     // the refn, <= 2
     tb_uint32_t                 refn    : 2;
 
-    // the wheel index
+    // the wheel slot index
     tb_uint32_t                 windx;
 
 }tb_ltimer_task_t;
@@ -88,14 +124,20 @@ typedef struct __tb_ltimer_task_t
  *
  * tick: 1s
  *
- *           1s    1s   ..
- * wheel: |-----|-----|-----|-----|-----|-----|---- ... -----|  <= circle queue
- *                             timers
- *                 btime ==================> now
- *                       |     |     |
- *                       |     |     |
- *                       |     |     | => the same timeout timer_task list (vector)
- *                                   |
+ * root:    |-----|-----|-----|-----|---- ... -----|  <= 256 ticks, 1s per slot
+ *           wtick  |                                   
+ *                  | => the same timeout task list (list entry)
+ *
+ * level1:  |-----|-----|-----|-----|---- ... -----|  <= 64 slots, 256 ticks per slot
+ * level2:  |-----|-----|-----|-----|---- ... -----|  <= 64 slots, 256 * 64 ticks per slot
+ * ...
+ *
+ * the task is added to the lowest wheel which covers its expired tick,
+ * and the slot of the upper wheel will be cascaded to the lower wheels 
+ * when the root wheel has been turned a full circle.
+ *
+ * the farther tasks out of the whole range are put into the top wheel 
+ * and will be cascaded again until they are expired.
  *
  * </pre>
  */
@@ -110,7 +152,7 @@ typedef struct __tb_ltimer_t
     // is worked?
     tb_atomic_t                 work;
 
-    // the base time
+    // the base time of the current tick
     tb_hong_t                   btime;
 
     // cache time?
@@ -125,14 +167,20 @@ typedef struct __tb_ltimer_t
     // the pool
     tb_fixed_pool_ref_t         pool;
 
-    // the expired tasks
-    tb_vector_ref_t             expired;
+    // the task count in the wheels
+    tb_size_t                   size;
+
+    // the task count in the root wheel
+    tb_size_t                   rsize;
 
-    // the wheel
-    tb_vector_ref_t             wheel[TB_LTIMER_WHEEL_MAXN];
+    // the current tick of the wheels, all ticks before it have been expired
+    tb_hong_t                   wtick;
 
-    // the wheel base
-    tb_size_t                   wbase;
+    // the expired tasks
+    tb_list_entry_head_t        expired;
+
+    // the wheels
+    tb_list_entry_head_t        wheel[TB_LTIMER_WHEEL_SLOTN];
 
 }tb_ltimer_t;
 
@@ -152,6 +200,39 @@ static __tb_inline__ tb_hong_t tb_ltimer_now(tb_ltimer_t* timer)
     // using cached time
     return tb_cache_time_mclock();
 }
+static tb_void_t tb_ltimer_add_slot(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
+{
+    // the tick difference, the farther tasks will be put into the top wheel 
+    tb_hong_t etick = timer_task->etick;
+    tb_hong_t tdiff = etick - timer->wtick;
+    if (tdiff > TB_LTIMER_WHEEL_RANGE)
+    {
+        etick = timer->wtick + TB_LTIMER_WHEEL_RANGE;
+        tdiff = TB_LTIMER_WHEEL_RANGE;
+    }
+
+    // the wheel index
+    tb_size_t windx = 0;
+    if (tdiff < TB_LTIMER_WHEEL_ROOT_MAXN) windx = (tb_size_t)(etick & (TB_LTIMER_WHEEL_ROOT_MAXN - 1));
+    else
+    {
+        // find the lowest upper wheel which covers it
+        tb_size_t level = 1;
+        while (level < TB_LTIMER_WHEEL_LEVEL - 1 && (tdiff >> tb_ltimer_wheel_shift(level + 1))) level++;
+        windx = tb_ltimer_wheel_slot(level, etick);
+    }
+
+    // trace
+    tb_trace_d("add: wtick: %lld, etick: %lld, windx: %lu", timer->wtick, timer_task->etick, windx);
+
+    // add task to the wheel list
+    tb_assert(windx < TB_LTIMER_WHEEL_SLOTN);
+    tb_list_entry_insert_tail(&timer->wheel[windx], &timer_task->entry);
+    if (windx < TB_LTIMER_WHEEL_ROOT_MAXN) timer->rsize++;
+
+    // save the wheel index
+    timer_task->windx = (tb_uint32_t)windx;
+}
 static tb_bool_t tb_ltimer_add_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
 {
     // check
@@ -161,162 +242,88 @@ static tb_bool_t tb_ltimer_add_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_
     // trace
     tb_trace_d("add: when: %lld, period: %u, refn: %u", timer_task->when, timer_task->period, timer_task->refn);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // empty? move to the wheel head
-        if (!tb_fixed_pool_size(timer->pool)) 
-        {
-            timer->btime = tb_ltimer_now(timer);
-            timer->wbase = 0;
-        }
-
-        // trace
-        tb_trace_d("add: btime: %lld, wbase: %lu", timer->btime, timer->wbase);
-
-        // the timer difference
-        tb_hong_t tdiff = timer_task->when - timer->btime;
-        tb_assert_and_check_break(tdiff >= 0);
-
-        // trace
-        tb_trace_d("add: tdiff: %lld", tdiff);
-
-        // the wheel difference
-        tb_size_t wdiff = (tb_size_t)(tdiff / timer->tick);
-        tb_assert_and_check_break(wdiff < TB_LTIMER_WHEEL_MAXN);
-
-        // trace
-        tb_trace_d("add: wdiff: %lu", wdiff);
-
-        // the wheel index
-        tb_size_t windx = (timer->wbase + wdiff) & (TB_LTIMER_WHEEL_MAXN - 1);
-
-        // trace
-        tb_trace_d("add: windx: %lu", windx);
-
-        // the wheel list
-        tb_vector_ref_t wlist = timer->wheel[windx];
-        if (!wlist) wlist = timer->wheel[windx] = tb_vector_init(timer->grow, tb_element_ptr(tb_null, tb_null));
-        tb_assert_and_check_break(wlist);
+    // empty? move to the current time
+    if (!timer->size) timer->btime = tb_ltimer_now(timer);
 
-        // save the wheel index
-        timer_task->windx = (tb_uint32_t)windx;
+    // the expired tick, the task will be expired at the first tick which does not begin before it
+    tb_hong_t tdiff = timer_task->when - timer->btime;
+    timer_task->etick = timer->wtick + (tdiff > 0? (tdiff + timer->tick - 1) / timer->tick : 0);
 
-        // add task to the wheel list
-        tb_vector_insert_tail(wlist, timer_task);
+    // add it to the wheels
+    tb_ltimer_add_slot(timer, timer_task);
+    timer->size++;
 
-        // ok
-        ok = tb_true;
-
-    } while (0);
-
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 static tb_bool_t tb_ltimer_del_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
 {
     // check
     tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
-    tb_assert_and_check_return_val(timer_task && timer_task->func && timer_task->refn && timer_task->when, tb_false);
+    tb_assert_and_check_return_val(timer_task && timer_task->refn && timer_task->when, tb_false);
 
     // trace
     tb_trace_d("del: when: %lld, period: %u, refn: %u", timer_task->when, timer_task->period, timer_task->refn);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // check
-        tb_assert_and_check_break(timer_task->windx != -1 && timer_task->windx < tb_arrayn(timer->wheel));
-
-        // the wheel list
-        tb_vector_ref_t wlist = timer->wheel[timer_task->windx];
-        tb_assert_and_check_break(wlist);
-
-        // find the task from the wheel list
-        tb_size_t itor = tb_find_all(wlist, timer_task);
-        tb_assert_and_check_break(itor != tb_iterator_tail(wlist));
-
-        // del the task from the wheel list
-        tb_vector_remove(wlist, itor);
-
-        // clear the wheel index
-        timer_task->windx = -1;
-
-        // ok
-        ok = tb_true;
+    // not in the wheels?
+    tb_check_return_val(timer_task->windx < TB_LTIMER_WHEEL_SLOTN, tb_false);
 
-    } while (0);
+    // del the task from the wheel list
+    tb_list_entry_remove(&timer->wheel[timer_task->windx], &timer_task->entry);
+    if (timer_task->windx < TB_LTIMER_WHEEL_ROOT_MAXN) timer->rsize--;
+    timer->size--;
 
-    // ok?
-    return ok;
-}
-static tb_bool_t tb_ltimer_expired_task_done(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
-{
-    // the task
-    tb_ltimer_task_t const* timer_task = (tb_ltimer_task_t const*)item;
-    
-    // done func
-    if (timer_task && timer_task->func) 
-    { 
-        // trace
-        tb_trace_d("done: expired: when: %lld, period: %u, refn: %u, killed: %u", timer_task->when, timer_task->period, timer_task->refn, timer_task->killed);
-
-        // done
-        timer_task->func(timer_task->killed? tb_true : tb_false, timer_task->priv);
-    }
+    // clear the wheel index
+    timer_task->windx = TB_LTIMER_WHEEL_INDEX_NONE;
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_ltimer_expired_task_exit(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+static tb_bool_t tb_ltimer_cascade(tb_ltimer_t* timer, tb_size_t level)
 {
-    // check
-    tb_ltimer_t*    timer = priv? (tb_ltimer_t*)(((tb_pointer_t*)priv)[0]) : tb_null;
-    tb_hong_t*      now = priv? (tb_hong_t*)(((tb_pointer_t*)priv)[1]) : tb_null;
-    tb_assert_and_check_return_val(timer && now, tb_false);
+    // the wheel slot of the current tick
+    tb_size_t               windx = tb_ltimer_wheel_slot(level, timer->wtick);
+    tb_list_entry_head_ref_t wlist = &timer->wheel[windx];
 
-    // the task
-    tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)item;
-    if (timer_task)
+    // move all tasks of this slot to the lower wheels
+    while (tb_list_entry_size(wlist))
     {
-        // repeat?
-        if (timer_task->repeat)
-        {
-            // update when
-            timer_task->when = *now + timer_task->period;
+        // the task
+        tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry(wlist, tb_list_entry_head(wlist));
+        tb_list_entry_remove_head(wlist);
 
-            // continue the task
-            if (!tb_ltimer_add_task(timer, timer_task))
-            {
-                // trace
-                tb_trace_e("continue to add timer_task failed");
-            }
-        }
-        else
-        {
-            // refn--
-            if (timer_task->refn > 1) timer_task->refn--;
-            // remove it from pool directly
-            else tb_fixed_pool_free(timer->pool, timer_task);
-        }
+        // re-add it
+        tb_ltimer_add_slot(timer, timer_task);
     }
 
-    // ok
-    return tb_true;
+    // continue to cascade the upper wheel if this wheel has been turned a full circle
+    return windx == tb_ltimer_wheel_slot(level, 0);
 }
-static tb_void_t tb_ltimer_expired_list_exit(tb_element_ref_t element, tb_pointer_t buff)
+static tb_void_t tb_ltimer_expired_exit(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task, tb_hong_t now)
 {
-    // check
-    tb_vector_ref_t list = buff? *((tb_vector_ref_t*)buff) : tb_null;
-    tb_assert_and_check_return(list);
+    // clear the wheel index
+    timer_task->windx = TB_LTIMER_WHEEL_INDEX_NONE;
 
-    // exit list
-    tb_vector_exit(list);
+    // repeat?
+    if (timer_task->repeat)
+    {
+        // update when
+        timer_task->when = now + timer_task->period;
 
-    // clear it
-    *((tb_pointer_t*)buff) = tb_null;
+        // continue the task
+        if (!tb_ltimer_add_task(timer, timer_task))
+        {
+            // trace
+            tb_trace_e("continue to add timer_task failed");
+        }
+    }
+    else
+    {
+        // refn--
+        if (timer_task->refn > 1) timer_task->refn--;
+        // remove it from pool directly
+        else tb_fixed_pool_free(timer->pool, timer_task);
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -350,8 +357,12 @@ tb_ltimer_ref_t tb_ltimer_init(tb_size_t grow, tb_size_t tick, tb_bool_t ctime)
         tb_assert_and_check_break(timer->pool);
 
         // init the expired tasks
-        timer->expired      = tb_vector_init((TB_LTIMER_WHEEL_MAXN >> 3) + 8, tb_element_ptr(tb_ltimer_expired_list_exit, tb_null));
-        tb_assert_and_check_break(timer->expired);
+        tb_list_entry_init(&timer->expired, tb_ltimer_task_t, entry, tb_null);
+
+        // init the wheels
+        tb_size_t i = 0;
+        for (i = 0; i < TB_LTIMER_WHEEL_SLOTN; i++)
+            tb_list_entry_init(&timer->wheel[i], tb_ltimer_task_t, entry, tb_null);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -396,15 +407,9 @@ tb_void_t tb_ltimer_exit(tb_ltimer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // exit wheel
-    {
-        tb_size_t i = 0;
-        for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
-        {
-            if (timer->wheel[i]) tb_vector_exit(timer->wheel[i]);
-            timer->wheel[i] = tb_null;
-        }
-    }
+    // exit the wheels, all tasks will be freed with the pool
+    timer->size = 0;
+    timer->rsize = 0;
 
     // exit pool
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
@@ -413,10 +418,6 @@ tb_void_t tb_ltimer_exit(tb_ltimer_ref_t self)
     // leave
     tb_spinlock_leave(&timer->lock);
 
-    // exit the expired tasks
-    if (timer->expired) tb_vector_exit(timer->expired);
-    timer->expired = tb_null;
-
     // exit lock
     tb_spinlock_exit(&timer->lock);
 
@@ -440,18 +441,17 @@ tb_void_t tb_ltimer_clear(tb_ltimer_ref_t self)
         // enter
         tb_spinlock_enter(&timer->lock);
 
-        // move to the wheel head
+        // move to the current time
         timer->btime = tb_ltimer_now(timer);
-        timer->wbase = 0;
+        timer->size  = 0;
+        timer->rsize = 0;
 
-        // clear wheel
-        {
-            tb_size_t i = 0;
-            for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
-            {
-                if (timer->wheel[i]) tb_vector_clear(timer->wheel[i]);
-            }
-        }
+        // clear the wheels
+        tb_size_t i = 0;
+        for (i = 0; i < TB_LTIMER_WHEEL_SLOTN; i++) tb_list_entry_clear(&timer->wheel[i]);
+
+        // clear the expired tasks
+        tb_list_entry_clear(&timer->expired);
 
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
@@ -466,8 +466,8 @@ tb_size_t tb_ltimer_limit(tb_ltimer_ref_t self)
     tb_ltimer_t* timer = (tb_ltimer_t*)self;
     tb_assert_and_check_return_val(timer, 0);
 
-    // the self limit
-    return (TB_LTIMER_WHEEL_MAXN * timer->tick);
+    // no limit, the farther tasks will be cascaded again 
+    return (tb_size_t)-1;
 }
 tb_size_t tb_ltimer_delay(tb_ltimer_ref_t self)
 {
@@ -482,7 +482,7 @@ tb_bool_t tb_ltimer_spak(tb_ltimer_ref_t self)
 {
     // check
     tb_ltimer_t* timer = (tb_ltimer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->tick && timer->expired, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_get(&timer->stop), tb_false);
@@ -493,89 +493,97 @@ tb_bool_t tb_ltimer_spak(tb_ltimer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
+    // empty? move to the current time
+    if (!timer->size) timer->btime = now;
+
+    // trace
+    tb_trace_d("spak: btime: %lld, wtick: %lld, now: %lld, size: %lu", timer->btime, timer->wtick, now, timer->size);
+
+    // walk all begun ticks
+    tb_list_entry_head_ref_t expired = &timer->expired;
+    while (timer->btime <= now)
     {
-        // less than one tick? continue to wait
-        if (now - timer->btime < timer->tick)
+        // the root wheel has been turned a full circle? cascade the upper wheels
+        tb_size_t level = 1;
+        if (!(timer->wtick & (TB_LTIMER_WHEEL_ROOT_MAXN - 1)))
         {
-            ok = tb_true;
-            break;
+            while (level < TB_LTIMER_WHEEL_LEVEL && tb_ltimer_cascade(timer, level)) level++;
         }
 
-        // empty? move to the wheel head
-        if (!tb_fixed_pool_size(timer->pool))
+        /* the root wheel is empty? skip the rest ticks of this circle at once if all of them have begun,
+         * so the catch-up after a long suspend or a clock jump only cascades once per circle
+         */
+        if (!timer->rsize)
         {
-            timer->btime = now;
-            timer->wbase = 0;
-            ok = tb_true;
-            break;
+            tb_size_t skip = TB_LTIMER_WHEEL_ROOT_MAXN - (tb_size_t)(timer->wtick & (TB_LTIMER_WHEEL_ROOT_MAXN - 1));
+            if (timer->btime + (tb_hong_t)(skip - 1) * timer->tick <= now)
+            {
+                timer->wtick += skip;
+                timer->btime += (tb_hong_t)skip * timer->tick;
+                continue;
+            }
         }
 
-        // the diff
-        tb_size_t diff = (tb_size_t)((now - timer->btime) / timer->tick);
-
-        // trace
-        tb_trace_d("spak: btime: %lld, wbase: %lu, now: %lld, diff: %lu", timer->btime, timer->wbase, now, diff);
-
-        // walk the expired lists
-        tb_size_t i = 0;
-        tb_size_t n = tb_min(diff, TB_LTIMER_WHEEL_MAXN - 1);
-        for (i = 0; i <= n; i++)
+        // detach the expired tasks of the current tick
+        tb_list_entry_head_ref_t wlist = &timer->wheel[timer->wtick & (TB_LTIMER_WHEEL_ROOT_MAXN - 1)];
+        if (tb_list_entry_size(wlist))
         {
-            // the wheel index
-            tb_size_t indx = (timer->wbase + i) & (TB_LTIMER_WHEEL_MAXN - 1);
-
-            // the wheel list
-            tb_vector_ref_t list = timer->wheel[indx];
-            tb_check_continue(list && tb_vector_size(list));
-
-            // detach the wheel list to the expired tasks
-            tb_vector_insert_tail(timer->expired, list);
-            timer->wheel[indx] = tb_null;
+            timer->size -= tb_list_entry_size(wlist);
+            timer->rsize -= tb_list_entry_size(wlist);
+            tb_list_entry_splice_tail(expired, wlist);
         }
 
-        // update the base time
-        timer->btime = now;
-
-        // update the wheel base
-        timer->wbase = (timer->wbase + diff) & (TB_LTIMER_WHEEL_MAXN - 1);
-        
-        // ok
-        ok = tb_true;
+        // the next tick
+        timer->wtick++;
+        timer->btime += timer->tick;
+    }
 
-    } while (0);
+    // mark the expired tasks
+    tb_for_all_if (tb_ltimer_task_t*, timer_task, tb_list_entry_itor(expired), timer_task)
+    {
+        timer_task->windx = TB_LTIMER_WHEEL_INDEX_EXPIRED;
+    }
 
     // leave
     tb_spinlock_leave(&timer->lock);
 
-    // ok? and exists expired tasks?
-    if (ok && tb_vector_size(timer->expired))
+    // exists expired tasks?
+    if (tb_list_entry_size(expired))
     {
-        // done all expired list
-        tb_for_all_if (tb_vector_ref_t, list, timer->expired, list)
+        // done the expired tasks
+        tb_for_all_if (tb_ltimer_task_t*, timer_task, tb_list_entry_itor(expired), timer_task)
         {
-            // done the expired task 
-            tb_walk_all(list, tb_ltimer_expired_task_done, tb_null);
+            // done func
+            if (timer_task->func) 
+            { 
+                // trace
+                tb_trace_d("done: expired: when: %lld, period: %u, refn: %u, killed: %u", timer_task->when, timer_task->period, timer_task->refn, timer_task->killed);
 
-            // enter
-            tb_spinlock_enter(&timer->lock);
+                // done
+                timer_task->func(timer_task->killed? tb_true : tb_false, timer_task->priv);
+            }
+        }
 
-            // exit the expired task
-            tb_pointer_t data[2]; data[0] = self; data[1] = &now;
-            tb_walk_all(list, tb_ltimer_expired_task_exit, data);
+        // enter
+        tb_spinlock_enter(&timer->lock);
 
-            // leave
-            tb_spinlock_leave(&timer->lock);
+        // exit the expired tasks
+        while (tb_list_entry_size(expired))
+        {
+            // the task
+            tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry(expired, tb_list_entry_head(expired));
+            tb_list_entry_remove_head(expired);
+
+            // exit it
+            tb_ltimer_expired_exit(timer, timer_task, now);
         }
-    }
 
-    // clear expired
-    tb_vector_clear(timer->expired);
+        // leave
+        tb_spinlock_leave(&timer->lock);
+    }
 
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 tb_void_t tb_ltimer_loop(tb_ltimer_ref_t self)
 {
@@ -639,7 +647,7 @@ tb_ltimer_task_ref_t tb_ltimer_task_init_at(tb_ltimer_ref_t self, tb_hize_t when
         timer_task->period    = period;
         timer_task->repeat    = repeat? 1 : 0;
         timer_task->killed    = 0;
-        timer_task->windx     = -1;
+        timer_task->windx     = TB_LTIMER_WHEEL_INDEX_NONE;
 
         // add timer_task
         if (!tb_ltimer_add_task(timer, timer_task))
@@ -697,7 +705,7 @@ tb_void_t tb_ltimer_task_post_at(tb_ltimer_ref_t self, tb_hize_t when, tb_size_t
         timer_task->period    = period;
         timer_task->repeat    = repeat? 1 : 0;
         timer_task->killed    = 0;
-        timer_task->windx     = -1;
+        timer_task->windx     = TB_LTIMER_WHEEL_INDEX_NONE;
 
         // add task
         if (!tb_ltimer_add_task(timer, timer_task))
@@ -729,7 +737,8 @@ tb_void_t tb_ltimer_task_exit(tb_ltimer_ref_t self, tb_ltimer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    if (timer_task->refn > 1)
+    // is expiring now? cancel it and it will be removed after being done
+    if (timer_task->windx == TB_LTIMER_WHEEL_INDEX_EXPIRED && timer_task->refn > 1)
     {
         // refn--
         timer_task->refn--;
@@ -739,8 +748,14 @@ tb_void_t tb_ltimer_task_exit(tb_ltimer_ref_t self, tb_ltimer_task_ref_t task)
         timer_task->priv      = tb_null;
         timer_task->repeat    = 0;
     }
-    // remove it from pool directly if the task have been expired 
-    else tb_fixed_pool_free(timer->pool, timer_task);
+    else 
+    {
+        // remove it from the wheels directly if the task have been not expired
+        if (timer_task->windx != TB_LTIMER_WHEEL_INDEX_NONE) tb_ltimer_del_task(timer, timer_task);
+
+        // remove it from pool
+        tb_fixed_pool_free(timer->pool, timer_task);
+    }
 
     // leave
     tb_spinlock_leave(&timer->lock);
@@ -762,7 +777,7 @@ tb_void_t tb_ltimer_task_kill(tb_ltimer_ref_t self, tb_ltimer_task_ref_t task)
     do
     {
         // expired or removed?
-        tb_check_break(timer_task->refn == 2);
+        tb_check_break(timer_task->refn == 2 && timer_task->windx != TB_LTIMER_WHEEL_INDEX_EXPIRED);
 
         // del the task first
         if (!tb_ltimer_del_task(timer, timer_task))
@@ -66,7 +66,7 @@ typedef __tb_typeref__(ltimer_task);
 
 /*! init timer
  *
- * lower tick and limit range, but faster
+ * lower tick but faster, the hierarchical timing wheels have no limit range
  * 
  * @param grow          the timer grow
  * @param tick          the timer tick
@@ -98,7 +98,7 @@ tb_void_t               tb_ltimer_clear(tb_ltimer_ref_t timer);
  *
  * @param timer         the timer 
  *
- * @return              the timer limit range: [now, now + limit)
+ * @return              the timer limit range: [now, now + limit), (tb_size_t)-1: no limit
  */
 tb_size_t               tb_ltimer_limit(tb_ltimer_ref_t timer);
 
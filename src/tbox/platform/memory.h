@@ -103,6 +103,57 @@ tb_pointer_t            tb_native_memory_ralloc(tb_pointer_t data, tb_size_t siz
  */
 tb_bool_t               tb_native_memory_free(tb_pointer_t data);
 
+/*! purge the pages of the unused native memory and return them to the system
+ *
+ * only the whole pages in this range will be purged, and the purged pages
+ * will be reloaded with the undefined data (.e.g zero) when they are accessed again.
+ *
+ * @param data          the data address
+ * @param size          the data size
+ *
+ * @return              the purged size
+ */
+tb_size_t               tb_native_memory_purge(tb_pointer_t data, tb_size_t size);
+
+/*! map the anonymous virtual memory pages
+ *
+ * the physical pages will be allocated lazily when they are accessed,
+ * so it is suitable for the large and sparsely used memory, .e.g the coroutine stacks.
+ *
+ * @note the whole size will be charged to the commit limit on windows at once,
+ * only the physical pages are allocated lazily, 
+ * but it will be not charged until the pages are accessed on the overcommitted systems, .e.g linux
+ *
+ * @param size          the size, it must be aligned by the page size
+ *
+ * @return              the data address, return tb_null if failed or not supported
+ */
+tb_pointer_t            tb_native_memory_map(tb_size_t size);
+
+/*! unmap the virtual memory pages
+ *
+ * @param data          the data address from tb_native_memory_map()
+ * @param size          the size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_native_memory_unmap(tb_pointer_t data, tb_size_t size);
+
+/*! make the guard pages of the mapped memory, it will crash if they are accessed
+ *
+ * @param data          the data address, it must be aligned by the page size
+ * @param size          the size, it must be aligned by the page size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_native_memory_guard(tb_pointer_t data, tb_size_t size);
+
+/*! trim the native memory heap and return the free memory at the top of it to the system
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_native_memory_trim(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
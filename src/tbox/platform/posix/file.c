@@ -44,6 +44,9 @@
 #ifdef TB_CONFIG_POSIX_HAVE_SENDFILE
 #   include <sys/sendfile.h>
 #endif
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+#   include <sys/mman.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -184,6 +187,31 @@ tb_hize_t tb_file_size(tb_file_ref_t file)
     // ok?
     return size;
 }
+tb_byte_t const* tb_file_map(tb_file_ref_t file, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(file && size, tb_null);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // map it
+    tb_pointer_t data = mmap(tb_null, size, PROT_READ, MAP_SHARED, tb_file2fd(file), 0);
+    return data != MAP_FAILED? (tb_byte_t const*)data : tb_null;
+#else
+    return tb_null;
+#endif
+}
+tb_bool_t tb_file_unmap(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // unmap it
+    return !munmap((tb_pointer_t)data, size)? tb_true : tb_false;
+#else
+    return tb_false;
+#endif
+}
 tb_bool_t tb_file_info(tb_char_t const* path, tb_file_info_t* info)
 {
     // check
@@ -96,9 +96,15 @@ tb_void_t tb_thread_local_exit(tb_thread_local_ref_t local)
     // check
     tb_assert(local);
 
+    // remove it from the thread local list, only exit it once
+    tb_check_return(tb_thread_local_remove(local));
+
     // exit it
     pthread_key_delete(((pthread_key_t*)local->priv)[0]);
     pthread_key_delete(((pthread_key_t*)local->priv)[1]);
+
+    // reset it
+    local->inited = tb_false;
 }
 tb_bool_t tb_thread_local_has(tb_thread_local_ref_t local)
 {
@@ -64,16 +64,26 @@ tb_bool_t tb_thread_local_init_env()
 }
 tb_void_t tb_thread_local_exit_env()
 {
-    // enter lock
-    tb_spinlock_enter(&g_thread_local_lock);
-
     // exit all thread locals
-    tb_for_all_if (tb_thread_local_ref_t, local, tb_single_list_entry_itor(&g_thread_local_list), local)
+    while (1)
     {
-        // exit it
+        // get the head thread local
+        tb_thread_local_ref_t local = tb_null;
+        tb_spinlock_enter(&g_thread_local_lock);
+        if (!tb_single_list_entry_is_null(&g_thread_local_list))
+            local = (tb_thread_local_ref_t)tb_single_list_entry(&g_thread_local_list, tb_single_list_entry_head(&g_thread_local_list));
+        tb_spinlock_leave(&g_thread_local_lock);
+
+        // end?
+        tb_check_break(local);
+
+        // exit it and remove it from the thread local list
         tb_thread_local_exit(local);
     }
 
+    // enter lock
+    tb_spinlock_enter(&g_thread_local_lock);
+
     // exit the thread local list
     tb_single_list_entry_exit(&g_thread_local_list);
 
@@ -94,6 +104,39 @@ tb_void_t tb_thread_local_walk(tb_walk_func_t func, tb_cpointer_t priv)
     // leave lock
     tb_spinlock_leave(&g_thread_local_lock);
 }
+static __tb_inline__ tb_bool_t tb_thread_local_remove(tb_thread_local_ref_t local)
+{
+    // check
+    tb_assert(local);
+
+    // enter lock
+    tb_spinlock_enter(&g_thread_local_lock);
+
+    // find and remove it from the thread local list
+    tb_bool_t                   ok = tb_false;
+    tb_single_list_entry_ref_t  prev = (tb_single_list_entry_ref_t)&g_thread_local_list;
+    tb_single_list_entry_ref_t  entry = tb_single_list_entry_head(&g_thread_local_list);
+    while (entry)
+    {
+        // found?
+        if (entry == &local->entry)
+        {
+            tb_single_list_entry_remove_next(&g_thread_local_list, prev);
+            ok = tb_true;
+            break;
+        }
+
+        // next
+        prev = entry;
+        entry = tb_single_list_entry_next(entry);
+    }
+
+    // leave lock
+    tb_spinlock_leave(&g_thread_local_lock);
+
+    // ok?
+    return ok;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
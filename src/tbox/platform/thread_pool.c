@@ -50,38 +50,67 @@
 #   define TB_THREAD_POOL_WORKER_MAXN           (64)
 #endif
 
-// the jobs grow
+// the job deque maxn of each worker, the power of 2
 #ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_POOL_GROW        (256)
+#   define TB_THREAD_POOL_WORKER_DEQUE_MAXN     (256)
 #else
-#   define TB_THREAD_POOL_JOBS_POOL_GROW        (512)
+#   define TB_THREAD_POOL_WORKER_DEQUE_MAXN     (4096)
 #endif
 
-// the working jobs grow
+// the cached free jobs maxn of each worker
 #ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_WORKING_GROW     (32)
+#   define TB_THREAD_POOL_WORKER_CACHE_MAXN     (64)
 #else
-#   define TB_THREAD_POOL_JOBS_WORKING_GROW     (64)
+#   define TB_THREAD_POOL_WORKER_CACHE_MAXN     (256)
 #endif
 
-// the jobs waiting maxn
+// the spinning count of the idle worker before parking it
+#define TB_THREAD_POOL_WORKER_SPIN              (32)
+
+// the injected jobs maxn for the non-worker threads
 #ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_WAITING_MAXN     (1 << 16)
+#   define TB_THREAD_POOL_JOBS_INJECT_MAXN      (256)
 #else
-#   define TB_THREAD_POOL_JOBS_WAITING_MAXN     (1 << 20)
+#   define TB_THREAD_POOL_JOBS_INJECT_MAXN      (4096)
 #endif
 
-// the pull jobs time maxn
+// the jobs waiting maxn of the overflow lists
 #ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (10000)
+#   define TB_THREAD_POOL_JOBS_WAITING_MAXN     (1 << 16)
 #else
-#   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (20000)
+#   define TB_THREAD_POOL_JOBS_WAITING_MAXN     (1 << 20)
 #endif
 
+// the pull jobs maxn from the injected jobs at once
+#define TB_THREAD_POOL_JOBS_PULL_MAXN           (16)
+
+// the closed successor links of the done job
+#define TB_THREAD_POOL_JOB_SUCCS_CLOSED         ((tb_long_t)1)
+
+// load the index with the acquire semantics and store it with the release semantics
+#if (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 7)) || defined(TB_COMPILER_IS_CLANG)
+#   define tb_thread_pool_load(a)               __atomic_load_n(a, __ATOMIC_ACQUIRE)
+#   define tb_thread_pool_store(a, v)           __atomic_store_n(a, v, __ATOMIC_RELEASE)
+#endif
+
+// load the value directly without the locked instruction
+#define tb_thread_pool_value(a)                 (*((__tb_volatile__ tb_atomic_t*)(a)))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the thread pool job link type of the successors
+typedef struct __tb_thread_pool_link_t
+{
+    // the successor job
+    struct __tb_thread_pool_job_t*      job;
+
+    // the next link
+    struct __tb_thread_pool_link_t*     next;
+
+}tb_thread_pool_link_t;
+
 // the thread pool job type
 typedef struct __tb_thread_pool_job_t
 {
@@ -101,21 +130,48 @@ typedef struct __tb_thread_pool_job_t
      */
     tb_atomic_t                         state;
 
-    // the entry
+    // the kill epoch of the pool when posting it, it will be killed if the epoch has been changed
+    tb_size_t                           epoch;
+
+    // the unfinished predecessors count and one reference for linking them, it will be pushed once it is zero
+    tb_atomic_t                         deps;
+
+    // the successor links, it will be closed after this job has been done
+    tb_atomic_t                         succs;
+
+    // the entry for the overflow lists
     tb_list_entry_t                     entry;
 
+    // the next cached free job
+    struct __tb_thread_pool_job_t*      next;
+
 }tb_thread_pool_job_t;
 
-// the thread pool job stats type
-typedef struct __tb_thread_pool_job_stats_t
+// the thread pool index type, it is placed at its own cache line
+typedef __tb_cacheline_aligned__ struct __tb_thread_pool_index_t
 {
-    // the done count
-    tb_size_t                           done_count;
+    // the index
+    tb_atomic_t                         index;
+
+}__tb_cacheline_aligned__ tb_thread_pool_index_t;
 
-    // the done total time
-    tb_hize_t                           total_time;
+/* the thread pool deque type (chase-lev)
+ *
+ * the owner worker pushes and pops jobs at the bottom without the locked instruction except for the last job,
+ * the other workers steal jobs at the top by one compare-and-swap.
+ */
+typedef struct __tb_thread_pool_deque_t
+{
+    // the top index for the thieves
+    tb_thread_pool_index_t              top;
 
-}tb_thread_pool_job_stats_t;
+    // the bottom index for the owner
+    tb_thread_pool_index_t              bottom;
+
+    // the jobs
+    tb_thread_pool_job_t**              jobs;
+
+}tb_thread_pool_deque_t;
 
 // the thread pool worker priv type
 typedef struct __tb_thread_pool_worker_priv_t
@@ -129,8 +185,11 @@ typedef struct __tb_thread_pool_worker_priv_t
 }tb_thread_pool_worker_priv_t;
 
 // the thread pool worker type
-typedef struct __tb_thread_pool_worker_t
+typedef __tb_cacheline_aligned__ struct __tb_thread_pool_worker_t
 {
+    // the deque
+    tb_thread_pool_deque_t              deque;
+
     // the worker id
     tb_size_t                           id;
 
@@ -140,14 +199,20 @@ typedef struct __tb_thread_pool_worker_t
     // the loop
     tb_thread_ref_t                     loop;
 
-    // the jobs
-    tb_vector_ref_t                     jobs;
+    // the random seed for choosing the victims
+    tb_uint32_t                         seed;
 
-    // the pull time
-    tb_size_t                           pull;
+    // the cached free jobs
+    tb_thread_pool_job_t*               jobs_cache;
 
-    // the stats
-    tb_hash_map_ref_t                   stats;
+    // the cached free jobs count
+    tb_size_t                           jobs_cache_size;
+
+    // the posted jobs count from this worker, it is only written by this worker
+    tb_size_t                           jobs_posted;
+
+    // the freed jobs count from this worker, it is only written by this worker
+    tb_size_t                           jobs_freed;
 
     // is stoped?
     tb_atomic_t                         bstoped;
@@ -155,45 +220,69 @@ typedef struct __tb_thread_pool_worker_t
     // the private data 
     tb_thread_pool_worker_priv_t        priv[TB_THREAD_POOL_WORKER_PRIV_MAXN];
 
-}tb_thread_pool_worker_t;
+}__tb_cacheline_aligned__ tb_thread_pool_worker_t;
 
 // the thread pool type
-typedef struct __tb_thread_pool_impl_t
+typedef __tb_cacheline_aligned__ struct __tb_thread_pool_impl_t
 {
+    // the worker list
+    tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
+
     // the thread stack size
     tb_size_t                           stack;
 
     // the worker maxn
     tb_size_t                           worker_maxn;
 
-    // the lock
+    // the worker size, it is only increased with the lock
+    tb_size_t                           worker_size;
+
+    // the lock for the workers and the overflow jobs
     tb_spinlock_t                       lock;
 
-    // the jobs pool
-    tb_fixed_pool_ref_t                 jobs_pool;
+    // the injected urgent jobs from the non-worker threads
+    tb_mpmc_queue_ref_t                 jobs_inject_urgent;
 
-    // the urgent jobs
+    // the injected jobs from the non-worker threads
+    tb_mpmc_queue_ref_t                 jobs_inject;
+
+    // the overflow urgent jobs if the injected jobs are full
     tb_list_entry_head_t                jobs_urgent;
     
-    // the waiting jobs
+    // the overflow waiting jobs if the injected jobs are full
     tb_list_entry_head_t                jobs_waiting;
-    
-    // the pending jobs
-    tb_list_entry_head_t                jobs_pending;
+
+    // the overflow jobs count
+    tb_atomic_t                         jobs_overflow;
+
+    // the posted jobs count from the non-worker threads
+    tb_atomic_t                         jobs_posted;
+
+    // the freed jobs count from the non-worker threads
+    tb_atomic_t                         jobs_freed;
+
+    // the kill epoch
+    tb_atomic_t                         epoch;
 
     // is stoped
-    tb_bool_t                           bstoped;
+    tb_atomic_t                         bstoped;
+
+    // the idle worker count
+    tb_atomic_t                         idle;
 
-    // the semaphore
+    // the semaphore for parking the idle workers
     tb_semaphore_ref_t                  semaphore;
-    
-    // the worker size
-    tb_size_t                           worker_size;
 
-    // the worker list
-    tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
+}__tb_cacheline_aligned__ tb_thread_pool_impl_t;
 
-}tb_thread_pool_impl_t;
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the current worker
+#ifdef __tb_thread_local__
+static __tb_thread_local__ tb_thread_pool_worker_t* g_worker = tb_null;
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
@@ -220,170 +309,547 @@ static tb_void_t tb_thread_pool_instance_kill(tb_handle_t pool, tb_cpointer_t pr
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * worker implementation
+ * deque implementation
  */
-static tb_bool_t tb_thread_pool_worker_walk_pull(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value, tb_bool_t* is_break)
+#ifndef tb_thread_pool_load
+static __tb_inline__ tb_long_t tb_thread_pool_load(tb_atomic_t* index)
+{
+    tb_long_t value = *((__tb_volatile__ tb_atomic_t*)index);
+    tb_barrier();
+    return value;
+}
+static __tb_inline__ tb_void_t tb_thread_pool_store(tb_atomic_t* index, tb_long_t value)
+{
+    tb_barrier();
+    *((__tb_volatile__ tb_atomic_t*)index) = value;
+}
+#endif
+static tb_bool_t tb_thread_pool_deque_init(tb_thread_pool_deque_t* deque)
+{
+    // check
+    tb_assert(deque);
+
+    // init it
+    deque->top.index    = 0;
+    deque->bottom.index = 0;
+    deque->jobs         = tb_nalloc0_type(TB_THREAD_POOL_WORKER_DEQUE_MAXN, tb_thread_pool_job_t*);
+    return deque->jobs? tb_true : tb_false;
+}
+static tb_void_t tb_thread_pool_deque_exit(tb_thread_pool_deque_t* deque)
 {
-    // the worker pull
-    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)value;
-    tb_assert(worker && worker->jobs && worker->stats && is_break);
+    // check
+    tb_assert(deque);
 
+    // exit it
+    if (deque->jobs) tb_free(deque->jobs);
+    deque->jobs = tb_null;
+}
+static __tb_inline__ tb_size_t tb_thread_pool_deque_size(tb_thread_pool_deque_t* deque)
+{
+    // the approximate size
+    tb_long_t size = tb_thread_pool_value(&deque->bottom.index) - tb_thread_pool_value(&deque->top.index);
+    return size > 0? (tb_size_t)size : 0;
+}
+static __tb_inline__ tb_bool_t tb_thread_pool_deque_push(tb_thread_pool_deque_t* deque, tb_thread_pool_job_t* job)
+{
     // full?
-    if (worker->pull >= TB_THREAD_POOL_JOBS_PULL_TIME_MAXN)
+    tb_long_t bottom = deque->bottom.index;
+    tb_long_t top = tb_thread_pool_load(&deque->top.index);
+    tb_check_return_val(bottom - top < TB_THREAD_POOL_WORKER_DEQUE_MAXN, tb_false);
+
+    // push it
+    ((tb_thread_pool_job_t* __tb_volatile__*)deque->jobs)[bottom & (TB_THREAD_POOL_WORKER_DEQUE_MAXN - 1)] = job;
+    tb_thread_pool_store(&deque->bottom.index, bottom + 1);
+    return tb_true;
+}
+static __tb_inline__ tb_thread_pool_job_t* tb_thread_pool_deque_pop(tb_thread_pool_deque_t* deque)
+{
+    // empty? the thieves only increase the top
+    tb_long_t bottom = deque->bottom.index;
+    tb_check_return_val(bottom > tb_thread_pool_value(&deque->top.index), tb_null);
+
+    // reserve the bottom job, and the thieves must see it before we read the top
+    bottom--;
+    tb_thread_pool_value(&deque->bottom.index) = bottom;
+    tb_barrier();
+    tb_long_t top = tb_thread_pool_value(&deque->top.index);
+
+    // empty?
+    if (top > bottom)
     {
-        // break it
-        *is_break = tb_true;
-        return tb_false;
+        tb_thread_pool_value(&deque->bottom.index) = bottom + 1;
+        return tb_null;
     }
 
-    // the job
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert(job);
+    // pop it
+    tb_thread_pool_job_t* job = ((tb_thread_pool_job_t* __tb_volatile__*)deque->jobs)[bottom & (TB_THREAD_POOL_WORKER_DEQUE_MAXN - 1)];
+    if (top == bottom)
+    {
+        // the last job, race with the thieves
+        if (tb_atomic_fetch_and_pset(&deque->top.index, top, top + 1) != top) job = tb_null;
+        tb_thread_pool_value(&deque->bottom.index) = bottom + 1;
+    }
+    return job;
+}
+static __tb_inline__ tb_thread_pool_job_t* tb_thread_pool_deque_steal(tb_thread_pool_deque_t* deque)
+{
+    // empty?
+    tb_long_t top = tb_thread_pool_load(&deque->top.index);
+    tb_barrier();
+    tb_long_t bottom = tb_thread_pool_load(&deque->bottom.index);
+    tb_check_return_val(top < bottom, tb_null);
+
+    // steal it, it may be lost for the owner or other thieves
+    tb_thread_pool_job_t* job = ((tb_thread_pool_job_t* __tb_volatile__*)deque->jobs)[top & (TB_THREAD_POOL_WORKER_DEQUE_MAXN - 1)];
+    return tb_atomic_fetch_and_pset(&deque->top.index, top, top + 1) == top? job : tb_null;
+}
 
-    // the pool
-    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
-    tb_assert(impl);
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * jobs implementation
+ */
+static __tb_inline__ tb_thread_pool_worker_t* tb_thread_pool_worker_self(tb_thread_pool_impl_t* impl)
+{
+#ifdef __tb_thread_local__
+    return (g_worker && g_worker->pool == (tb_thread_pool_ref_t)impl)? g_worker : tb_null;
+#else
+    return tb_null;
+#endif
+}
+static tb_thread_pool_job_t* tb_thread_pool_jobs_init(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_task_t const* task)
+{
+    // make job from the cached free jobs of the current worker first
+    tb_thread_pool_job_t* job = tb_null;
+    if (worker && worker->jobs_cache)
+    {
+        job = worker->jobs_cache;
+        worker->jobs_cache = job->next;
+        worker->jobs_cache_size--;
+        tb_memset(job, 0, sizeof(tb_thread_pool_job_t));
+    }
+    else job = tb_malloc0_type(tb_thread_pool_job_t);
+    tb_assert_and_check_return_val(job, tb_null);
+
+    // init job
+    job->refn   = 1;
+    job->state  = TB_STATE_WAITING;
+    job->task   = *task;
+    job->epoch  = (tb_size_t)tb_thread_pool_value(&impl->epoch);
+    return job;
+}
+static tb_void_t tb_thread_pool_jobs_exit(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // refn--
+    tb_check_return(tb_atomic_fetch_and_dec(&job->refn) <= 1);
 
-    // append the job to the pending jobs
-    tb_list_entry_insert_tail(&impl->jobs_pending, &job->entry);  
+    // free it to the cached free jobs of the current worker
+    if (worker)
+    {
+        tb_thread_pool_store((tb_atomic_t*)&worker->jobs_freed, worker->jobs_freed + 1);
+        if (worker->jobs_cache_size < TB_THREAD_POOL_WORKER_CACHE_MAXN)
+        {
+            job->next = worker->jobs_cache;
+            worker->jobs_cache = job;
+            worker->jobs_cache_size++;
+        }
+        else tb_free(job);
+    }
+    else
+    {
+        tb_atomic_fetch_and_inc(&impl->jobs_freed);
+        tb_free(job);
+    }
+}
+static tb_size_t tb_thread_pool_jobs_size(tb_thread_pool_impl_t* impl)
+{
+    /* the alive jobs count
+     *
+     * the job is counted before it is published and we load all freed counts before the posted counts, 
+     * so the posted count is never less than the freed count, but we also clamp it for the stale counts
+     */
+    tb_size_t i = 0;
+    tb_size_t n = tb_thread_pool_value(&impl->worker_size);
+    tb_size_t freed = tb_thread_pool_value(&impl->jobs_freed);
+    for (i = 0; i < n; i++) freed += tb_thread_pool_value(&impl->worker_list[i].jobs_freed);
+    tb_barrier();
+    tb_size_t posted = tb_thread_pool_value(&impl->jobs_posted);
+    for (i = 0; i < n; i++) posted += tb_thread_pool_value(&impl->worker_list[i].jobs_posted);
+    return posted > freed? posted - freed : 0;
+}
+static tb_bool_t tb_thread_pool_jobs_push(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job, tb_bool_t force)
+{
+    // non-urgent job from the worker? push it to the deque of this worker
+    tb_bool_t ok = tb_false;
+    if (worker && !job->task.urgent) ok = tb_thread_pool_deque_push(&worker->deque, job);
 
-    // append the job to the working jobs
-    tb_vector_insert_tail(worker->jobs, job);   
+    // inject it
+    if (!ok) ok = tb_mpmc_queue_try_put(job->task.urgent? impl->jobs_inject_urgent : impl->jobs_inject, job);
 
-    // computate the job average time 
-    tb_size_t average_time = 200;
-    if (tb_hash_map_size(worker->stats))
+    // full? append it to the overflow jobs
+    if (!ok)
     {
-        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-        if (stats && stats->done_count) average_time = (tb_size_t)(stats->total_time / stats->done_count);
-    }
+        // enter
+        tb_spinlock_enter(&impl->lock);
 
-    // update the pull time
-    worker->pull += average_time;
+        // append it
+        if (force || tb_list_entry_size(&impl->jobs_urgent) + tb_list_entry_size(&impl->jobs_waiting) + 1 < TB_THREAD_POOL_JOBS_WAITING_MAXN)
+        {
+            tb_list_entry_insert_tail(job->task.urgent? &impl->jobs_urgent : &impl->jobs_waiting, &job->entry);
+            tb_atomic_fetch_and_inc(&impl->jobs_overflow);
+            ok = tb_true;
+        }
 
-    // trace
-    tb_trace_d("worker[%lu]: pull: task[%p:%s] from %s", worker->id, job->task.done, job->task.name, iterator == tb_list_entry_itor(&impl->jobs_waiting)? "waiting" : "urgent");
+        // leave
+        tb_spinlock_leave(&impl->lock);
+    }
 
-    // remove the job from the waiting or urgent jobs
-    return tb_true;
+    // ok?
+    return ok;
+}
+static __tb_inline__ tb_void_t tb_thread_pool_jobs_count(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker)
+{
+    // update the posted count
+    if (worker) tb_thread_pool_store((tb_atomic_t*)&worker->jobs_posted, worker->jobs_posted + 1);
+    else tb_atomic_fetch_and_inc(&impl->jobs_posted);
 }
-static tb_bool_t tb_thread_pool_worker_walk_pull_and_clean(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_bool_t tb_thread_pool_jobs_post(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
 {
-    // the worker pull
-    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)value;
-    tb_assert(worker && worker->jobs && worker->stats);
+    // count it first, the worker may pop and free it before we return from pushing it
+    tb_thread_pool_jobs_count(impl, worker);
 
-    // the job
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert(job);
+    // push it
+    return tb_thread_pool_jobs_push(impl, worker, job, tb_false);
+}
+static tb_bool_t tb_thread_pool_jobs_link(tb_thread_pool_job_t* job, tb_thread_pool_link_t* link)
+{
+    // push the successor link if this job has not been done
+    tb_long_t head = 0;
+    do
+    {
+        head = tb_thread_pool_value(&job->succs);
+        tb_check_return_val(head != TB_THREAD_POOL_JOB_SUCCS_CLOSED, tb_false);
+        link->next = (tb_thread_pool_link_t*)head;
 
-    // the job state
-    tb_size_t state = tb_atomic_get(&job->state);
+    } while (tb_atomic_fetch_and_pset(&job->succs, head, (tb_long_t)link) != head);
 
-    // waiting and non-full? pull it
-    tb_bool_t ok = tb_false;
-    if (state == TB_STATE_WAITING && worker->pull < TB_THREAD_POOL_JOBS_PULL_TIME_MAXN)
+    // ok
+    return tb_true;
+}
+static tb_size_t tb_thread_pool_jobs_unlink(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job, tb_bool_t killed)
+{
+    // close the successor links
+    tb_thread_pool_link_t* link = (tb_thread_pool_link_t*)tb_atomic_fetch_and_set(&job->succs, TB_THREAD_POOL_JOB_SUCCS_CLOSED);
+    tb_assert((tb_long_t)link != TB_THREAD_POOL_JOB_SUCCS_CLOSED);
+
+    // release all successors
+    tb_size_t post = 0;
+    while (link)
     {
-        // append the job to the working jobs
-        tb_vector_insert_tail(worker->jobs, job);   
+        // the successor
+        tb_thread_pool_link_t*  next = link->next;
+        tb_thread_pool_job_t*   succ = link->job;
 
-        // computate the job average time 
-        tb_size_t average_time = 200;
-        if (tb_hash_map_size(worker->stats))
+        // kill it if this job has been killed
+        if (killed) tb_atomic_pset(&succ->state, TB_STATE_WAITING, TB_STATE_KILLING);
+
+        // push it if all predecessors have been done, it has been counted
+        if (tb_atomic_fetch_and_dec(&succ->deps) == 1)
         {
-            tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-            if (stats && stats->done_count) average_time = (tb_size_t)(stats->total_time / stats->done_count);
+            tb_bool_t ok = tb_thread_pool_jobs_push(impl, worker, succ, tb_true);
+            tb_assert(ok); tb_used(ok);
+            post++;
         }
 
-        // update the pull time
-        worker->pull += average_time;
-
-        // trace
-        tb_trace_d("worker[%lu]: pull: task[%p:%s] from pending", worker->id, job->task.done, job->task.name);
+        // free this link
+        tb_free(link);
+        link = next;
     }
-    // finished or killed? remove it
-    else if (state == TB_STATE_FINISHED || state == TB_STATE_KILLED)
-    {
-        // trace
-        tb_trace_d("worker[%lu]: remove: task[%p:%s] from pending", worker->id, job->task.done, job->task.name);
 
-        // exit the job
-        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+    // the pushed successors count
+    return post;
+}
+static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_task_t const* task, tb_size_t refn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && task && task->done, tb_null);
 
-        // remove it from the waiting or urgent jobs
-        ok = tb_true;
+    // stoped?
+    tb_check_return_val(!tb_thread_pool_value(&impl->bstoped), tb_null);
 
-        // refn--
-        if (job->refn > 1) job->refn--;
-        // remove it from pool directly
-        else 
-        {
-            // the pool
-            tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
-            tb_assert(impl);
+    // make job
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_init(impl, worker, task);
+    tb_assert_and_check_return_val(job, tb_null);
 
-            // remove it from the jobs pool
-            tb_fixed_pool_free(impl->jobs_pool, job);
-        }
+    // the job will be freed by the worker once it is posted, so we must add the reference of the task handle first
+    job->refn = refn;
+
+    // post it
+    if (!tb_thread_pool_jobs_post(impl, worker, job))
+    {
+        // trace
+        tb_trace_e("task[%p:%s]: post failed, too many jobs!", task->done, task->name);
+
+        // exit it, it has been counted and will be counted as freed
+        job->refn = 1;
+        tb_thread_pool_jobs_exit(impl, worker, job);
+        return tb_null;
     }
 
-    // remove it?
-    return ok;
+    // ok
+    return job;
 }
-static tb_bool_t tb_thread_pool_worker_walk_clean(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+
+static tb_thread_pool_job_t* tb_thread_pool_jobs_post_after(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_task_t const* task, tb_size_t refn, tb_thread_pool_task_ref_t const* deps, tb_size_t deps_size)
 {
-    // the worker pull
-    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)value;
-    tb_assert(worker && worker->jobs);
+    // check
+    tb_assert_and_check_return_val(impl && task && task->done && (deps || !deps_size), tb_null);
 
-    // the job
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert(job);
+    // stoped?
+    tb_check_return_val(!tb_thread_pool_value(&impl->bstoped), tb_null);
 
-    // the job state
-    tb_size_t state = tb_atomic_get(&job->state);
+    // make job
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_init(impl, worker, task);
+    tb_assert_and_check_return_val(job, tb_null);
 
-    // finished or killed? remove it
-    tb_bool_t ok = tb_false;
-    if (state == TB_STATE_FINISHED || state == TB_STATE_KILLED)
-    {
-        // trace
-        tb_trace_d("worker[%lu]: remove: task[%p:%s] from pending", worker->id, job->task.done, job->task.name);
+    // init the references and the predecessors count with one reference for linking them
+    job->refn = refn;
+    job->deps = deps_size + 1;
 
-        // exit the job
-        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+    // count it now, it will be pushed once all predecessors have been done
+    tb_thread_pool_jobs_count(impl, worker);
 
-        // remove it from the pending jobs
-        ok = tb_true;
+    // link it to all predecessors
+    tb_size_t i = 0;
+    for (i = 0; i < deps_size; i++)
+    {
+        // the predecessor
+        tb_thread_pool_job_t* prev = (tb_thread_pool_job_t*)deps[i];
+        tb_assert(prev);
 
-        // refn--
-        if (job->refn > 1) job->refn--;
-        // remove it from pool directly
-        else 
+        // link it
+        tb_thread_pool_link_t* link = prev? tb_malloc0_type(tb_thread_pool_link_t) : tb_null;
+        if (link)
         {
-            // the pool
-            tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
-            tb_assert(impl);
+            link->job = job;
+            if (tb_thread_pool_jobs_link(prev, link)) continue;
 
-            // remove it from the jobs pool
-            tb_fixed_pool_free(impl->jobs_pool, job);
+            // the predecessor has been done
+            tb_free(link);
+            if (tb_atomic_get(&prev->state) == TB_STATE_FINISHED)
+            {
+                tb_atomic_fetch_and_dec(&job->deps);
+                continue;
+            }
         }
+
+        // the predecessor has been killed or we cannot link it? kill this job
+        tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+        tb_atomic_fetch_and_dec(&job->deps);
     }
 
-    // remove it?
-    return ok;
+    // release the linking reference, and push it if all predecessors have been done
+    if (tb_atomic_fetch_and_dec(&job->deps) == 1)
+    {
+        tb_bool_t ok = tb_thread_pool_jobs_push(impl, worker, job, tb_true);
+        tb_assert(ok); tb_used(ok);
+    }
+
+    // ok
+    return job;
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * worker implementation
+ */
+static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv);
 static tb_void_t tb_thread_pool_worker_post(tb_thread_pool_impl_t* impl, tb_size_t post)
 {
     // check
     tb_assert_and_check_return(impl && impl->semaphore);
 
+    // the posted jobs must be visible before checking the idle workers
+    tb_barrier();
+
+    // no idle workers?
+    tb_long_t idle = tb_thread_pool_value(&impl->idle);
+    tb_check_return(idle > 0);
+
     // the semaphore value
     tb_long_t value = tb_semaphore_value(impl->semaphore);
 
-    // post wait
-    if (value >= 0 && (tb_size_t)value < post) 
-        tb_semaphore_post(impl->semaphore, post - value);
+    // wake up the idle workers which have not been posted
+    if (value >= 0 && value < idle) 
+        tb_semaphore_post(impl->semaphore, tb_min(post, (tb_size_t)(idle - value)));
+}
+static tb_void_t tb_thread_pool_worker_spawn(tb_thread_pool_impl_t* impl)
+{
+    // all workers are busy and we can spawn more workers?
+    tb_check_return(    !tb_thread_pool_value(&impl->idle) 
+                    &&  tb_thread_pool_value(&impl->worker_size) < impl->worker_maxn);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // spawn a new worker
+    tb_size_t i = impl->worker_size;
+    if (i < impl->worker_maxn && !tb_thread_pool_value(&impl->bstoped))
+    {
+        // the worker 
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+        // init worker
+        tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
+        worker->id      = i;
+        worker->pool    = (tb_thread_pool_ref_t)impl;
+        worker->seed    = (tb_uint32_t)i * 2654435761u + 1;
+        if (tb_thread_pool_deque_init(&worker->deque))
+        {
+            // the worker must be inited before the thieves see it
+            tb_thread_pool_store((tb_atomic_t*)&impl->worker_size, i + 1);
+
+            // init loop
+            worker->loop = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
+            tb_assert(worker->loop);
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_pull_overflow(tb_thread_pool_worker_t* worker, tb_list_entry_head_ref_t jobs)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // pull the first job, and push some others to the deque of this worker
+    tb_size_t               count = 0;
+    tb_thread_pool_job_t*   job = tb_null;
+    while (tb_list_entry_size(jobs) && count < TB_THREAD_POOL_JOBS_PULL_MAXN)
+    {
+        tb_thread_pool_job_t* next = (tb_thread_pool_job_t*)tb_list_entry(jobs, tb_list_entry_head(jobs));
+        if (job && !tb_thread_pool_deque_push(&worker->deque, next)) break;
+        tb_list_entry_remove_head(jobs);
+        if (!job) job = next;
+        count++;
+    }
+    tb_atomic_fetch_and_sub(&impl->jobs_overflow, count);
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_pull(tb_thread_pool_worker_t* worker)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+
+    // pull the urgent jobs first
+    tb_pointer_t data = tb_null;
+    if (tb_mpmc_queue_try_get(impl->jobs_inject_urgent, &data)) return (tb_thread_pool_job_t*)data;
+    if (tb_thread_pool_value(&impl->jobs_overflow) && tb_list_entry_size(&impl->jobs_urgent))
+    {
+        tb_thread_pool_job_t* job = tb_thread_pool_worker_pull_overflow(worker, &impl->jobs_urgent);
+        if (job) return job;
+    }
+
+    // pop the job from the deque of this worker
+    tb_thread_pool_job_t* job = tb_thread_pool_deque_pop(&worker->deque);
+    if (job) return job;
+
+    // pull some injected jobs, and push others to the deque of this worker
+    tb_pointer_t list[TB_THREAD_POOL_JOBS_PULL_MAXN];
+    tb_size_t    size = tb_mpmc_queue_get_list(impl->jobs_inject, list, TB_THREAD_POOL_JOBS_PULL_MAXN);
+    if (size)
+    {
+        tb_size_t i = 1;
+        for (i = 1; i < size; i++) 
+        {
+            // the deque is empty now, it will not be full
+            tb_bool_t ok = tb_thread_pool_deque_push(&worker->deque, (tb_thread_pool_job_t*)list[i]);
+            tb_assert(ok); tb_used(ok);
+        }
+        return (tb_thread_pool_job_t*)list[0];
+    }
+
+    // pull the overflow jobs
+    if (tb_thread_pool_value(&impl->jobs_overflow) && tb_list_entry_size(&impl->jobs_waiting))
+    {
+        job = tb_thread_pool_worker_pull_overflow(worker, &impl->jobs_waiting);
+        if (job) return job;
+    }
+
+    // steal the job from other workers, starting at the random victim
+    tb_size_t n = tb_thread_pool_value(&impl->worker_size);
+    if (n > 1)
+    {
+        // the next random value, xorshift32
+        worker->seed ^= worker->seed << 13;
+        worker->seed ^= worker->seed >> 17;
+        worker->seed ^= worker->seed << 5;
+
+        // steal it
+        tb_size_t i = 0;
+        tb_size_t victim = worker->seed % n;
+        for (i = 0; i < n; i++, victim = (victim + 1 < n)? victim + 1 : 0)
+        {
+            if (victim != worker->id && (job = tb_thread_pool_deque_steal(&impl->worker_list[victim].deque))) 
+                return job;
+        }
+    }
+
+    // no jobs
+    return tb_null;
+}
+static tb_void_t tb_thread_pool_worker_done(tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+
+    // the pool has been killed after posting it? kill it if be waiting
+    if (job->epoch != (tb_size_t)tb_thread_pool_value(&impl->epoch)) 
+        tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+
+    // the job state
+    tb_size_t state = tb_atomic_fetch_and_pset(&job->state, TB_STATE_WAITING, TB_STATE_WORKING);
+    
+    // the job is waiting? work it
+    if (state == TB_STATE_WAITING)
+    {
+        // done the job
+        job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // update the job state
+        tb_atomic_set(&job->state, TB_STATE_FINISHED);
+    }
+    // the job is killing? work it
+    else if (state == TB_STATE_KILLING)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: kill: task[%p:%s]", worker->id, job->task.done, job->task.name);
+
+        // update the job state
+        tb_atomic_set(&job->state, TB_STATE_KILLED);
+    }
+
+    // exit the job
+    if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+    // release the successors, they will be killed if this job has not been finished
+    tb_size_t post = tb_thread_pool_jobs_unlink(impl, worker, job, state != TB_STATE_WAITING);
+
+    // free it
+    tb_thread_pool_jobs_exit(impl, worker, job);
+
+    // spawn or wake up the workers for the successors
+    if (post)
+    {
+        tb_thread_pool_worker_spawn(impl);
+        tb_thread_pool_worker_post(impl, post);
+    }
 }
 static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
 {
@@ -397,188 +863,66 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
     do
     {
         // check
-        tb_assert_and_check_break(worker && !worker->jobs && !worker->stats);
+        tb_assert_and_check_break(worker);
 
         // the pool
         tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
         tb_assert_and_check_break(impl && impl->semaphore);
 
-        // wait some time for leaving the lock
-        tb_msleep((worker->id + 1) * 20);
-
-        // init jobs
-        worker->jobs = tb_vector_init(TB_THREAD_POOL_JOBS_WORKING_GROW, tb_element_ptr(tb_null, tb_null));
-        tb_assert_and_check_break(worker->jobs);
+        // save the current worker
+#ifdef __tb_thread_local__
+        g_worker = worker;
+#endif
 
-        // init stats
-        worker->stats = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_ptr(tb_null, tb_null), tb_element_mem(sizeof(tb_thread_pool_job_stats_t), tb_null, tb_null));
-        tb_assert_and_check_break(worker->stats);
-        
         // loop
+        tb_size_t spin = 0;
         while (1)
         {
-            // pull jobs if be idle
-            if (!tb_vector_size(worker->jobs))
+            // pull and done the job
+            tb_thread_pool_job_t* job = tb_thread_pool_worker_pull(worker);
+            if (job)
             {
-                // enter 
-                tb_spinlock_enter(&impl->lock);
-
-                // init the pull time
-                worker->pull = 0;
-
-                // pull from the urgent jobs
-                if (tb_list_entry_size(&impl->jobs_urgent))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: try pulling from urgent: %lu", worker->id, tb_list_entry_size(&impl->jobs_urgent));
-
-                    // pull it
-                    tb_remove_if_until(tb_list_entry_itor(&impl->jobs_urgent), tb_thread_pool_worker_walk_pull, worker);
-                }
-
-                // pull from the waiting jobs
-                if (tb_list_entry_size(&impl->jobs_waiting))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: try pulling from waiting: %lu", worker->id, tb_list_entry_size(&impl->jobs_waiting));
-
-                    // pull it
-                    tb_remove_if_until(tb_list_entry_itor(&impl->jobs_waiting), tb_thread_pool_worker_walk_pull, worker);
-                }
-
-                // pull from the pending jobs and clean some finished and killed jobs
-                if (tb_list_entry_size(&impl->jobs_pending))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: try pulling from pending: %lu", worker->id, tb_list_entry_size(&impl->jobs_pending));
-
-                    // no jobs? try to pull from the pending jobs
-                    if (!tb_vector_size(worker->jobs))
-                        tb_remove_if(tb_list_entry_itor(&impl->jobs_pending), tb_thread_pool_worker_walk_pull_and_clean, worker);
-                    // clean some finished and killed jobs
-                    else tb_remove_if(tb_list_entry_itor(&impl->jobs_pending), tb_thread_pool_worker_walk_clean, worker);
-                }
-
-                // leave 
-                tb_spinlock_leave(&impl->lock);
-
-                // idle? wait it
-                if (!tb_vector_size(worker->jobs))
-                {
-                    // killed?
-                    tb_check_break(!tb_atomic_get(&worker->bstoped));
-
-                    // trace
-                    tb_trace_d("worker[%lu]: wait: ..", worker->id);
-
-                    // wait some time
-                    tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
-                    tb_assert_and_check_break(wait > 0);
-
-                    // trace
-                    tb_trace_d("worker[%lu]: wait: ok", worker->id);
-
-                    // continue it
-                    continue;
-                }
-                else
-                {
-#ifdef TB_TRACE_DEBUG
-                    // update the jobs urgent size
-                    tb_size_t jobs_urgent_size = tb_list_entry_size(&impl->jobs_urgent);
-
-                    // update the jobs waiting size
-                    tb_size_t jobs_waiting_size = tb_list_entry_size(&impl->jobs_waiting);
-
-                    // update the jobs pending size
-                    tb_size_t jobs_pending_size = tb_list_entry_size(&impl->jobs_pending);
-
-                    // trace
-                    tb_trace_d("worker[%lu]: pull: jobs: %lu, time: %lu ms, waiting: %lu, pending: %lu, urgent: %lu", worker->id, tb_vector_size(worker->jobs), worker->pull, jobs_waiting_size, jobs_pending_size, jobs_urgent_size);
-#endif
-                }
+                tb_thread_pool_worker_done(worker, job);
+                spin = 0;
+                continue;
             }
 
-            // done jobs
-            tb_for_all (tb_thread_pool_job_t*, job, worker->jobs)
+            // spin some time for the next jobs
+            if (spin < TB_THREAD_POOL_WORKER_SPIN)
             {
-                // check
-                tb_assert_and_check_continue(job && job->task.done);
-
-                // the job state
-                tb_size_t state = tb_atomic_fetch_and_pset(&job->state, TB_STATE_WAITING, TB_STATE_WORKING);
-                
-                // the job is waiting? work it
-                if (state == TB_STATE_WAITING)
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker->id, job->task.done, job->task.name);
-
-                    // init the time
-                    tb_hong_t time = tb_cache_time_spak();
-
-                    // done the job
-                    job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
-
-                    // computate the time
-                    time = tb_cache_time_spak() - time;
-
-                    // exists? update time and count
-                    tb_size_t               itor;
-                    tb_hash_map_item_ref_t  item = tb_null;
-                    if (    ((itor = tb_hash_map_find(worker->stats, job->task.done)) != tb_iterator_tail(worker->stats))
-                        &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(worker->stats, itor)))
-                    {
-                        // the stats
-                        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)item->data;
-                        tb_assert_and_check_break(stats);
-
-                        // update the done count
-                        stats->done_count++;
-
-                        // update the total time 
-                        stats->total_time += time;
-                    }
-                    
-                    // no item? add it
-                    if (!item) 
-                    {
-                        // init stats
-                        tb_thread_pool_job_stats_t stats = {0};
-                        stats.done_count = 1;
-                        stats.total_time = time;
-
-                        // add stats
-                        tb_hash_map_insert(worker->stats, job->task.done, &stats);
-                    }
-
-#ifdef TB_TRACE_DEBUG
-                    tb_size_t done_count = 0;
-                    tb_hize_t total_time = 0;
-                    tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-                    if (stats)
-                    {
-                        done_count = stats->done_count;
-                        total_time = stats->total_time;
-                    }
-
-                    // trace
-                    tb_trace_d("worker[%lu]: done: task[%p:%s]: time: %lld ms, average: %lld ms, count: %lu", worker->id, job->task.done, job->task.name, time, (total_time / (tb_hize_t)done_count), done_count);
-#endif
+                tb_sched_yield();
+                spin++;
+                continue;
+            }
 
-                    // update the job state
-                    tb_atomic_set(&job->state, TB_STATE_FINISHED);
-                }
-                // the job is killing? work it
-                else if (state == TB_STATE_KILLING)
-                {
-                    // update the job state
-                    tb_atomic_set(&job->state, TB_STATE_KILLED);
-                }
+            // park it, and pull it again to avoid missing the notification
+            tb_atomic_fetch_and_inc(&impl->idle);
+            if ((job = tb_thread_pool_worker_pull(worker)))
+            {
+                tb_atomic_fetch_and_dec(&impl->idle);
+                tb_thread_pool_worker_done(worker, job);
+                spin = 0;
+                continue;
             }
 
-            // clear jobs
-            tb_vector_clear(worker->jobs);
+            // killed?
+            if (tb_atomic_get(&worker->bstoped))
+            {
+                tb_atomic_fetch_and_dec(&impl->idle);
+                break;
+            }
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ..", worker->id);
+
+            // wait it
+            tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
+            tb_atomic_fetch_and_dec(&impl->idle);
+            tb_assert_and_check_break(wait > 0);
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ok", worker->id);
+            spin = 0;
         }
 
     } while (0);
@@ -608,144 +952,30 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
             priv->priv = tb_null;
         }
 
-        // exit stats
-        if (worker->stats) tb_hash_map_exit(worker->stats);
-        worker->stats = tb_null;
+        // exit the cached free jobs
+        while (worker->jobs_cache)
+        {
+            tb_thread_pool_job_t* job = worker->jobs_cache;
+            worker->jobs_cache = job->next;
+            tb_free(job);
+        }
+        worker->jobs_cache_size = 0;
 
-        // exit jobs
-        if (worker->jobs) tb_vector_exit(worker->jobs);
-        worker->jobs = tb_null;
+        // clear the current worker
+#ifdef __tb_thread_local__
+        g_worker = tb_null;
+#endif
     }
 
     // exit
     return 0;
 }
-
-/* //////////////////////////////////////////////////////////////////////////////////////
- * jobs implementation
- */
-static tb_bool_t tb_thread_pool_jobs_walk_kill_all(tb_pointer_t item, tb_cpointer_t priv)
-{
-    // check
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert_and_check_return_val(job, tb_false);
-
-    // trace
-    tb_trace_d("task[%p:%s]: kill: ..", job->task.done, job->task.name);
-
-    // kill it if be waiting
-    tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
-
-    // ok
-    return tb_true;
-}
-#ifdef __tb_debug__
-static tb_bool_t tb_thread_pool_jobs_walk_dump_all(tb_pointer_t item, tb_cpointer_t priv)
-{
-    // check
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert_and_check_return_val(job, tb_false);
-
-    // the state string
-    static tb_char_t const* s_state_cstr[] = 
-    {
-        "waiting"
-    ,   "working"
-    ,   "killed"
-    ,   "finished"
-    };
-    tb_assert_and_check_return_val(job->state < tb_arrayn(s_state_cstr), tb_false);
-
-    // trace
-    tb_trace_d("    task[%p:%s]: refn: %lu, state: %s", job->task.done, job->task.name, job->refn, s_state_cstr[job->state]);
-
-    // ok
-    return tb_true;
-}
-#endif
-static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_size_t* post_size)
+static tb_void_t tb_thread_pool_wait_some(tb_size_t* pdelay)
 {
-    // check
-    tb_assert_and_check_return_val(impl && task && task->done && post_size, tb_null);
-
-    // done
-    tb_bool_t               ok = tb_false;
-    tb_thread_pool_job_t*   job = tb_null;
-    do
-    {
-        // check
-        tb_assert_and_check_break(tb_list_entry_size(&impl->jobs_waiting) + tb_list_entry_size(&impl->jobs_urgent) + 1 < TB_THREAD_POOL_JOBS_WAITING_MAXN);
-
-        // make job
-        job = (tb_thread_pool_job_t*)tb_fixed_pool_malloc0(impl->jobs_pool);
-        tb_assert_and_check_break(job);
-
-        // init job
-        job->refn   = 1;
-        job->state  = TB_STATE_WAITING;
-        job->task   = *task;
-
-        // non-urgent job? 
-        if (!task->urgent)
-        {
-            // post to the waiting jobs
-            tb_list_entry_insert_tail(&impl->jobs_waiting, &job->entry);
-        }
-        else
-        {
-            // post to the urgent jobs
-            tb_list_entry_insert_tail(&impl->jobs_urgent, &job->entry);
-        }
-
-        // the waiting jobs count
-        tb_size_t jobs_waiting_count = tb_list_entry_size(&impl->jobs_waiting) + tb_list_entry_size(&impl->jobs_urgent);
-        tb_assert_and_check_break(jobs_waiting_count);
-
-        // update the post size
-        if (*post_size < impl->worker_size) (*post_size)++;
-
-        // trace
-        tb_trace_d("task[%p:%s]: post: %lu: ..", task->done, task->name, *post_size);
-
-        // init them if the workers have been not inited
-        if (impl->worker_size < jobs_waiting_count)
-        {
-            tb_size_t i = impl->worker_size;
-            tb_size_t n = tb_min(jobs_waiting_count, impl->worker_maxn);
-            for (; i < n; i++)
-            {
-                // the worker 
-                tb_thread_pool_worker_t* worker = &impl->worker_list[i];
-
-                // clear worker
-                tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
-
-                // init worker
-                worker->id          = i;
-                worker->pool        = (tb_thread_pool_ref_t)impl;
-                worker->loop        = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
-                tb_assert_and_check_continue(worker->loop);
-            }
-
-            // update the worker size
-            impl->worker_size = i;
-        }
-
-        // ok
-        ok = tb_true;
-    
-    } while (0);
-
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        tb_fixed_pool_free(impl->jobs_pool, job);
-        job = tb_null;
-    }
-
-    // ok?
-    return job;
+    // yield it first, and sleep it with the exponential backoff
+    if (*pdelay < 16) tb_sched_yield();
+    else tb_msleep(tb_min(1 << (*pdelay - 16), 200));
+    if (*pdelay < 24) (*pdelay)++;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -763,7 +993,7 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
     do
     {
         // make pool
-        impl = tb_malloc0_type(tb_thread_pool_impl_t);
+        impl = (tb_thread_pool_impl_t*)tb_align_malloc0(sizeof(tb_thread_pool_impl_t), TB_SMP_CACHE_BYTES);
         tb_assert_and_check_break(impl);
 
         // init lock
@@ -778,21 +1008,19 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
 
         // init workers
         impl->worker_size   = 0;
-        impl->worker_maxn   = worker_maxn;
+        impl->worker_maxn   = tb_min(worker_maxn, TB_THREAD_POOL_WORKER_MAXN);
 
-        // init jobs pool
-        impl->jobs_pool     = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
-        tb_assert_and_check_break(impl->jobs_pool);
+        // init the injected jobs
+        impl->jobs_inject_urgent = tb_mpmc_queue_init(TB_THREAD_POOL_JOBS_INJECT_MAXN, tb_false);
+        impl->jobs_inject        = tb_mpmc_queue_init(TB_THREAD_POOL_JOBS_INJECT_MAXN, tb_false);
+        tb_assert_and_check_break(impl->jobs_inject_urgent && impl->jobs_inject);
 
-        // init jobs urgent
+        // init the overflow urgent jobs
         tb_list_entry_init(&impl->jobs_urgent, tb_thread_pool_job_t, entry, tb_null);
 
-        // init jobs waiting
+        // init the overflow waiting jobs
         tb_list_entry_init(&impl->jobs_waiting, tb_thread_pool_job_t, entry, tb_null);
 
-        // init jobs pending
-        tb_list_entry_init(&impl->jobs_pending, tb_thread_pool_job_t, entry, tb_null);
-
         // init semaphore
         impl->semaphore = tb_semaphore_init(0);
         tb_assert_and_check_break(impl->semaphore);
@@ -839,7 +1067,7 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
     }
 
     /* exit all workers
-     * need not lock it because the worker size will not be increase d
+     * need not lock it because the worker size will not be increased
      */
     tb_size_t i = 0;
     tb_size_t n = impl->worker_size;
@@ -863,27 +1091,21 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
             tb_thread_exit(worker->loop);
             worker->loop = tb_null;
         }
+
+        // exit deque
+        tb_thread_pool_deque_exit(&worker->deque);
     }
     impl->worker_size = 0;
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // exit pending jobs
-    tb_list_entry_exit(&impl->jobs_pending);
-
-    // exit waiting jobs
+    // exit the overflow jobs
     tb_list_entry_exit(&impl->jobs_waiting);
-
-    // exit urgent jobs
     tb_list_entry_exit(&impl->jobs_urgent);
 
-    // exit jobs pool
-    if (impl->jobs_pool) tb_fixed_pool_exit(impl->jobs_pool);
-    impl->jobs_pool = tb_null;
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    // exit the injected jobs
+    if (impl->jobs_inject) tb_mpmc_queue_exit(impl->jobs_inject);
+    if (impl->jobs_inject_urgent) tb_mpmc_queue_exit(impl->jobs_inject_urgent);
+    impl->jobs_inject = tb_null;
+    impl->jobs_inject_urgent = tb_null;
 
     // exit lock
     tb_spinlock_exit(&impl->lock);
@@ -893,7 +1115,7 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
     impl->semaphore = tb_null;
 
     // exit it
-    tb_free(impl);
+    tb_align_free(impl);
 
     // trace
     tb_trace_d("exit: ok");
@@ -918,15 +1140,15 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
         tb_trace_d("kill: ..");
 
         // stoped
-        impl->bstoped = tb_true;
+        tb_atomic_set(&impl->bstoped, 1);
         
         // kill all workers
         tb_size_t i = 0;
         tb_size_t n = impl->worker_size;
         for (i = 0; i < n; i++) tb_atomic_set(&impl->worker_list[i].bstoped, 1);
 
-        // kill all jobs
-        if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+        // kill all waiting jobs
+        tb_atomic_fetch_and_inc(&impl->epoch);
 
         // post it
         post = impl->worker_size;
@@ -935,8 +1157,12 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
     // leave
     tb_spinlock_leave(&impl->lock);
 
-    // post the workers
-    if (post) tb_thread_pool_worker_post(impl, post);
+    // wake up all workers
+    if (post) 
+    {
+        tb_long_t value = tb_semaphore_value(impl->semaphore);
+        if (value >= 0 && (tb_size_t)value < post) tb_semaphore_post(impl->semaphore, post - value);
+    }
 }
 tb_size_t tb_thread_pool_worker_size(tb_thread_pool_ref_t pool)
 {
@@ -944,17 +1170,8 @@ tb_size_t tb_thread_pool_worker_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
     // the worker size
-    tb_size_t worker_size = impl->worker_size;
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // ok?
-    return worker_size;
+    return tb_thread_pool_value(&impl->worker_size);
 }
 tb_void_t tb_thread_pool_worker_setp(tb_thread_pool_worker_ref_t worker, tb_size_t index, tb_thread_pool_priv_exit_func_t exit, tb_cpointer_t priv)
 {
@@ -981,17 +1198,8 @@ tb_size_t tb_thread_pool_task_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
     // the task size
-    tb_size_t task_size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // ok?
-    return task_size;
+    return tb_thread_pool_jobs_size(impl);
 }
 tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv, tb_bool_t urgent)
 {
@@ -999,44 +1207,24 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_false);
 
-    // init the post size
-    tb_size_t post_size = 0;
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
+    task.urgent     = urgent;
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
+    // post task
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, tb_thread_pool_worker_self(impl), &task, 1);
+    tb_check_return_val(job, tb_false);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // stoped?
-        tb_check_break(!impl->bstoped);
-
-        // init task
-        tb_thread_pool_task_t task = {0};
-        task.name       = name;
-        task.done       = done;
-        task.exit       = exit;
-        task.priv       = priv;
-        task.urgent     = urgent;
-
-        // post task
-        tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, &task, &post_size);
-        tb_assert_and_check_break(job);
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
+    // spawn or wake up the workers
+    tb_thread_pool_worker_spawn(impl);
+    tb_thread_pool_worker_post(impl, 1);
 
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // post the workers
-    if (ok && post_size) tb_thread_pool_worker_post(impl, post_size);
-
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_pool_task_t const* list, tb_size_t size)
 {
@@ -1044,29 +1232,20 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && list, 0);
 
-    // init the post size
-    tb_size_t post_size = 0;
-
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // done
-    tb_size_t ok = 0;
-    if (!impl->bstoped)
+    // post tasks
+    tb_size_t                   ok = 0;
+    tb_thread_pool_worker_t*    worker = tb_thread_pool_worker_self(impl);
+    for (ok = 0; ok < size; ok++)
     {
-        for (ok = 0; ok < size; ok++)
-        {
-            // post task
-            tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, &list[ok], &post_size);
-            tb_assert_and_check_break(job);
-        }
+        if (!tb_thread_pool_jobs_post_task(impl, worker, &list[ok], 1)) break;
     }
 
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // post the workers
-    if (ok && post_size) tb_thread_pool_worker_post(impl, post_size);
+    // spawn or wake up the workers
+    if (ok)
+    {
+        tb_thread_pool_worker_spawn(impl);
+        tb_thread_pool_worker_post(impl, ok);
+    }
 
     // ok?
     return ok;
@@ -1077,51 +1256,81 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_null);
 
-    // init the post size
-    tb_size_t post_size = 0;
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
+    task.urgent     = urgent;
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
+    // post task, the task handle has one reference
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, tb_thread_pool_worker_self(impl), &task, 2);
+    tb_check_return_val(job, tb_null);
 
-    // done
-    tb_bool_t               ok = tb_false;
-    tb_thread_pool_job_t*   job = tb_null;
-    do
-    {
-        // stoped?
-        tb_check_break(!impl->bstoped);
+    // spawn or wake up the workers
+    tb_thread_pool_worker_spawn(impl);
+    tb_thread_pool_worker_post(impl, 1);
 
-        // init task
-        tb_thread_pool_task_t task = {0};
-        task.name       = name;
-        task.done       = done;
-        task.exit       = exit;
-        task.priv       = priv;
-        task.urgent     = urgent;
+    // ok
+    return (tb_thread_pool_task_ref_t)job;
+}
+tb_bool_t tb_thread_pool_task_post_after(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t const* deps, tb_size_t deps_size, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv)
+{
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
+    tb_assert_and_check_return_val(impl && done, tb_false);
 
-        // post task
-        job = tb_thread_pool_jobs_post_task(impl, &task, &post_size);
-        tb_assert_and_check_break(job);
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
 
-        // refn++
-        job->refn++;
+    // post task after all predecessors
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_after(impl, tb_thread_pool_worker_self(impl), &task, 1, deps, deps_size);
+    tb_check_return_val(job, tb_false);
 
-        // ok
-        ok = tb_true;
+    // spawn or wake up the workers
+    tb_thread_pool_worker_spawn(impl);
+    tb_thread_pool_worker_post(impl, 1);
 
-    } while (0);
+    // ok
+    return tb_true;
+}
+tb_thread_pool_task_ref_t tb_thread_pool_task_init_after(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t const* deps, tb_size_t deps_size, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv)
+{
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
+    tb_assert_and_check_return_val(impl && done, tb_null);
 
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
 
-    // post the workers
-    if (ok && post_size) tb_thread_pool_worker_post(impl, post_size);
-    // failed?
-    else if (!ok) job = tb_null;
+    // post task after all predecessors, the task handle has one reference
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_after(impl, tb_thread_pool_worker_self(impl), &task, 2, deps, deps_size);
+    tb_check_return_val(job, tb_null);
 
-    // ok?
+    // spawn or wake up the workers
+    tb_thread_pool_worker_spawn(impl);
+    tb_thread_pool_worker_post(impl, 1);
+
+    // ok
     return (tb_thread_pool_task_ref_t)job;
 }
+tb_thread_pool_task_ref_t tb_thread_pool_task_then(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t task, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(task, tb_null);
+
+    // init the continuation task after it
+    return tb_thread_pool_task_init_after(pool, &task, 1, name, done, exit, priv);
+}
 tb_void_t tb_thread_pool_task_kill(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t task)
 {
     // check
@@ -1140,15 +1349,8 @@ tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return(impl);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // kill all jobs
-    if (!impl->bstoped && impl->jobs_pool) 
-        tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    // kill all waiting jobs, they will be killed when the workers pull them
+    if (!tb_thread_pool_value(&impl->bstoped)) tb_atomic_fetch_and_inc(&impl->epoch);
 }
 tb_long_t tb_thread_pool_task_wait(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t task, tb_long_t timeout)
 {
@@ -1157,17 +1359,15 @@ tb_long_t tb_thread_pool_task_wait(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     tb_assert_and_check_return_val(pool && job, -1);
 
     // wait it
+    tb_size_t delay = 0;
     tb_hong_t time = tb_cache_time_spak();
     tb_size_t state = TB_STATE_WAITING;
     while ( ((state = tb_atomic_get(&job->state)) != TB_STATE_FINISHED) 
         &&  state != TB_STATE_KILLED
         &&  (timeout < 0 || tb_cache_time_spak() < time + timeout))
     {
-        // trace
-        tb_trace_d("task[%p:%s]: wait: state: %s: ..", job->task.done, job->task.name, tb_state_cstr(state));
-
         // wait some time
-        tb_msleep(200);
+        tb_thread_pool_wait_some(&delay);
     }
 
     // ok?
@@ -1181,37 +1381,21 @@ tb_long_t tb_thread_pool_task_wait_all(tb_thread_pool_ref_t pool, tb_long_t time
 
     // wait it
     tb_size_t size = 0;
+    tb_size_t delay = 0;
     tb_hong_t time = tb_cache_time_spak();
     while ((timeout < 0 || tb_cache_time_spak() < time + timeout))
     {
-        // enter
-        tb_spinlock_enter(&impl->lock);
-
         // the jobs count
-        size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
-
-        // trace
-        tb_trace_d("wait: jobs: %lu, waiting: %lu, pending: %lu, urgent: %lu: .."
-                    , size
-                    , tb_list_entry_size(&impl->jobs_waiting)
-                    , tb_list_entry_size(&impl->jobs_pending) 
-                    , tb_list_entry_size(&impl->jobs_urgent));
-
-#if 0
-        tb_for_all_if (tb_thread_pool_job_t*, job, tb_list_entry_itor(&impl->jobs_pending), job)
-        {
-            tb_trace_d("wait: job: %s from pending", tb_state_cstr(tb_atomic_get(&job->state)));
-        }
-#endif
-
-        // leave
-        tb_spinlock_leave(&impl->lock);
+        size = tb_thread_pool_jobs_size(impl);
 
         // ok?
         tb_check_break(size);
 
+        // trace
+        if (delay == 24) tb_trace_d("wait: jobs: %lu: ..", size);
+
         // wait some time
-        tb_msleep(200);
+        tb_thread_pool_wait_some(&delay);
     }
 
     // ok?
@@ -1227,16 +1411,8 @@ tb_void_t tb_thread_pool_task_exit(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // kill it first
     tb_thread_pool_task_kill(pool, task);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // refn--
-    if (job->refn > 1) job->refn--;
-    // remove it from pool directly
-    else tb_fixed_pool_free(impl->jobs_pool, job);
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    // refn--, remove it from pool if no references
+    tb_thread_pool_jobs_exit(impl, tb_thread_pool_worker_self(impl), job);
 }
 #ifdef __tb_debug__
 tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
@@ -1253,7 +1429,7 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
     {
         // trace
         tb_trace_i("");
-        tb_trace_i("workers: size: %lu, maxn: %lu", impl->worker_size, impl->worker_maxn);
+        tb_trace_i("workers: size: %lu, maxn: %lu, idle: %ld", impl->worker_size, impl->worker_maxn, (tb_long_t)tb_thread_pool_value(&impl->idle));
 
         // walk
         tb_size_t i = 0;
@@ -1264,21 +1440,14 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
             tb_assert_and_check_break(worker);
 
             // dump worker
-            tb_trace_i("    worker: id: %lu, stoped: %ld", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped));
+            tb_trace_i("    worker: id: %lu, stoped: %ld, deque: %lu, posted: %lu, freed: %lu", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped), tb_thread_pool_deque_size(&worker->deque), worker->jobs_posted, worker->jobs_freed);
         }
 
         // trace
         tb_trace_i("");
 
-        // dump all jobs
-        if (impl->jobs_pool) 
-        {
-            // trace
-            tb_trace_i("jobs: size: %lu", tb_fixed_pool_size(impl->jobs_pool));
-
-            // dump jobs
-            tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_dump_all, tb_null);
-        }
+        // dump jobs
+        tb_trace_i("jobs: size: %lu, inject: %lu, urgent: %lu, overflow: %lu", tb_thread_pool_jobs_size(impl), tb_mpmc_queue_size(impl->jobs_inject), tb_mpmc_queue_size(impl->jobs_inject_urgent), tb_list_entry_size(&impl->jobs_urgent) + tb_list_entry_size(&impl->jobs_waiting));
     }
 
     // leave
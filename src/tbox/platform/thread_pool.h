@@ -192,6 +192,67 @@ tb_size_t                   tb_thread_pool_task_post_list(tb_thread_pool_ref_t p
  */
 tb_thread_pool_task_ref_t   tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv, tb_bool_t urgent);
 
+/*! post one task after the given tasks
+ *
+ * the task will be posted automatically once all given tasks have been done,
+ * and it will be killed if any of them has been killed.
+ *
+ * @param pool              the thread pool 
+ * @param deps              the predecessor task handles, they need be alive until this function returns
+ * @param deps_size         the predecessor task count
+ * @param name              the task name, optional
+ * @param done              the task done func
+ * @param exit              the task exit func, optional
+ * @param priv              the task private data
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_thread_pool_task_post_after(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t const* deps, tb_size_t deps_size, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv);
+
+/*! init one task after the given tasks
+ *
+ * the returned task handle can be waited or be used as the predecessor of other tasks, 
+ * so we can submit the task graph without blocking any threads.
+ *
+ * @code
+    tb_thread_pool_task_ref_t load  = tb_thread_pool_task_init(pool, "load", tb_demo_load, tb_null, file, tb_false);
+    tb_thread_pool_task_ref_t parse = tb_thread_pool_task_then(pool, load, "parse", tb_demo_parse, tb_null, file);
+    tb_thread_pool_task_ref_t index = tb_thread_pool_task_then(pool, parse, "index", tb_demo_index, tb_null, file);
+
+    // ...
+
+    // all predecessors have been done after waiting the last task, and the handles can be exited now
+    tb_thread_pool_task_wait(pool, index, -1);
+    tb_thread_pool_task_exit(pool, index);
+    tb_thread_pool_task_exit(pool, parse);
+    tb_thread_pool_task_exit(pool, load);
+ * @endcode
+ *
+ * @param pool              the thread pool 
+ * @param deps              the predecessor task handles, they need be alive until this function returns
+ * @param deps_size         the predecessor task count
+ * @param name              the task name, optional
+ * @param done              the task done func
+ * @param exit              the task exit func, optional
+ * @param priv              the task private data
+ *
+ * @return                  the thread pool task
+ */
+tb_thread_pool_task_ref_t   tb_thread_pool_task_init_after(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t const* deps, tb_size_t deps_size, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv);
+
+/*! init the continuation task of the given task
+ *
+ * @param pool              the thread pool 
+ * @param task              the predecessor task handle
+ * @param name              the task name, optional
+ * @param done              the task done func
+ * @param exit              the task exit func, optional
+ * @param priv              the task private data
+ *
+ * @return                  the thread pool task
+ */
+tb_thread_pool_task_ref_t   tb_thread_pool_task_then(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t task, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv);
+
 /*! kill the waiting task
  *
  * @param pool              the thread pool 
@@ -36,7 +36,6 @@
 #include "platform.h"
 #include "../memory/memory.h"
 #include "../container/container.h"
-#include "../algorithm/algorithm.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +45,9 @@
 // the timer task type
 typedef struct __tb_timer_task_t
 {
+    // the heap entry
+    tb_heap_entry_t             entry;
+
     // the func
     tb_timer_task_func_t        func;
 
@@ -91,7 +93,7 @@ typedef struct __tb_timer_t
     tb_fixed_pool_ref_t         pool;
 
     // the heap
-    tb_heap_ref_t               heap;
+    tb_heap_entry_head_t        heap;
 
     // the event
     tb_event_ref_t              event;
@@ -114,20 +116,21 @@ static __tb_inline__ tb_hong_t tb_timer_now(tb_timer_t* timer)
     // using cached time
     return tb_cache_time_mclock();
 }
-static tb_long_t tb_timer_comp_by_when(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+static tb_long_t tb_timer_comp_by_when(tb_cpointer_t litem, tb_cpointer_t ritem)
 {
     // check
-    tb_timer_task_t const* ltask = (tb_timer_task_t const*)ldata;
-    tb_timer_task_t const* rtask = (tb_timer_task_t const*)rdata;
+    tb_timer_task_t const* ltask = (tb_timer_task_t const*)litem;
+    tb_timer_task_t const* rtask = (tb_timer_task_t const*)ritem;
     tb_assert_and_check_return_val(ltask && rtask, -1);
 
     // comp
     return (ltask->when > rtask->when? 1 : (ltask->when < rtask->when? -1 : 0));
 }
-static tb_bool_t tb_timer_pred_by_task(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static __tb_inline__ tb_timer_task_t* tb_timer_task_top(tb_timer_t* timer)
 {
-    // is equal?
-    return item == value;
+    // the top task
+    tb_heap_entry_ref_t entry = tb_heap_entry_top(&timer->heap);
+    return entry? (tb_timer_task_t*)tb_heap_entry(&timer->heap, entry) : tb_null;
 }
 static tb_int_t tb_timer_instance_loop(tb_cpointer_t priv)
 {
@@ -223,9 +226,6 @@ tb_timer_ref_t tb_timer_init(tb_size_t grow, tb_bool_t ctime)
         timer = tb_malloc0_type(tb_timer_t);
         tb_assert_and_check_break(timer);
 
-        // init element
-        tb_element_t element = tb_element_ptr(tb_null, tb_null); element.comp = tb_timer_comp_by_when;
-
         // init timer
         timer->grow         = tb_max(grow, 16);
         timer->ctime        = ctime;
@@ -238,8 +238,7 @@ tb_timer_ref_t tb_timer_init(tb_size_t grow, tb_bool_t ctime)
         tb_assert_and_check_break(timer->pool);
         
         // init heap
-        timer->heap         = tb_heap_init(timer->grow, element);
-        tb_assert_and_check_break(timer->heap);
+        tb_heap_entry_init(&timer->heap, tb_timer_task_t, entry, timer->grow, tb_timer_comp_by_when);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -284,8 +283,7 @@ tb_void_t tb_timer_exit(tb_timer_ref_t self)
     tb_spinlock_enter(&timer->lock);
 
     // exit heap
-    if (timer->heap) tb_heap_exit(timer->heap);
-    timer->heap = tb_null;
+    tb_heap_entry_exit(&timer->heap);
 
     // exit pool
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
@@ -331,7 +329,7 @@ tb_void_t tb_timer_clear(tb_timer_ref_t self)
         tb_spinlock_enter(&timer->lock);
 
         // clear heap
-        if (timer->heap) tb_heap_clear(timer->heap);
+        tb_heap_entry_clear(&timer->heap);
 
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
@@ -344,7 +342,7 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer, -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), -1);
@@ -354,12 +352,8 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
 
     // done
     tb_hize_t when = -1; 
-    if (tb_heap_size(timer->heap))
-    {
-        // the task
-        tb_timer_task_t const* timer_task = (tb_timer_task_t const*)tb_heap_top(timer->heap);
-        if (timer_task) when = timer_task->when;
-    }
+    tb_timer_task_t const* timer_task = tb_timer_task_top(timer);
+    if (timer_task) when = timer_task->when;
 
     // leave
     tb_spinlock_leave(&timer->lock);
@@ -371,7 +365,7 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer, -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), -1);
@@ -381,18 +375,14 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 
     // done
     tb_size_t delay = -1; 
-    if (tb_heap_size(timer->heap))
+    tb_timer_task_t const* timer_task = tb_timer_task_top(timer);
+    if (timer_task)
     {
-        // the task
-        tb_timer_task_t const* timer_task = (tb_timer_task_t const*)tb_heap_top(timer->heap);
-        if (timer_task)
-        {
-            // the now
-            tb_hong_t now = tb_timer_now(timer);
+        // the now
+        tb_hong_t now = tb_timer_now(timer);
 
-            // the delay
-            delay = timer_task->when > now? (tb_size_t)(timer_task->when - now) : 0;
-        }
+        // the delay
+        delay = timer_task->when > now? (tb_size_t)(timer_task->when - now) : 0;
     }
 
     // leave
@@ -405,7 +395,7 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool, tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_get(&timer->stop), tb_false);
@@ -420,17 +410,16 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
     tb_bool_t               killed = tb_false;
     do
     {
+        // the top task
+        tb_timer_task_t* timer_task = tb_timer_task_top(timer);
+
         // empty? 
-        if (!tb_heap_size(timer->heap))
+        if (!timer_task)
         {
             ok = tb_true;
             break;
         }
 
-        // the top task
-        tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
-        tb_assert_and_check_break(timer_task);
-
         // check refn
         tb_assert(timer_task->refn);
 
@@ -440,9 +429,6 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
         // timeout?
         if (timer_task->when <= now)
         {
-            // pop it
-            tb_heap_pop(timer->heap);
-
             // save func and data for calling it later
             func = timer_task->func;
             priv = timer_task->priv;
@@ -457,10 +443,13 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
                 timer_task->when = now + timer_task->period;
 
                 // continue timer_task
-                tb_heap_put(timer->heap, timer_task);
+                tb_heap_entry_update(&timer->heap, &timer_task->entry);
             }
             else 
             {
+                // pop it
+                tb_heap_entry_pop(&timer->heap);
+
                 // refn--
                 if (timer_task->refn > 1) timer_task->refn--;
                 // remove it from pool directly
@@ -536,7 +525,7 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap && func, tb_null);
+    tb_assert_and_check_return_val(timer && timer->pool && func, tb_null);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), tb_null);
@@ -551,11 +540,8 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
     if (timer_task)
     {
         // the top when 
-        if (tb_heap_size(timer->heap))
-        {
-            tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
-            if (timer_task) when_top = timer_task->when;
-        }
+        tb_timer_task_t const* timer_top = tb_timer_task_top(timer);
+        if (timer_top) when_top = timer_top->when;
 
         // init task
         timer_task->refn      = 2;
@@ -564,9 +550,14 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
         timer_task->when      = when;
         timer_task->period    = period;
         timer_task->repeat    = repeat? 1 : 0;
+        tb_heap_entry_entry_init(&timer_task->entry);
 
         // add task
-        tb_heap_put(timer->heap, timer_task);
+        if (!tb_heap_entry_put(&timer->heap, &timer_task->entry))
+        {
+            tb_fixed_pool_free(timer->pool, timer_task);
+            timer_task = tb_null;
+        }
 
         // the event
         event = timer->event;
@@ -604,7 +595,7 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return(timer && timer->pool && timer->heap && func);
+    tb_assert_and_check_return(timer && timer->pool && func);
 
     // stoped?
     tb_assert_and_check_return(!tb_atomic_get(&timer->stop));
@@ -619,11 +610,8 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
     if (timer_task)
     {
         // the top when 
-        if (tb_heap_size(timer->heap))
-        {
-            tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
-            if (timer_task) when_top = timer_task->when;
-        }
+        tb_timer_task_t const* timer_top = tb_timer_task_top(timer);
+        if (timer_top) when_top = timer_top->when;
 
         // init task
         timer_task->refn      = 1;
@@ -632,9 +620,14 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
         timer_task->when      = when;
         timer_task->period    = period;
         timer_task->repeat    = repeat? 1 : 0;
+        tb_heap_entry_entry_init(&timer_task->entry);
 
         // add task
-        tb_heap_put(timer->heap, timer_task);
+        if (!tb_heap_entry_put(&timer->heap, &timer_task->entry))
+        {
+            tb_fixed_pool_free(timer->pool, timer_task);
+            timer_task = tb_null;
+        }
 
         // the event
         event = timer->event;
@@ -669,19 +662,11 @@ tb_void_t tb_timer_task_exit(tb_timer_ref_t self, tb_timer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // remove it?
-    if (timer_task->refn > 1)
-    {
-        // refn--
-        timer_task->refn--;
+    // remove it from the heap if the timer_task have been not expired
+    if (tb_heap_entry_is_in(&timer_task->entry)) tb_heap_entry_remove(&timer->heap, &timer_task->entry);
 
-        // cancel task 
-        timer_task->func      = tb_null;
-        timer_task->priv      = tb_null;
-        timer_task->repeat    = 0;
-    }
-    // remove it from pool directly if the timer_task have been expired 
-    else tb_fixed_pool_free(timer->pool, timer_task);
+    // remove it from pool directly
+    tb_fixed_pool_free(timer->pool, timer_task);
 
     // leave
     tb_spinlock_leave(&timer->lock);
@@ -705,13 +690,6 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
         // expired or removed?
         tb_check_break(timer_task->refn == 2);
 
-        // find it
-        tb_size_t itor = tb_find_all_if(timer->heap, tb_timer_pred_by_task, timer_task);
-        tb_assert_and_check_break(itor != tb_iterator_tail(timer->heap));
-
-        // remove this task
-        tb_heap_remove(timer->heap, itor);
-
         // killed
         timer_task->killed = 1;
 
@@ -721,8 +699,8 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
         // modify when => now
         timer_task->when = tb_timer_now(timer);
 
-        // re-add timer_task
-        tb_heap_put(timer->heap, timer_task);
+        // move it to the top of the heap
+        tb_heap_entry_update(&timer->heap, &timer_task->entry);
 
     } while (0);
 
@@ -376,6 +376,28 @@ tb_hize_t tb_file_size(tb_file_ref_t file)
     LARGE_INTEGER p = {{0}};
     return pGetFileSizeEx(file, &p)? (tb_hong_t)p.QuadPart : 0;
 }
+tb_byte_t const* tb_file_map(tb_file_ref_t file, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(file && size, tb_null);
+
+    // init the file mapping
+    HANDLE mapping = CreateFileMappingW((HANDLE)file, tb_null, PAGE_READONLY, 0, 0, tb_null);
+    tb_check_return_val(mapping, tb_null);
+
+    // map it, the view will keep the file mapping alive after closing it
+    tb_byte_t const* data = (tb_byte_t const*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)size);
+    CloseHandle(mapping);
+    return data;
+}
+tb_bool_t tb_file_unmap(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // unmap it
+    return UnmapViewOfFile((LPCVOID)data)? tb_true : tb_false;
+}
 tb_bool_t tb_file_info(tb_char_t const* path, tb_file_info_t* info)
 {
     // check
@@ -29,6 +29,7 @@
 #include "prefix.h"
 #include "../sched.h"
 #include "../memory.h"
+#include "../page.h"
 #include "../atomic.h"
 #include "../spinlock.h"
 
@@ -187,4 +188,66 @@ tb_bool_t tb_native_memory_free(tb_pointer_t data)
     // ok?
     return ok;
 }
+tb_size_t tb_native_memory_purge(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data && size, 0);
+
+    // the page size
+    tb_size_t page_size = tb_page_size();
+    tb_assert_and_check_return_val(page_size, 0);
+
+    // the whole pages in this range
+    tb_size_t head = tb_align((tb_size_t)data, page_size);
+    tb_size_t tail = ((tb_size_t)data + size) & ~(page_size - 1);
+    tb_check_return_val(head < tail, 0);
+
+    // reset them, the system will discard them instead of writing them to the paging file
+    return VirtualAlloc((LPVOID)head, (SIZE_T)(tail - head), MEM_RESET, PAGE_READWRITE)? tail - head : 0;
+}
+tb_pointer_t tb_native_memory_map(tb_size_t size)
+{
+    // check
+    tb_check_return_val(size, tb_null);
 
+    /* reserve and commit them eagerly
+     *
+     * the physical pages will be still allocated when they are accessed first,
+     * but the whole size will be charged to the system commit limit at once.
+     *
+     * @note we do not reserve them only and commit them on the guard page faults,
+     * because the system only grows the guard pages of the thread stacks automatically.
+     */
+    return (tb_pointer_t)VirtualAlloc(tb_null, (SIZE_T)size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+tb_bool_t tb_native_memory_unmap(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data && size, tb_false);
+
+    // unmap it
+    return VirtualFree((LPVOID)data, 0, MEM_RELEASE)? tb_true : tb_false;
+}
+tb_bool_t tb_native_memory_guard(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data && size, tb_false);
+
+    // disable to access them
+    DWORD protect = 0;
+    return VirtualProtect((LPVOID)data, (SIZE_T)size, PAGE_NOACCESS, &protect)? tb_true : tb_false;
+}
+tb_bool_t tb_native_memory_trim()
+{
+    // enter 
+    tb_spinlock_enter_without_profiler(&g_lock);
+
+    // compact the heap and decommit the free pages
+    if (g_heap) HeapCompact((HANDLE)g_heap, 0);
+
+    // leave
+    tb_spinlock_leave(&g_lock);
+
+    // ok
+    return tb_true;
+}
@@ -118,6 +118,7 @@ function check_interfaces()
     add_cfuncs("libc", nil,         "locale.h",                         "setlocale")
     add_cfuncs("libc", nil,         "stdio.h",                          "fputs")
     add_cfuncs("libc", nil,         "stdlib.h",                         "srandom", "random")
+    add_cfuncs("libc", nil,         "malloc.h",                         "malloc_trim")
 
     -- add the interfaces for libm
     add_cfuncs("libm", nil,         "math.h",                           "sincos", 
@@ -164,6 +165,7 @@ function check_interfaces()
     add_cfuncs("posix", nil,        "ifaddrs.h",                        "getifaddrs")
     add_cfuncs("posix", nil,        "semaphore.h",                      "sem_init")
     add_cfuncs("posix", nil,        "unistd.h",                         "getpagesize", "sysconf")
+    add_cfuncs("posix", nil,        "sys/mman.h",                       "madvise", "mmap")
     add_cfuncs("posix", nil,        "sched.h",                          "sched_yield")
     add_cfuncs("posix", nil,        "regex.h",                          "regcomp", "regexec")
     add_cfuncs("posix", nil,        "sys/uio.h",                        "readv", "writev", "preadv", "pwritev")